@@ -0,0 +1,81 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/AST.cpp" "CMakeFiles/IStudio.dir/src/AST.cpp.o" "gcc" "CMakeFiles/IStudio.dir/src/AST.cpp.o.d"
+  "/root/repo/src/Config.cpp" "CMakeFiles/IStudio.dir/src/Config.cpp.o" "gcc" "CMakeFiles/IStudio.dir/src/Config.cpp.o.d"
+  "/root/repo/src/Lexer.cpp" "CMakeFiles/IStudio.dir/src/Lexer.cpp.o" "gcc" "CMakeFiles/IStudio.dir/src/Lexer.cpp.o.d"
+  "/root/repo/src/Parser.cpp" "CMakeFiles/IStudio.dir/src/Parser.cpp.o" "gcc" "CMakeFiles/IStudio.dir/src/Parser.cpp.o.d"
+  "/root/repo/src/Symbol.cpp" "CMakeFiles/IStudio.dir/src/Symbol.cpp.o" "gcc" "CMakeFiles/IStudio.dir/src/Symbol.cpp.o.d"
+  "/root/repo/src/codegen/CCodeGenerator.cpp" "CMakeFiles/IStudio.dir/src/codegen/CCodeGenerator.cpp.o" "gcc" "CMakeFiles/IStudio.dir/src/codegen/CCodeGenerator.cpp.o.d"
+  "/root/repo/src/codegen/CppCodeGenerator.cpp" "CMakeFiles/IStudio.dir/src/codegen/CppCodeGenerator.cpp.o" "gcc" "CMakeFiles/IStudio.dir/src/codegen/CppCodeGenerator.cpp.o.d"
+  "/root/repo/src/codegen/GenericCodeGenerator.cpp" "CMakeFiles/IStudio.dir/src/codegen/GenericCodeGenerator.cpp.o" "gcc" "CMakeFiles/IStudio.dir/src/codegen/GenericCodeGenerator.cpp.o.d"
+  "/root/repo/src/codegen/JavaCodeGenerator.cpp" "CMakeFiles/IStudio.dir/src/codegen/JavaCodeGenerator.cpp.o" "gcc" "CMakeFiles/IStudio.dir/src/codegen/JavaCodeGenerator.cpp.o.d"
+  "/root/repo/src/codegen/PythonCodeGenerator.cpp" "CMakeFiles/IStudio.dir/src/codegen/PythonCodeGenerator.cpp.o" "gcc" "CMakeFiles/IStudio.dir/src/codegen/PythonCodeGenerator.cpp.o.d"
+  "/root/repo/src/codegen/RuleParser.cpp" "CMakeFiles/IStudio.dir/src/codegen/RuleParser.cpp.o" "gcc" "CMakeFiles/IStudio.dir/src/codegen/RuleParser.cpp.o.d"
+  "/root/repo/src/ir/Arena.cpp" "CMakeFiles/IStudio.dir/src/ir/Arena.cpp.o" "gcc" "CMakeFiles/IStudio.dir/src/ir/Arena.cpp.o.d"
+  "/root/repo/src/ir/Bitcode.cpp" "CMakeFiles/IStudio.dir/src/ir/Bitcode.cpp.o" "gcc" "CMakeFiles/IStudio.dir/src/ir/Bitcode.cpp.o.d"
+  "/root/repo/src/ir/Cloning.cpp" "CMakeFiles/IStudio.dir/src/ir/Cloning.cpp.o" "gcc" "CMakeFiles/IStudio.dir/src/ir/Cloning.cpp.o.d"
+  "/root/repo/src/ir/DeadCodeElimination.cpp" "CMakeFiles/IStudio.dir/src/ir/DeadCodeElimination.cpp.o" "gcc" "CMakeFiles/IStudio.dir/src/ir/DeadCodeElimination.cpp.o.d"
+  "/root/repo/src/ir/Dominators.cpp" "CMakeFiles/IStudio.dir/src/ir/Dominators.cpp.o" "gcc" "CMakeFiles/IStudio.dir/src/ir/Dominators.cpp.o.d"
+  "/root/repo/src/ir/EscapeAnalysis.cpp" "CMakeFiles/IStudio.dir/src/ir/EscapeAnalysis.cpp.o" "gcc" "CMakeFiles/IStudio.dir/src/ir/EscapeAnalysis.cpp.o.d"
+  "/root/repo/src/ir/GVN.cpp" "CMakeFiles/IStudio.dir/src/ir/GVN.cpp.o" "gcc" "CMakeFiles/IStudio.dir/src/ir/GVN.cpp.o.d"
+  "/root/repo/src/ir/IR.cpp" "CMakeFiles/IStudio.dir/src/ir/IR.cpp.o" "gcc" "CMakeFiles/IStudio.dir/src/ir/IR.cpp.o.d"
+  "/root/repo/src/ir/IRParser.cpp" "CMakeFiles/IStudio.dir/src/ir/IRParser.cpp.o" "gcc" "CMakeFiles/IStudio.dir/src/ir/IRParser.cpp.o.d"
+  "/root/repo/src/ir/IRPrinter.cpp" "CMakeFiles/IStudio.dir/src/ir/IRPrinter.cpp.o" "gcc" "CMakeFiles/IStudio.dir/src/ir/IRPrinter.cpp.o.d"
+  "/root/repo/src/ir/InductionVariables.cpp" "CMakeFiles/IStudio.dir/src/ir/InductionVariables.cpp.o" "gcc" "CMakeFiles/IStudio.dir/src/ir/InductionVariables.cpp.o.d"
+  "/root/repo/src/ir/Inliner.cpp" "CMakeFiles/IStudio.dir/src/ir/Inliner.cpp.o" "gcc" "CMakeFiles/IStudio.dir/src/ir/Inliner.cpp.o.d"
+  "/root/repo/src/ir/LICM.cpp" "CMakeFiles/IStudio.dir/src/ir/LICM.cpp.o" "gcc" "CMakeFiles/IStudio.dir/src/ir/LICM.cpp.o.d"
+  "/root/repo/src/ir/Liveness.cpp" "CMakeFiles/IStudio.dir/src/ir/Liveness.cpp.o" "gcc" "CMakeFiles/IStudio.dir/src/ir/Liveness.cpp.o.d"
+  "/root/repo/src/ir/LoopInfo.cpp" "CMakeFiles/IStudio.dir/src/ir/LoopInfo.cpp.o" "gcc" "CMakeFiles/IStudio.dir/src/ir/LoopInfo.cpp.o.d"
+  "/root/repo/src/ir/LoopSimplify.cpp" "CMakeFiles/IStudio.dir/src/ir/LoopSimplify.cpp.o" "gcc" "CMakeFiles/IStudio.dir/src/ir/LoopSimplify.cpp.o.d"
+  "/root/repo/src/ir/LoopUnroll.cpp" "CMakeFiles/IStudio.dir/src/ir/LoopUnroll.cpp.o" "gcc" "CMakeFiles/IStudio.dir/src/ir/LoopUnroll.cpp.o.d"
+  "/root/repo/src/ir/Lowering.cpp" "CMakeFiles/IStudio.dir/src/ir/Lowering.cpp.o" "gcc" "CMakeFiles/IStudio.dir/src/ir/Lowering.cpp.o.d"
+  "/root/repo/src/ir/PassManager.cpp" "CMakeFiles/IStudio.dir/src/ir/PassManager.cpp.o" "gcc" "CMakeFiles/IStudio.dir/src/ir/PassManager.cpp.o.d"
+  "/root/repo/src/ir/Passes.cpp" "CMakeFiles/IStudio.dir/src/ir/Passes.cpp.o" "gcc" "CMakeFiles/IStudio.dir/src/ir/Passes.cpp.o.d"
+  "/root/repo/src/ir/SCCP.cpp" "CMakeFiles/IStudio.dir/src/ir/SCCP.cpp.o" "gcc" "CMakeFiles/IStudio.dir/src/ir/SCCP.cpp.o.d"
+  "/root/repo/src/ir/SimplifyCFG.cpp" "CMakeFiles/IStudio.dir/src/ir/SimplifyCFG.cpp.o" "gcc" "CMakeFiles/IStudio.dir/src/ir/SimplifyCFG.cpp.o.d"
+  "/root/repo/src/ir/TailCallElimination.cpp" "CMakeFiles/IStudio.dir/src/ir/TailCallElimination.cpp.o" "gcc" "CMakeFiles/IStudio.dir/src/ir/TailCallElimination.cpp.o.d"
+  "/root/repo/src/ir/ValueRange.cpp" "CMakeFiles/IStudio.dir/src/ir/ValueRange.cpp.o" "gcc" "CMakeFiles/IStudio.dir/src/ir/ValueRange.cpp.o.d"
+  "/root/repo/src/ir/Verifier.cpp" "CMakeFiles/IStudio.dir/src/ir/Verifier.cpp.o" "gcc" "CMakeFiles/IStudio.dir/src/ir/Verifier.cpp.o.d"
+  "/root/repo/src/istudio/Diagnostics.cpp" "CMakeFiles/IStudio.dir/src/istudio/Diagnostics.cpp.o" "gcc" "CMakeFiles/IStudio.dir/src/istudio/Diagnostics.cpp.o.d"
+  "/root/repo/src/istudio/Lexer.cpp" "CMakeFiles/IStudio.dir/src/istudio/Lexer.cpp.o" "gcc" "CMakeFiles/IStudio.dir/src/istudio/Lexer.cpp.o.d"
+  "/root/repo/src/istudio/ThreadPool.cpp" "CMakeFiles/IStudio.dir/src/istudio/ThreadPool.cpp.o" "gcc" "CMakeFiles/IStudio.dir/src/istudio/ThreadPool.cpp.o.d"
+  "/root/repo/src/main.cpp" "CMakeFiles/IStudio.dir/src/main.cpp.o" "gcc" "CMakeFiles/IStudio.dir/src/main.cpp.o.d"
+  "/root/repo/src/semantic/AnalysisCache.cpp" "CMakeFiles/IStudio.dir/src/semantic/AnalysisCache.cpp.o" "gcc" "CMakeFiles/IStudio.dir/src/semantic/AnalysisCache.cpp.o.d"
+  "/root/repo/src/semantic/ConstantEvaluator.cpp" "CMakeFiles/IStudio.dir/src/semantic/ConstantEvaluator.cpp.o" "gcc" "CMakeFiles/IStudio.dir/src/semantic/ConstantEvaluator.cpp.o.d"
+  "/root/repo/src/semantic/ControlFlowGraph.cpp" "CMakeFiles/IStudio.dir/src/semantic/ControlFlowGraph.cpp.o" "gcc" "CMakeFiles/IStudio.dir/src/semantic/ControlFlowGraph.cpp.o.d"
+  "/root/repo/src/semantic/Dataflow.cpp" "CMakeFiles/IStudio.dir/src/semantic/Dataflow.cpp.o" "gcc" "CMakeFiles/IStudio.dir/src/semantic/Dataflow.cpp.o.d"
+  "/root/repo/src/semantic/FlowAnalysis.cpp" "CMakeFiles/IStudio.dir/src/semantic/FlowAnalysis.cpp.o" "gcc" "CMakeFiles/IStudio.dir/src/semantic/FlowAnalysis.cpp.o.d"
+  "/root/repo/src/semantic/OwnershipAnalysis.cpp" "CMakeFiles/IStudio.dir/src/semantic/OwnershipAnalysis.cpp.o" "gcc" "CMakeFiles/IStudio.dir/src/semantic/OwnershipAnalysis.cpp.o.d"
+  "/root/repo/src/semantic/SemanticAnalyzer.cpp" "CMakeFiles/IStudio.dir/src/semantic/SemanticAnalyzer.cpp.o" "gcc" "CMakeFiles/IStudio.dir/src/semantic/SemanticAnalyzer.cpp.o.d"
+  "/root/repo/src/semantic/SymbolTable.cpp" "CMakeFiles/IStudio.dir/src/semantic/SymbolTable.cpp.o" "gcc" "CMakeFiles/IStudio.dir/src/semantic/SymbolTable.cpp.o.d"
+  "/root/repo/src/semantic/Type.cpp" "CMakeFiles/IStudio.dir/src/semantic/Type.cpp.o" "gcc" "CMakeFiles/IStudio.dir/src/semantic/Type.cpp.o.d"
+  "/root/repo/src/vm/Bytecode.cpp" "CMakeFiles/IStudio.dir/src/vm/Bytecode.cpp.o" "gcc" "CMakeFiles/IStudio.dir/src/vm/Bytecode.cpp.o.d"
+  "/root/repo/src/vm/BytecodeCompiler.cpp" "CMakeFiles/IStudio.dir/src/vm/BytecodeCompiler.cpp.o" "gcc" "CMakeFiles/IStudio.dir/src/vm/BytecodeCompiler.cpp.o.d"
+  "/root/repo/src/vm/Interpreter.cpp" "CMakeFiles/IStudio.dir/src/vm/Interpreter.cpp.o" "gcc" "CMakeFiles/IStudio.dir/src/vm/Interpreter.cpp.o.d"
+  "/root/repo/src/vm/Intrinsics.cpp" "CMakeFiles/IStudio.dir/src/vm/Intrinsics.cpp.o" "gcc" "CMakeFiles/IStudio.dir/src/vm/Intrinsics.cpp.o.d"
+  "/root/repo/src/vm/Value.cpp" "CMakeFiles/IStudio.dir/src/vm/Value.cpp.o" "gcc" "CMakeFiles/IStudio.dir/src/vm/Value.cpp.o.d"
+  "/root/repo/src/x86/Assembler.cpp" "CMakeFiles/IStudio.dir/src/x86/Assembler.cpp.o" "gcc" "CMakeFiles/IStudio.dir/src/x86/Assembler.cpp.o.d"
+  "/root/repo/src/x86/CodeGen.cpp" "CMakeFiles/IStudio.dir/src/x86/CodeGen.cpp.o" "gcc" "CMakeFiles/IStudio.dir/src/x86/CodeGen.cpp.o.d"
+  "/root/repo/src/x86/ElfWriter.cpp" "CMakeFiles/IStudio.dir/src/x86/ElfWriter.cpp.o" "gcc" "CMakeFiles/IStudio.dir/src/x86/ElfWriter.cpp.o.d"
+  "/root/repo/src/x86/Jit.cpp" "CMakeFiles/IStudio.dir/src/x86/Jit.cpp.o" "gcc" "CMakeFiles/IStudio.dir/src/x86/Jit.cpp.o.d"
+  "/root/repo/src/x86/LinearScan.cpp" "CMakeFiles/IStudio.dir/src/x86/LinearScan.cpp.o" "gcc" "CMakeFiles/IStudio.dir/src/x86/LinearScan.cpp.o.d"
+  )
+
+# Targets to which this target links which contain Fortran sources.
+set(CMAKE_Fortran_TARGET_LINKED_INFO_FILES
+  )
+
+# Targets to which this target links which contain Fortran sources.
+set(CMAKE_Fortran_TARGET_FORWARD_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
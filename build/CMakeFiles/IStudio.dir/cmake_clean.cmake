@@ -0,0 +1,127 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/IStudio.dir/src/AST.cpp.o"
+  "CMakeFiles/IStudio.dir/src/AST.cpp.o.d"
+  "CMakeFiles/IStudio.dir/src/Config.cpp.o"
+  "CMakeFiles/IStudio.dir/src/Config.cpp.o.d"
+  "CMakeFiles/IStudio.dir/src/Lexer.cpp.o"
+  "CMakeFiles/IStudio.dir/src/Lexer.cpp.o.d"
+  "CMakeFiles/IStudio.dir/src/Parser.cpp.o"
+  "CMakeFiles/IStudio.dir/src/Parser.cpp.o.d"
+  "CMakeFiles/IStudio.dir/src/Symbol.cpp.o"
+  "CMakeFiles/IStudio.dir/src/Symbol.cpp.o.d"
+  "CMakeFiles/IStudio.dir/src/codegen/CCodeGenerator.cpp.o"
+  "CMakeFiles/IStudio.dir/src/codegen/CCodeGenerator.cpp.o.d"
+  "CMakeFiles/IStudio.dir/src/codegen/CppCodeGenerator.cpp.o"
+  "CMakeFiles/IStudio.dir/src/codegen/CppCodeGenerator.cpp.o.d"
+  "CMakeFiles/IStudio.dir/src/codegen/GenericCodeGenerator.cpp.o"
+  "CMakeFiles/IStudio.dir/src/codegen/GenericCodeGenerator.cpp.o.d"
+  "CMakeFiles/IStudio.dir/src/codegen/JavaCodeGenerator.cpp.o"
+  "CMakeFiles/IStudio.dir/src/codegen/JavaCodeGenerator.cpp.o.d"
+  "CMakeFiles/IStudio.dir/src/codegen/PythonCodeGenerator.cpp.o"
+  "CMakeFiles/IStudio.dir/src/codegen/PythonCodeGenerator.cpp.o.d"
+  "CMakeFiles/IStudio.dir/src/codegen/RuleParser.cpp.o"
+  "CMakeFiles/IStudio.dir/src/codegen/RuleParser.cpp.o.d"
+  "CMakeFiles/IStudio.dir/src/ir/Arena.cpp.o"
+  "CMakeFiles/IStudio.dir/src/ir/Arena.cpp.o.d"
+  "CMakeFiles/IStudio.dir/src/ir/Bitcode.cpp.o"
+  "CMakeFiles/IStudio.dir/src/ir/Bitcode.cpp.o.d"
+  "CMakeFiles/IStudio.dir/src/ir/Cloning.cpp.o"
+  "CMakeFiles/IStudio.dir/src/ir/Cloning.cpp.o.d"
+  "CMakeFiles/IStudio.dir/src/ir/DeadCodeElimination.cpp.o"
+  "CMakeFiles/IStudio.dir/src/ir/DeadCodeElimination.cpp.o.d"
+  "CMakeFiles/IStudio.dir/src/ir/Dominators.cpp.o"
+  "CMakeFiles/IStudio.dir/src/ir/Dominators.cpp.o.d"
+  "CMakeFiles/IStudio.dir/src/ir/EscapeAnalysis.cpp.o"
+  "CMakeFiles/IStudio.dir/src/ir/EscapeAnalysis.cpp.o.d"
+  "CMakeFiles/IStudio.dir/src/ir/GVN.cpp.o"
+  "CMakeFiles/IStudio.dir/src/ir/GVN.cpp.o.d"
+  "CMakeFiles/IStudio.dir/src/ir/IR.cpp.o"
+  "CMakeFiles/IStudio.dir/src/ir/IR.cpp.o.d"
+  "CMakeFiles/IStudio.dir/src/ir/IRParser.cpp.o"
+  "CMakeFiles/IStudio.dir/src/ir/IRParser.cpp.o.d"
+  "CMakeFiles/IStudio.dir/src/ir/IRPrinter.cpp.o"
+  "CMakeFiles/IStudio.dir/src/ir/IRPrinter.cpp.o.d"
+  "CMakeFiles/IStudio.dir/src/ir/InductionVariables.cpp.o"
+  "CMakeFiles/IStudio.dir/src/ir/InductionVariables.cpp.o.d"
+  "CMakeFiles/IStudio.dir/src/ir/Inliner.cpp.o"
+  "CMakeFiles/IStudio.dir/src/ir/Inliner.cpp.o.d"
+  "CMakeFiles/IStudio.dir/src/ir/LICM.cpp.o"
+  "CMakeFiles/IStudio.dir/src/ir/LICM.cpp.o.d"
+  "CMakeFiles/IStudio.dir/src/ir/Liveness.cpp.o"
+  "CMakeFiles/IStudio.dir/src/ir/Liveness.cpp.o.d"
+  "CMakeFiles/IStudio.dir/src/ir/LoopInfo.cpp.o"
+  "CMakeFiles/IStudio.dir/src/ir/LoopInfo.cpp.o.d"
+  "CMakeFiles/IStudio.dir/src/ir/LoopSimplify.cpp.o"
+  "CMakeFiles/IStudio.dir/src/ir/LoopSimplify.cpp.o.d"
+  "CMakeFiles/IStudio.dir/src/ir/LoopUnroll.cpp.o"
+  "CMakeFiles/IStudio.dir/src/ir/LoopUnroll.cpp.o.d"
+  "CMakeFiles/IStudio.dir/src/ir/Lowering.cpp.o"
+  "CMakeFiles/IStudio.dir/src/ir/Lowering.cpp.o.d"
+  "CMakeFiles/IStudio.dir/src/ir/PassManager.cpp.o"
+  "CMakeFiles/IStudio.dir/src/ir/PassManager.cpp.o.d"
+  "CMakeFiles/IStudio.dir/src/ir/Passes.cpp.o"
+  "CMakeFiles/IStudio.dir/src/ir/Passes.cpp.o.d"
+  "CMakeFiles/IStudio.dir/src/ir/SCCP.cpp.o"
+  "CMakeFiles/IStudio.dir/src/ir/SCCP.cpp.o.d"
+  "CMakeFiles/IStudio.dir/src/ir/SimplifyCFG.cpp.o"
+  "CMakeFiles/IStudio.dir/src/ir/SimplifyCFG.cpp.o.d"
+  "CMakeFiles/IStudio.dir/src/ir/TailCallElimination.cpp.o"
+  "CMakeFiles/IStudio.dir/src/ir/TailCallElimination.cpp.o.d"
+  "CMakeFiles/IStudio.dir/src/ir/ValueRange.cpp.o"
+  "CMakeFiles/IStudio.dir/src/ir/ValueRange.cpp.o.d"
+  "CMakeFiles/IStudio.dir/src/ir/Verifier.cpp.o"
+  "CMakeFiles/IStudio.dir/src/ir/Verifier.cpp.o.d"
+  "CMakeFiles/IStudio.dir/src/istudio/Diagnostics.cpp.o"
+  "CMakeFiles/IStudio.dir/src/istudio/Diagnostics.cpp.o.d"
+  "CMakeFiles/IStudio.dir/src/istudio/Lexer.cpp.o"
+  "CMakeFiles/IStudio.dir/src/istudio/Lexer.cpp.o.d"
+  "CMakeFiles/IStudio.dir/src/istudio/ThreadPool.cpp.o"
+  "CMakeFiles/IStudio.dir/src/istudio/ThreadPool.cpp.o.d"
+  "CMakeFiles/IStudio.dir/src/main.cpp.o"
+  "CMakeFiles/IStudio.dir/src/main.cpp.o.d"
+  "CMakeFiles/IStudio.dir/src/semantic/AnalysisCache.cpp.o"
+  "CMakeFiles/IStudio.dir/src/semantic/AnalysisCache.cpp.o.d"
+  "CMakeFiles/IStudio.dir/src/semantic/ConstantEvaluator.cpp.o"
+  "CMakeFiles/IStudio.dir/src/semantic/ConstantEvaluator.cpp.o.d"
+  "CMakeFiles/IStudio.dir/src/semantic/ControlFlowGraph.cpp.o"
+  "CMakeFiles/IStudio.dir/src/semantic/ControlFlowGraph.cpp.o.d"
+  "CMakeFiles/IStudio.dir/src/semantic/Dataflow.cpp.o"
+  "CMakeFiles/IStudio.dir/src/semantic/Dataflow.cpp.o.d"
+  "CMakeFiles/IStudio.dir/src/semantic/FlowAnalysis.cpp.o"
+  "CMakeFiles/IStudio.dir/src/semantic/FlowAnalysis.cpp.o.d"
+  "CMakeFiles/IStudio.dir/src/semantic/OwnershipAnalysis.cpp.o"
+  "CMakeFiles/IStudio.dir/src/semantic/OwnershipAnalysis.cpp.o.d"
+  "CMakeFiles/IStudio.dir/src/semantic/SemanticAnalyzer.cpp.o"
+  "CMakeFiles/IStudio.dir/src/semantic/SemanticAnalyzer.cpp.o.d"
+  "CMakeFiles/IStudio.dir/src/semantic/SymbolTable.cpp.o"
+  "CMakeFiles/IStudio.dir/src/semantic/SymbolTable.cpp.o.d"
+  "CMakeFiles/IStudio.dir/src/semantic/Type.cpp.o"
+  "CMakeFiles/IStudio.dir/src/semantic/Type.cpp.o.d"
+  "CMakeFiles/IStudio.dir/src/vm/Bytecode.cpp.o"
+  "CMakeFiles/IStudio.dir/src/vm/Bytecode.cpp.o.d"
+  "CMakeFiles/IStudio.dir/src/vm/BytecodeCompiler.cpp.o"
+  "CMakeFiles/IStudio.dir/src/vm/BytecodeCompiler.cpp.o.d"
+  "CMakeFiles/IStudio.dir/src/vm/Interpreter.cpp.o"
+  "CMakeFiles/IStudio.dir/src/vm/Interpreter.cpp.o.d"
+  "CMakeFiles/IStudio.dir/src/vm/Intrinsics.cpp.o"
+  "CMakeFiles/IStudio.dir/src/vm/Intrinsics.cpp.o.d"
+  "CMakeFiles/IStudio.dir/src/vm/Value.cpp.o"
+  "CMakeFiles/IStudio.dir/src/vm/Value.cpp.o.d"
+  "CMakeFiles/IStudio.dir/src/x86/Assembler.cpp.o"
+  "CMakeFiles/IStudio.dir/src/x86/Assembler.cpp.o.d"
+  "CMakeFiles/IStudio.dir/src/x86/CodeGen.cpp.o"
+  "CMakeFiles/IStudio.dir/src/x86/CodeGen.cpp.o.d"
+  "CMakeFiles/IStudio.dir/src/x86/ElfWriter.cpp.o"
+  "CMakeFiles/IStudio.dir/src/x86/ElfWriter.cpp.o.d"
+  "CMakeFiles/IStudio.dir/src/x86/Jit.cpp.o"
+  "CMakeFiles/IStudio.dir/src/x86/Jit.cpp.o.d"
+  "CMakeFiles/IStudio.dir/src/x86/LinearScan.cpp.o"
+  "CMakeFiles/IStudio.dir/src/x86/LinearScan.cpp.o.d"
+  "IStudio"
+  "IStudio.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/IStudio.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
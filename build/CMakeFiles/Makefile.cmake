@@ -0,0 +1,72 @@
+# CMAKE generated file: DO NOT EDIT!
+# Generated by "Unix Makefiles" Generator, CMake Version 4.4
+
+# The generator used is:
+set(CMAKE_DEPENDS_GENERATOR "Unix Makefiles")
+
+# The top level Makefile was generated from the following files:
+set(CMAKE_MAKEFILE_DEPENDS
+  "CMakeCache.txt"
+  "/opt/cmakepy/cmake/data/share/cmake-4.4/Modules/BasicConfigVersion-AnyNewerVersion.cmake.in"
+  "/opt/cmakepy/cmake/data/share/cmake-4.4/Modules/CMakeCXXInformation.cmake"
+  "/opt/cmakepy/cmake/data/share/cmake-4.4/Modules/CMakeCommonLanguageInclude.cmake"
+  "/opt/cmakepy/cmake/data/share/cmake-4.4/Modules/CMakeGenericSystem.cmake"
+  "/opt/cmakepy/cmake/data/share/cmake-4.4/Modules/CMakeInitializeConfigs.cmake"
+  "/opt/cmakepy/cmake/data/share/cmake-4.4/Modules/CMakeLanguageInformation.cmake"
+  "/opt/cmakepy/cmake/data/share/cmake-4.4/Modules/CMakePackageConfigHelpers.cmake"
+  "/opt/cmakepy/cmake/data/share/cmake-4.4/Modules/CMakeSystemSpecificInformation.cmake"
+  "/opt/cmakepy/cmake/data/share/cmake-4.4/Modules/CMakeSystemSpecificInitialize.cmake"
+  "/opt/cmakepy/cmake/data/share/cmake-4.4/Modules/CTest.cmake"
+  "/opt/cmakepy/cmake/data/share/cmake-4.4/Modules/CTestUseLaunchers.cmake"
+  "/opt/cmakepy/cmake/data/share/cmake-4.4/Modules/CheckCXXSourceCompiles.cmake"
+  "/opt/cmakepy/cmake/data/share/cmake-4.4/Modules/CheckIncludeFileCXX.cmake"
+  "/opt/cmakepy/cmake/data/share/cmake-4.4/Modules/CheckLibraryExists.cmake"
+  "/opt/cmakepy/cmake/data/share/cmake-4.4/Modules/Compiler/CMakeCommonCompilerMacros.cmake"
+  "/opt/cmakepy/cmake/data/share/cmake-4.4/Modules/Compiler/GNU-CXX.cmake"
+  "/opt/cmakepy/cmake/data/share/cmake-4.4/Modules/Compiler/GNU.cmake"
+  "/opt/cmakepy/cmake/data/share/cmake-4.4/Modules/FindPackageHandleStandardArgs.cmake"
+  "/opt/cmakepy/cmake/data/share/cmake-4.4/Modules/FindPackageMessage.cmake"
+  "/opt/cmakepy/cmake/data/share/cmake-4.4/Modules/FindThreads.cmake"
+  "/opt/cmakepy/cmake/data/share/cmake-4.4/Modules/GNUInstallDirs.cmake"
+  "/opt/cmakepy/cmake/data/share/cmake-4.4/Modules/Internal/CMakeCXXLinkerInformation.cmake"
+  "/opt/cmakepy/cmake/data/share/cmake-4.4/Modules/Internal/CMakeCommonLinkerInformation.cmake"
+  "/opt/cmakepy/cmake/data/share/cmake-4.4/Modules/Internal/CheckCommon.cmake"
+  "/opt/cmakepy/cmake/data/share/cmake-4.4/Modules/Internal/CheckSourceCompiles.cmake"
+  "/opt/cmakepy/cmake/data/share/cmake-4.4/Modules/Linker/GNU-CXX.cmake"
+  "/opt/cmakepy/cmake/data/share/cmake-4.4/Modules/Linker/GNU.cmake"
+  "/opt/cmakepy/cmake/data/share/cmake-4.4/Modules/Platform/Linker/GNU.cmake"
+  "/opt/cmakepy/cmake/data/share/cmake-4.4/Modules/Platform/Linker/Linux-GNU-CXX.cmake"
+  "/opt/cmakepy/cmake/data/share/cmake-4.4/Modules/Platform/Linker/Linux-GNU.cmake"
+  "/opt/cmakepy/cmake/data/share/cmake-4.4/Modules/Platform/Linux-GNU-CXX.cmake"
+  "/opt/cmakepy/cmake/data/share/cmake-4.4/Modules/Platform/Linux-GNU.cmake"
+  "/opt/cmakepy/cmake/data/share/cmake-4.4/Modules/Platform/Linux-Initialize.cmake"
+  "/opt/cmakepy/cmake/data/share/cmake-4.4/Modules/Platform/Linux.cmake"
+  "/opt/cmakepy/cmake/data/share/cmake-4.4/Modules/Platform/UnixPaths.cmake"
+  "/opt/cmakepy/cmake/data/share/cmake-4.4/Modules/WriteBasicConfigVersionFile.cmake"
+  "/root/repo/CMakeLists.txt"
+  "CMakeFiles/4.4.4/CMakeCXXCompiler.cmake"
+  "CMakeFiles/4.4.4/CMakeSystem.cmake"
+  "/root/repo/cmake/IStudioConfig.cmake.in"
+  )
+
+# The corresponding makefile is:
+set(CMAKE_MAKEFILE_OUTPUTS
+  "Makefile"
+  "CMakeFiles/cmake.check_cache"
+  )
+
+# Byproducts of CMake generate step:
+set(CMAKE_MAKEFILE_PRODUCTS
+  "IStudioConfig.cmake"
+  "IStudioConfigVersion.cmake"
+  "CMakeFiles/CMakeDirectoryInformation.cmake"
+  )
+
+# Dependency information for all targets:
+set(CMAKE_DEPEND_INFO_FILES
+  "CMakeFiles/IStudio.dir/DependInfo.cmake"
+  "CMakeFiles/ipl_compiler.dir/DependInfo.cmake"
+  "CMakeFiles/test_suite.dir/DependInfo.cmake"
+  "CMakeFiles/sample_tests.dir/DependInfo.cmake"
+  "CMakeFiles/install-all.dir/DependInfo.cmake"
+  )
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ipl_compiler.dir/src/ipl_compiler/ipl_compiler.cpp.o"
+  "CMakeFiles/ipl_compiler.dir/src/ipl_compiler/ipl_compiler.cpp.o.d"
+  "ipl_compiler"
+  "ipl_compiler.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ipl_compiler.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
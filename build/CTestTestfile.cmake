@@ -0,0 +1,237 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo
+# Build directory: /root/repo/build
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test("ipl_help_test" "/root/repo/build/IStudio" "--help")
+set_tests_properties("ipl_help_test" PROPERTIES  WORKING_DIRECTORY "/root/repo" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;251;add_test;/root/repo/CMakeLists.txt;0;")
+add_test("ipl_version_test" "/root/repo/build/IStudio" "--version")
+set_tests_properties("ipl_version_test" PROPERTIES  WORKING_DIRECTORY "/root/repo" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;256;add_test;/root/repo/CMakeLists.txt;0;")
+add_test("ipl_sample_lex_test" "/root/repo/build/IStudio" "--lex-ipl-samples")
+set_tests_properties("ipl_sample_lex_test" PROPERTIES  WORKING_DIRECTORY "/root/repo" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;262;add_test;/root/repo/CMakeLists.txt;0;")
+add_test("ipl_simple_compile_test" "/root/repo/build/IStudio" "compile" "examples/ipl/00_hello_world.ipl" "--grammar" "examples/grammar_rules.txt" "--translation" "examples/translation_rules.txt")
+set_tests_properties("ipl_simple_compile_test" PROPERTIES  WORKING_DIRECTORY "/root/repo" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;268;add_test;/root/repo/CMakeLists.txt;0;")
+add_test("ipl_invalid_unterminated_string" "/root/repo/build/IStudio" "compile" "examples/ipl_invalid/00_unterminated_string.ipl")
+set_tests_properties("ipl_invalid_unterminated_string" PROPERTIES  WILL_FAIL "TRUE" WORKING_DIRECTORY "/root/repo" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;274;add_test;/root/repo/CMakeLists.txt;0;")
+add_test("ipl_invalid_unknown_character" "/root/repo/build/IStudio" "compile" "examples/ipl_invalid/01_unknown_character.ipl")
+set_tests_properties("ipl_invalid_unknown_character" PROPERTIES  WILL_FAIL "TRUE" WORKING_DIRECTORY "/root/repo" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;280;add_test;/root/repo/CMakeLists.txt;0;")
+add_test("ipl_invalid_missing_paren" "/root/repo/build/IStudio" "compile" "examples/ipl_invalid/02_missing_paren.ipl")
+set_tests_properties("ipl_invalid_missing_paren" PROPERTIES  WILL_FAIL "TRUE" WORKING_DIRECTORY "/root/repo" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;286;add_test;/root/repo/CMakeLists.txt;0;")
+add_test("ipl_invalid_missing_semicolon" "/root/repo/build/IStudio" "compile" "examples/ipl_invalid/03_missing_semicolon.ipl")
+set_tests_properties("ipl_invalid_missing_semicolon" PROPERTIES  WILL_FAIL "TRUE" WORKING_DIRECTORY "/root/repo" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;292;add_test;/root/repo/CMakeLists.txt;0;")
+add_test("ipl_emit_sema_test" "/root/repo/build/IStudio" "compile" "tests/parser_valid/loops.ipl" "--emit-sema")
+set_tests_properties("ipl_emit_sema_test" PROPERTIES  PASS_REGULAR_EXPRESSION [[- \[fn\] sum_to : int
+  - \[var\] limit : int
+    - \[var\] total : int
+      - \[var\] i : int]] WORKING_DIRECTORY "/root/repo" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;301;add_test;/root/repo/CMakeLists.txt;0;")
+add_test("ipl_forward_call_test" "/root/repo/build/IStudio" "compile" "tests/semantic_valid/forward_call.ipl")
+set_tests_properties("ipl_forward_call_test" PROPERTIES  WORKING_DIRECTORY "/root/repo" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;310;add_test;/root/repo/CMakeLists.txt;0;")
+add_test("ipl_branch_returns_test" "/root/repo/build/IStudio" "compile" "tests/semantic_valid/branch_returns.ipl")
+set_tests_properties("ipl_branch_returns_test" PROPERTIES  WORKING_DIRECTORY "/root/repo" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;316;add_test;/root/repo/CMakeLists.txt;0;")
+add_test("ipl_missing_return_test" "/root/repo/build/IStudio" "compile" "tests/semantic_invalid/missing_return.ipl")
+set_tests_properties("ipl_missing_return_test" PROPERTIES  PASS_REGULAR_EXPRESSION "Function 'main' with non-void return type must return a value" WORKING_DIRECTORY "/root/repo" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;321;add_test;/root/repo/CMakeLists.txt;0;")
+add_test("ipl_maybe_unassigned_test" "/root/repo/build/IStudio" "compile" "tests/semantic_invalid/maybe_unassigned.ipl")
+set_tests_properties("ipl_maybe_unassigned_test" PROPERTIES  PASS_REGULAR_EXPRESSION "Variable 'value' may be used before it is assigned" WORKING_DIRECTORY "/root/repo" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;329;add_test;/root/repo/CMakeLists.txt;0;")
+add_test("ipl_use_after_move_test" "/root/repo/build/IStudio" "compile" "tests/semantic_invalid/use_after_move.ipl")
+set_tests_properties("ipl_use_after_move_test" PROPERTIES  PASS_REGULAR_EXPRESSION "Use of moved value: name" WORKING_DIRECTORY "/root/repo" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;337;add_test;/root/repo/CMakeLists.txt;0;")
+add_test("ipl_move_while_borrowed_test" "/root/repo/build/IStudio" "compile" "tests/semantic_invalid/move_while_borrowed.ipl")
+set_tests_properties("ipl_move_while_borrowed_test" PROPERTIES  PASS_REGULAR_EXPRESSION "Cannot move 'name' while it is borrowed by 'view'" WORKING_DIRECTORY "/root/repo" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;345;add_test;/root/repo/CMakeLists.txt;0;")
+add_test("ipl_cpp_move_elision_test" "/root/repo/build/IStudio" "compile" "examples/ipl/13_ownership.ipl" "--target" "cpp" "--output" "/dev/stdout")
+set_tests_properties("ipl_cpp_move_elision_test" PROPERTIES  PASS_REGULAR_EXPRESSION [[void consume\(string data\)
+ \{
+    print\(std::move\(data\)\);]] WORKING_DIRECTORY "/root/repo" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;354;add_test;/root/repo/CMakeLists.txt;0;")
+add_test("ipl_cpp_move_repeated_argument_test" "/root/repo/build/IStudio" "compile" "tests/semantic_valid/repeated_owned_argument.ipl" "--target" "cpp" "--output" "/dev/stdout")
+set_tests_properties("ipl_cpp_move_repeated_argument_test" PROPERTIES  FAIL_REGULAR_EXPRESSION [[std::move\(name\)]] PASS_REGULAR_EXPRESSION [[    pair\(name, name\);
+.*    pair\(std::move\(last\), "x"\);]] WORKING_DIRECTORY "/root/repo" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;363;add_test;/root/repo/CMakeLists.txt;0;")
+add_test("ipl_incremental_analysis_test" "/root/repo/build/IStudio" "compile" "tests/incremental/base.ipl" "--reanalyze" "tests/incremental/edited.ipl")
+set_tests_properties("ipl_incremental_analysis_test" PROPERTIES  PASS_REGULAR_EXPRESSION [[Call to undefined function: helper
+Reanalysis: 4 functions checked, 2 reused
+.*\[function\] scale : string]] WORKING_DIRECTORY "/root/repo" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;375;add_test;/root/repo/CMakeLists.txt;0;")
+add_test("ipl_assign_constant_test" "/root/repo/build/IStudio" "compile" "tests/semantic_invalid/assign_constant.ipl")
+set_tests_properties("ipl_assign_constant_test" PROPERTIES  PASS_REGULAR_EXPRESSION "Cannot assign to constant: limit" WORKING_DIRECTORY "/root/repo" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;384;add_test;/root/repo/CMakeLists.txt;0;")
+add_test("ipl_constant_folding_test" "/root/repo/build/IStudio" "compile" "tests/semantic_valid/constant_folding.ipl" "--target" "c" "--output" "/dev/stdout")
+set_tests_properties("ipl_constant_folding_test" PROPERTIES  PASS_REGULAR_EXPRESSION [[int area = 42;
+    int third = \(9 / 3\);
+    int wide = \(2000000000 \+ 2000000000\);.*largest = 3.5;]] WORKING_DIRECTORY "/root/repo" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;392;add_test;/root/repo/CMakeLists.txt;0;")
+add_test("ipl_constant_folding_python_test" "/root/repo/build/IStudio" "compile" "tests/semantic_valid/constant_folding.ipl" "--target" "python" "--output" "/dev/stdout")
+set_tests_properties("ipl_constant_folding_python_test" PROPERTIES  PASS_REGULAR_EXPRESSION [[area = 42
+        third = \(9 / 3\)
+]] WORKING_DIRECTORY "/root/repo" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;401;add_test;/root/repo/CMakeLists.txt;0;")
+add_test("ipl_template_instances_test" "/root/repo/build/IStudio" "compile" "tests/semantic_valid/template_instances.ipl" "--target" "c" "--output" "/dev/stdout")
+set_tests_properties("ipl_template_instances_test" PROPERTIES  PASS_REGULAR_EXPRESSION [[int pick_int\(int first, int second, int takeFirst\).*char\* pick_string\(.*int b = pick_int\(3, 4, false\);]] WORKING_DIRECTORY "/root/repo" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;409;add_test;/root/repo/CMakeLists.txt;0;")
+add_test("ipl_template_conflict_test" "/root/repo/build/IStudio" "compile" "tests/semantic_invalid/template_conflict.ipl")
+set_tests_properties("ipl_template_conflict_test" PROPERTIES  PASS_REGULAR_EXPRESSION "Conflicting types for template parameter T: int and string in call to same" WORKING_DIRECTORY "/root/repo" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;417;add_test;/root/repo/CMakeLists.txt;0;")
+add_test("ipl_ssa_lowering_test" "/root/repo/build/IStudio" "compile" "tests/semantic_valid/ssa_lowering.ipl" "--emit-ir")
+set_tests_properties("ipl_ssa_lowering_test" PROPERTIES  PASS_REGULAR_EXPRESSION [[while.cond1:  . preds = %entry %if.end5
+  %0 = phi int \[ 0, %entry \], \[ %8, %if.end5 \].*%5 = add int %1, %0]] WORKING_DIRECTORY "/root/repo" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;425;add_test;/root/repo/CMakeLists.txt;0;")
+add_test("ipl_pass_pipeline_test" "/root/repo/build/IStudio" "compile" "tests/semantic_valid/pass_pipeline.ipl" "--emit-ir" "--passes" "dce" "--time-passes")
+set_tests_properties("ipl_pass_pipeline_test" PROPERTIES  PASS_REGULAR_EXPRESSION [[entry:
+  %0 = mul int %x, 2
+  ret int %0
+.*Pass execution report.*-2 +\+0 +1/2  dce]] WORKING_DIRECTORY "/root/repo" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;433;add_test;/root/repo/CMakeLists.txt;0;")
+add_test("ipl_sccp_pipeline_test" "/root/repo/build/IStudio" "compile" "tests/semantic_valid/sccp.ipl" "--emit-ir" "-O")
+set_tests_properties("ipl_sccp_pipeline_test" PROPERTIES  PASS_REGULAR_EXPRESSION [[function int @classify\(int %n\) \{
+entry:
+  %0 = add int %n, 2
+  br label %while.cond1
+.*while.body2:  . preds = %while.cond1
+  %3 = add int %1, 1
+  br label %while.cond1
+while.end3:  . preds = %while.cond1
+  ret int %0]] WORKING_DIRECTORY "/root/repo" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;441;add_test;/root/repo/CMakeLists.txt;0;")
+add_test("ipl_gvn_test" "/root/repo/build/IStudio" "compile" "tests/semantic_valid/gvn.ipl" "--emit-ir" "--passes" "gvn")
+set_tests_properties("ipl_gvn_test" PROPERTIES  PASS_REGULAR_EXPRESSION "%1 = add int %0, %c
+  %2 = gt bool %1, 10
+.*if.then1:  . preds = %entry
+  %3 = mul int %1, 2
+.*if.else2:  . preds = %entry
+  br_if bool %2," WORKING_DIRECTORY "/root/repo" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;449;add_test;/root/repo/CMakeLists.txt;0;")
+add_test("ipl_inliner_test" "/root/repo/build/IStudio" "compile" "tests/semantic_valid/inliner.ipl" "--emit-ir" "-O")
+set_tests_properties("ipl_inliner_test" PROPERTIES  PASS_REGULAR_EXPRESSION [[function int @square\(int %x\).*function int @main\(\) \{
+entry:
+  %0 = call int @fact\(int 4\)
+  %1 = mul int 5, %0
+  %2 = add int 25, %1
+  ret int %2
+\}]] WORKING_DIRECTORY "/root/repo" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;457;add_test;/root/repo/CMakeLists.txt;0;")
+add_test("ipl_licm_test" "/root/repo/build/IStudio" "compile" "tests/semantic_valid/licm.ipl" "--emit-ir" "--passes" "licm")
+set_tests_properties("ipl_licm_test" PROPERTIES  PASS_REGULAR_EXPRESSION "entry:
+  %0 = mul int %scale, %offset
+  br label %while.cond1
+.*while.body2:  . preds = %while.cond1
+  br label %while.cond3
+.*while.body4:  . preds = %while.cond3
+  %7 = add int %5, %0
+" WORKING_DIRECTORY "/root/repo" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;465;add_test;/root/repo/CMakeLists.txt;0;")
+add_test("ipl_loop_unroll_test" "/root/repo/build/IStudio" "compile" "tests/semantic_valid/loop_unroll.ipl" "--emit-ir" "-O")
+set_tests_properties("ipl_loop_unroll_test" PROPERTIES  PASS_REGULAR_EXPRESSION [[function int @kernel\(int %scale\) \{.*  %2 = lt bool %0, 8
+  br_if bool %2, label %for.body2, label %for.end3
+for.body2:  . preds = %for.cond1
+  %3 = mul int %0, %scale
+  %4 = add int %1, %3
+  %5 = add int %0, 1
+  %6 = mul int %5, %scale
+.*  %13 = add int %10, %12
+  %14 = add int %11, 1
+  br label %for.cond1
+]] WORKING_DIRECTORY "/root/repo" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;473;add_test;/root/repo/CMakeLists.txt;0;")
+add_test("ipl_loop_simplify_test" "/root/repo/build/IStudio" "compile" "tests/semantic_valid/loop_unroll.ipl" "--emit-ir" "--passes" "simplifycfg,loop-simplify")
+set_tests_properties("ipl_loop_simplify_test" PROPERTIES  PASS_REGULAR_EXPRESSION "br_if bool %2, label %while.body3, label %loop.exit4
+.*loop.exit4:  . preds = %while.cond2
+  br label %if.end5
+if.end5:  . preds = %entry %loop.exit4
+" WORKING_DIRECTORY "/root/repo" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;481;add_test;/root/repo/CMakeLists.txt;0;")
+add_test("ipl_vm_run_test" "/root/repo/build/IStudio" "run" "tests/semantic_valid/vm_run.ipl" "-O")
+set_tests_properties("ipl_vm_run_test" PROPERTIES  PASS_REGULAR_EXPRESSION "squares: 385
+fib: 610
+rotate: 21
+length: 2
+math: 1024
+" WORKING_DIRECTORY "/root/repo" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;489;add_test;/root/repo/CMakeLists.txt;0;")
+add_test("ipl_tail_call_test" "/root/repo/build/IStudio" "run" "tests/semantic_valid/tail_calls.ipl" "-O" "--no-jit")
+set_tests_properties("ipl_tail_call_test" PROPERTIES  PASS_REGULAR_EXPRESSION "5000050000
+21
+even: no
+" WORKING_DIRECTORY "/root/repo" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;498;add_test;/root/repo/CMakeLists.txt;0;")
+add_test("ipl_tail_call_ir_test" "/root/repo/build/IStudio" "compile" "tests/semantic_valid/tail_calls.ipl" "-O" "--emit-ir")
+set_tests_properties("ipl_tail_call_ir_test" PROPERTIES  PASS_REGULAR_EXPRESSION [[function int @sumTo.*
+tailrecurse1:.*function bool @even.*= tail call bool @odd\(int ]] WORKING_DIRECTORY "/root/repo" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;506;add_test;/root/repo/CMakeLists.txt;0;")
+add_test("ipl_range_check_test" "/root/repo/build/IStudio" "run" "tests/semantic_valid/range_checks.ipl" "-O" "--no-jit")
+set_tests_properties("ipl_range_check_test" PROPERTIES  PASS_REGULAR_EXPRESSION "45
+15
+7
+past the end
+5
+" WORKING_DIRECTORY "/root/repo" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;515;add_test;/root/repo/CMakeLists.txt;0;")
+add_test("ipl_range_check_ir_test" "/root/repo/build/IStudio" "compile" "tests/semantic_valid/range_checks.ipl" "-O" "--emit-ir")
+set_tests_properties("ipl_range_check_ir_test" PROPERTIES  FAIL_REGULAR_EXPRESSION "index out of range" PASS_REGULAR_EXPRESSION [[function int @pastTheEnd.*call void @println\(string "past the end"\)]] WORKING_DIRECTORY "/root/repo" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;523;add_test;/root/repo/CMakeLists.txt;0;")
+add_test("ipl_vm_bytecode_test" "/root/repo/build/IStudio" "run" "tests/semantic_valid/vm_run.ipl" "--emit-bytecode")
+set_tests_properties("ipl_vm_bytecode_test" PROPERTIES  PASS_REGULAR_EXPRESSION [[function rotate \(params 1, registers 10\)
+.*    9: AddI r8, r5, r2
+.*   11: Move r9, r6
+   12: Move r6, r7
+   13: Move r7, r9
+   14: Jump 7
+   15: MulI r8, r6, r4
+   16: AddI r6, r8, r7
+]] WORKING_DIRECTORY "/root/repo" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;532;add_test;/root/repo/CMakeLists.txt;0;")
+add_test("ipl_escape_analysis_test" "/root/repo/build/IStudio" "compile" "tests/semantic_valid/escape_analysis.ipl" "--emit-escapes")
+set_tests_properties("ipl_escape_analysis_test" PROPERTIES  PASS_REGULAR_EXPRESSION [[@count.*listCreate\(\)  . allocation, local
+.*@build.*listCreate\(\)  . allocation, returned
+.*@fill.*listCreate\(\)  . allocation, escaped
+.*add string "hello ", %name  . allocation, local
+.*@build\(int 3\)  . allocation, local
+.*@shout.*listCreate\(\)  . allocation, local
+  %1 = call string @toUpper\(string "hi"\)  . allocation, returned
+]] WORKING_DIRECTORY "/root/repo" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;540;add_test;/root/repo/CMakeLists.txt;0;")
+add_test("ipl_bitcode_save_test" "/root/repo/build/IStudio" "compile" "tests/semantic_valid/vm_run.ipl" "-O" "--save-ir" "/root/repo/build/vm_run.irb")
+set_tests_properties("ipl_bitcode_save_test" PROPERTIES  FIXTURES_SETUP "ir_bitcode" PASS_REGULAR_EXPRESSION [[IR bitcode written to: .*vm_run.irb \([0-9]+ bytes\)
+]] WORKING_DIRECTORY "/root/repo" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;549;add_test;/root/repo/CMakeLists.txt;0;")
+add_test("ipl_bitcode_save_library_test" "/root/repo/build/IStudio" "compile" "tests/semantic_valid/branch_returns.ipl" "--save-ir" "/root/repo/build/branch_returns.irb")
+set_tests_properties("ipl_bitcode_save_library_test" PROPERTIES  FIXTURES_SETUP "ir_bitcode" PASS_REGULAR_EXPRESSION "IR bitcode written to: .*branch_returns.irb" WORKING_DIRECTORY "/root/repo" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;559;add_test;/root/repo/CMakeLists.txt;0;")
+add_test("ipl_bitcode_link_test" "/root/repo/build/IStudio" "run" "/root/repo/build/vm_run.irb" "/root/repo/build/branch_returns.irb" "-v")
+set_tests_properties("ipl_bitcode_link_test" PROPERTIES  FIXTURES_REQUIRED "ir_bitcode" PASS_REGULAR_EXPRESSION "Loaded 3 functions from .*vm_run.irb
+Loaded 2 functions from .*branch_returns.irb
+.*squares: 385
+fib: 610
+rotate: 21
+length: 2
+math: 1024
+" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;569;add_test;/root/repo/CMakeLists.txt;0;")
+add_test("ipl_ir_file_pass_test" "/root/repo/build/IStudio" "compile" "tests/ir/sccp_branch.ir" "--passes" "sccp,simplifycfg" "--verify-ir" "--emit-ir")
+set_tests_properties("ipl_ir_file_pass_test" PROPERTIES  PASS_REGULAR_EXPRESSION [[function int @pick\(int %x\) {
+entry:
+  %0 = add int %x, 5
+  ret int %0
+}
+]] WORKING_DIRECTORY "/root/repo" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;579;add_test;/root/repo/CMakeLists.txt;0;")
+add_test("ipl_ir_verifier_test" "/root/repo/build/IStudio" "compile" "tests/ir/invalid_dominance.ir")
+set_tests_properties("ipl_ir_verifier_test" PROPERTIES  PASS_REGULAR_EXPRESSION "Error: invalid IR:
+  function 'broken': block 'skip2': operand 0 does not dominate its use in `%1 = mul int %0, 2`" WORKING_DIRECTORY "/root/repo" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;587;add_test;/root/repo/CMakeLists.txt;0;")
+add_test("ipl_verify_each_pass_test" "/root/repo/build/IStudio" "run" "tests/semantic_valid/vm_run.ipl" "-O" "--verify-ir" "--no-jit")
+set_tests_properties("ipl_verify_each_pass_test" PROPERTIES  FAIL_REGULAR_EXPRESSION "verification failed" PASS_REGULAR_EXPRESSION "squares: 385
+fib: 610
+" WORKING_DIRECTORY "/root/repo" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;595;add_test;/root/repo/CMakeLists.txt;0;")
+add_test("ipl_guarded_division_test" "/root/repo/build/IStudio" "run" "tests/semantic_valid/guarded_division.ipl")
+set_tests_properties("ipl_guarded_division_test" PROPERTIES  FAIL_REGULAR_EXPRESSION "Runtime error" PASS_REGULAR_EXPRESSION "above: no
+outside: yes
+" WORKING_DIRECTORY "/root/repo" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;605;add_test;/root/repo/CMakeLists.txt;0;")
+add_test("ipl_guarded_division_optimized_test" "/root/repo/build/IStudio" "run" "tests/semantic_valid/guarded_division.ipl" "-O")
+set_tests_properties("ipl_guarded_division_optimized_test" PROPERTIES  FAIL_REGULAR_EXPRESSION "Runtime error" PASS_REGULAR_EXPRESSION "above: no
+outside: yes
+" WORKING_DIRECTORY "/root/repo" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;614;add_test;/root/repo/CMakeLists.txt;0;")
+add_test("ipl_vm_stack_overflow_test" "bash" "-c" [[ulimit -s 1024 && exec "$0" run tests/semantic_valid/jit_stack_overflow.ipl --no-jit]] "/root/repo/build/IStudio")
+set_tests_properties("ipl_vm_stack_overflow_test" PROPERTIES  PASS_REGULAR_EXPRESSION [[
+5000
+Runtime error: stack overflow in call to 'depth'
+$]] WORKING_DIRECTORY "/root/repo" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;626;add_test;/root/repo/CMakeLists.txt;0;")
+add_test("ipl_native_build_test" "/root/repo/build/IStudio" "compile" "tests/semantic_valid/native_codegen.ipl" "-O" "--target" "x86-64" "--output" "/root/repo/build/native_codegen")
+set_tests_properties("ipl_native_build_test" PROPERTIES  FIXTURES_SETUP "native_codegen" PASS_REGULAR_EXPRESSION "Executable written to: .*native_codegen
+" WORKING_DIRECTORY "/root/repo" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;638;add_test;/root/repo/CMakeLists.txt;0;")
+add_test("ipl_native_run_test" "/root/repo/build/native_codegen")
+set_tests_properties("ipl_native_run_test" PROPERTIES  FIXTURES_REQUIRED "native_codegen" PASS_REGULAR_EXPRESSION [[^fib: 6765
+rotate: 21
+pressure: -9744
+$]] _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;648;add_test;/root/repo/CMakeLists.txt;0;")
+add_test("ipl_jit_run_test" "/root/repo/build/IStudio" "run" "tests/semantic_valid/jit_run.ipl" "-v")
+set_tests_properties("ipl_jit_run_test" PROPERTIES  PASS_REGULAR_EXPRESSION [[even: yes
+negative: -42
+Executed natively \(3 of 4 functions compiled\)
+]] WORKING_DIRECTORY "/root/repo" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;655;add_test;/root/repo/CMakeLists.txt;0;")
+add_test("ipl_jit_division_by_zero_test" "/root/repo/build/IStudio" "run" "tests/semantic_valid/jit_division_by_zero.ipl")
+set_tests_properties("ipl_jit_division_by_zero_test" PROPERTIES  PASS_REGULAR_EXPRESSION [[
+3
+Runtime error: integer division by zero
+$]] WORKING_DIRECTORY "/root/repo" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;664;add_test;/root/repo/CMakeLists.txt;0;")
+add_test("ipl_jit_stack_overflow_test" "/root/repo/build/IStudio" "run" "tests/semantic_valid/jit_stack_overflow.ipl")
+set_tests_properties("ipl_jit_stack_overflow_test" PROPERTIES  PASS_REGULAR_EXPRESSION [[
+5000
+Runtime error: stack overflow in call to 'depth'
+$]] WORKING_DIRECTORY "/root/repo" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;672;add_test;/root/repo/CMakeLists.txt;0;")
+add_test("ipl_dead_branch_test" "/root/repo/build/IStudio" "compile" "tests/semantic_valid/dead_branch.ipl" "--target" "c" "--output" "/dev/stdout")
+set_tests_properties("ipl_dead_branch_test" PROPERTIES  FAIL_REGULAR_EXPRESSION [[if \(|x = 5]] PASS_REGULAR_EXPRESSION [[int x = 1.*x = 7.*x = \(x \+ 1\)]] WORKING_DIRECTORY "/root/repo" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;681;add_test;/root/repo/CMakeLists.txt;0;")
+add_test("ipl_full_suite_test" "/root/repo/scripts/run_ipl_suite.sh")
+set_tests_properties("ipl_full_suite_test" PROPERTIES  TIMEOUT "120" WORKING_DIRECTORY "/root/repo" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;692;add_test;/root/repo/CMakeLists.txt;0;")
+add_test("ipl_samples_test" "/root/repo/scripts/test_ipl_samples.sh")
+set_tests_properties("ipl_samples_test" PROPERTIES  TIMEOUT "120" WORKING_DIRECTORY "/root/repo" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;699;add_test;/root/repo/CMakeLists.txt;0;")
@@ -31,6 +31,12 @@ struct FunctionParameter {
     std::string name;
 };
 
+// `T` or `T: Concept` in `template <...> function ...`
+struct TemplateParameter {
+    std::string name;
+    std::string constraint;
+};
+
 // Base AST Node class
 class ASTNode {
 public:
@@ -52,6 +58,13 @@ public:
     void addFunction(std::unique_ptr<ASTNode> func) {
         functions_.push_back(std::move(func));
     }
+
+    // Swaps in a re-parsed function and hands back the old one, leaving the other
+    // function nodes (and analysis results keyed by them) untouched.
+    std::unique_ptr<ASTNode> replaceFunction(std::size_t index, std::unique_ptr<ASTNode> func) {
+        std::swap(functions_.at(index), func);
+        return func;
+    }
     
     void print(int indent = 0) const override;
 
@@ -67,12 +80,14 @@ public:
     FunctionNode(std::string returnType,
                  std::string name,
                  std::vector<FunctionParameter> parameters,
-                 std::unique_ptr<ASTNode> body)
+                 std::unique_ptr<ASTNode> body,
+                 std::vector<TemplateParameter> templateParameters = {})
         : ASTNode(ASTNodeType::Function),
           return_type_(std::move(returnType)),
           name_(std::move(name)),
           parameters_(std::move(parameters)),
-          body_(std::move(body)) {}
+          body_(std::move(body)),
+          template_parameters_(std::move(templateParameters)) {}
     
     void print(int indent = 0) const override;
 
@@ -80,12 +95,15 @@ public:
     const std::string& getName() const { return name_; }
     const std::vector<FunctionParameter>& getParameters() const { return parameters_; }
     const ASTNode* getBody() const { return body_.get(); }
+    const std::vector<TemplateParameter>& getTemplateParameters() const { return template_parameters_; }
+    bool isTemplate() const { return !template_parameters_.empty(); }
     
 private:
     std::string return_type_;
     std::string name_;
     std::vector<FunctionParameter> parameters_;
     std::unique_ptr<ASTNode> body_;
+    std::vector<TemplateParameter> template_parameters_;
 };
 
 // Variable declaration node
@@ -93,22 +111,27 @@ class VariableDeclarationNode : public ASTNode {
 public:
     VariableDeclarationNode(std::string type,
                             std::string name,
-                            std::unique_ptr<ASTNode> initializer) 
+                            std::unique_ptr<ASTNode> initializer,
+                            bool constant = false) 
         : ASTNode(ASTNodeType::VariableDeclaration),
           type_(std::move(type)),
           name_(std::move(name)),
-          initializer_(std::move(initializer)) {}
+          initializer_(std::move(initializer)),
+          constant_(constant) {}
     
     void print(int indent = 0) const override;
 
     const std::string& getTypeName() const { return type_; }
     const std::string& getName() const { return name_; }
     const ASTNode* getInitializer() const { return initializer_.get(); }
+    // Declared with `const` or `final`
+    bool isConstant() const { return constant_; }
     
 private:
     std::string type_;
     std::string name_;
     std::unique_ptr<ASTNode> initializer_;
+    bool constant_;
 };
 
 // Assignment node
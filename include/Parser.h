@@ -17,7 +17,8 @@ public:
     [[nodiscard]] bool hadError() const noexcept { return hadError_; }
     
 private:
-    std::unique_ptr<FunctionNode> parseFunction();
+    std::unique_ptr<FunctionNode> parseFunction(std::vector<TemplateParameter> templateParameters = {});
+    std::vector<TemplateParameter> parseTemplateHeader();
     std::unique_ptr<BlockNode> parseBlock();
     std::unique_ptr<ASTNode> parseStatement();
     std::unique_ptr<ASTNode> parseReturn();
@@ -38,6 +39,7 @@ private:
     std::unique_ptr<ASTNode> finishCall(std::unique_ptr<ASTNode> callee);
     std::unique_ptr<ASTNode> parsePrimary();
     std::vector<FunctionParameter> parseParameterList();
+    std::string parseTypeName();
     bool isTypeKeyword(const std::string& token) const;
     const istudio::Token* peekToken(size_t offset = 0) const;
     const istudio::Token* getCurrentToken() const;
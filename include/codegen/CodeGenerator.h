@@ -1,8 +1,15 @@
 #pragma once
 
 #include "../include/AST.h"
+#include "semantic/ConstantValue.h"
+#include "semantic/OwnershipAnalysis.h"
+#include "semantic/TemplateInstances.h"
+#include "semantic/TypeAnnotations.h"
+#include <cctype>
 #include <string>
+#include <string_view>
 #include <memory>
+#include <optional>
 #include <sstream>
 #include <vector>
 
@@ -74,7 +81,129 @@ public:
     // Get the target language of this generator
     TargetLanguage getTargetLanguage() const { return targetLanguage_; }
 
+    // Attach the types resolved by semantic analysis; without them, generators only
+    // see the type names written in the source.
+    void setTypeAnnotations(const semantic::TypeAnnotations* annotations) { annotations_ = annotations; }
+
+    // Attach the ownership facts of semantic analysis (last uses of owned values).
+    void setOwnershipFacts(const semantic::OwnershipFacts* ownership) { ownership_ = ownership; }
+
+    // Attach the constants folded by semantic analysis; folded operators and pure
+    // calls are emitted as their literal value.
+    void setConstants(const semantic::ConstantTable* constants) { constants_ = constants; }
+
+    // Attach the template instantiations found by semantic analysis. Typed targets
+    // emit one monomorphized copy of a template function per instantiation.
+    void setTemplateInstances(const semantic::TemplateInstances* templates) { templates_ = templates; }
+
 protected:
+    // IPL type name of a declaration, including the inferred type of `let x = ...`
+    std::string declaredTypeName(const VariableDeclarationNode& varDecl) const {
+        if (varDecl.getTypeName().empty() && annotations_) {
+            if (const auto type = annotations_->typeOf(varDecl)) {
+                return instantiatedTypeName(type->name());
+            }
+        }
+        return instantiatedTypeName(varDecl.getTypeName());
+    }
+
+    // One copy of a template function per instantiation, each generated by
+    // generateFunction while instance_ is set. Templates nobody calls emit nothing.
+    std::vector<std::string> generateInstances(const FunctionNode& function) {
+        std::vector<std::string> copies;
+        if (templates_) {
+            for (const auto* instance : templates_->instancesOf(function.getName())) {
+                instance_ = instance;
+                instanceOf_ = &function;
+                copies.push_back(generateFunction(function));
+            }
+        }
+        instance_ = nullptr;
+        instanceOf_ = nullptr;
+        return copies;
+    }
+
+    // Name to emit for a function: the mangled instance name inside a monomorphized copy.
+    std::string functionName(const FunctionNode& function) const {
+        return instance_ ? instance_->mangledName : function.getName();
+    }
+
+    // Instance a call of a template resolved to; nullptr for ordinary calls.
+    const semantic::TemplateInstance* calledInstance(const CallExpressionNode& call) const {
+        return templates_ ? templates_->find(call) : nullptr;
+    }
+
+    // `spelling` with the template parameters of the instance being emitted replaced by
+    // its arguments (`ref T` -> `ref int`); unchanged outside monomorphized copies.
+    std::string instantiatedTypeName(std::string_view spelling) const {
+        if (!instance_) {
+            return std::string(spelling);
+        }
+        const auto& parameters = instanceOf_->getTemplateParameters();
+        std::string result;
+        std::size_t i = 0;
+        while (i < spelling.size()) {
+            if (!std::isalnum(static_cast<unsigned char>(spelling[i])) && spelling[i] != '_') {
+                result += spelling[i++];
+                continue;
+            }
+            std::size_t end = i;
+            while (end < spelling.size() && (std::isalnum(static_cast<unsigned char>(spelling[end])) || spelling[end] == '_')) {
+                ++end;
+            }
+            const std::string_view word = spelling.substr(i, end - i);
+            std::string replacement(word);
+            for (std::size_t p = 0; p < parameters.size() && p < instance_->arguments.size(); ++p) {
+                if (parameters[p].name == word) {
+                    replacement = instance_->arguments[p]->name();
+                }
+            }
+            result += replacement;
+            i = end;
+        }
+        return result;
+    }
+
+    const semantic::TypeAnnotations* annotations_{nullptr};
+    // Literal spelling of a folded operator or call; nullopt for anything else.
+    std::optional<std::string> foldedLiteral(const ASTNode& node) const {
+        if (!constants_ || (node.getType() != ASTNodeType::BinaryOperation &&
+                            node.getType() != ASTNodeType::UnaryOperation &&
+                            node.getType() != ASTNodeType::CallExpression)) {
+            return std::nullopt;
+        }
+        if (const auto* value = constants_->find(node)) {
+            return semantic::toLiteral(*value);
+        }
+        return std::nullopt;
+    }
+
+    // For an `if` whose condition folded to a constant, the only branch that can run
+    // (nullptr for a false condition without `otherwise`); nullopt when the condition
+    // is not constant. Generators emit that branch alone instead of the whole `if`.
+    std::optional<const ASTNode*> prunedBranch(const IfNode& ifNode) const {
+        const ASTNode* condition = ifNode.getCondition();
+        if (!condition) {
+            return std::nullopt;
+        }
+        std::optional<semantic::ConstantValue> value;
+        if (condition->getType() == ASTNodeType::Literal) {
+            value = semantic::parseLiteral(static_cast<const LiteralNode*>(condition)->getValue());
+        } else if (const auto* folded = constants_ ? constants_->find(*condition) : nullptr) {
+            value = *folded;
+        }
+        const bool* taken = value ? std::get_if<bool>(&*value) : nullptr;
+        if (!taken) {
+            return std::nullopt;
+        }
+        return *taken ? ifNode.getThenBranch() : ifNode.getElseBranch();
+    }
+
+    const semantic::OwnershipFacts* ownership_{nullptr};
+    const semantic::ConstantTable* constants_{nullptr};
+    const semantic::TemplateInstances* templates_{nullptr};
+    const semantic::TemplateInstance* instance_{nullptr}; // monomorphized copy being emitted
+    const FunctionNode* instanceOf_{nullptr};
     TargetLanguage targetLanguage_;
     std::ostringstream output_;
 };
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace istudio::ir {
+
+// Bump allocator owning the IR objects of one function. Objects are never freed
+// individually: an erased instruction stays allocated (unlinked) until the arena goes
+// away, at which point every object is destroyed in reverse order of creation.
+class Arena {
+public:
+    Arena() = default;
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+    ~Arena();
+
+    template <typename T, typename... Args>
+    T* create(Args&&... args)
+    {
+        T* object = new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            destructors_.push_back({object, [](void* p) { static_cast<T*>(p)->~T(); }});
+        }
+        return object;
+    }
+
+    void* allocate(std::size_t size, std::size_t alignment);
+
+    // Bytes handed out so far, padding included.
+    [[nodiscard]] std::size_t bytesUsed() const noexcept { return used_; }
+
+private:
+    struct Destructor {
+        void* object;
+        void (*destroy)(void*);
+    };
+
+    static constexpr std::size_t kChunkSize = 16 * 1024;
+
+    std::vector<std::unique_ptr<std::byte[]>> chunks_;
+    std::byte* cursor_{nullptr};
+    std::byte* end_{nullptr};
+    std::size_t used_{0};
+    std::vector<Destructor> destructors_;
+};
+
+} // namespace istudio::ir
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "ir/IR.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace istudio::ir {
+
+// Binary form of a module, for caching optimized IR between builds and linking
+// modules without going back to their source:
+//
+//   magic "IPLB", version           varint
+//   string table                    count, then length + bytes per string
+//   module name                     string index
+//   function table                  count, then name, offset, size per function
+//   function bodies                 each self-contained, at its table offset
+//
+// Integers are LEB128 varints (signed ones zigzag-encoded), floats 8 little-endian
+// bytes, and every name, label, callee and string constant is an index into the
+// string table. Inside a body, instructions refer to values by a dense number:
+// arguments, then the function's constants, then instructions in program order.
+std::vector<std::uint8_t> writeBitcode(const IRModule& module);
+
+// Whether `bytes` start like a bitcode file.
+bool isBitcode(std::span<const std::uint8_t> bytes);
+
+// Reads bitcode written by writeBitcode. Opening a file only decodes the string
+// and function tables; a function body is decoded when it is read, so callers can
+// load just the functions they need. Read functions allocate all their values,
+// block labels included, in their own arena and do not refer back to the reader.
+class BitcodeReader {
+public:
+    static std::expected<BitcodeReader, std::string> open(std::vector<std::uint8_t> bytes);
+    static std::expected<BitcodeReader, std::string> openFile(const std::filesystem::path& path);
+
+    [[nodiscard]] const std::string& moduleName() const { return strings_[moduleName_]; }
+    [[nodiscard]] std::size_t functionCount() const { return functions_.size(); }
+    [[nodiscard]] const std::string& functionName(std::size_t index) const
+    {
+        return strings_[functions_[index].name];
+    }
+    [[nodiscard]] std::optional<std::size_t> findFunction(std::string_view name) const;
+
+    std::expected<std::unique_ptr<IRFunction>, std::string> readFunction(std::size_t index) const;
+
+    // Adds every function to `module`, which must not define any of them yet: this
+    // is how separately compiled modules are linked.
+    std::expected<void, std::string> readInto(IRModule& module) const;
+    std::expected<std::unique_ptr<IRModule>, std::string> readModule() const;
+
+private:
+    struct FunctionEntry {
+        std::size_t name{0};
+        std::size_t offset{0};
+        std::size_t size{0};
+    };
+
+    BitcodeReader() = default;
+
+    std::vector<std::uint8_t> bytes_;
+    std::vector<std::string> strings_;
+    std::size_t moduleName_{0};
+    std::vector<FunctionEntry> functions_;
+    std::size_t bodies_{0}; // offset of the first body
+};
+
+} // namespace istudio::ir
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "ir/IR.h"
+
+#include <unordered_map>
+#include <vector>
+
+namespace istudio::ir {
+
+// Original values and blocks mapped to their copies.
+struct CloneMap {
+    std::unordered_map<const IRValue*, IRValue*> values;
+    std::unordered_map<const IRBasicBlock*, IRBasicBlock*> blocks;
+
+    // The copy, or `value` itself when it was not copied.
+    [[nodiscard]] IRValue* lookup(IRValue* value) const
+    {
+        const auto it = values.find(value);
+        return it != values.end() ? it->second : value;
+    }
+    [[nodiscard]] IRBasicBlock* lookup(IRBasicBlock* block) const
+    {
+        const auto it = blocks.find(block);
+        return it != blocks.end() ? it->second : block;
+    }
+};
+
+// Copies `blocks`, of this or another function, into `function` in front of `before`
+// (appended when nullptr), in the given order. Operands and branch targets within
+// the copied region refer to the copies; anything else keeps referring to the
+// original, except constants, which are taken from `function`. Values already in
+// `map` (such as arguments bound to call operands) are substituted as given.
+// Predecessor lists of the copies only hold edges from within the region: edges
+// entering or leaving it are the caller's to connect.
+void cloneBlocks(const std::vector<const IRBasicBlock*>& blocks, IRFunction& function, IRBasicBlock* before,
+                 CloneMap& map);
+
+} // namespace istudio::ir
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "ir/PassManager.h"
+
+namespace istudio::ir {
+
+// Whether removing `inst` when its result is unused changes behaviour. Calls may have
+// side effects; stores and terminators always matter.
+bool hasSideEffects(const IRInstruction& inst);
+
+// Deletes instructions whose results are never used, following operands that become
+// dead in turn. Keeps the CFG unchanged.
+class DeadCodeElimination : public FunctionPass {
+public:
+    [[nodiscard]] std::string_view name() const override { return "dce"; }
+    PreservedAnalyses run(IRFunction& function, FunctionAnalyses& analyses) const override;
+};
+
+// Assumes every instruction dead until an instruction with side effects needs it.
+// Unlike dce, which starts from the unused instructions, this also removes cycles of
+// instructions that only feed each other, such as the Phi and increment of a loop
+// counter nothing reads. Branches are kept, so the CFG is unchanged.
+class AggressiveDeadCodeElimination : public FunctionPass {
+public:
+    [[nodiscard]] std::string_view name() const override { return "adce"; }
+    PreservedAnalyses run(IRFunction& function, FunctionAnalyses& analyses) const override;
+};
+
+} // namespace istudio::ir
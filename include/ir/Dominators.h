@@ -0,0 +1,57 @@
+#pragma once
+
+#include "ir/IR.h"
+#include "ir/PassManager.h"
+
+#include <unordered_map>
+#include <vector>
+
+namespace istudio::ir {
+
+// Dominator tree of a function's CFG, built with the iterative algorithm of Cooper,
+// Harvey and Kennedy ("A Simple, Fast Dominance Algorithm", 2001). Blocks not
+// reachable from the entry are not in the tree.
+class DominatorTree {
+public:
+    [[nodiscard]] IRBasicBlock* getRoot() const { return root_; }
+    [[nodiscard]] bool isReachable(const IRBasicBlock* block) const { return nodes_.contains(block); }
+
+    // nullptr for the entry block and unreachable blocks.
+    [[nodiscard]] IRBasicBlock* getIdom(const IRBasicBlock* block) const;
+    [[nodiscard]] const std::vector<IRBasicBlock*>& getChildren(const IRBasicBlock* block) const;
+
+    // Every block dominates itself. O(1): compares DFS intervals of the tree.
+    [[nodiscard]] bool dominates(const IRBasicBlock* a, const IRBasicBlock* b) const;
+    [[nodiscard]] bool properlyDominates(const IRBasicBlock* a, const IRBasicBlock* b) const
+    {
+        return a != b && dominates(a, b);
+    }
+    // Whether the value `def` is available at `user`. A Phi uses its operands at the
+    // end of the incoming blocks, which callers account for themselves.
+    [[nodiscard]] bool dominates(const IRInstruction* def, const IRInstruction* user) const;
+
+    // Reachable blocks in reverse post-order of the CFG.
+    [[nodiscard]] const std::vector<IRBasicBlock*>& reversePostOrder() const { return order_; }
+
+private:
+    friend struct DominatorTreeAnalysis;
+
+    struct Node {
+        IRBasicBlock* idom{nullptr};
+        std::vector<IRBasicBlock*> children;
+        unsigned in{0};
+        unsigned out{0};
+    };
+
+    IRBasicBlock* root_{nullptr};
+    std::unordered_map<const IRBasicBlock*, Node> nodes_;
+    std::vector<IRBasicBlock*> order_;
+};
+
+struct DominatorTreeAnalysis {
+    static constexpr AnalysisKind kind = AnalysisKind::Dominators;
+    using Result = DominatorTree;
+    static DominatorTree run(const IRFunction& function, FunctionAnalyses& analyses);
+};
+
+} // namespace istudio::ir
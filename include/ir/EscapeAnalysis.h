@@ -0,0 +1,67 @@
+#pragma once
+
+#include "ir/IR.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <unordered_map>
+#include <vector>
+
+namespace istudio::ir {
+
+// How far a string, collection or owned object can be reached from, ordered from
+// best to worst for a backend:
+//   Local    - only from the function that holds it; it can live in that frame
+//              (stack storage in C/C++, a value type, no boxing in Java) and die
+//              with it.
+//   Returned - also from the caller, but only through the return value; it can be
+//              built in storage the caller provides.
+//   Escaped  - anywhere: an unknown function kept it, or it was stored into
+//              something that escaped; it needs the heap.
+enum class EscapeState : std::uint8_t {
+    Local,
+    Returned,
+    Escaped
+};
+
+const char* toString(EscapeState state);
+
+// Escape facts of a module. Only values of heap type (String and Opaque) are
+// tracked; everything else is Local.
+class EscapeInfo {
+public:
+    [[nodiscard]] EscapeState stateOf(const IRValue& value) const;
+
+    // Instructions that create a new object: string concatenation, calls of
+    // runtime allocators such as listCreate, and calls of module functions whose
+    // result is not one of their arguments. In program order.
+    [[nodiscard]] const std::vector<const IRInstruction*>& allocations(const IRFunction& function) const;
+
+    // What a function may do with the object passed as its `index`th argument:
+    // Returned when it may hand it back, Escaped when it may keep it.
+    [[nodiscard]] EscapeState parameterState(const IRFunction& function, std::size_t index) const;
+
+private:
+    friend EscapeInfo analyzeEscapes(const IRModule& module);
+
+    std::unordered_map<const IRValue*, EscapeState> states_;
+    std::unordered_map<const IRFunction*, std::vector<const IRInstruction*>> allocations_;
+    std::unordered_map<const IRFunction*, std::vector<EscapeState>> parameters_;
+};
+
+// Flow-insensitive, interprocedural escape analysis. Within a function, values that
+// may refer to the same object are merged into one class (Phis with their operands,
+// a container's elements with everything stored into or loaded from it), and a
+// class is as bad as the worst thing done to any member; elements escape with their
+// container. Across functions, each function is summarised by what it does with
+// its parameters, and the summaries are iterated to a fixed point starting from
+// "nothing escapes", so recursion is handled. Calls of functions neither in the
+// module nor known to the runtime are assumed to keep every argument.
+EscapeInfo analyzeEscapes(const IRModule& module);
+
+// The `--emit-escapes` output: the IR with the state of every allocation noted
+// next to it.
+void printEscapeReport(const IRModule& module, const EscapeInfo& info, std::ostream& out);
+
+} // namespace istudio::ir
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "ir/PassManager.h"
+
+namespace istudio::ir {
+
+// Dominator-based value numbering. The dominator tree is walked in preorder with a
+// scoped table of the expressions computed so far; an instruction computing an
+// expression already available from a dominating block (same opcode, type and
+// operands, commutative operands in canonical order) is replaced by the earlier
+// value. Covers the arithmetic, comparison and logical opcodes, Phis with identical
+// incoming values, and Loads, which are only reused while no Store or Call can have
+// run in between.
+class GlobalValueNumbering : public FunctionPass {
+public:
+    [[nodiscard]] std::string_view name() const override { return "gvn"; }
+    PreservedAnalyses run(IRFunction& function, FunctionAnalyses& analyses) const override;
+};
+
+} // namespace istudio::ir
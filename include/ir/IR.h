@@ -1,29 +1,156 @@
 #pragma once
 
+#include "ir/Arena.h"
+#include "ir/IntrusiveList.h"
+
+#include <cstdint>
+#include <map>
 #include <memory>
 #include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
 #include <vector>
-#include <unordered_map>
 
 namespace istudio::ir {
 
 // Forward declarations
 class IRValue;
+class IRUse;
 class IRInstruction;
 class IRBasicBlock;
 class IRFunction;
 class IRModule;
 
-// Base value class
+// Machine-level value types. IPL types without a direct representation (strings,
+// collections, template parameters) are Opaque references.
+enum class IRType {
+    Void,
+    Bool,
+    Int,
+    Float,
+    String,
+    Opaque
+};
+
+const char* toString(IRType type);
+
+// Maps an IPL type name (`int`, `number`, `list<int>`, ...) to its IR type.
+IRType irTypeOf(std::string_view iplType);
+
+enum class IRValueKind {
+    Constant,
+    Argument,
+    Instruction,
+    BasicBlock,
+    Function
+};
+
+// One operand slot of an instruction. Every use of a value is linked into that
+// value's use list, so walking the users of a value or replacing it costs O(uses).
+class IRUse {
+public:
+    IRUse(IRInstruction* user, unsigned index) : user_(user), index_(index) {}
+
+    IRValue* get() const { return value_; }
+    IRInstruction* getUser() const { return user_; }
+    unsigned getOperandNo() const { return index_; }
+    IRUse* getNextUse() const { return nextUse_; }
+
+    // Moves this use from the current value's use list to `value`'s.
+    void set(IRValue* value);
+
+private:
+    friend class IRInstruction;
+
+    IRValue* value_{nullptr};
+    IRInstruction* user_;
+    unsigned index_;
+    IRUse* prevUse_{nullptr};
+    IRUse* nextUse_{nullptr};
+};
+
+// Base value class. Values carry no names: each has a small integer id, unique
+// within its function, that passes can use to index dense side tables. The printer
+// makes up readable names.
 class IRValue {
 public:
-    explicit IRValue(std::string name) : name_(std::move(name)) {}
+    IRValue(IRValueKind kind, IRType type, unsigned id) : kind_(kind), type_(type), id_(id) {}
+    IRValue(const IRValue&) = delete;
+    IRValue& operator=(const IRValue&) = delete;
     virtual ~IRValue() = default;
-    
+
+    IRValueKind getKind() const { return kind_; }
+    IRType getType() const { return type_; }
+    unsigned getId() const { return id_; }
+
+    class use_iterator {
+    public:
+        explicit use_iterator(IRUse* use = nullptr) : use_(use) {}
+        IRUse& operator*() const { return *use_; }
+        IRUse* operator->() const { return use_; }
+        use_iterator& operator++()
+        {
+            use_ = use_->getNextUse();
+            return *this;
+        }
+        bool operator==(const use_iterator& other) const { return use_ == other.use_; }
+
+    private:
+        IRUse* use_;
+    };
+
+    struct UseRange {
+        IRUse* first;
+        use_iterator begin() const { return use_iterator(first); }
+        use_iterator end() const { return use_iterator(); }
+    };
+
+    // Uses in no particular order; a user appears once per operand slot.
+    UseRange uses() const { return {firstUse_}; }
+    bool hasUses() const { return firstUse_ != nullptr; }
+    std::size_t getNumUses() const;
+
+    // Makes every use of this value use `replacement` instead.
+    void replaceAllUsesWith(IRValue* replacement);
+
+private:
+    friend class IRUse;
+
+    IRValueKind kind_;
+    IRType type_;
+    unsigned id_;
+    IRUse* firstUse_{nullptr};
+};
+
+// Compile-time constant; monostate stands for `undef` (a read of a variable that was
+// never written on some path) and `null`.
+using IRConstantValue = std::variant<std::monostate, bool, std::int64_t, double, std::string>;
+
+class IRConstant : public IRValue {
+public:
+    IRConstant(IRType type, IRConstantValue value, unsigned id)
+        : IRValue(IRValueKind::Constant, type, id), value_(std::move(value)) {}
+
+    const IRConstantValue& getValue() const { return value_; }
+    bool isUndef() const { return std::holds_alternative<std::monostate>(value_); }
+
+private:
+    IRConstantValue value_;
+};
+
+// Arguments keep their source parameter name; it is part of the function's signature.
+class IRArgument : public IRValue {
+public:
+    IRArgument(std::string name, IRType type, std::size_t index, unsigned id)
+        : IRValue(IRValueKind::Argument, type, id), name_(std::move(name)), index_(index) {}
+
     const std::string& getName() const { return name_; }
-    
-protected:
+    std::size_t getIndex() const { return index_; }
+
+private:
     std::string name_;
+    std::size_t index_;
 };
 
 // Instruction opcodes
@@ -44,6 +171,8 @@ enum class IRInstructionOp {
     Le,
     Gt,
     Ge,
+    Neg,
+    Not,
     Assign,
     Call,
     Return,
@@ -56,53 +185,200 @@ enum class IRInstructionOp {
     GetElementPtr
 };
 
-// Base instruction class
-class IRInstruction : public IRValue {
+const char* toString(IRInstructionOp op);
+
+// Base instruction class. Operands are the values read; block operands of branches
+// are kept separately as targets.
+//   Return      [value]
+//   Branch      targets {dest}
+//   BranchIf    [cond], targets {then, else}
+//   Phi         [v0, v1, ...], incoming blocks {b0, b1, ...}
+//   Call        [args...], callee name
+// Instructions are created by IRFunction::createInstruction and live in its arena.
+class IRInstruction : public IRValue, public IntrusiveListNode<IRInstruction> {
 public:
-    explicit IRInstruction(std::string name, IRInstructionOp op)
-        : IRValue(std::move(name)), op_(op) {}
-    virtual ~IRInstruction() = default;
-    
+    IRInstruction(IRFunction* function, IRInstructionOp op, IRType type, unsigned id)
+        : IRValue(IRValueKind::Instruction, type, id), op_(op), function_(function) {}
+
     IRInstructionOp getOp() const { return op_; }
-    
+
+    std::size_t getNumOperands() const { return operands_.size(); }
+    IRValue* getOperand(std::size_t index) const { return operands_[index]->get(); }
+    IRUse& getOperandUse(std::size_t index) const { return *operands_[index]; }
+    void addOperand(IRValue* value);
+    void setOperand(std::size_t index, IRValue* value) { operands_[index]->set(value); }
+    void removeOperand(std::size_t index);
+    // Unlinks every operand from its value's use list.
+    void dropAllReferences();
+
+    // Branch targets, or the incoming blocks of a Phi (parallel to its operands).
+    const std::vector<IRBasicBlock*>& getBlocks() const { return blocks_; }
+    void addBlock(IRBasicBlock* block) { blocks_.push_back(block); }
+    void setBlock(std::size_t index, IRBasicBlock* block) { blocks_[index] = block; }
+    void removeBlock(std::size_t index) { blocks_.erase(blocks_.begin() + static_cast<std::ptrdiff_t>(index)); }
+
+    const std::string& getCallee() const { return callee_; }
+    void setCallee(std::string callee) { callee_ = std::move(callee); }
+
+    // A call in tail position: the next instruction returns its result, so nothing
+    // in the caller's frame is needed afterwards and a backend may jump to the
+    // callee instead of calling it.
+    bool isTailCall() const { return tailCall_; }
+    void setTailCall(bool tailCall) { tailCall_ = tailCall; }
+
+    IRBasicBlock* getParent() const { return parent_; }
+    IRFunction* getFunction() const { return function_; }
+
+    // Unlinks the instruction from its block and drops its operands. It must have no
+    // uses left; its memory is reclaimed with the function.
+    void eraseFromParent();
+
+    bool isTerminator() const
+    {
+        return op_ == IRInstructionOp::Return || op_ == IRInstructionOp::Branch || op_ == IRInstructionOp::BranchIf;
+    }
+
 private:
+    friend class IRBasicBlock;
+
     IRInstructionOp op_;
+    std::vector<IRUse*> operands_;
+    std::vector<IRBasicBlock*> blocks_;
+    std::string callee_;
+    bool tailCall_{false};
+    IRFunction* function_;
+    IRBasicBlock* parent_{nullptr};
 };
 
-// Basic block class
-class IRBasicBlock : public IRValue {
+// Basic block class. The label is a static hint (`entry`, `while.cond`, ...) the
+// printer combines with the block's position.
+class IRBasicBlock : public IRValue, public IntrusiveListNode<IRBasicBlock> {
 public:
-    explicit IRBasicBlock(std::string name)
-        : IRValue(std::move(name)) {}
-    
-    void addInstruction(std::unique_ptr<IRInstruction> inst) {
-        instructions_.push_back(std::move(inst));
+    using InstructionList = IntrusiveList<IRInstruction>;
+
+    IRBasicBlock(IRFunction* function, std::string_view label, unsigned id)
+        : IRValue(IRValueKind::BasicBlock, IRType::Void, id), label_(label), function_(function) {}
+
+    std::string_view getLabel() const { return label_; }
+    IRFunction* getParent() const { return function_; }
+
+    // Appends `inst`, which must not be in a block yet.
+    IRInstruction* append(IRInstruction* inst) { return insertBefore(nullptr, inst); }
+    // Inserts `inst` in front of `before`; appends when `before` is nullptr.
+    IRInstruction* insertBefore(IRInstruction* before, IRInstruction* inst)
+    {
+        inst->parent_ = this;
+        instructions_.insert(before, inst);
+        return inst;
+    }
+    // Phis are kept at the top of the block.
+    IRInstruction* addPhi(IRInstruction* phi) { return insertBefore(getFirstNonPhi(), phi); }
+    // Unlinks `inst` without touching its operands.
+    void remove(IRInstruction* inst)
+    {
+        instructions_.remove(inst);
+        inst->parent_ = nullptr;
+    }
+
+    const InstructionList& getInstructions() const { return instructions_; }
+    InstructionList::iterator begin() const { return instructions_.begin(); }
+    InstructionList::iterator end() const { return instructions_.end(); }
+    bool empty() const { return instructions_.empty(); }
+
+    IRInstruction* getFirstNonPhi() const
+    {
+        IRInstruction* inst = instructions_.front();
+        while (inst && inst->getOp() == IRInstructionOp::Phi) {
+            inst = inst->getNextNode();
+        }
+        return inst;
     }
-    
-    const std::vector<std::unique_ptr<IRInstruction>>& getInstructions() const {
-        return instructions_;
+
+    // nullptr while the block is still open
+    IRInstruction* getTerminator() const
+    {
+        IRInstruction* last = instructions_.back();
+        return last && last->isTerminator() ? last : nullptr;
+    }
+
+    const std::vector<IRBasicBlock*>& getPredecessors() const { return predecessors_; }
+    void addPredecessor(IRBasicBlock* block) { predecessors_.push_back(block); }
+    void removePredecessor(IRBasicBlock* block) { std::erase(predecessors_, block); }
+    // Drops one edge from `pred`: its predecessor entry and the matching Phi operands.
+    void removeIncomingEdge(IRBasicBlock* pred);
+    // Edges from `from` now come from `to`, in the predecessor list and in Phis.
+    void replacePredecessor(IRBasicBlock* from, IRBasicBlock* to);
+    std::vector<IRBasicBlock*> getSuccessors() const
+    {
+        const auto* terminator = getTerminator();
+        return terminator ? terminator->getBlocks() : std::vector<IRBasicBlock*>{};
     }
-    
+
 private:
-    std::vector<std::unique_ptr<IRInstruction>> instructions_;
+    std::string_view label_;
+    IRFunction* function_;
+    InstructionList instructions_;
+    std::vector<IRBasicBlock*> predecessors_;
 };
 
-// Function class
+// Function class. Owns the arena every value of the function is allocated from.
 class IRFunction : public IRValue {
 public:
-    explicit IRFunction(std::string name)
-        : IRValue(std::move(name)) {}
-    
-    void addBasicBlock(std::unique_ptr<IRBasicBlock> block) {
-        basicBlocks_.push_back(std::move(block));
+    using BlockList = IntrusiveList<IRBasicBlock>;
+
+    IRFunction(std::string name, IRType returnType)
+        : IRValue(IRValueKind::Function, returnType, 0), name_(std::move(name)) {}
+
+    const std::string& getName() const { return name_; }
+
+    // `label` must outlive the function; string literals are the intended use.
+    IRBasicBlock* createBlock(std::string_view label)
+    {
+        return arena_.create<IRBasicBlock>(this, label, nextId_++);
     }
-    
-    const std::vector<std::unique_ptr<IRBasicBlock>>& getBasicBlocks() const {
-        return basicBlocks_;
+    // Links a block created by createBlock into the function; appends when `before`
+    // is nullptr.
+    IRBasicBlock* insertBlock(IRBasicBlock* block, IRBasicBlock* before = nullptr)
+    {
+        blocks_.insert(before, block);
+        return block;
+    }
+    void removeBlock(IRBasicBlock* block) { blocks_.remove(block); }
+
+    const BlockList& getBasicBlocks() const { return blocks_; }
+    IRBasicBlock* getEntryBlock() const { return blocks_.front(); }
+
+    // A new instruction, not yet in any block.
+    IRInstruction* createInstruction(IRInstructionOp op, IRType type = IRType::Void)
+    {
+        return arena_.create<IRInstruction>(this, op, type, nextId_++);
+    }
+
+    IRArgument* addArgument(std::string name, IRType type)
+    {
+        arguments_.push_back(arena_.create<IRArgument>(std::move(name), type, arguments_.size(), nextId_++));
+        return arguments_.back();
     }
-    
+    const std::vector<IRArgument*>& getArguments() const { return arguments_; }
+
+    // Constants are uniqued per function: equal constants are the same value.
+    IRConstant* getConstant(IRType type, IRConstantValue value);
+    IRConstant* getUndef(IRType type) { return getConstant(type, std::monostate{}); }
+
+    // Upper bound on value ids, for sizing dense side tables.
+    unsigned getValueCount() const { return nextId_; }
+
+    Arena& getArena() { return arena_; }
+    std::size_t getArenaBytes() const { return arena_.bytesUsed(); }
+
 private:
-    std::vector<std::unique_ptr<IRBasicBlock>> basicBlocks_;
+    std::string name_;
+    // Declared before the lists so it is destroyed after them.
+    Arena arena_;
+    BlockList blocks_;
+    std::vector<IRArgument*> arguments_;
+    std::map<std::pair<IRType, IRConstantValue>, IRConstant*> constants_;
+    unsigned nextId_{0};
 };
 
 // Module class
@@ -110,20 +386,20 @@ class IRModule {
 public:
     explicit IRModule(std::string name)
         : name_(std::move(name)) {}
-    
+
     void addFunction(std::unique_ptr<IRFunction> func) {
         functions_.push_back(std::move(func));
     }
-    
+
     const std::vector<std::unique_ptr<IRFunction>>& getFunctions() const {
         return functions_;
     }
-    
+
     const std::string& getName() const { return name_; }
-    
+
 private:
     std::string name_;
     std::vector<std::unique_ptr<IRFunction>> functions_;
 };
 
-} // namespace istudio::ir
\ No newline at end of file
+} // namespace istudio::ir
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "ir/IR.h"
+
+#include <expected>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace istudio::ir {
+
+// Reads the textual IR printModule writes, so a pass can be run on a hand-written
+// or saved `.ir` file without going through the front end. Printing a parsed
+// module gives back the text it was parsed from. Beyond what the printer emits:
+//   - instruction results may have any name (`%sum = add int %a, %b`), and a
+//     block at position n may be named without the n the printer appends;
+//   - `; preds = ...` comments are optional: predecessors come from the branches,
+//     the comment only fixes their order and must agree with them;
+//   - an untyped `undef` operand takes the instruction's type.
+// Errors name the line: "line 7: unknown value %x". The result is not verified.
+std::expected<std::unique_ptr<IRModule>, std::string> parseModule(std::string_view text);
+
+// Adds the functions of `text` to `module`, which must not define any of them yet;
+// the module line of the text is not used.
+std::expected<void, std::string> parseInto(IRModule& module, std::string_view text);
+
+} // namespace istudio::ir
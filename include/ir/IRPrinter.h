@@ -0,0 +1,37 @@
+#pragma once
+
+#include "ir/IR.h"
+
+#include <functional>
+#include <ostream>
+#include <string>
+
+namespace istudio::ir {
+
+// Textual form of the IR, as printed by `--emit-ir`:
+//
+//   function int @add(int %a, int %b) {
+//   entry:
+//     %0 = add int %a, %b
+//     ret int %0
+//   }
+//
+// Values have no stored names: instructions are numbered in program order and blocks
+// are named by their label and position, so the numbering is always dense.
+void printModule(const IRModule& module, std::ostream& out);
+void printFunction(const IRFunction& function, std::ostream& out);
+
+// Text appended to an instruction's line as a `; ...` comment; empty for none.
+// Analyses use it to show their results next to the IR.
+using InstructionAnnotator = std::function<std::string(const IRInstruction&)>;
+
+void printModule(const IRModule& module, std::ostream& out, const InstructionAnnotator& annotate);
+void printFunction(const IRFunction& function, std::ostream& out, const InstructionAnnotator& annotate);
+
+std::string toString(const IRModule& module);
+
+// One instruction as printFunction prints it, without the indentation; values are
+// named as in the listing of the whole function. For diagnostics.
+std::string toString(const IRInstruction& inst);
+
+} // namespace istudio::ir
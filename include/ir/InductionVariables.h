@@ -0,0 +1,42 @@
+#pragma once
+
+#include "ir/IR.h"
+#include "ir/LoopInfo.h"
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace istudio::ir {
+
+// A basic induction variable: a header Phi that starts at `start` on entry and
+// changes by the constant `step` on every iteration,
+//   %iv   = phi int [ start, %preheader ], [ %next, %latch ]
+//   %next = add int %iv, step          (or sub, or add step, %iv)
+struct InductionVariable {
+    IRInstruction* phi{nullptr};
+    IRValue* start{nullptr};
+    IRInstruction* increment{nullptr};
+    std::int64_t step{0};
+};
+
+// Induction variables of a loop with a preheader and a single latch, in header order.
+std::vector<InductionVariable> findInductionVariables(const Loop& loop);
+
+// How the loop decides to run another iteration: it exits from the header, staying
+// while `iv <predicate> bound` holds, with `bound` loop-invariant. Other blocks may
+// leave the loop too. The predicate is normalised so the induction variable is on
+// the left and true means "stay".
+struct LoopExitCondition {
+    InductionVariable iv;
+    IRInstructionOp predicate{IRInstructionOp::Lt};
+    IRValue* bound{nullptr};
+};
+
+std::optional<LoopExitCondition> findExitCondition(const Loop& loop);
+
+// Number of times the body of the loop runs, when the start, step and bound are all
+// constant and the header is the only block leaving the loop.
+std::optional<std::uint64_t> computeTripCount(const Loop& loop);
+
+} // namespace istudio::ir
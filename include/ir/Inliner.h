@@ -0,0 +1,50 @@
+#pragma once
+
+#include "ir/PassManager.h"
+
+#include <cstddef>
+
+namespace istudio::ir {
+
+// Tuning knobs of the inliner. Costs are in instructions of the callee, weighted by
+// what they cost a backend: Phis and unconditional branches usually vanish, calls
+// cost what the call overhead does.
+struct InlineParams {
+    // Inline when the callee costs at most this after subtracting the benefit.
+    int threshold{25};
+    // Cost of a call (argument passing, the call and return, frame setup); saved
+    // by inlining, so it counts as benefit.
+    int callPenalty{10};
+    // Extra benefit per constant argument, which sccp can fold once inlined.
+    int constantArgumentBonus{5};
+    // Extra benefit when this is the only call of the callee in the module.
+    int singleCallSiteBonus{60};
+    // Callers are not grown past this many instructions.
+    std::size_t maxCallerSize{4000};
+};
+
+// Replaces calls of functions defined in the module by a copy of the callee's body.
+// Functions are visited bottom-up in the call graph (callees before callers, by
+// Tarjan's strongly connected components), so a callee is inlined with its own
+// calls already inlined and the cost model sees its final size. Calls within a
+// cycle of the call graph are never inlined, which keeps recursion finite.
+//
+// Inlined callees stay in the module: IPL has no linkage, so a function may still
+// be called from outside the module even when no call to it is left.
+class Inliner : public ModulePass {
+public:
+    Inliner() = default;
+    explicit Inliner(InlineParams params)
+        : params_(params) {}
+
+    [[nodiscard]] std::string_view name() const override { return "inline"; }
+    PreservedAnalyses run(IRModule& module) override;
+
+    [[nodiscard]] std::size_t inlinedCalls() const noexcept { return inlined_; }
+
+private:
+    InlineParams params_;
+    std::size_t inlined_{0};
+};
+
+} // namespace istudio::ir
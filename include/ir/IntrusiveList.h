@@ -0,0 +1,125 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+
+namespace istudio::ir {
+
+template <typename T>
+class IntrusiveList;
+
+// Link fields of an object that can sit in an IntrusiveList<T>. An object is in at
+// most one list at a time.
+template <typename T>
+class IntrusiveListNode {
+public:
+    T* getPrevNode() const { return prev_; }
+    T* getNextNode() const { return next_; }
+    bool isLinked() const { return linked_; }
+
+private:
+    friend class IntrusiveList<T>;
+
+    T* prev_{nullptr};
+    T* next_{nullptr};
+    bool linked_{false};
+};
+
+// Doubly linked list threaded through its elements: insertion and removal are O(1)
+// and never allocate. The list does not own its elements (the function's Arena does).
+//
+// Removing the element an iterator points at invalidates only that iterator, so
+// passes that erase while walking advance first:
+//   for (auto it = block.begin(); it != block.end();) { IRInstruction& inst = *it++; ... }
+template <typename T>
+class IntrusiveList {
+public:
+    class iterator {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+
+        iterator() = default;
+        iterator(const IntrusiveList* list, T* node) : list_(list), node_(node) {}
+
+        T& operator*() const { return *node_; }
+        T* operator->() const { return node_; }
+        iterator& operator++()
+        {
+            node_ = link(node_).next_;
+            return *this;
+        }
+        iterator operator++(int)
+        {
+            iterator copy = *this;
+            ++*this;
+            return copy;
+        }
+        iterator& operator--()
+        {
+            node_ = node_ ? link(node_).prev_ : list_->tail_;
+            return *this;
+        }
+        iterator operator--(int)
+        {
+            iterator copy = *this;
+            --*this;
+            return copy;
+        }
+        bool operator==(const iterator& other) const { return node_ == other.node_; }
+
+    private:
+        const IntrusiveList* list_{nullptr};
+        T* node_{nullptr};
+    };
+
+    IntrusiveList() = default;
+    IntrusiveList(const IntrusiveList&) = delete;
+    IntrusiveList& operator=(const IntrusiveList&) = delete;
+
+    iterator begin() const { return iterator(this, head_); }
+    iterator end() const { return iterator(this, nullptr); }
+
+    T* front() const { return head_; }
+    T* back() const { return tail_; }
+    bool empty() const { return head_ == nullptr; }
+    std::size_t size() const { return size_; }
+
+    void push_back(T* node) { insert(nullptr, node); }
+    void push_front(T* node) { insert(head_, node); }
+
+    // Links `node` in front of `before`; appends when `before` is nullptr.
+    void insert(T* before, T* node)
+    {
+        auto& entry = link(node);
+        entry.next_ = before;
+        entry.prev_ = before ? link(before).prev_ : tail_;
+        (entry.prev_ ? link(entry.prev_).next_ : head_) = node;
+        (before ? link(before).prev_ : tail_) = node;
+        entry.linked_ = true;
+        ++size_;
+    }
+
+    void remove(T* node)
+    {
+        auto& entry = link(node);
+        (entry.prev_ ? link(entry.prev_).next_ : head_) = entry.next_;
+        (entry.next_ ? link(entry.next_).prev_ : tail_) = entry.prev_;
+        entry.prev_ = nullptr;
+        entry.next_ = nullptr;
+        entry.linked_ = false;
+        --size_;
+    }
+
+private:
+    static IntrusiveListNode<T>& link(T* node) { return *static_cast<IntrusiveListNode<T>*>(node); }
+
+    T* head_{nullptr};
+    T* tail_{nullptr};
+    std::size_t size_{0};
+};
+
+} // namespace istudio::ir
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "ir/PassManager.h"
+
+namespace istudio::ir {
+
+// Loop-invariant code motion. Instructions of a loop whose operands are all defined
+// outside it compute the same value on every iteration and are moved to the loop's
+// preheader, innermost loops first so invariants climb out of a whole nest. Only
+// instructions that cannot trap are hoisted, as the preheader also runs when the
+// loop body does not: division needs a non-zero constant divisor, and a Load must
+// execute on every path through the loop in a loop that writes no memory. Loops
+// without a preheader are left alone. The CFG is not changed.
+class LoopInvariantCodeMotion : public FunctionPass {
+public:
+    [[nodiscard]] std::string_view name() const override { return "licm"; }
+    PreservedAnalyses run(IRFunction& function, FunctionAnalyses& analyses) const override;
+};
+
+} // namespace istudio::ir
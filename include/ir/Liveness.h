@@ -0,0 +1,51 @@
+#pragma once
+
+#include "ir/IR.h"
+#include "ir/PassManager.h"
+
+#include <unordered_map>
+#include <vector>
+
+namespace istudio::ir {
+
+// Values (instructions and arguments) live on entry to and exit from each block.
+// A Phi operand counts as used at the end of the incoming block, not at the Phi.
+class Liveness {
+public:
+    [[nodiscard]] bool isLiveIn(const IRBasicBlock& block, const IRValue& value) const
+    {
+        return test(sets_.at(&block).in, value);
+    }
+    [[nodiscard]] bool isLiveOut(const IRBasicBlock& block, const IRValue& value) const
+    {
+        return test(sets_.at(&block).out, value);
+    }
+
+    // Bit sets indexed by IRValue::getId().
+    [[nodiscard]] const std::vector<bool>& liveIn(const IRBasicBlock& block) const { return sets_.at(&block).in; }
+    [[nodiscard]] const std::vector<bool>& liveOut(const IRBasicBlock& block) const { return sets_.at(&block).out; }
+
+private:
+    friend struct LivenessAnalysis;
+
+    struct Sets {
+        std::vector<bool> in;
+        std::vector<bool> out;
+    };
+
+    static bool test(const std::vector<bool>& set, const IRValue& value)
+    {
+        return value.getId() < set.size() && set[value.getId()];
+    }
+
+    std::unordered_map<const IRBasicBlock*, Sets> sets_;
+};
+
+// Backward dataflow over the CFG, iterated to a fixed point.
+struct LivenessAnalysis {
+    static constexpr AnalysisKind kind = AnalysisKind::Liveness;
+    using Result = Liveness;
+    static Liveness run(const IRFunction& function, FunctionAnalyses& analyses);
+};
+
+} // namespace istudio::ir
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "ir/IR.h"
+#include "ir/PassManager.h"
+
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace istudio::ir {
+
+// A natural loop: the header and every block that reaches one of its back edges
+// (an edge into the header from a block the header dominates) without passing
+// through the header. Back edges sharing a header form one loop.
+class Loop {
+public:
+    [[nodiscard]] IRBasicBlock* getHeader() const { return blocks_.front(); }
+    [[nodiscard]] Loop* getParentLoop() const { return parent_; }
+    [[nodiscard]] const std::vector<Loop*>& getSubLoops() const { return subLoops_; }
+    // 1 for an outermost loop.
+    [[nodiscard]] unsigned getDepth() const { return depth_; }
+
+    // Blocks of the loop and of its subloops, header first, in reverse post-order.
+    [[nodiscard]] const std::vector<IRBasicBlock*>& getBlocks() const { return blocks_; }
+    [[nodiscard]] bool contains(const IRBasicBlock* block) const { return members_.contains(block); }
+    [[nodiscard]] bool contains(const Loop* other) const
+    {
+        for (; other; other = other->parent_) {
+            if (other == this) {
+                return true;
+            }
+        }
+        return false;
+    }
+    // Whether `value` is computed inside the loop (constants and arguments are not).
+    [[nodiscard]] bool isLoopInvariant(const IRValue* value) const;
+
+    // Blocks with a back edge to the header.
+    [[nodiscard]] std::vector<IRBasicBlock*> getLatches() const;
+    // Blocks of the loop with a successor outside it.
+    [[nodiscard]] std::vector<IRBasicBlock*> getExitingBlocks() const;
+    // Blocks outside the loop with a predecessor inside it, without duplicates.
+    [[nodiscard]] std::vector<IRBasicBlock*> getExitBlocks() const;
+    // The only predecessor of the header from outside the loop, when that block has
+    // the header as its only successor; nullptr otherwise. Code hoisted out of the
+    // loop goes there.
+    [[nodiscard]] IRBasicBlock* getPreheader() const;
+
+private:
+    friend struct LoopAnalysis;
+
+    Loop* parent_{nullptr};
+    std::vector<Loop*> subLoops_;
+    unsigned depth_{1};
+    std::vector<IRBasicBlock*> blocks_;
+    std::unordered_set<const IRBasicBlock*> members_;
+};
+
+// The loop nest of a function.
+class LoopInfo {
+public:
+    // The innermost loop containing `block`, or nullptr.
+    [[nodiscard]] Loop* getLoopFor(const IRBasicBlock* block) const
+    {
+        const auto it = loopFor_.find(block);
+        return it != loopFor_.end() ? it->second : nullptr;
+    }
+    [[nodiscard]] unsigned getLoopDepth(const IRBasicBlock* block) const
+    {
+        const Loop* loop = getLoopFor(block);
+        return loop ? loop->getDepth() : 0;
+    }
+    [[nodiscard]] bool isLoopHeader(const IRBasicBlock* block) const
+    {
+        const Loop* loop = getLoopFor(block);
+        return loop && loop->getHeader() == block;
+    }
+
+    [[nodiscard]] const std::vector<Loop*>& getTopLevelLoops() const { return topLevel_; }
+    // Every loop, inner loops before the loops containing them.
+    [[nodiscard]] std::vector<Loop*> getLoopsInnermostFirst() const;
+    [[nodiscard]] bool empty() const { return loops_.empty(); }
+    [[nodiscard]] std::size_t size() const { return loops_.size(); }
+
+private:
+    friend struct LoopAnalysis;
+
+    std::vector<std::unique_ptr<Loop>> loops_;
+    std::vector<Loop*> topLevel_;
+    std::unordered_map<const IRBasicBlock*, Loop*> loopFor_;
+};
+
+struct LoopAnalysis {
+    static constexpr AnalysisKind kind = AnalysisKind::Loops;
+    using Result = LoopInfo;
+    static LoopInfo run(const IRFunction& function, FunctionAnalyses& analyses);
+};
+
+} // namespace istudio::ir
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "ir/PassManager.h"
+
+namespace istudio::ir {
+
+// Puts every loop in canonical form, which later loop passes rely on:
+//  - a preheader: one block outside the loop whose only successor is the header,
+//  - a single latch: one block with the back edge to the header,
+//  - dedicated exits: blocks after the loop are entered only from inside it.
+// Each is made by routing the offending edges through a new block, which takes over
+// the matching Phi operands of the block the edges led to.
+class LoopSimplify : public FunctionPass {
+public:
+    [[nodiscard]] std::string_view name() const override { return "loop-simplify"; }
+    PreservedAnalyses run(IRFunction& function, FunctionAnalyses& analyses) const override;
+};
+
+} // namespace istudio::ir
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "ir/PassManager.h"
+
+#include <cstddef>
+
+namespace istudio::ir {
+
+struct UnrollParams {
+    // Largest number of copies of the body per iteration of the unrolled loop.
+    unsigned factor{4};
+    // Loops are not unrolled past this many instructions.
+    std::size_t maxUnrolledSize{160};
+};
+
+// Partial unrolling of innermost loops whose trip count is a compile-time constant.
+// The loop is copied `factor` times in a chain, the last copy's latch going back to
+// the original header. The factor divides the trip count, so the exit tests of the
+// copies never fire and are removed: one test per `factor` iterations remains, and
+// the straight-line body is what a later scheduler or vectorizer wants to see.
+// Expects loops in the form loop-simplify produces; others are left alone.
+class LoopUnroll : public FunctionPass {
+public:
+    LoopUnroll() = default;
+    explicit LoopUnroll(UnrollParams params)
+        : params_(params) {}
+
+    [[nodiscard]] std::string_view name() const override { return "loop-unroll"; }
+    PreservedAnalyses run(IRFunction& function, FunctionAnalyses& analyses) const override;
+
+private:
+    UnrollParams params_;
+};
+
+} // namespace istudio::ir
@@ -2,23 +2,77 @@
 
 #include "ir/IR.h"
 #include "AST.h"
+#include "semantic/TypeAnnotations.h"
+
 #include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 namespace istudio::ir {
 
+// Lowers the AST to SSA form. Local variables never reach the IR: every read is
+// resolved to the reaching definition while the function is lowered, inserting Phi
+// nodes at joins on demand (Braun et al., "Simple and Efficient Construction of
+// Static Single Assignment Form", CC 2013). Trivial Phis are removed as soon as they
+// are complete, so no separate SSA cleanup runs.
 class LoweringPass {
 public:
-    explicit LoweringPass() = default;
+    // Without annotations, value types are only inferred from literals and operators.
+    explicit LoweringPass(const semantic::TypeAnnotations* annotations = nullptr) : annotations_(annotations) {}
     ~LoweringPass() = default;
-    
+
     std::unique_ptr<IRModule> lower(const ProgramNode& program);
-    
+
 private:
+    using VariableId = std::size_t;
+
     std::unique_ptr<IRFunction> lowerFunction(const FunctionNode& func);
-    std::unique_ptr<IRBasicBlock> lowerBlock(const BlockNode& block);
-    std::unique_ptr<IRInstruction> lowerInstruction(const ASTNode& node);
-    
+    void lowerBlock(const BlockNode& block);
+    void lowerStatement(const ASTNode& node);
+    void lowerIf(const IfNode& node);
+    void lowerWhile(const WhileNode& node);
+    void lowerFor(const ForNode& node);
+    IRValue* lowerExpression(const ASTNode& node);
+    IRValue* lowerBinary(const BinaryOperationNode& node);
+    IRValue* lowerShortCircuit(const BinaryOperationNode& node, bool isAnd);
+    IRValue* lowerCall(const CallExpressionNode& node);
+
+    // On-the-fly SSA construction
+    void writeVariable(VariableId variable, IRBasicBlock* block, IRValue* value);
+    IRValue* readVariable(VariableId variable, IRBasicBlock* block);
+    IRValue* readVariableRecursive(VariableId variable, IRBasicBlock* block);
+    IRValue* addPhiOperands(VariableId variable, IRInstruction* phi);
+    IRValue* tryRemoveTrivialPhi(IRInstruction* phi);
+    void sealBlock(IRBasicBlock* block);
+
+    VariableId declareVariable(const std::string& name, IRType type);
+    std::optional<VariableId> lookupVariable(std::string_view name) const;
+
+    // Blocks are created detached and placed into the function once they are reached,
+    // so blocks without predecessors never appear in the output.
+    IRBasicBlock* createBlock(std::string_view label);
+    void placeBlock(IRBasicBlock* block);
+    IRInstruction* emit(IRInstructionOp op, IRType type, std::vector<IRValue*> operands);
+    void branch(IRBasicBlock* target);
+    void branchIf(IRValue* condition, IRBasicBlock* thenBlock, IRBasicBlock* elseBlock);
+    IRValue* undef(IRType type);
+    IRType typeOf(const ASTNode& node, IRType fallback) const;
+
+    const semantic::TypeAnnotations* annotations_{nullptr};
     std::unique_ptr<IRModule> module_;
+
+    // Per-function state
+    IRFunction* function_{nullptr};
+    IRBasicBlock* current_{nullptr}; // nullptr after a return: the code is unreachable
+    std::vector<IRType> variableTypes_;
+    std::vector<std::unordered_map<std::string, VariableId>> scopes_;
+    std::unordered_map<const IRBasicBlock*, std::unordered_map<VariableId, IRValue*>> currentDef_;
+    std::unordered_map<const IRBasicBlock*, std::vector<std::pair<VariableId, IRInstruction*>>> incompletePhis_;
+    std::unordered_set<const IRBasicBlock*> sealed_;
 };
 
-} // namespace istudio::ir
\ No newline at end of file
+} // namespace istudio::ir
@@ -0,0 +1,203 @@
+#pragma once
+
+#include "ir/IR.h"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <expected>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace istudio::ir {
+
+// Function analyses the pass manager caches. A pass reports which of them its
+// changes left intact; every other cached result of the function is dropped.
+enum class AnalysisKind : unsigned {
+    Dominators,
+    Loops,
+    Liveness,
+    Count
+};
+
+const char* toString(AnalysisKind kind);
+
+class PreservedAnalyses {
+public:
+    static PreservedAnalyses all() { return PreservedAnalyses(kAll); }
+    static PreservedAnalyses none() { return PreservedAnalyses(0); }
+    // For passes that only rewrite instructions: the CFG and everything derived from
+    // it stay valid.
+    static PreservedAnalyses cfg()
+    {
+        return none().preserve(AnalysisKind::Dominators).preserve(AnalysisKind::Loops);
+    }
+
+    PreservedAnalyses& preserve(AnalysisKind kind)
+    {
+        mask_ |= bit(kind);
+        return *this;
+    }
+    [[nodiscard]] bool preserves(AnalysisKind kind) const { return (mask_ & bit(kind)) != 0; }
+    [[nodiscard]] bool preservesAll() const { return mask_ == kAll; }
+
+    // Only what both sides preserve survives a sequence of passes.
+    PreservedAnalyses& intersect(const PreservedAnalyses& other)
+    {
+        mask_ &= other.mask_;
+        return *this;
+    }
+
+private:
+    static constexpr unsigned kAll = (1u << static_cast<unsigned>(AnalysisKind::Count)) - 1;
+    static unsigned bit(AnalysisKind kind) { return 1u << static_cast<unsigned>(kind); }
+
+    explicit PreservedAnalyses(unsigned mask) : mask_(mask) {}
+
+    unsigned mask_;
+};
+
+// Cached analysis results of one function. An analysis is a type with
+//   static constexpr AnalysisKind kind;
+//   using Result = ...;
+//   static Result run(const IRFunction&, FunctionAnalyses&);
+// and is computed on first request. Each function has its own cache, so function
+// pipelines running on different threads never share one.
+class FunctionAnalyses {
+public:
+    explicit FunctionAnalyses(const IRFunction& function) : function_(function) {}
+
+    [[nodiscard]] const IRFunction& function() const noexcept { return function_; }
+
+    template <typename Analysis>
+    const typename Analysis::Result& get()
+    {
+        auto& slot = results_[static_cast<std::size_t>(Analysis::kind)];
+        if (!slot) {
+            slot = std::make_unique<Holder<typename Analysis::Result>>(Analysis::run(function_, *this));
+            ++computed_;
+        }
+        return static_cast<const Holder<typename Analysis::Result>&>(*slot).value;
+    }
+
+    template <typename Analysis>
+    [[nodiscard]] bool isCached() const
+    {
+        return results_[static_cast<std::size_t>(Analysis::kind)] != nullptr;
+    }
+
+    void invalidate(const PreservedAnalyses& preserved);
+
+    // Number of analysis runs so far; a cache hit does not count.
+    [[nodiscard]] std::size_t computedCount() const noexcept { return computed_; }
+
+private:
+    struct Result {
+        virtual ~Result() = default;
+    };
+    template <typename T>
+    struct Holder : Result {
+        explicit Holder(T result) : value(std::move(result)) {}
+        T value;
+    };
+
+    const IRFunction& function_;
+    std::array<std::unique_ptr<Result>, static_cast<std::size_t>(AnalysisKind::Count)> results_;
+    std::size_t computed_{0};
+};
+
+// Function passes of a pipeline run concurrently on different functions, so run()
+// must not modify the pass object itself.
+class FunctionPass {
+public:
+    virtual ~FunctionPass() = default;
+    [[nodiscard]] virtual std::string_view name() const = 0;
+    virtual PreservedAnalyses run(IRFunction& function, FunctionAnalyses& analyses) const = 0;
+};
+
+// Module passes see the whole module (e.g. to inline across functions) and run alone.
+class ModulePass {
+public:
+    virtual ~ModulePass() = default;
+    [[nodiscard]] virtual std::string_view name() const = 0;
+    virtual PreservedAnalyses run(IRModule& module) = 0;
+};
+
+// Size of the IR, to report what a pass did.
+struct IRSize {
+    std::size_t functions{0};
+    std::size_t blocks{0};
+    std::size_t instructions{0};
+};
+
+IRSize measure(const IRFunction& function);
+IRSize measure(const IRModule& module);
+
+// What one pass did over a whole run. For a function pass the time is summed over
+// all functions, so with several threads it can exceed the pipeline's wall time.
+struct PassStatistics {
+    std::string name;
+    std::chrono::nanoseconds time{0};
+    std::ptrdiff_t blockDelta{0};
+    std::ptrdiff_t instructionDelta{0};
+    std::size_t runs{0};       // functions (or 1 for a module pass)
+    std::size_t unchanged{0};  // runs that reported PreservedAnalyses::all()
+};
+
+struct PassManagerOptions {
+    // Threads for function pipelines; 0 selects the hardware concurrency.
+    unsigned jobs{0};
+    // Measure every pass; IR sizes are only counted when this is set.
+    bool timePasses{false};
+    // Run the IR verifier on the input and after every pass; the first pass that
+    // leaves broken IR behind stops the run.
+    bool verifyEach{false};
+};
+
+// Runs a sequence of passes over a module. Consecutive function passes are grouped
+// into one pipeline that takes each function through all of them before moving on,
+// and different functions go through the pipeline in parallel. Module passes are
+// barriers between pipelines.
+class PassManager {
+public:
+    explicit PassManager(PassManagerOptions options = {}) : options_(options) {}
+
+    void addPass(std::unique_ptr<FunctionPass> pass);
+    void addPass(std::unique_ptr<ModulePass> pass);
+    [[nodiscard]] bool empty() const noexcept { return stages_.empty(); }
+
+    // Fails only with verifyEach, saying which pass broke which invariants.
+    std::expected<void, std::string> run(IRModule& module);
+
+    // Statistics of the last run, one entry per added pass, in pipeline order.
+    [[nodiscard]] const std::vector<PassStatistics>& statistics() const noexcept { return statistics_; }
+    [[nodiscard]] std::chrono::nanoseconds totalTime() const noexcept { return total_; }
+    [[nodiscard]] std::size_t analysisRuns() const noexcept { return analysisRuns_; }
+
+    // The --time-passes table.
+    void printReport(std::ostream& out) const;
+
+private:
+    // A module pass, or a pipeline of function passes.
+    struct Stage {
+        std::unique_ptr<ModulePass> modulePass;
+        std::vector<std::unique_ptr<FunctionPass>> functionPasses;
+        std::size_t firstStatistic{0};
+    };
+
+    std::expected<void, std::string> runModulePass(Stage& stage, IRModule& module,
+                                                   std::vector<std::unique_ptr<FunctionAnalyses>>& analyses);
+    std::expected<void, std::string> runPipeline(Stage& stage, IRModule& module,
+                                                 std::vector<std::unique_ptr<FunctionAnalyses>>& analyses);
+
+    PassManagerOptions options_;
+    std::vector<Stage> stages_;
+    std::vector<PassStatistics> statistics_;
+    std::chrono::nanoseconds total_{0};
+    std::size_t analysisRuns_{0};
+};
+
+} // namespace istudio::ir
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "ir/PassManager.h"
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace istudio::ir {
+
+// The pipeline -O runs.
+std::string_view defaultPipeline();
+
+// Names accepted by addPipeline, in registration order.
+std::vector<std::string_view> registeredPasses();
+
+// Appends the passes of a comma-separated pipeline (`dce,dce`) to `manager`. On an
+// unknown name nothing is added and `error` says which name.
+bool addPipeline(PassManager& manager, std::string_view pipeline, std::string& error);
+
+} // namespace istudio::ir
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "ir/PassManager.h"
+
+namespace istudio::ir {
+
+// Sparse conditional constant propagation (Wegman and Zadeck, "Constant Propagation
+// with Conditional Branches", TOPLAS 1991). Values are assumed constant until proven
+// otherwise and blocks unreachable until an executable edge reaches them, so
+// constants flowing around loops and through branches that never go one way are
+// found, which folding each instruction on its own misses.
+//
+// Operators are folded with semantic::ConstantEvaluator, so the IR agrees with the
+// source-level folding on what is safe to fold. Instructions with a constant result
+// are replaced by the constant; branch conditions become constants, which leaves
+// removing the dead edges to simplifycfg. The CFG itself is not changed.
+class SparseConditionalConstantPropagation : public FunctionPass {
+public:
+    [[nodiscard]] std::string_view name() const override { return "sccp"; }
+    PreservedAnalyses run(IRFunction& function, FunctionAnalyses& analyses) const override;
+};
+
+} // namespace istudio::ir
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "ir/PassManager.h"
+
+namespace istudio::ir {
+
+// Cleans up the control-flow graph until nothing changes:
+//   - a BranchIf on a constant, or with both targets equal, becomes a Branch;
+//   - blocks no longer reachable from the entry are deleted;
+//   - a Phi left with a single incoming value is replaced by that value;
+//   - a block containing only a Branch is bypassed when its target has no Phis;
+//   - a block is merged into its predecessor when that is the block's only
+//     predecessor and the block is the predecessor's only successor.
+class SimplifyCFG : public FunctionPass {
+public:
+    [[nodiscard]] std::string_view name() const override { return "simplifycfg"; }
+    PreservedAnalyses run(IRFunction& function, FunctionAnalyses& analyses) const override;
+};
+
+} // namespace istudio::ir
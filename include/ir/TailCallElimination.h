@@ -0,0 +1,22 @@
+#pragma once
+
+#include "ir/PassManager.h"
+
+namespace istudio::ir {
+
+// Finds calls in tail position (directly followed by the return of their result)
+// and
+//   - turns those of the function itself into a loop: the body moves into a new
+//     block after the entry, each argument becomes a Phi there, and the recursive
+//     call becomes a branch back that feeds the call's operands to the Phis;
+//   - marks every other one as a tail call, which backends can emit as a jump so
+//     mutual recursion runs in constant stack.
+// Functions with an Alloca are left alone: a callee reusing the frame could see
+// the caller's locals disappear from under a pointer to them.
+class TailCallElimination : public FunctionPass {
+public:
+    [[nodiscard]] std::string_view name() const override { return "tailcall"; }
+    PreservedAnalyses run(IRFunction& function, FunctionAnalyses& analyses) const override;
+};
+
+} // namespace istudio::ir
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "ir/PassManager.h"
+
+namespace istudio::ir {
+
+// Value range propagation. Every int and bool value gets the interval of values it
+// can take, from
+//   - constants, and arithmetic on intervals that cannot wrap;
+//   - induction variables of canonical loops: the start and the exit condition
+//     bound what `i` reaches in `for (i = start; i < n; i = i + step)`;
+//   - the branches taken to reach a block: in the body of that loop `i < n`
+//     holds, whatever `n` is, and so does every comparison it implies.
+// Comparisons this decides become constants, as do the bools combined from them,
+// so the index checks a loop makes on its own counter fold away and simplifycfg
+// removes the path that reports them. Operand uses are rewritten too, so a check
+// GVN merged with the loop condition folds where the condition already holds. The
+// CFG is not changed.
+class ValueRangePropagation : public FunctionPass {
+public:
+    [[nodiscard]] std::string_view name() const override { return "vrp"; }
+    PreservedAnalyses run(IRFunction& function, FunctionAnalyses& analyses) const override;
+};
+
+} // namespace istudio::ir
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "ir/IR.h"
+
+#include <string>
+#include <vector>
+
+namespace istudio::ir {
+
+// Checks the invariants every pass may assume and must preserve:
+//   - each block ends in its only terminator, and its Phis come first;
+//   - branches have their targets, and the predecessor lists match the branches;
+//   - a Phi has one incoming value per predecessor edge;
+//   - operands are live values of the same function, and every definition
+//     dominates its uses (a Phi uses its operand at the end of the incoming block;
+//     blocks the entry cannot reach are exempt);
+//   - operand and result types fit the opcode;
+//   - a tail call is directly followed by the return of its result.
+// Returns one message per problem, naming values as the printer does; empty when
+// the function is well formed.
+std::vector<std::string> verifyFunction(const IRFunction& function);
+
+// Every function, plus what spans functions: names are unique, and calls of a
+// module function pass it the right number of arguments.
+std::vector<std::string> verifyModule(const IRModule& module);
+
+} // namespace istudio::ir
@@ -0,0 +1,49 @@
+#ifndef ISTUDIO_THREADPOOL_H
+#define ISTUDIO_THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace istudio {
+
+// Fixed-size worker pool for data-parallel compiler phases. parallelFor hands out
+// indices dynamically, so uneven work items (large vs. tiny functions) balance
+// across threads; the calling thread participates and the call blocks until every
+// index has been processed.
+class ThreadPool {
+public:
+    // threadCount == 0 selects std::thread::hardware_concurrency().
+    explicit ThreadPool(unsigned threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    [[nodiscard]] unsigned size() const noexcept { return static_cast<unsigned>(workers_.size()) + 1; }
+
+    void parallelFor(std::size_t count, const std::function<void(std::size_t)>& body);
+
+private:
+    void workerLoop();
+    void runJob();
+
+    std::vector<std::jthread> workers_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    const std::function<void(std::size_t)>* body_{nullptr};
+    std::size_t count_{0};
+    std::atomic<std::size_t> next_{0};
+    std::size_t active_{0};
+    std::size_t generation_{0};
+    bool stopping_{false};
+};
+
+} // namespace istudio
+
+#endif // ISTUDIO_THREADPOOL_H
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "AST.h"
+#include "Diagnostics.h"
+#include "semantic/ConstantValue.h"
+#include "semantic/OwnershipAnalysis.h"
+#include "semantic/SymbolTable.h"
+#include "semantic/TemplateInstances.h"
+#include "semantic/TypeAnnotations.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace istudio::semantic {
+
+// Structural hash of a subtree. A cached body result is only reused for a function
+// node whose fingerprint is unchanged, which guards against a replaced node being
+// allocated at the address of the one it replaced.
+std::uint64_t fingerprint(const ASTNode& node);
+
+// A global name a function body looked up while being checked, and the signature it
+// saw (empty when the name was undefined). The body's result stays valid as long as
+// every dependency still resolves to the same signature.
+struct FunctionDependency {
+    std::string name;
+    std::string signature;
+};
+
+// Everything checking one function body produced.
+struct FunctionResult {
+    std::uint64_t fingerprint{0};
+    std::vector<FunctionDependency> dependencies;
+    DiagnosticEngine diagnostics;
+    TypeAnnotations annotations;
+    OwnershipFacts ownership;
+    ConstantTable constants;
+    TemplateInstances templates;
+    SymbolScope::Ptr record; // only with SemanticOptions::recordScopes
+    bool success{true};
+};
+
+// Function-body results kept between SemanticAnalyzer::analyze() calls. Entries are
+// keyed by function node, so an edit loop that swaps a re-parsed function into the
+// program (ProgramNode::replaceFunction) keeps every other entry usable.
+class AnalysisCache {
+public:
+    // Entry for `function` if it was computed on a tree with the same fingerprint.
+    [[nodiscard]] const FunctionResult* find(const FunctionNode& function, std::uint64_t fingerprint) const
+    {
+        const auto it = results_.find(&function);
+        return it != results_.end() && it->second.fingerprint == fingerprint ? &it->second : nullptr;
+    }
+
+    void store(const FunctionNode& function, FunctionResult result) { results_[&function] = std::move(result); }
+
+    // Drops the entries of functions that are no longer part of the program.
+    void retain(const std::vector<const FunctionNode*>& functions);
+
+    void clear() noexcept { results_.clear(); }
+    [[nodiscard]] std::size_t size() const noexcept { return results_.size(); }
+
+private:
+    std::unordered_map<const FunctionNode*, FunctionResult> results_;
+};
+
+} // namespace istudio::semantic
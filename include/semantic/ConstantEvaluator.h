@@ -0,0 +1,45 @@
+#pragma once
+
+#include "AST.h"
+#include "semantic/ConstantValue.h"
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace istudio::semantic {
+
+// Compile-time evaluation of IPL operators and pure library functions.
+//
+// Folding only happens when every target computes the same result: integer
+// results must fit the 32-bit `int` of the C, C++ and Java output, integer `/` is
+// left alone (Python divides into a float) and `%` needs non-negative operands,
+// since C, Java and Python disagree on the rest.
+//
+// The evaluator is immutable once the pure functions are registered, so the
+// concurrent function-body checks share one instance.
+class ConstantEvaluator {
+public:
+    // Registers the value-returning functions of a library whose functions are all
+    // side-effect free (e.g. core_math). Names in `shadowed` (functions the program
+    // itself declares) are skipped, since calls resolve to the program's versions.
+    void addPureLibrary(const ProgramNode& library, const std::vector<std::string>& shadowed);
+
+    [[nodiscard]] bool isPure(std::string_view function) const { return pure_.contains(function); }
+
+    std::optional<ConstantValue> unary(std::string_view op, const ConstantValue& operand) const;
+    std::optional<ConstantValue> binary(std::string_view op, const ConstantValue& left, const ConstantValue& right) const;
+
+    // Runs a registered pure function on constant arguments. Gives up (nullopt) on
+    // anything it cannot evaluate exactly or once a step or recursion budget is spent.
+    std::optional<ConstantValue> call(std::string_view function, const std::vector<ConstantValue>& arguments) const;
+
+private:
+    friend class Interpreter;
+
+    std::unordered_map<std::string_view, const FunctionNode*> pure_;
+};
+
+} // namespace istudio::semantic
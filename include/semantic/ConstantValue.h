@@ -0,0 +1,52 @@
+#pragma once
+
+#include "AST.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+
+namespace istudio::semantic {
+
+// A value known at compile time. Strings hold the literal's source spelling
+// between the quotes, escapes included, so folding never re-escapes text.
+using ConstantValue = std::variant<bool, std::int64_t, double, std::string>;
+
+// Value of a literal lexeme; nullopt for null, raw strings and out-of-range numbers.
+std::optional<ConstantValue> parseLiteral(std::string_view lexeme);
+
+// IPL literal spelling of a value (`3`, `2.5`, `true`, `"text"`); doubles always
+// carry a decimal point or exponent so they stay floating point when re-read.
+std::string toLiteral(const ConstantValue& value);
+
+// Folded values of expressions, filled during semantic analysis and read by code
+// generation. Like TypeAnnotations, keys are node addresses.
+class ConstantTable {
+public:
+    void set(const ASTNode& node, ConstantValue value) { values_[&node] = std::move(value); }
+
+    [[nodiscard]] const ConstantValue* find(const ASTNode& node) const
+    {
+        const auto it = values_.find(&node);
+        return it != values_.end() ? &it->second : nullptr;
+    }
+
+    void merge(ConstantTable&& other)
+    {
+        values_.merge(other.values_);
+        other.values_.clear();
+    }
+
+    void clear() noexcept { values_.clear(); }
+    [[nodiscard]] std::size_t size() const noexcept { return values_.size(); }
+
+private:
+    std::unordered_map<const ASTNode*, ConstantValue> values_;
+};
+
+} // namespace istudio::semantic
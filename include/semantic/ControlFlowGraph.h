@@ -0,0 +1,52 @@
+#pragma once
+
+#include "AST.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace istudio::semantic {
+
+using BlockId = std::uint32_t;
+
+// A straight-line run of AST elements. Elements are simple statements
+// (declarations, assignments, expression statements, returns) and the condition
+// expressions of if/while/for, in evaluation order.
+struct CFGBlock {
+    BlockId id{0};
+    std::vector<const ASTNode*> elements;
+    std::vector<BlockId> successors;
+    std::vector<BlockId> predecessors;
+};
+
+// Per-function control-flow graph over the AST. Block 0 is the entry and block 1
+// the (empty) exit; every return and the implicit fall-off at the end of the body
+// have an edge to the exit.
+class ControlFlowGraph {
+public:
+    static ControlFlowGraph build(const FunctionNode& function);
+
+    [[nodiscard]] BlockId entry() const noexcept { return 0; }
+    [[nodiscard]] BlockId exit() const noexcept { return 1; }
+    [[nodiscard]] const std::vector<CFGBlock>& blocks() const noexcept { return blocks_; }
+    [[nodiscard]] const CFGBlock& block(BlockId id) const { return blocks_[id]; }
+
+    // Reachable blocks in reverse post-order from the entry.
+    [[nodiscard]] const std::vector<BlockId>& reversePostOrder() const noexcept { return rpo_; }
+    [[nodiscard]] bool isReachable(BlockId id) const { return reachable_[id]; }
+
+    // True when control can reach the end of the body without a return statement.
+    [[nodiscard]] bool fallsOffEnd() const { return isReachable(fallthrough_); }
+
+private:
+    friend class CFGBuilder;
+
+    void computeOrder();
+
+    std::vector<CFGBlock> blocks_;
+    std::vector<BlockId> rpo_;
+    std::vector<bool> reachable_;
+    BlockId fallthrough_{0};
+};
+
+} // namespace istudio::semantic
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "semantic/ControlFlowGraph.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace istudio::semantic {
+
+// Fixed-size bit set sized at runtime; one bit per tracked fact (e.g. local slot).
+class BitVector {
+public:
+    BitVector() = default;
+    explicit BitVector(std::size_t size, bool value = false)
+        : words_((size + 63) / 64, value ? ~std::uint64_t{0} : 0), size_(size)
+    {
+        trim();
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept { return size_; }
+    [[nodiscard]] bool test(std::size_t bit) const { return (words_[bit / 64] >> (bit % 64)) & 1U; }
+    void set(std::size_t bit) { words_[bit / 64] |= std::uint64_t{1} << (bit % 64); }
+    void reset(std::size_t bit) { words_[bit / 64] &= ~(std::uint64_t{1} << (bit % 64)); }
+
+    void intersectWith(const BitVector& other)
+    {
+        for (std::size_t i = 0; i < words_.size(); ++i) {
+            words_[i] &= other.words_[i];
+        }
+    }
+
+    void unionWith(const BitVector& other)
+    {
+        for (std::size_t i = 0; i < words_.size(); ++i) {
+            words_[i] |= other.words_[i];
+        }
+    }
+
+    // this = gen | (this & ~kill)
+    void transfer(const BitVector& gen, const BitVector& kill)
+    {
+        for (std::size_t i = 0; i < words_.size(); ++i) {
+            words_[i] = gen.words_[i] | (words_[i] & ~kill.words_[i]);
+        }
+    }
+
+    bool operator==(const BitVector& other) const = default;
+
+private:
+    void trim()
+    {
+        if (size_ % 64 != 0 && !words_.empty()) {
+            words_.back() &= (std::uint64_t{1} << (size_ % 64)) - 1;
+        }
+    }
+
+    std::vector<std::uint64_t> words_;
+    std::size_t size_{0};
+};
+
+enum class DataflowMeet {
+    Intersect, // must-analyses (definitely assigned, ...)
+    Union      // may-analyses (maybe moved, ...)
+};
+
+// Classic gen/kill formulation: OUT[b] = gen[b] | (IN[b] & ~kill[b]) and IN[b] is
+// the meet over the predecessors' OUT sets. `boundary` is IN of the entry block.
+// Backward problems swap the roles: IN[b] = gen[b] | (OUT[b] & ~kill[b]), OUT[b] is
+// the meet over the successors and `boundary` is OUT of the exit block.
+struct GenKillProblem {
+    GenKillProblem(std::size_t bitCount, DataflowMeet meetKind, std::size_t blockCount)
+        : bits(bitCount), meet(meetKind), boundary(bitCount),
+          gen(blockCount, BitVector(bitCount)), kill(blockCount, BitVector(bitCount))
+    {
+    }
+
+    // Record an event of `block` in execution order; the last event per bit wins.
+    void generates(BlockId block, std::size_t bit)
+    {
+        gen[block].set(bit);
+        kill[block].reset(bit);
+    }
+
+    void kills(BlockId block, std::size_t bit)
+    {
+        gen[block].reset(bit);
+        kill[block].set(bit);
+    }
+
+    std::size_t bits;
+    DataflowMeet meet;
+    BitVector boundary;
+    std::vector<BitVector> gen;
+    std::vector<BitVector> kill;
+};
+
+// Solves a forward problem by iterating in reverse post-order until a fixed point;
+// returns IN for every block. Unreachable blocks keep the meet's identity.
+std::vector<BitVector> solveForward(const ControlFlowGraph& cfg, const GenKillProblem& problem);
+
+// Backward counterpart (liveness, ...); returns OUT, the state at the end of every block.
+std::vector<BitVector> solveBackward(const ControlFlowGraph& cfg, const GenKillProblem& problem);
+
+} // namespace istudio::semantic
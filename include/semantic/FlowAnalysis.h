@@ -0,0 +1,71 @@
+#pragma once
+
+#include "AST.h"
+#include "semantic/ControlFlowGraph.h"
+#include "semantic/SymbolTable.h"
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace istudio::semantic {
+
+using SlotId = std::uint32_t;
+inline constexpr SlotId kNoSlot = UINT32_MAX;
+
+// A parameter or local variable of the function; every declaration gets its own
+// slot, so shadowing declarations never share dataflow bits.
+struct LocalSlot {
+    std::string name;
+    std::string typeName; // without the ownership qualifier; empty when inferred
+    OwnershipKind ownership{OwnershipKind::Unknown};
+    bool parameter{false};
+};
+
+enum class FlowEventKind {
+    Use,     // value read
+    Define,  // value written (assignment, initialized declaration)
+    Declare, // declaration without initializer: the slot starts unassigned
+    Move     // `move x`: ownership transferred out of the slot
+};
+
+struct FlowEvent {
+    FlowEventKind kind;
+    SlotId slot;
+    const ASTNode* node;
+};
+
+// CFG of a function plus the slot-level events of every block, in evaluation order.
+// Names are resolved lexically once here, so the dataflow problems below only deal
+// with slot indices.
+class FunctionFlow {
+public:
+    explicit FunctionFlow(const FunctionNode& function);
+
+    [[nodiscard]] const FunctionNode& function() const noexcept { return function_; }
+    [[nodiscard]] const ControlFlowGraph& cfg() const noexcept { return cfg_; }
+    [[nodiscard]] const std::vector<LocalSlot>& slots() const noexcept { return slots_; }
+    [[nodiscard]] const std::vector<FlowEvent>& events(BlockId block) const { return events_[block]; }
+
+    // Slot of a declaration, assignment or identifier node; kNoSlot for globals.
+    [[nodiscard]] SlotId slotOf(const ASTNode& node) const;
+
+private:
+    const FunctionNode& function_;
+    ControlFlowGraph cfg_;
+    std::vector<LocalSlot> slots_;
+    std::vector<std::vector<FlowEvent>> events_;
+    std::unordered_map<const ASTNode*, SlotId> resolved_;
+};
+
+struct FlowIssue {
+    std::string message;
+    const ASTNode* node;
+};
+
+// Flow-sensitive checks over the CFG: definite assignment and, when `requiresReturn`,
+// definite return. Ownership is checked separately (OwnershipAnalysis.h).
+std::vector<FlowIssue> checkFunctionFlow(const FunctionFlow& flow, bool requiresReturn);
+
+} // namespace istudio::semantic
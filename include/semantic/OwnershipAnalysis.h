@@ -0,0 +1,40 @@
+#pragma once
+
+#include "semantic/FlowAnalysis.h"
+
+#include <cstddef>
+#include <unordered_set>
+#include <vector>
+
+namespace istudio::semantic {
+
+// Ownership facts later phases may rely on once a function passed checkOwnership.
+class OwnershipFacts {
+public:
+    // Reads of an owned value that are its last use on every path and are not
+    // pinned by a live borrow: the value can be moved into its consumer instead
+    // of being copied.
+    [[nodiscard]] bool isLastUse(const ASTNode& node) const { return lastUses_.contains(&node); }
+    void addLastUse(const ASTNode& node) { lastUses_.insert(&node); }
+
+    void merge(OwnershipFacts&& other)
+    {
+        lastUses_.merge(other.lastUses_);
+        other.lastUses_.clear();
+    }
+
+    void clear() noexcept { lastUses_.clear(); }
+    [[nodiscard]] std::size_t size() const noexcept { return lastUses_.size(); }
+
+private:
+    std::unordered_set<const ASTNode*> lastUses_;
+};
+
+// Computes the moved and borrowed state of owned locals at every program point:
+// reports uses of moved values and moves out of borrowed values, and records last
+// uses into `facts`. Only owned slots and the borrowed locals bound to them get bit
+// indices, and only blocks that touch them carry transfer functions, so functions
+// without owned values cost nothing.
+std::vector<FlowIssue> checkOwnership(const FunctionFlow& flow, OwnershipFacts& facts);
+
+} // namespace istudio::semantic
@@ -2,24 +2,97 @@
 
 #include "AST.h"
 #include "Diagnostics.h"
+#include "semantic/AnalysisCache.h"
+#include "semantic/ConstantEvaluator.h"
+#include "semantic/OwnershipAnalysis.h"
 #include "semantic/SymbolTable.h"
+#include "semantic/TemplateInstances.h"
 #include "semantic/Type.h"
+#include "semantic/TypeAnnotations.h"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
 
 namespace istudio::semantic {
 
 struct SemanticOptions {
     bool verbose{false};
+    // Keep a snapshot of every scope after analysis (needed by --emit-sema only).
+    bool recordScopes{false};
+    // Threads used to check function bodies; 0 selects the hardware concurrency.
+    unsigned jobs{0};
+};
+
+// Work done by the last analyze() call.
+struct AnalysisStats {
+    std::size_t checkedFunctions{0};
+    std::size_t reusedFunctions{0};
 };
 
 class SemanticAnalyzer {
 public:
     explicit SemanticAnalyzer(SemanticOptions options = {});
 
+    // Declares the functions of a library module (e.g. the stdlib) in the global scope
+    // of subsequent analyze() calls. Library bodies are trusted and not re-checked;
+    // program functions may shadow library functions of the same name. Calls into a
+    // `pure` library with constant arguments are evaluated at compile time.
+    void addLibrary(const ProgramNode& library, bool pure = false);
+
+    // Runs in two phases: every function signature is collected into a global scope
+    // that is then frozen, and function bodies are checked concurrently, each with its
+    // own scope stack and diagnostic buffer. Buffers are merged in source order, so the
+    // reported diagnostics do not depend on scheduling.
+    //
+    // Repeated calls are incremental: a function body is only re-checked if its node
+    // changed or if a global it looked up (a callee, or a name that was undefined)
+    // now resolves to a different signature. Other bodies reuse their cached
+    // diagnostics, symbols, types and facts.
     bool analyze(const ProgramNode& program, DiagnosticEngine& diagnostics);
 
+    [[nodiscard]] const AnalysisStats& lastStats() const noexcept { return stats_; }
+
+    // Only populated when SemanticOptions::recordScopes is set.
     [[nodiscard]] const SymbolScope::Ptr& globalScope() const noexcept { return globalScope_; }
 
+    // Resolved types of the expressions and declarations of the last analyzed program.
+    [[nodiscard]] const TypeAnnotations& typeAnnotations() const noexcept { return annotations_; }
+
+    // Last uses of owned values, which code generators may move instead of copy.
+    [[nodiscard]] const OwnershipFacts& ownershipFacts() const noexcept { return ownership_; }
+
+    // Compile-time values of folded expressions (operators on constants, const/final
+    // variables, pure library calls).
+    [[nodiscard]] const ConstantTable& constants() const noexcept { return constants_; }
+
+    // Template function instantiations, in order of first use, and the instance each
+    // call of a template resolved to.
+    [[nodiscard]] const TemplateInstances& templateInstances() const noexcept { return templates_; }
+
 private:
+    // Body checker for a single function, layered over the frozen global scope.
+    SemanticAnalyzer(const SemanticOptions& options,
+                     std::shared_ptr<TypeContext> types,
+                     std::shared_ptr<const ConstantEvaluator> evaluator,
+                     const ScopedSymbolTable& globals);
+
+    void declareFunction(const FunctionNode& node, bool reportErrors);
+    TypePtr resolveReturnType(const FunctionNode& node);
+    // Resolves a written type, with the template parameters of the current function.
+    TypePtr resolveType(std::string_view spelling);
+    TypeBindings templateBindings(const FunctionNode& node) const;
+    void instantiateCall(const CallExpressionNode& call, const FunctionNode& function);
+
+    // Lookup that records names resolving to globals (or to nothing) as dependencies
+    // of the function body being checked.
+    const Symbol* lookupDependency(std::string_view name);
+    std::string signatureOf(std::string_view name) const;
+    bool isReusable(const FunctionResult& result) const;
+
     void visit(const ASTNode& node);
     void visitProgram(const ProgramNode& node);
     void visitFunction(const FunctionNode& node);
@@ -35,21 +108,37 @@ private:
     void visitWhile(const WhileNode& node);
     void visitFor(const ForNode& node);
 
+    // Types an expression once; later queries for the same node hit the annotation table.
     TypePtr checkExpressionType(const ASTNode& expr);
+    TypePtr computeExpressionType(const ASTNode& expr);
+    std::optional<ConstantValue> foldConstant(const ASTNode& expr) const;
+    std::optional<ConstantValue> constantOf(const ASTNode& expr) const;
 
     void pushScope();
     void popScope();
+    void recordLocalScope();
 
     void report(DiagnosticSeverity severity, std::string message, const ASTNode& node);
 
 private:
     SemanticOptions options_;
-    TypeContext types_;
+    std::shared_ptr<TypeContext> types_;
+    std::vector<const ProgramNode*> libraries_;
+    std::vector<const ProgramNode*> pureLibraries_;
+    std::shared_ptr<const ConstantEvaluator> evaluator_;
+    ScopedSymbolTable scopes_;
+    TypeAnnotations annotations_;
+    OwnershipFacts ownership_;
+    ConstantTable constants_;
+    TemplateInstances templates_;
+    TypeBindings typeParameters_;
+    AnalysisCache cache_;
+    AnalysisStats stats_;
+    std::unordered_set<std::string> dependencies_;
     SymbolScope::Ptr globalScope_;
-    SymbolScope::Ptr currentScope_;
+    SymbolScope::Ptr recordScope_;
     DiagnosticEngine* diagnostics_{nullptr};
     bool success_{true};
-    bool hasReturnStatement_{false};
 };
 
 } // namespace istudio::semantic
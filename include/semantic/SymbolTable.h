@@ -1,10 +1,15 @@
 #pragma once
 
+#include "semantic/ConstantValue.h"
 #include "semantic/Type.h"
+#include <cstdint>
+#include <deque>
 #include <memory>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <vector>
 
 namespace istudio::semantic {
 
@@ -20,6 +25,11 @@ enum class OwnershipKind {
     Reference
 };
 
+// Ownership qualifier of a type spelling: `owned<T>`, `owned T`, `borrowed<T>`, ...
+OwnershipKind ownershipOf(std::string_view typeName);
+// The type spelling without its ownership qualifier (`owned<string>` -> `string`).
+std::string_view stripOwnership(std::string_view typeName);
+
 struct Symbol {
     std::string name;
     SymbolKind kind{SymbolKind::Variable};
@@ -27,8 +37,14 @@ struct Symbol {
     OwnershipKind ownership{OwnershipKind::Unknown};
     bool isInitialized{false};
     bool hasMoved{false};
+    bool isConstant{false};
+    std::optional<ConstantValue> constant{}; // value of a const/final with a foldable initializer
+    const FunctionNode* declaration{nullptr}; // functions: parameters and template header
 };
 
+// Persisted scope tree. The analyzer only builds one when a caller asks to keep the
+// scopes around after analysis (e.g. `--emit-sema`); name resolution itself runs on
+// ScopedSymbolTable below.
 class SymbolScope : public std::enable_shared_from_this<SymbolScope> {
 public:
     using Ptr = std::shared_ptr<SymbolScope>;
@@ -36,10 +52,12 @@ public:
     explicit SymbolScope(Ptr parent = {});
 
     Ptr createChild();
+    // Re-parents an existing scope tree under this scope (a cached function scope).
+    void adoptChild(Ptr child);
 
     bool declare(Symbol symbol);
-    std::optional<Symbol> lookupLocal(const std::string& name) const;
-    std::optional<Symbol> lookup(const std::string& name) const;
+    const Symbol* lookupLocal(std::string_view name) const;
+    const Symbol* lookup(std::string_view name) const;
     const Ptr& parent() const noexcept { return parent_; }
     const std::unordered_map<std::string, Symbol>& symbols() const noexcept { return symbols_; }
     const std::vector<Ptr>& children() const noexcept { return children_; }
@@ -47,7 +65,64 @@ public:
 private:
     Ptr parent_;
     std::unordered_map<std::string, Symbol> symbols_;
+    std::unordered_map<std::string_view, const Symbol*> index_; // string_view keys for lookup
     std::vector<Ptr> children_;
 };
 
+// Single scoped symbol table used during analysis. Names are interned once; each name
+// keeps a chain of the bindings that currently shadow each other, and the binding stack
+// doubles as the undo log, so pushScope/popScope/lookup are O(1) (amortized, pop is
+// linear in the bindings the scope introduced).
+//
+// declare/lookup hand out pointers into the binding stack. They stay valid until the
+// scope that introduced the binding is popped, so callers update isInitialized/hasMoved
+// in place instead of copying the symbol out and back.
+//
+// A table may sit on top of a frozen enclosing table (the global signature scope shared
+// by concurrent function-body checks). Lookups fall through to it; its bindings are
+// read-only, so lookupWritable only sees this table's own bindings.
+class ScopedSymbolTable {
+public:
+    explicit ScopedSymbolTable(const ScopedSymbolTable* enclosing = nullptr);
+
+    void pushScope();
+    void popScope();
+    [[nodiscard]] std::size_t depth() const noexcept { return scopeMarks_.size(); }
+
+    // Returns the new binding, or nullptr if the name is already bound in this scope.
+    Symbol* declare(Symbol symbol);
+    const Symbol* lookupLocal(std::string_view name) const;
+    const Symbol* lookup(std::string_view name) const;
+    Symbol* lookupWritable(std::string_view name);
+
+    // Visits the bindings introduced by the innermost scope in declaration order.
+    template <typename Fn>
+    void forEachLocal(Fn&& fn) const
+    {
+        for (std::size_t i = scopeMarks_.back(); i < bindings_.size(); ++i) {
+            fn(bindings_[i].symbol);
+        }
+    }
+
+private:
+    using NameId = std::uint32_t;
+    static constexpr std::uint32_t kNoBinding = UINT32_MAX;
+
+    struct Binding {
+        Symbol symbol;
+        NameId name;
+        std::uint32_t shadowed; // binding of the same name this one hides, or kNoBinding
+    };
+
+    NameId intern(std::string_view name);
+    std::uint32_t find(std::string_view name) const;
+
+    const ScopedSymbolTable* enclosing_{nullptr};
+    std::deque<std::string> names_; // owns the interned spellings viewed by ids_
+    std::unordered_map<std::string_view, NameId> ids_;
+    std::vector<std::uint32_t> heads_; // innermost binding per NameId
+    std::deque<Binding> bindings_; // deque: push/pop at the end keep other bindings in place
+    std::vector<std::uint32_t> scopeMarks_; // bindings_.size() when each scope was pushed
+};
+
 } // namespace istudio::semantic
@@ -0,0 +1,125 @@
+#pragma once
+
+#include "AST.h"
+#include "semantic/Type.h"
+
+#include <cctype>
+#include <cstddef>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace istudio::semantic {
+
+// One instantiation of a template function, e.g. swap<int>.
+struct TemplateInstance {
+    std::string function;           // template name
+    std::vector<TypePtr> arguments; // in template parameter order
+    TypePtr returnType;
+    std::string mangledName;        // swap_int, for targets without templates
+};
+
+// Template instantiations of the analyzed program and the instance each call resolved
+// to. Each distinct instantiation is stored once, in order of first use, so
+// monomorphizing generators emit one copy per instantiation rather than per call.
+class TemplateInstances {
+public:
+    // Resolves `call` to the instance of `function` for these arguments, creating the
+    // instance on first use.
+    const TemplateInstance& instantiate(const ASTNode& call,
+                                        const FunctionNode& function,
+                                        std::vector<TypePtr> arguments,
+                                        TypePtr returnType)
+    {
+        const auto [it, inserted] = byKey_.try_emplace(keyOf(function.getName(), arguments), instances_.size());
+        if (inserted) {
+            std::string mangled = function.getName();
+            for (const auto& argument : arguments) {
+                mangled += '_' + mangle(argument->name());
+            }
+            instances_.push_back(
+                TemplateInstance{function.getName(), std::move(arguments), std::move(returnType), std::move(mangled)});
+        }
+        calls_[&call] = it->second;
+        return instances_[it->second];
+    }
+
+    // Instance a call resolved to; nullptr for calls of ordinary functions.
+    [[nodiscard]] const TemplateInstance* find(const ASTNode& call) const
+    {
+        const auto it = calls_.find(&call);
+        return it != calls_.end() ? &instances_[it->second] : nullptr;
+    }
+
+    [[nodiscard]] std::vector<const TemplateInstance*> instancesOf(std::string_view function) const
+    {
+        std::vector<const TemplateInstance*> result;
+        for (const auto& instance : instances_) {
+            if (instance.function == function) {
+                result.push_back(&instance);
+            }
+        }
+        return result;
+    }
+
+    // Adds the instances and calls of `other`, keeping the first-use order.
+    void merge(const TemplateInstances& other)
+    {
+        std::vector<std::size_t> remap;
+        remap.reserve(other.instances_.size());
+        for (const auto& instance : other.instances_) {
+            const auto [it, inserted] = byKey_.try_emplace(keyOf(instance.function, instance.arguments), instances_.size());
+            if (inserted) {
+                instances_.push_back(instance);
+            }
+            remap.push_back(it->second);
+        }
+        for (const auto& [call, index] : other.calls_) {
+            calls_[call] = remap[index];
+        }
+    }
+
+    void clear() noexcept
+    {
+        instances_.clear();
+        byKey_.clear();
+        calls_.clear();
+    }
+    [[nodiscard]] std::size_t size() const noexcept { return instances_.size(); }
+
+private:
+    static std::string keyOf(std::string_view function, const std::vector<TypePtr>& arguments)
+    {
+        std::string key{function};
+        for (const auto& argument : arguments) {
+            key += '|' + argument->name();
+        }
+        return key;
+    }
+
+    // `list<number>` -> `list_number`
+    static std::string mangle(std::string_view typeName)
+    {
+        std::string result;
+        for (const char c : typeName) {
+            if (std::isalnum(static_cast<unsigned char>(c))) {
+                result += c;
+            } else if (!result.empty() && result.back() != '_') {
+                result += '_';
+            }
+        }
+        while (!result.empty() && result.back() == '_') {
+            result.pop_back();
+        }
+        return result;
+    }
+
+    std::deque<TemplateInstance> instances_; // deque: references stay valid on insert
+    std::unordered_map<std::string, std::size_t> byKey_;
+    std::unordered_map<const ASTNode*, std::size_t> calls_;
+};
+
+} // namespace istudio::semantic
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cstddef>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -18,6 +20,8 @@ enum class TypeKind {
     Reference,
     Optional,
     Function,
+    Generic,   // instance of a parametric type, e.g. matrix<number>
+    Parameter, // template parameter inside a template function
     Unknown
 };
 
@@ -50,6 +54,30 @@ private:
     TypePtr pointee_;
 };
 
+class TypeParameter : public Type {
+public:
+    explicit TypeParameter(std::string name) : Type(TypeKind::Parameter, std::move(name)) {}
+};
+
+// Named by its canonical spelling (`dict<string, int>`), so instances compare equal
+// by name like every other type.
+class GenericType : public Type {
+public:
+    GenericType(std::string name, std::string base, std::vector<TypePtr> arguments)
+        : Type(TypeKind::Generic, std::move(name)), base_(std::move(base)), arguments_(std::move(arguments)) {}
+
+    [[nodiscard]] const std::string& base() const noexcept { return base_; }
+    [[nodiscard]] const std::vector<TypePtr>& arguments() const noexcept { return arguments_; }
+
+private:
+    std::string base_;
+    std::vector<TypePtr> arguments_;
+};
+
+// Template parameter names in scope (`T` -> a TypeParameter, or the argument type of
+// an instantiation).
+using TypeBindings = std::unordered_map<std::string, TypePtr>;
+
 class FunctionType : public Type {
 public:
     FunctionType(TypePtr returnType, std::vector<TypePtr> parameters);
@@ -70,10 +98,31 @@ public:
     TypePtr getOrCreatePointer(TypePtr pointee, std::string decoration);
     TypePtr getOrCreateFunction(TypePtr returnType, std::vector<TypePtr> parameters);
 
+    // Resolves a type spelling: builtins, the names in `bindings`, instantiations such
+    // as `matrix<number>` and `T?` (shorthand for Optional<T>). nullptr if any part is
+    // unknown.
+    TypePtr resolve(std::string_view spelling, const TypeBindings* bindings = nullptr);
+
+    // The unique instance of a parametric type (matrix, list, set, Optional, Result,
+    // dict, tuple), created on first use. nullptr for an unknown base or a wrong
+    // number of arguments. Safe to call from concurrent function-body checks.
+    TypePtr instantiate(std::string_view base, std::vector<TypePtr> arguments);
+
+    // `type` with bound template parameters replaced, e.g. list<T> -> list<int>.
+    TypePtr substitute(const TypePtr& type, const TypeBindings& bindings);
+
+    [[nodiscard]] std::size_t instantiationCount() const;
+
 private:
+    TypePtr resolveSpelling(std::string_view& spelling, const TypeBindings* bindings);
+
     std::unordered_map<std::string, TypePtr> builtins_;
+    std::unordered_map<std::string, std::size_t> templates_; // base -> arity, 0 = variadic
     std::vector<TypePtr> pointers_;
     std::vector<TypePtr> functions_;
+
+    mutable std::mutex instancesMutex_;
+    std::unordered_map<std::string, TypePtr> instances_; // canonical spelling -> instance
 };
 
 } // namespace istudio::semantic
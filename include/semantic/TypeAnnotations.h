@@ -0,0 +1,52 @@
+#pragma once
+
+#include "AST.h"
+#include "semantic/Type.h"
+
+#include <cstddef>
+#include <unordered_map>
+#include <utility>
+
+namespace istudio::semantic {
+
+// Resolved type of every expression and declaration, written once during semantic
+// analysis and read by later phases (lowering, code generation) instead of
+// re-deriving types from the AST. Keys are node addresses, so the table is only
+// valid while the analyzed AST is alive.
+class TypeAnnotations {
+public:
+    void set(const ASTNode& node, TypePtr type) { types_[&node] = std::move(type); }
+
+    // Returns nullptr for nodes that were never annotated.
+    [[nodiscard]] const TypePtr* find(const ASTNode& node) const
+    {
+        const auto it = types_.find(&node);
+        return it != types_.end() ? &it->second : nullptr;
+    }
+
+    [[nodiscard]] TypePtr typeOf(const ASTNode& node) const
+    {
+        const TypePtr* type = find(node);
+        return type ? *type : nullptr;
+    }
+
+    // Moves every entry of `other` into this table (used to collect per-function
+    // tables built by parallel workers; their key sets are disjoint).
+    void merge(TypeAnnotations&& other)
+    {
+        if (types_.empty()) {
+            types_ = std::move(other.types_);
+        } else {
+            types_.merge(other.types_);
+        }
+        other.types_.clear();
+    }
+
+    void clear() noexcept { types_.clear(); }
+    [[nodiscard]] std::size_t size() const noexcept { return types_.size(); }
+
+private:
+    std::unordered_map<const ASTNode*, TypePtr> types_;
+};
+
+} // namespace istudio::semantic
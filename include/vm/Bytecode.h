@@ -0,0 +1,116 @@
+#pragma once
+
+#include "vm/Value.h"
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace istudio::vm {
+
+// Register machine opcodes. Operands are register numbers of the current frame
+// unless noted; `bx` is the 32-bit operand formed by b and c.
+//   arithmetic, comparison  a = b <op> c        (the ...I forms take ints only)
+//   Neg, Not, Move          a = <op> b
+//   LoadK                   a = constants[bx]
+//   Jump                    pc = bx
+//   JumpIf, JumpIfNot       if (a is truthy / falsy) pc = bx
+//   Call                    a = call of calls[bx]
+//   TailCall                return call of calls[bx], run in this frame
+//   Return                  return a
+// The order is the order of the interpreter's dispatch table.
+#define ISTUDIO_VM_OPCODES(X) \
+    X(Move)                   \
+    X(LoadK)                  \
+    X(AddI)                   \
+    X(SubI)                   \
+    X(MulI)                   \
+    X(EqI)                    \
+    X(NeI)                    \
+    X(LtI)                    \
+    X(LeI)                    \
+    X(GtI)                    \
+    X(GeI)                    \
+    X(Add)                    \
+    X(Sub)                    \
+    X(Mul)                    \
+    X(Div)                    \
+    X(Rem)                    \
+    X(And)                    \
+    X(Or)                     \
+    X(Xor)                    \
+    X(Shl)                    \
+    X(Shr)                    \
+    X(Eq)                     \
+    X(Ne)                     \
+    X(Lt)                     \
+    X(Le)                     \
+    X(Gt)                     \
+    X(Ge)                     \
+    X(Neg)                    \
+    X(Not)                    \
+    X(Jump)                   \
+    X(JumpIf)                 \
+    X(JumpIfNot)              \
+    X(Call)                   \
+    X(TailCall)               \
+    X(Return)                 \
+    X(ReturnVoid)
+
+enum class Opcode : std::uint8_t {
+#define ISTUDIO_VM_ENUM(name) name,
+    ISTUDIO_VM_OPCODES(ISTUDIO_VM_ENUM)
+#undef ISTUDIO_VM_ENUM
+};
+
+const char* toString(Opcode op);
+
+struct Instruction {
+    Opcode op;
+    std::uint16_t a{0};
+    std::uint16_t b{0};
+    std::uint16_t c{0};
+
+    [[nodiscard]] std::uint32_t bx() const { return b | (static_cast<std::uint32_t>(c) << 16); }
+    void setBx(std::uint32_t value)
+    {
+        b = static_cast<std::uint16_t>(value);
+        c = static_cast<std::uint16_t>(value >> 16);
+    }
+};
+static_assert(sizeof(Instruction) == 8);
+
+// Arguments are passed in `argCount` consecutive registers from `firstArg`, which
+// become the first registers of the callee's frame.
+struct CallSite {
+    std::uint32_t callee{0}; // function index, or intrinsic index when `intrinsic`
+    std::uint16_t firstArg{0};
+    std::uint16_t argCount{0};
+    bool intrinsic{false};
+};
+
+struct Function {
+    std::string name;
+    std::uint16_t params{0};
+    std::uint32_t registers{0};
+    std::vector<Instruction> code;
+    std::vector<Value> constants;
+    std::vector<CallSite> calls;
+};
+
+struct Program {
+    std::vector<Function> functions;
+    std::unordered_map<std::string, std::uint32_t> index;
+
+    [[nodiscard]] const Function* find(const std::string& name) const
+    {
+        const auto it = index.find(name);
+        return it != index.end() ? &functions[it->second] : nullptr;
+    }
+};
+
+void disassemble(const Program& program, std::ostream& out);
+
+} // namespace istudio::vm
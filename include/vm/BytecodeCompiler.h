@@ -0,0 +1,17 @@
+#pragma once
+
+#include "ir/IR.h"
+#include "vm/Bytecode.h"
+
+#include <expected>
+#include <string>
+
+namespace istudio::vm {
+
+// Translates SSA IR into register bytecode. Every argument, instruction result and
+// constant of a function gets its own register; Phis become copies on the incoming
+// edges. Calls resolve to functions of the module first, then to intrinsics. Fails
+// on memory instructions, which lowering does not produce, and on unknown callees.
+std::expected<Program, std::string> compileModule(const ir::IRModule& module);
+
+} // namespace istudio::vm
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "vm/Bytecode.h"
+#include "vm/Intrinsics.h"
+
+#include <expected>
+#include <iostream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace istudio::vm {
+
+// Executes a Program. Frames are windows onto one register stack: a call's
+// arguments are the first registers of the callee's frame, so nothing is copied on
+// entry. Calls do not recurse on the native stack: the caller's position is pushed
+// onto a frame stack and execution continues in the callee, so the depth is bounded
+// by kMaxCallDepth alone, whatever the build. Dispatch is direct-threaded through a
+// table of label addresses where the compiler supports it (GCC, Clang) and a switch
+// elsewhere.
+class Interpreter {
+public:
+    explicit Interpreter(const Program& program, std::ostream& out = std::cout, std::istream& in = std::cin);
+
+    // Runs `entry` and returns its result, or the run-time error that stopped it.
+    std::expected<Value, std::string> run(std::string_view entry = "main", std::span<const Value> args = {});
+
+    static constexpr std::size_t kMaxCallDepth = 10000;
+
+private:
+    // Where a caller resumes: the Call instruction whose result register receives
+    // the callee's return value.
+    struct Frame {
+        const Function* function;
+        std::size_t base;
+        const Instruction* call;
+    };
+
+    Value execute(const Function& entry);
+
+    const Program& program_;
+    Runtime runtime_;
+    std::vector<Value> stack_;
+    std::vector<Frame> frames_;
+};
+
+} // namespace istudio::vm
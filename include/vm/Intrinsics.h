@@ -0,0 +1,37 @@
+#pragma once
+
+#include "vm/Value.h"
+
+#include <istream>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+namespace istudio::vm {
+
+// Raised by the interpreter and intrinsics when a program fails at run time.
+class RuntimeError : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+// Where a running program's I/O goes.
+struct Runtime {
+    std::ostream& out;
+    std::istream& in;
+};
+
+// A native implementation of a standard library function (core_io, core_math,
+// core_collections). Functions defined by the program take precedence.
+struct Intrinsic {
+    std::string_view name;
+    Value (*call)(std::span<const Value> args, Runtime& runtime);
+};
+
+const std::vector<Intrinsic>& intrinsics();
+std::optional<std::uint32_t> findIntrinsic(std::string_view name);
+
+} // namespace istudio::vm
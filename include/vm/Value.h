@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <variant>
+#include <vector>
+
+namespace istudio::vm {
+
+struct List;
+struct Dict;
+
+// A runtime value. Scalars are held inline; lists and dictionaries are shared, so
+// passing one to a function passes a reference, as in the generated Java and Python.
+using Value = std::variant<std::monostate, bool, std::int64_t, double, std::string, std::shared_ptr<List>,
+                           std::shared_ptr<Dict>>;
+
+struct List {
+    std::vector<Value> items;
+};
+
+// Keys are compared by their printed form, so 1 and "1" name the same entry.
+struct Dict {
+    std::map<std::string, Value> entries;
+};
+
+[[nodiscard]] inline bool isNull(const Value& value) { return std::holds_alternative<std::monostate>(value); }
+[[nodiscard]] inline bool isNumber(const Value& value)
+{
+    return std::holds_alternative<std::int64_t>(value) || std::holds_alternative<double>(value);
+}
+// Numeric value of an int or float; 0 for anything else.
+[[nodiscard]] double toDouble(const Value& value);
+[[nodiscard]] bool isTruthy(const Value& value);
+[[nodiscard]] std::string toString(const Value& value);
+[[nodiscard]] const char* typeName(const Value& value);
+
+} // namespace istudio::vm
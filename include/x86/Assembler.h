@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace istudio::x86 {
+
+// General purpose registers in encoding order.
+enum class Reg : std::uint8_t {
+    Rax,
+    Rcx,
+    Rdx,
+    Rbx,
+    Rsp,
+    Rbp,
+    Rsi,
+    Rdi,
+    R8,
+    R9,
+    R10,
+    R11,
+    R12,
+    R13,
+    R14,
+    R15
+};
+
+const char* toString(Reg reg);
+
+// Condition codes, as encoded in Jcc and SETcc.
+enum class Cond : std::uint8_t {
+    Equal = 0x4,
+    NotEqual = 0x5,
+    Less = 0xC,
+    GreaterEqual = 0xD,
+    LessEqual = 0xE,
+    Greater = 0xF
+};
+
+// A register, or the 64-bit stack slot at [rbp + disp].
+struct Operand {
+    bool isMemory{false};
+    Reg reg{Reg::Rax};
+    std::int32_t disp{0};
+
+    static Operand r(Reg reg) { return {false, reg, 0}; }
+    static Operand frame(std::int32_t disp) { return {true, Reg::Rbp, disp}; }
+    bool operator==(const Operand&) const = default;
+};
+
+// A 32-bit PC-relative field the linker (or the JIT) fills in: the target is a
+// function by name, or an offset into the read-only data.
+struct Relocation {
+    enum class Kind { Call, Data };
+
+    std::size_t offset{0}; // of the 4-byte field within the code
+    Kind kind{Kind::Call};
+    std::string symbol;    // for Call
+    std::int64_t addend{0};
+};
+
+// Encodes the handful of 64-bit instructions the code generator needs. Jumps go to
+// labels and are resolved by finish(); every instruction with a 32-bit
+// displacement uses it, so no branch has to be relaxed.
+class Assembler {
+public:
+    using Label = std::uint32_t;
+
+    enum class Alu : std::uint8_t { Add = 0, Or = 1, And = 4, Sub = 5, Xor = 6, Cmp = 7 };
+
+    Label newLabel();
+    void bind(Label label);
+
+    void mov(Operand dst, Reg src);
+    void mov(Reg dst, Operand src);
+    void movImm(Reg dst, std::int64_t value);
+    void movAbs(Reg dst, std::uint64_t value); // always the 10-byte form, so it can be patched
+    void alu(Alu op, Reg dst, Operand src);
+    void aluImm(Alu op, Reg dst, std::int32_t value);
+    void imul(Reg dst, Operand src);
+    void imulImm(Reg dst, Reg src, std::int32_t value);
+    void cqo();
+    void idiv(Reg divisor);
+    void neg(Reg reg);
+    void shlCl(Reg reg);
+    void sarCl(Reg reg);
+    void test(Reg a, Reg b);
+    void setcc(Cond cond); // al = cond; then zero-extends into rax
+    void push(Reg reg);
+    void pop(Reg reg);
+    void subRsp(std::int32_t bytes);
+    void leaRspFromRbp(std::int32_t disp); // lea rsp, [rbp + disp]
+    void leaData(Reg dst, std::uint32_t dataOffset);
+    void call(const std::string& symbol);
+    void call(Reg target);
+    void jmp(const std::string& symbol);
+    void jmp(Reg target);
+    void jmp(Label label);
+    void jcc(Cond cond, Label label);
+    void ret();
+
+    // Patches every jump; labels must all be bound by now.
+    void finish();
+
+    [[nodiscard]] const std::vector<std::uint8_t>& code() const { return code_; }
+    [[nodiscard]] const std::vector<Relocation>& relocations() const { return relocations_; }
+    [[nodiscard]] std::size_t size() const { return code_.size(); }
+
+private:
+    void byte(std::uint8_t value) { code_.push_back(value); }
+    void imm32(std::int32_t value);
+    void rex(bool wide, unsigned reg, unsigned rm, bool force = false);
+    // ModRM (plus displacement) for `reg` and the r/m operand.
+    void modrm(unsigned reg, Operand rm);
+    void emitOp(std::uint8_t opcode, unsigned reg, Operand rm);
+    void emitOp2(std::uint8_t opcode, unsigned reg, Operand rm); // 0F-prefixed
+    void labelRef(Label label);
+
+    std::vector<std::uint8_t> code_;
+    std::vector<Relocation> relocations_;
+    std::vector<std::int64_t> labels_; // code offset, -1 while unbound
+    std::vector<std::pair<std::size_t, Label>> fixups_;
+};
+
+} // namespace istudio::x86
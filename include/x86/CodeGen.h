@@ -0,0 +1,57 @@
+#pragma once
+
+#include "ir/IR.h"
+#include "x86/Assembler.h"
+
+#include <cstdint>
+#include <expected>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace istudio::x86 {
+
+// Machine code for one or more functions, not yet placed in memory: calls and
+// string constants are left as relocations against function names and `rodata`.
+struct ObjectCode {
+    struct Symbol {
+        std::string name;
+        std::size_t offset{0};
+        std::size_t size{0};
+    };
+
+    std::vector<std::uint8_t> text;
+    std::vector<std::uint8_t> rodata;
+    std::vector<Symbol> functions;
+    std::vector<Relocation> relocations; // offsets into `text`
+
+    // Offset of a NUL-terminated copy of `text` in rodata, shared between equal strings.
+    std::uint32_t addString(std::string_view value);
+};
+
+// Called by a failed runtime check with a NUL-terminated message; it does not
+// return. Not a valid IPL name, so it cannot clash with a module function.
+inline constexpr std::string_view kTrapSymbol = "istudio.trap";
+
+// Checks for faults the bytecode VM reports as runtime errors, for hosts that
+// provide kTrapSymbol (the JIT). Without them the fault is the processor's.
+struct RuntimeChecks {
+    bool divisionByZero{false};
+    // Lowest address rsp may hold once a function has set up its frame; 0 disables
+    // the check.
+    std::uint64_t stackLimit{0};
+};
+
+// Compiles `function` for the System V x86-64 ABI and appends it to `object`.
+// Int and Bool values are supported; calls go to functions of `module` or to the
+// few core_io and core_math functions the C library can stand in for (print,
+// println, printNumber, abs). Anything else is reported as unsupported.
+std::expected<void, std::string> compileFunction(const ir::IRFunction& function, const ir::IRModule& module,
+                                                 ObjectCode& object, const RuntimeChecks& checks = {});
+
+// Whether compileFunction would accept `function`, without generating any code.
+std::expected<void, std::string> checkFunction(const ir::IRFunction& function, const ir::IRModule& module);
+
+std::expected<ObjectCode, std::string> compileModule(const ir::IRModule& module);
+
+} // namespace istudio::x86
@@ -0,0 +1,15 @@
+#pragma once
+
+#include "x86/CodeGen.h"
+
+#include <ostream>
+
+namespace istudio::x86 {
+
+// Writes `object` as a relocatable ELF64 x86-64 file (.o) that the system linker
+// accepts: .text with a global symbol per function, .rodata, and .rela.text with
+// PLT32 relocations for calls and PC32 ones for string constants. Callees the
+// object does not define are left undefined for the linker to resolve.
+void writeElfObject(const ObjectCode& object, std::ostream& out);
+
+} // namespace istudio::x86
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "ir/IR.h"
+
+#include <csetjmp>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace istudio::x86 {
+
+// Runs a module in-process as native code. Every function starts out as a small
+// stub in an mmap'd code region; the first call through a stub compiles the
+// function, patches the stub to jump straight to it and continues there, so only
+// functions that actually run are compiled. Pages are writable only while code is
+// being placed and executable otherwise.
+//
+// Code is compiled with the runtime checks of the bytecode VM: a zero divisor,
+// or a call that would exhaust the native stack, ends the run with the same
+// error the VM reports instead of a signal.
+//
+// Only x86-64 hosts with mmap (Linux and other POSIX systems) are supported;
+// isSupported() says whether this build can JIT at all.
+class Jit {
+public:
+    explicit Jit(const ir::IRModule& module);
+    ~Jit();
+    Jit(const Jit&) = delete;
+    Jit& operator=(const Jit&) = delete;
+
+    static bool isSupported();
+
+    // Checks that every function can be compiled, so no call fails halfway through
+    // a run.
+    std::expected<void, std::string> prepare();
+
+    // Calls `entry`, which must take no parameters, and returns its result, or the
+    // runtime error that stopped it.
+    std::expected<std::int64_t, std::string> run(std::string_view entry = "main");
+
+    [[nodiscard]] std::size_t compiledFunctions() const { return compiled_; }
+
+private:
+    static std::uint64_t resolve(Jit* jit, std::uint64_t index) noexcept;
+    [[noreturn]] static void trap(const char* message, Jit* jit) noexcept;
+
+    std::uint8_t* allocate(std::size_t size, std::size_t alignment);
+    void beginWrite();
+    void endWrite();
+    void writeTrampoline();
+    std::uint8_t* createStub(std::uint64_t index);
+    std::uint8_t* externalStub(const std::string& symbol);
+    std::uint8_t* trapStub();
+    std::uint8_t* compile(std::size_t index);
+
+    const ir::IRModule& module_;
+    std::uint8_t* region_{nullptr};
+    std::size_t capacity_{0};
+    std::size_t used_{0};
+    std::uint8_t* trampoline_{nullptr};
+    std::vector<std::uint8_t*> stubs_; // by function index
+    std::unordered_map<std::string, std::size_t> functions_;
+    std::unordered_map<std::string, std::uint8_t*> externals_;
+    std::uint8_t* trapStub_{nullptr};
+    std::uint64_t stackLimit_{0};
+    std::jmp_buf trapJump_{}; // back into run(), across the JIT frames
+    std::string trapMessage_;
+    std::size_t compiled_{0};
+};
+
+} // namespace istudio::x86
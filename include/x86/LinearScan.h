@@ -0,0 +1,44 @@
+#pragma once
+
+#include "ir/IR.h"
+#include "ir/Liveness.h"
+#include "x86/Assembler.h"
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace istudio::x86 {
+
+// Where a value lives for the whole function: a register, or a stack slot.
+struct Location {
+    enum class Kind : std::uint8_t { None, Register, Stack };
+
+    Kind kind{Kind::None};
+    Reg reg{Reg::Rax};
+    std::uint32_t slot{0};
+
+    bool operator==(const Location&) const = default;
+};
+
+struct Allocation {
+    std::vector<Location> locations; // by IRValue::getId()
+    std::uint32_t stackSlots{0};
+    std::vector<Reg> usedCalleeSaved;
+};
+
+// Registers the allocator may hand out. Values live across a call only get
+// callee-saved ones, so calls need no saves around them.
+struct RegisterPool {
+    std::span<const Reg> callerSaved;
+    std::span<const Reg> calleeSaved;
+};
+
+// Linear-scan allocation (Poletto and Sarkar) over one live interval per value:
+// instructions are numbered in block layout order and each interval is the hull of
+// the value's definition, uses and the blocks it is live through, taken from
+// liveness. When registers run out, the interval ending last is spilled.
+Allocation allocateRegisters(const ir::IRFunction& function, const ir::Liveness& liveness,
+                             const RegisterPool& pool);
+
+} // namespace istudio::x86
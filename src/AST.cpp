@@ -14,6 +14,16 @@ void ProgramNode::print(int indent) const {
 void FunctionNode::print(int indent) const {
     for (int i = 0; i < indent; i++) std::cout << "  ";
     std::cout << "Function: " << return_type_ << ' ' << name_;
+    if (!template_parameters_.empty()) {
+        std::cout << '<';
+        for (size_t i = 0; i < template_parameters_.size(); ++i) {
+            std::cout << (i > 0 ? ", " : "") << template_parameters_[i].name;
+            if (!template_parameters_[i].constraint.empty()) {
+                std::cout << ": " << template_parameters_[i].constraint;
+            }
+        }
+        std::cout << '>';
+    }
     std::ostringstream params;
     for (size_t i = 0; i < parameters_.size(); ++i) {
         params << parameters_[i].type << ' ' << parameters_[i].name;
@@ -29,7 +39,7 @@ void FunctionNode::print(int indent) const {
 
 void VariableDeclarationNode::print(int indent) const {
     for (int i = 0; i < indent; i++) std::cout << "  ";
-    std::cout << "VariableDeclaration: " << type_ << ' ' << name_ << "\n";
+    std::cout << "VariableDeclaration: " << (constant_ ? "const " : "") << type_ << ' ' << name_ << "\n";
     if (initializer_) {
         initializer_->print(indent + 1);
     }
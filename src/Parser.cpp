@@ -60,6 +60,37 @@ std::unique_ptr<ProgramNode> Parser::parse() {
     auto program = std::make_unique<ProgramNode>();
 
     while (position_ < tokens_.size()) {
+        if (currentLexeme() == "module" || currentLexeme() == "import") {
+            // Module and import headers carry no code; the driver resolves stdlib modules itself.
+            while (position_ < tokens_.size() && !matchToken(";")) {
+                advanceToken();
+            }
+            continue;
+        }
+
+        matchKeyword("export");
+        if (currentLexeme() == "template") {
+            auto templateParameters = parseTemplateHeader();
+            if (currentLexeme() == "function" && !templateParameters.empty()) {
+                if (auto function = parseFunction(std::move(templateParameters))) {
+                    program->addFunction(std::move(function));
+                    continue;
+                }
+            }
+            hadError_ = true;
+            synchronize();
+            continue;
+        }
+        if (currentLexeme() == "function") {
+            if (auto function = parseFunction()) {
+                program->addFunction(std::move(function));
+                continue;
+            }
+            hadError_ = true;
+            synchronize();
+            continue;
+        }
+
         if (isTypeKeyword(currentLexeme())) {
             if (auto function = parseFunction()) {
                 program->addFunction(std::move(function));
@@ -76,13 +107,36 @@ std::unique_ptr<ProgramNode> Parser::parse() {
     return program;
 }
 
-std::unique_ptr<FunctionNode> Parser::parseFunction()
+std::unique_ptr<FunctionNode> Parser::parseFunction(std::vector<TemplateParameter> templateParameters)
 {
+    // IPL form: function name(params) [: type] { ... }
+    if (matchKeyword("function")) {
+        std::string functionName = getNextToken();
+        if (functionName.empty() || !matchToken("(")) {
+            return nullptr;
+        }
+
+        auto parameters = parseParameterList();
+
+        std::string returnType = "void";
+        if (matchToken(":")) {
+            returnType = parseTypeName();
+        }
+
+        if (!expectLexeme("{")) {
+            return nullptr;
+        }
+
+        auto body = parseBlock();
+        return std::make_unique<FunctionNode>(std::move(returnType), std::move(functionName), std::move(parameters),
+                                              std::move(body), std::move(templateParameters));
+    }
+
     if (!isTypeKeyword(currentLexeme())) {
         return nullptr;
     }
 
-    std::string returnType = getNextToken();
+    std::string returnType = parseTypeName();
     std::string functionName = getNextToken();
 
     if (functionName.empty() || functionName == "(") {
@@ -155,7 +209,7 @@ std::unique_ptr<ASTNode> Parser::parseStatement() {
     }
 
     if (isTypeKeyword(currentLexeme())) {
-        const std::string type = getNextToken();
+        const std::string type = parseTypeName();
         const std::string name = getNextToken();
         if (name.empty()) {
             hadError_ = true;
@@ -324,32 +378,41 @@ std::unique_ptr<ASTNode> Parser::parseFor()
 
 std::unique_ptr<ASTNode> Parser::parseDeclarationLike(const std::string& keyword)
 {
-    (void)keyword;
-
+    // Accepted forms: `let name = e`, `let type name = e`, `let name : type = e` and `let name type = e`;
+    // the typed forms may leave out `= e`.
     std::string type;
-    std::string name = getNextToken();
+    std::string name = parseTypeName();
     if (name.empty()) {
         hadError_ = true;
         return nullptr;
     }
 
-    const auto* lookahead = getCurrentToken();
-    if (lookahead && lookahead->lexeme != "=" && lookahead->lexeme != ";") {
-        type = std::move(name);
-        name = getNextToken();
+    if (matchToken(":")) {
+        type = parseTypeName();
+    } else if (currentLexeme() != "=" && currentLexeme() != ";") {
+        std::string second = parseTypeName();
+        if (!isTypeKeyword(name) && isTypeKeyword(second)) {
+            type = std::move(second);
+        } else {
+            type = std::move(name);
+            name = std::move(second);
+        }
     }
 
-    if (!matchToken("=")) {
+    // The initializer may only be omitted when the type is spelled out (`let int x;`).
+    std::unique_ptr<ASTNode> initializer;
+    if (matchToken("=")) {
+        initializer = parseExpression();
+    } else if (type.empty()) {
         hadError_ = true;
         return nullptr;
     }
 
-    auto initializer = parseExpression();
     if (!expectLexeme(";")) {
         hadError_ = true;
         return nullptr;
     }
-    return std::make_unique<VariableDeclarationNode>(type, name, std::move(initializer));
+    return std::make_unique<VariableDeclarationNode>(type, name, std::move(initializer), keyword != "let");
 }
 
 std::unique_ptr<ASTNode> Parser::parseExpression() {
@@ -461,7 +524,7 @@ std::unique_ptr<ASTNode> Parser::parseFactor() {
 std::unique_ptr<ASTNode> Parser::parseUnary()
 {
     const std::string op = currentLexeme();
-    if (op == "!" || op == "-" || op == "+") {
+    if (op == "!" || op == "-" || op == "+" || op == "move") {
         getNextToken();
         auto operand = parseUnary();
         return std::make_unique<UnaryOperationNode>(op, std::move(operand));
@@ -534,12 +597,38 @@ std::unique_ptr<ASTNode> Parser::parsePrimary()
     return nullptr;
 }
 
+std::vector<TemplateParameter> Parser::parseTemplateHeader()
+{
+    // template = "template" "<" identifier [ ":" identifier ] { "," ... } ">"
+    std::vector<TemplateParameter> parameters;
+    if (!matchKeyword("template") || !matchToken("<")) {
+        return parameters;
+    }
+
+    while (position_ < tokens_.size() && currentLexeme() != ">") {
+        TemplateParameter parameter{getNextToken(), {}};
+        if (matchToken(":")) {
+            parameter.constraint = getNextToken();
+        }
+        parameters.push_back(std::move(parameter));
+        if (!matchToken(",")) {
+            break;
+        }
+    }
+
+    if (!matchToken(">")) {
+        parameters.clear();
+    }
+    return parameters;
+}
+
 std::vector<FunctionParameter> Parser::parseParameterList()
 {
     std::vector<FunctionParameter> parameters;
 
     while (position_ < tokens_.size() && currentLexeme() != ")") {
-        std::string type = getNextToken();
+        matchKeyword("const");
+        std::string type = parseTypeName();
         std::string name = getNextToken();
         if (type.empty() || name.empty()) {
             break;
@@ -556,6 +645,39 @@ std::vector<FunctionParameter> Parser::parseParameterList()
     return parameters;
 }
 
+std::string Parser::parseTypeName()
+{
+    // type = [ "owned" | "borrowed" | "ref" ] identifier [ "<" type { "," type } ">" ] [ "?" ]
+    std::string type = getNextToken();
+    if ((type == "owned" || type == "borrowed" || type == "ref") && currentLexeme() != "<") {
+        type += ' ' + getNextToken();
+    }
+
+    if (currentLexeme() == "<") {
+        type += getNextToken();
+        int depth = 1;
+        while (position_ < tokens_.size() && depth > 0) {
+            const std::string lexeme = getNextToken();
+            if (lexeme == "<") {
+                ++depth;
+            } else if (lexeme == ">") {
+                --depth;
+            } else if (lexeme == ">>") {
+                depth -= 2; // `list<list<int>>`
+            }
+            type += lexeme;
+            if (lexeme == ",") {
+                type += ' ';
+            }
+        }
+    }
+
+    if (currentLexeme() == "?") {
+        type += getNextToken();
+    }
+    return type;
+}
+
 bool Parser::isTypeKeyword(const std::string& token) const
 {
     static const std::vector<std::string> kTypeKeywords = {
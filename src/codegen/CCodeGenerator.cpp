@@ -1,4 +1,4 @@
-#include \"CCodeGenerator.h\"
+#include "codegen/CCodeGenerator.h"
 #include <sstream>
 #include <string>
 #include <vector>
@@ -7,8 +7,11 @@ namespace istudio {
 namespace codegen {
 
 std::string CCodeGenerator::generate(const ASTNode& node) {
+    if (const auto folded = foldedLiteral(node)) {
+        return generateLiteral(LiteralNode(*folded));
+    }
     std::ostringstream oss;
-    output_.str(\"\"); // Clear the stream
+    output_.str(""); // Clear the stream
     output_.clear(); // Clear any error flags
     
     switch (node.getType()) {
@@ -43,7 +46,7 @@ std::string CCodeGenerator::generate(const ASTNode& node) {
         case ASTNodeType::For:
             return generateFor(static_cast<const ForNode&>(node));
         default:
-            return \"// Unsupported node type in C code generation\\n\";
+            return "// Unsupported node type in C code generation\n";
     }
 }
 
@@ -51,14 +54,22 @@ std::string CCodeGenerator::generateProgram(const ProgramNode& program) {
     std::ostringstream oss;
     
     // Add standard headers
-    oss << \"#include <stdio.h>\\n\";
-    oss << \"#include <stdlib.h>\\n\\n\";
+    oss << "#include <stdio.h>\n";
+    oss << "#include <stdlib.h>\n\n";
     
     // Generate each function in the program
     for (const auto& func : program.getFunctions()) {
-        if (func) {
-            oss << generate(*func) << \"\\n\";
+        if (!func) {
+            continue;
+        }
+        const auto& function = static_cast<const FunctionNode&>(*func);
+        if (function.isTemplate()) {
+            for (const auto& copy : generateInstances(function)) {
+                oss << copy << "\n";
+            }
+            continue;
         }
+        oss << generate(*func) << "\n";
     }
     
     return oss.str();
@@ -68,47 +79,47 @@ std::string CCodeGenerator::generateFunction(const FunctionNode& function) {
     std::ostringstream oss;
     
     // Map IPL return type to C type
-    std::string cReturnType = function.getReturnType();
-    if (cReturnType == \"int\") {
-        cReturnType = \"int\";
-    } else if (cReturnType == \"float\") {
-        cReturnType = \"float\";
-    } else if (cReturnType == \"double\") {
-        cReturnType = \"double\";
-    } else if (cReturnType == \"bool\") {
-        cReturnType = \"int\"; // C doesn't have bool by default
-    } else if (cReturnType == \"string\" || cReturnType == \"char*\") {
-        cReturnType = \"char*\";
-    } else if (cReturnType == \"void\") {
-        cReturnType = \"void\";
+    std::string cReturnType = instantiatedTypeName(function.getReturnType());
+    if (cReturnType == "int") {
+        cReturnType = "int";
+    } else if (cReturnType == "float") {
+        cReturnType = "float";
+    } else if (cReturnType == "double") {
+        cReturnType = "double";
+    } else if (cReturnType == "bool") {
+        cReturnType = "int"; // C doesn't have bool by default
+    } else if (cReturnType == "string" || cReturnType == "char*") {
+        cReturnType = "char*";
+    } else if (cReturnType == "void") {
+        cReturnType = "void";
     } else {
         // Default to int for unknown types
-        cReturnType = \"int\";
+        cReturnType = "int";
     }
     
-    oss << cReturnType << \" \" << function.getName() << \"(\";
+    oss << cReturnType << " " << functionName(function) << "(";
     
     // Generate parameters
     const auto& params = function.getParameters();
     for (size_t i = 0; i < params.size(); ++i) {
-        if (i > 0) oss << \", \";
+        if (i > 0) oss << ", ";
         
         // Map IPL parameter type to C type
-        std::string cParamType = params[i].type;
-        if (cParamType == \"int\" || cParamType == \"float\" || cParamType == \"double\" || 
-            cParamType == \"bool\" || cParamType == \"string\" || cParamType == \"char*\") {
-            if (cParamType == \"bool\") cParamType = \"int\";
-            else if (cParamType == \"string\") cParamType = \"char*\";
+        std::string cParamType = instantiatedTypeName(semantic::stripOwnership(params[i].type));
+        if (cParamType == "int" || cParamType == "float" || cParamType == "double" || 
+            cParamType == "bool" || cParamType == "string" || cParamType == "char*") {
+            if (cParamType == "bool") cParamType = "int";
+            else if (cParamType == "string") cParamType = "char*";
         }
         
-        oss << cParamType << \" \" << params[i].name;
+        oss << cParamType << " " << params[i].name;
     }
-    oss << \")\";
+    oss << ")";
     
     if (function.getBody()) {
-        oss << \"\\n\" << generate(*function.getBody());
+        oss << "\n" << generate(*function.getBody());
     } else {
-        oss << \"; // Function declaration\\n\";
+        oss << "; // Function declaration\n";
     }
     
     return oss.str();
@@ -118,44 +129,47 @@ std::string CCodeGenerator::generateVariableDeclaration(const VariableDeclaratio
     std::ostringstream oss;
     
     // Map IPL type to C type
-    std::string cType = varDecl.getTypeName();
-    if (cType == \"int\" || cType == \"float\" || cType == \"double\") {
+    std::string cType(semantic::stripOwnership(declaredTypeName(varDecl)));
+    if (cType == "int" || cType == "float" || cType == "double") {
         // Types already match
-    } else if (cType == \"bool\") {
-        cType = \"int\"; // C doesn't have bool by default
-    } else if (cType == \"string\") {
-        cType = \"char*\";
+    } else if (cType == "bool") {
+        cType = "int"; // C doesn't have bool by default
+    } else if (cType == "string") {
+        cType = "char*";
     } else {
         // Default to int for unknown types
-        cType = \"int\";
+        cType = "int";
     }
     
-    oss << cType << \" \" << varDecl.getName();
+    oss << cType << " " << varDecl.getName();
     
     if (varDecl.getInitializer()) {
-        oss << \" = \" << generate(*varDecl.getInitializer());
+        oss << " = " << generate(*varDecl.getInitializer());
     }
-    oss << \";\";
+    oss << ";";
     
     return oss.str();
 }
 
 std::string CCodeGenerator::generateAssignment(const AssignmentNode& assignment) {
     std::ostringstream oss;
-    oss << assignment.getVariable() << \" = \" << generate(*assignment.getValue()) << \";\";
+    oss << assignment.getVariable() << " = " << generate(*assignment.getValue()) << ";";
     return oss.str();
 }
 
 std::string CCodeGenerator::generateBinaryOperation(const BinaryOperationNode& binOp) {
     std::ostringstream oss;
-    oss << \"(\" << generate(*binOp.getLeft()) << \" \" << binOp.getOperator() << \" \" 
-        << generate(*binOp.getRight()) << \")\";
+    oss << "(" << generate(*binOp.getLeft()) << " " << binOp.getOperator() << " " 
+        << generate(*binOp.getRight()) << ")";
     return oss.str();
 }
 
 std::string CCodeGenerator::generateUnaryOperation(const UnaryOperationNode& unaryOp) {
     std::ostringstream oss;
-    oss << unaryOp.getOperator() << \"(\" << generate(*unaryOp.getOperand()) << \")\";
+    if (unaryOp.getOperator() == "move") {
+        return generate(*unaryOp.getOperand()); // ownership transfer is implicit here
+    }
+    oss << unaryOp.getOperator() << "(" << generate(*unaryOp.getOperand()) << ")";
     return oss.str();
 }
 
@@ -163,16 +177,20 @@ std::string CCodeGenerator::generateCallExpression(const CallExpressionNode& cal
     std::ostringstream oss;
     
     if (call.getCallee()) {
-        oss << generate(*call.getCallee()) << \"(\";
+        if (const auto* instance = calledInstance(call)) {
+            oss << instance->mangledName << "(";
+        } else {
+            oss << generate(*call.getCallee()) << "(";
+        }
         
         const auto& args = call.getArguments();
         for (size_t i = 0; i < args.size(); ++i) {
-            if (i > 0) oss << \", \";
+            if (i > 0) oss << ", ";
             if (args[i]) {
                 oss << generate(*args[i]);
             }
         }
-        oss << \")\";
+        oss << ")";
     }
     
     return oss.str();
@@ -190,26 +208,26 @@ std::string CCodeGenerator::generateIdentifier(const IdentifierNode& identifier)
 
 std::string CCodeGenerator::generateBlock(const BlockNode& block) {
     std::ostringstream oss;
-    oss << \" {\\n\";
+    oss << " {\n";
     
     for (const auto& stmt : block.getStatements()) {
         if (stmt) {
-            oss << \"    \" << generate(*stmt) << \"\\n\";
+            oss << "    " << generate(*stmt) << "\n";
         }
     }
     
-    oss << \"}\";
+    oss << "}";
     return oss.str();
 }
 
 std::string CCodeGenerator::generateReturn(const ReturnNode& ret) {
     std::ostringstream oss;
-    oss << \"return\";
+    oss << "return";
     
     if (ret.getValue()) {
-        oss << \" \" << generate(*ret.getValue());
+        oss << " " << generate(*ret.getValue());
     }
-    oss << \";\";
+    oss << ";";
     
     return oss.str();
 }
@@ -217,26 +235,29 @@ std::string CCodeGenerator::generateReturn(const ReturnNode& ret) {
 std::string CCodeGenerator::generateExpressionStatement(const ExpressionStatementNode& exprStmt) {
     std::ostringstream oss;
     if (exprStmt.getExpression()) {
-        oss << generate(*exprStmt.getExpression()) << \";\";
+        oss << generate(*exprStmt.getExpression()) << ";";
     }
     return oss.str();
 }
 
 std::string CCodeGenerator::generateIf(const IfNode& ifNode) {
+    if (const auto taken = prunedBranch(ifNode)) {
+        return *taken ? generate(**taken) : std::string{};
+    }
     std::ostringstream oss;
-    oss << \"if (\";
+    oss << "if (";
     
     if (ifNode.getCondition()) {
         oss << generate(*ifNode.getCondition());
     }
-    oss << \")\";
+    oss << ")";
     
     if (ifNode.getThenBranch()) {
-        oss << \" \" << generate(*ifNode.getThenBranch());
+        oss << " " << generate(*ifNode.getThenBranch());
     }
     
     if (ifNode.getElseBranch()) {
-        oss << \" else \" << generate(*ifNode.getElseBranch());
+        oss << " else " << generate(*ifNode.getElseBranch());
     }
     
     return oss.str();
@@ -244,15 +265,15 @@ std::string CCodeGenerator::generateIf(const IfNode& ifNode) {
 
 std::string CCodeGenerator::generateWhile(const WhileNode& whileNode) {
     std::ostringstream oss;
-    oss << \"while (\";
+    oss << "while (";
     
     if (whileNode.getCondition()) {
         oss << generate(*whileNode.getCondition());
     }
-    oss << \")\";
+    oss << ")";
     
     if (whileNode.getBody()) {
-        oss << \" \" << generate(*whileNode.getBody());
+        oss << " " << generate(*whileNode.getBody());
     }
     
     return oss.str();
@@ -260,27 +281,27 @@ std::string CCodeGenerator::generateWhile(const WhileNode& whileNode) {
 
 std::string CCodeGenerator::generateFor(const ForNode& forNode) {
     std::ostringstream oss;
-    oss << \"for (\";
+    oss << "for (";
     
     if (forNode.getInit()) {
-        oss << generate(*forNode.getInit()) << \" \";
+        oss << generate(*forNode.getInit()) << " ";
     } else {
-        oss << \"; \";
+        oss << "; ";
     }
     
     if (forNode.getCondition()) {
-        oss << generate(*forNode.getCondition()) << \" \";
+        oss << generate(*forNode.getCondition()) << " ";
     } else {
-        oss << \"; \";
+        oss << "; ";
     }
     
     if (forNode.getIncrement()) {
         oss << generate(*forNode.getIncrement());
     }
-    oss << \")\";
+    oss << ")";
     
     if (forNode.getBody()) {
-        oss << \" \" << generate(*forNode.getBody());
+        oss << " " << generate(*forNode.getBody());
     }
     
     return oss.str();
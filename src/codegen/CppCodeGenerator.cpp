@@ -1,4 +1,4 @@
-#include \"CppCodeGenerator.h\"
+#include "codegen/CppCodeGenerator.h"
 #include <sstream>
 #include <string>
 #include <vector>
@@ -6,9 +6,28 @@
 namespace istudio {
 namespace codegen {
 
+namespace {
+
+// owned<T> is a T held by value; borrowed<T> and ref<T> bind to the caller's object.
+std::string withOwnership(const std::string& iplType, std::string cppType) {
+    switch (semantic::ownershipOf(iplType)) {
+        case semantic::OwnershipKind::Borrowed:
+            return "const " + cppType + "&";
+        case semantic::OwnershipKind::Reference:
+            return cppType + "&";
+        default:
+            return cppType;
+    }
+}
+
+} // namespace
+
 std::string CppCodeGenerator::generate(const ASTNode& node) {
+    if (const auto folded = foldedLiteral(node)) {
+        return generateLiteral(LiteralNode(*folded));
+    }
     std::ostringstream oss;
-    output_.str(\"\"); // Clear the stream
+    output_.str(""); // Clear the stream
     output_.clear(); // Clear any error flags
     
     switch (node.getType()) {
@@ -43,7 +62,7 @@ std::string CppCodeGenerator::generate(const ASTNode& node) {
         case ASTNodeType::For:
             return generateFor(static_cast<const ForNode&>(node));
         default:
-            return \"// Unsupported node type in C++ code generation\\n\";
+            return "// Unsupported node type in C++ code generation\n";
     }
 }
 
@@ -51,16 +70,25 @@ std::string CppCodeGenerator::generateProgram(const ProgramNode& program) {
     std::ostringstream oss;
     
     // Add standard headers
-    oss << \"#include <iostream>\\n\";
-    oss << \"#include <string>\\n\";
-    oss << \"#include <vector>\\n\";
-    oss << \"\\nusing namespace std;\\n\\n\";
+    oss << "#include <iostream>\n";
+    oss << "#include <string>\n";
+    oss << "#include <utility>\n";
+    oss << "#include <vector>\n";
+    oss << "\nusing namespace std;\n\n";
     
     // Generate each function in the program
     for (const auto& func : program.getFunctions()) {
-        if (func) {
-            oss << generate(*func) << \"\\n\";
+        if (!func) {
+            continue;
         }
+        const auto& function = static_cast<const FunctionNode&>(*func);
+        if (function.isTemplate()) {
+            for (const auto& copy : generateInstances(function)) {
+                oss << copy << "\n";
+            }
+            continue;
+        }
+        oss << generate(*func) << "\n";
     }
     
     return oss.str();
@@ -70,37 +98,37 @@ std::string CppCodeGenerator::generateFunction(const FunctionNode& function) {
     std::ostringstream oss;
     
     // Map IPL return type to C++ type
-    std::string cppReturnType = function.getReturnType();
-    if (cppReturnType == \"int\" || cppReturnType == \"float\" || cppReturnType == \"double\" || 
-        cppReturnType == \"bool\" || cppReturnType == \"string\" || cppReturnType == \"void\") {
+    std::string cppReturnType = instantiatedTypeName(function.getReturnType());
+    if (cppReturnType == "int" || cppReturnType == "float" || cppReturnType == "double" || 
+        cppReturnType == "bool" || cppReturnType == "string" || cppReturnType == "void") {
         // Types already match C++
     } else {
         // Default to int for unknown types
-        cppReturnType = \"int\";
+        cppReturnType = "int";
     }
     
-    oss << cppReturnType << \" \" << function.getName() << \"(\";
+    oss << cppReturnType << " " << functionName(function) << "(";
     
     // Generate parameters
     const auto& params = function.getParameters();
     for (size_t i = 0; i < params.size(); ++i) {
-        if (i > 0) oss << \", \";
+        if (i > 0) oss << ", ";
         
         // Map IPL parameter type to C++ type
-        std::string cppParamType = params[i].type;
-        if (cppParamType == \"int\" || cppParamType == \"float\" || cppParamType == \"double\" || 
-            cppParamType == \"bool\" || cppParamType == \"string\" || cppParamType == \"char*\") {
-            if (cppParamType == \"char*\") cppParamType = \"string\";  // Use std::string instead of char*
+        std::string cppParamType = instantiatedTypeName(semantic::stripOwnership(params[i].type));
+        if (cppParamType == "int" || cppParamType == "float" || cppParamType == "double" || 
+            cppParamType == "bool" || cppParamType == "string" || cppParamType == "char*") {
+            if (cppParamType == "char*") cppParamType = "string";  // Use std::string instead of char*
         }
         
-        oss << cppParamType << \" \" << params[i].name;
+        oss << withOwnership(params[i].type, cppParamType) << " " << params[i].name;
     }
-    oss << \")\";
+    oss << ")";
     
     if (function.getBody()) {
-        oss << \"\\n\" << generate(*function.getBody());
+        oss << "\n" << generate(*function.getBody());
     } else {
-        oss << \"; // Function declaration\\n\";
+        oss << "; // Function declaration\n";
     }
     
     return oss.str();
@@ -110,43 +138,48 @@ std::string CppCodeGenerator::generateVariableDeclaration(const VariableDeclarat
     std::ostringstream oss;
     
     // Map IPL type to C++ type
-    std::string cppType = varDecl.getTypeName();
-    if (cppType == \"int\" || cppType == \"float\" || cppType == \"double\" || 
-        cppType == \"bool\" || cppType == \"string\") {
+    const std::string iplType = declaredTypeName(varDecl);
+    std::string cppType(semantic::stripOwnership(iplType));
+    if (cppType == "int" || cppType == "float" || cppType == "double" || 
+        cppType == "bool" || cppType == "string") {
         // Types already match C++
-    } else if (cppType == \"char*\") {
-        cppType = \"string\";  // Use std::string instead of char*
+    } else if (cppType == "char*") {
+        cppType = "string";  // Use std::string instead of char*
     } else {
         // Default to int for unknown types
-        cppType = \"int\";
+        cppType = "int";
     }
     
-    oss << cppType << \" \" << varDecl.getName();
+    oss << withOwnership(iplType, cppType) << " " << varDecl.getName();
     
     if (varDecl.getInitializer()) {
-        oss << \" = \" << generate(*varDecl.getInitializer());
+        oss << " = " << generate(*varDecl.getInitializer());
     }
-    oss << \";\";
+    oss << ";";
     
     return oss.str();
 }
 
 std::string CppCodeGenerator::generateAssignment(const AssignmentNode& assignment) {
     std::ostringstream oss;
-    oss << assignment.getVariable() << \" = \" << generate(*assignment.getValue()) << \";\";
+    oss << assignment.getVariable() << " = " << generate(*assignment.getValue()) << ";";
     return oss.str();
 }
 
 std::string CppCodeGenerator::generateBinaryOperation(const BinaryOperationNode& binOp) {
     std::ostringstream oss;
-    oss << \"(\" << generate(*binOp.getLeft()) << \" \" << binOp.getOperator() << \" \" 
-        << generate(*binOp.getRight()) << \")\";
+    oss << "(" << generate(*binOp.getLeft()) << " " << binOp.getOperator() << " " 
+        << generate(*binOp.getRight()) << ")";
     return oss.str();
 }
 
 std::string CppCodeGenerator::generateUnaryOperation(const UnaryOperationNode& unaryOp) {
     std::ostringstream oss;
-    oss << unaryOp.getOperator() << \"(\" << generate(*unaryOp.getOperand()) << \")\";
+    if (unaryOp.getOperator() == "move") {
+        oss << "std::move(" << generate(*unaryOp.getOperand()) << ")";
+        return oss.str();
+    }
+    oss << unaryOp.getOperator() << "(" << generate(*unaryOp.getOperand()) << ")";
     return oss.str();
 }
 
@@ -154,16 +187,20 @@ std::string CppCodeGenerator::generateCallExpression(const CallExpressionNode& c
     std::ostringstream oss;
     
     if (call.getCallee()) {
-        oss << generate(*call.getCallee()) << \"(\";
+        if (const auto* instance = calledInstance(call)) {
+            oss << instance->mangledName << "(";
+        } else {
+            oss << generate(*call.getCallee()) << "(";
+        }
         
         const auto& args = call.getArguments();
         for (size_t i = 0; i < args.size(); ++i) {
-            if (i > 0) oss << \", \";
+            if (i > 0) oss << ", ";
             if (args[i]) {
                 oss << generate(*args[i]);
             }
         }
-        oss << \")\";
+        oss << ")";
     }
     
     return oss.str();
@@ -175,32 +212,36 @@ std::string CppCodeGenerator::generateLiteral(const LiteralNode& literal) {
 }
 
 std::string CppCodeGenerator::generateIdentifier(const IdentifierNode& identifier) {
+    // The last use of an owned value hands it over instead of copying it
+    if (ownership_ && ownership_->isLastUse(identifier)) {
+        return "std::move(" + identifier.getName() + ")";
+    }
     // For identifiers, return the name
     return identifier.getName();
 }
 
 std::string CppCodeGenerator::generateBlock(const BlockNode& block) {
     std::ostringstream oss;
-    oss << \" {\\n\";
+    oss << " {\n";
     
     for (const auto& stmt : block.getStatements()) {
         if (stmt) {
-            oss << \"    \" << generate(*stmt) << \"\\n\";
+            oss << "    " << generate(*stmt) << "\n";
         }
     }
     
-    oss << \"}\";
+    oss << "}";
     return oss.str();
 }
 
 std::string CppCodeGenerator::generateReturn(const ReturnNode& ret) {
     std::ostringstream oss;
-    oss << \"return\";
+    oss << "return";
     
     if (ret.getValue()) {
-        oss << \" \" << generate(*ret.getValue());
+        oss << " " << generate(*ret.getValue());
     }
-    oss << \";\";
+    oss << ";";
     
     return oss.str();
 }
@@ -208,26 +249,29 @@ std::string CppCodeGenerator::generateReturn(const ReturnNode& ret) {
 std::string CppCodeGenerator::generateExpressionStatement(const ExpressionStatementNode& exprStmt) {
     std::ostringstream oss;
     if (exprStmt.getExpression()) {
-        oss << generate(*exprStmt.getExpression()) << \";\";
+        oss << generate(*exprStmt.getExpression()) << ";";
     }
     return oss.str();
 }
 
 std::string CppCodeGenerator::generateIf(const IfNode& ifNode) {
+    if (const auto taken = prunedBranch(ifNode)) {
+        return *taken ? generate(**taken) : std::string{};
+    }
     std::ostringstream oss;
-    oss << \"if (\";
+    oss << "if (";
     
     if (ifNode.getCondition()) {
         oss << generate(*ifNode.getCondition());
     }
-    oss << \")\";
+    oss << ")";
     
     if (ifNode.getThenBranch()) {
-        oss << \" \" << generate(*ifNode.getThenBranch());
+        oss << " " << generate(*ifNode.getThenBranch());
     }
     
     if (ifNode.getElseBranch()) {
-        oss << \" else \" << generate(*ifNode.getElseBranch());
+        oss << " else " << generate(*ifNode.getElseBranch());
     }
     
     return oss.str();
@@ -235,15 +279,15 @@ std::string CppCodeGenerator::generateIf(const IfNode& ifNode) {
 
 std::string CppCodeGenerator::generateWhile(const WhileNode& whileNode) {
     std::ostringstream oss;
-    oss << \"while (\";
+    oss << "while (";
     
     if (whileNode.getCondition()) {
         oss << generate(*whileNode.getCondition());
     }
-    oss << \")\";
+    oss << ")";
     
     if (whileNode.getBody()) {
-        oss << \" \" << generate(*whileNode.getBody());
+        oss << " " << generate(*whileNode.getBody());
     }
     
     return oss.str();
@@ -251,27 +295,27 @@ std::string CppCodeGenerator::generateWhile(const WhileNode& whileNode) {
 
 std::string CppCodeGenerator::generateFor(const ForNode& forNode) {
     std::ostringstream oss;
-    oss << \"for (\";
+    oss << "for (";
     
     if (forNode.getInit()) {
-        oss << generate(*forNode.getInit()) << \" \";
+        oss << generate(*forNode.getInit()) << " ";
     } else {
-        oss << \"; \";
+        oss << "; ";
     }
     
     if (forNode.getCondition()) {
-        oss << generate(*forNode.getCondition()) << \" \";
+        oss << generate(*forNode.getCondition()) << " ";
     } else {
-        oss << \"; \";
+        oss << "; ";
     }
     
     if (forNode.getIncrement()) {
         oss << generate(*forNode.getIncrement());
     }
-    oss << \")\";
+    oss << ")";
     
     if (forNode.getBody()) {
-        oss << \" \" << generate(*forNode.getBody());
+        oss << " " << generate(*forNode.getBody());
     }
     
     return oss.str();
@@ -1,4 +1,4 @@
-#include "GenericCodeGenerator.h"
+#include "codegen/GenericCodeGenerator.h"
 #include <sstream>
 #include <algorithm>
 #include <cctype>
@@ -16,6 +16,9 @@ void GenericCodeGenerator::loadRules(const std::vector<CodeGenerationRule>& rule
 }
 
 std::string GenericCodeGenerator::generate(const ASTNode& node) {
+    if (const auto folded = foldedLiteral(node)) {
+        return generateLiteral(LiteralNode(*folded));
+    }
     std::ostringstream oss;
     output_.str(""); // Clear the stream
     output_.clear(); // Clear any error flags
@@ -151,7 +154,7 @@ std::string GenericCodeGenerator::generateFunction(const FunctionNode& function)
 std::string GenericCodeGenerator::generateVariableDeclaration(const VariableDeclarationNode& varDecl) {
     auto it = rules_.find("VariableDeclaration");
     if (it != rules_.end()) {
-        std::string mappedType = mapType(varDecl.getTypeName());
+        std::string mappedType = mapType(declaredTypeName(varDecl));
         
         std::string initValue = "";
         if (varDecl.getInitializer()) {
@@ -168,7 +171,7 @@ std::string GenericCodeGenerator::generateVariableDeclaration(const VariableDecl
     } else {
         // Default behavior if no rule exists
         std::ostringstream oss;
-        std::string mappedType = mapType(varDecl.getTypeName());
+        std::string mappedType = mapType(declaredTypeName(varDecl));
         
         oss << mappedType << " " << varDecl.getName();
         
@@ -223,6 +226,9 @@ std::string GenericCodeGenerator::generateBinaryOperation(const BinaryOperationN
 }
 
 std::string GenericCodeGenerator::generateUnaryOperation(const UnaryOperationNode& unaryOp) {
+    if (unaryOp.getOperator() == "move") {
+        return generate(*unaryOp.getOperand()); // ownership transfer is implicit here
+    }
     auto it = rules_.find("UnaryOperation");
     if (it != rules_.end()) {
         std::string operandStr = generate(*unaryOp.getOperand());
@@ -367,6 +373,9 @@ std::string GenericCodeGenerator::generateExpressionStatement(const ExpressionSt
 }
 
 std::string GenericCodeGenerator::generateIf(const IfNode& ifNode) {
+    if (const auto taken = prunedBranch(ifNode)) {
+        return *taken ? generate(**taken) : std::string{};
+    }
     auto it = rules_.find("If");
     if (it != rules_.end()) {
         std::string conditionStr = "";
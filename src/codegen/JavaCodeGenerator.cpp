@@ -1,4 +1,4 @@
-#include \"JavaCodeGenerator.h\"
+#include "codegen/JavaCodeGenerator.h"
 #include <sstream>
 #include <string>
 #include <vector>
@@ -7,8 +7,11 @@ namespace istudio {
 namespace codegen {
 
 std::string JavaCodeGenerator::generate(const ASTNode& node) {
+    if (const auto folded = foldedLiteral(node)) {
+        return generateLiteral(LiteralNode(*folded));
+    }
     std::ostringstream oss;
-    output_.str(\"\"); // Clear the stream
+    output_.str(""); // Clear the stream
     output_.clear(); // Clear any error flags
     
     switch (node.getType()) {
@@ -43,7 +46,7 @@ std::string JavaCodeGenerator::generate(const ASTNode& node) {
         case ASTNodeType::For:
             return generateFor(static_cast<const ForNode&>(node));
         default:
-            return \"// Unsupported node type in Java code generation\\n\";
+            return "// Unsupported node type in Java code generation\n";
     }
 }
 
@@ -51,16 +54,24 @@ std::string JavaCodeGenerator::generateProgram(const ProgramNode& program) {
     std::ostringstream oss;
     
     // Create a class to contain all functions
-    oss << \"public class IPLProgram {\\n\\n\";
+    oss << "public class IPLProgram {\n\n";
     
     // Generate each function in the program as a method
     for (const auto& func : program.getFunctions()) {
-        if (func) {
-            oss << \"    \" << generate(*func) << \"\\n\\n\";
+        if (!func) {
+            continue;
+        }
+        const auto& function = static_cast<const FunctionNode&>(*func);
+        if (function.isTemplate()) {
+            for (const auto& copy : generateInstances(function)) {
+                oss << "    " << copy << "\n\n";
+            }
+            continue;
         }
+        oss << "    " << generate(*func) << "\n\n";
     }
     
-    oss << \"}\\n\";
+    oss << "}\n";
     return oss.str();
 }
 
@@ -68,51 +79,51 @@ std::string JavaCodeGenerator::generateFunction(const FunctionNode& function) {
     std::ostringstream oss;
     
     // Map IPL return type to Java type
-    std::string javaReturnType = function.getReturnType();
-    if (javaReturnType == \"int\") {
-        javaReturnType = \"int\";
-    } else if (javaReturnType == \"float\") {
-        javaReturnType = \"float\";
-    } else if (javaReturnType == \"double\") {
-        javaReturnType = \"double\";
-    } else if (javaReturnType == \"bool\") {
-        javaReturnType = \"boolean\";
-    } else if (javaReturnType == \"string\" || javaReturnType == \"String\") {
-        javaReturnType = \"String\";
-    } else if (javaReturnType == \"void\") {
-        javaReturnType = \"void\";
+    std::string javaReturnType = instantiatedTypeName(function.getReturnType());
+    if (javaReturnType == "int") {
+        javaReturnType = "int";
+    } else if (javaReturnType == "float") {
+        javaReturnType = "float";
+    } else if (javaReturnType == "double") {
+        javaReturnType = "double";
+    } else if (javaReturnType == "bool") {
+        javaReturnType = "boolean";
+    } else if (javaReturnType == "string" || javaReturnType == "String") {
+        javaReturnType = "String";
+    } else if (javaReturnType == "void") {
+        javaReturnType = "void";
     } else {
         // Default to int for unknown types
-        javaReturnType = \"int\";
+        javaReturnType = "int";
     }
     
-    oss << \"public static \" << javaReturnType << \" \" << function.getName() << \"(\";
+    oss << "public static " << javaReturnType << " " << functionName(function) << "(";
     
     // Generate parameters
     const auto& params = function.getParameters();
     for (size_t i = 0; i < params.size(); ++i) {
-        if (i > 0) oss << \", \";
+        if (i > 0) oss << ", ";
         
         // Map IPL parameter type to Java type
-        std::string javaParamType = params[i].type;
-        if (javaParamType == \"int\" || javaParamType == \"float\" || javaParamType == \"double\") {
+        std::string javaParamType = instantiatedTypeName(semantic::stripOwnership(params[i].type));
+        if (javaParamType == "int" || javaParamType == "float" || javaParamType == "double") {
             // Types already match
-        } else if (javaParamType == \"bool\") {
-            javaParamType = \"boolean\";
-        } else if (javaParamType == \"string\" || javaParamType == \"String\" || javaParamType == \"char*\") {
-            javaParamType = \"String\";
+        } else if (javaParamType == "bool") {
+            javaParamType = "boolean";
+        } else if (javaParamType == "string" || javaParamType == "String" || javaParamType == "char*") {
+            javaParamType = "String";
         } else {
-            javaParamType = \"int\"; // Default for unknown types
+            javaParamType = "int"; // Default for unknown types
         }
         
-        oss << javaParamType << \" \" << params[i].name;
+        oss << javaParamType << " " << params[i].name;
     }
-    oss << \")\";
+    oss << ")";
     
     if (function.getBody()) {
-        oss << \"\\n\" << generate(*function.getBody());
+        oss << "\n" << generate(*function.getBody());
     } else {
-        oss << \";\";
+        oss << ";";
     }
     
     return oss.str();
@@ -122,44 +133,47 @@ std::string JavaCodeGenerator::generateVariableDeclaration(const VariableDeclara
     std::ostringstream oss;
     
     // Map IPL type to Java type
-    std::string javaType = varDecl.getTypeName();
-    if (javaType == \"int\" || javaType == \"float\" || javaType == \"double\") {
+    std::string javaType(semantic::stripOwnership(declaredTypeName(varDecl)));
+    if (javaType == "int" || javaType == "float" || javaType == "double") {
         // Types already match
-    } else if (javaType == \"bool\") {
-        javaType = \"boolean\";
-    } else if (javaType == \"string\" || javaType == \"String\" || javaType == \"char*\") {
-        javaType = \"String\";
+    } else if (javaType == "bool") {
+        javaType = "boolean";
+    } else if (javaType == "string" || javaType == "String" || javaType == "char*") {
+        javaType = "String";
     } else {
         // Default to int for unknown types
-        javaType = \"int\";
+        javaType = "int";
     }
     
-    oss << javaType << \" \" << varDecl.getName();
+    oss << javaType << " " << varDecl.getName();
     
     if (varDecl.getInitializer()) {
-        oss << \" = \" << generate(*varDecl.getInitializer());
+        oss << " = " << generate(*varDecl.getInitializer());
     }
-    oss << \";\";
+    oss << ";";
     
     return oss.str();
 }
 
 std::string JavaCodeGenerator::generateAssignment(const AssignmentNode& assignment) {
     std::ostringstream oss;
-    oss << assignment.getVariable() << \" = \" << generate(*assignment.getValue()) << \";\";
+    oss << assignment.getVariable() << " = " << generate(*assignment.getValue()) << ";";
     return oss.str();
 }
 
 std::string JavaCodeGenerator::generateBinaryOperation(const BinaryOperationNode& binOp) {
     std::ostringstream oss;
-    oss << \"(\" << generate(*binOp.getLeft()) << \" \" << binOp.getOperator() << \" \" 
-        << generate(*binOp.getRight()) << \")\";
+    oss << "(" << generate(*binOp.getLeft()) << " " << binOp.getOperator() << " " 
+        << generate(*binOp.getRight()) << ")";
     return oss.str();
 }
 
 std::string JavaCodeGenerator::generateUnaryOperation(const UnaryOperationNode& unaryOp) {
     std::ostringstream oss;
-    oss << unaryOp.getOperator() << \"(\" << generate(*unaryOp.getOperand()) << \")\";
+    if (unaryOp.getOperator() == "move") {
+        return generate(*unaryOp.getOperand()); // ownership transfer is implicit here
+    }
+    oss << unaryOp.getOperator() << "(" << generate(*unaryOp.getOperand()) << ")";
     return oss.str();
 }
 
@@ -167,16 +181,20 @@ std::string JavaCodeGenerator::generateCallExpression(const CallExpressionNode&
     std::ostringstream oss;
     
     if (call.getCallee()) {
-        oss << generate(*call.getCallee()) << \"(\";
+        if (const auto* instance = calledInstance(call)) {
+            oss << instance->mangledName << "(";
+        } else {
+            oss << generate(*call.getCallee()) << "(";
+        }
         
         const auto& args = call.getArguments();
         for (size_t i = 0; i < args.size(); ++i) {
-            if (i > 0) oss << \", \";
+            if (i > 0) oss << ", ";
             if (args[i]) {
                 oss << generate(*args[i]);
             }
         }
-        oss << \")\";
+        oss << ")";
     }
     
     return oss.str();
@@ -186,7 +204,7 @@ std::string JavaCodeGenerator::generateLiteral(const LiteralNode& literal) {
     std::string value = literal.getValue();
     
     // Handle string literals in Java (need double quotes)
-    if (value.length() >= 2 && value[0] == '\"' && value[value.length()-1] == '\"') {
+    if (value.length() >= 2 && value[0] == '"' && value[value.length()-1] == '"') {
         return value; // Already properly quoted
     }
     
@@ -200,26 +218,26 @@ std::string JavaCodeGenerator::generateIdentifier(const IdentifierNode& identifi
 
 std::string JavaCodeGenerator::generateBlock(const BlockNode& block) {
     std::ostringstream oss;
-    oss << \" {\\n\";
+    oss << " {\n";
     
     for (const auto& stmt : block.getStatements()) {
         if (stmt) {
-            oss << \"        \" << generate(*stmt) << \"\\n\";
+            oss << "        " << generate(*stmt) << "\n";
         }
     }
     
-    oss << \"    }\";
+    oss << "    }";
     return oss.str();
 }
 
 std::string JavaCodeGenerator::generateReturn(const ReturnNode& ret) {
     std::ostringstream oss;
-    oss << \"return\";
+    oss << "return";
     
     if (ret.getValue()) {
-        oss << \" \" << generate(*ret.getValue());
+        oss << " " << generate(*ret.getValue());
     }
-    oss << \";\";
+    oss << ";";
     
     return oss.str();
 }
@@ -227,26 +245,29 @@ std::string JavaCodeGenerator::generateReturn(const ReturnNode& ret) {
 std::string JavaCodeGenerator::generateExpressionStatement(const ExpressionStatementNode& exprStmt) {
     std::ostringstream oss;
     if (exprStmt.getExpression()) {
-        oss << generate(*exprStmt.getExpression()) << \";\";
+        oss << generate(*exprStmt.getExpression()) << ";";
     }
     return oss.str();
 }
 
 std::string JavaCodeGenerator::generateIf(const IfNode& ifNode) {
+    if (const auto taken = prunedBranch(ifNode)) {
+        return *taken ? generate(**taken) : std::string{};
+    }
     std::ostringstream oss;
-    oss << \"if (\";
+    oss << "if (";
     
     if (ifNode.getCondition()) {
         oss << generate(*ifNode.getCondition());
     }
-    oss << \")\";
+    oss << ")";
     
     if (ifNode.getThenBranch()) {
-        oss << \" \" << generate(*ifNode.getThenBranch());
+        oss << " " << generate(*ifNode.getThenBranch());
     }
     
     if (ifNode.getElseBranch()) {
-        oss << \" else \" << generate(*ifNode.getElseBranch());
+        oss << " else " << generate(*ifNode.getElseBranch());
     }
     
     return oss.str();
@@ -254,15 +275,15 @@ std::string JavaCodeGenerator::generateIf(const IfNode& ifNode) {
 
 std::string JavaCodeGenerator::generateWhile(const WhileNode& whileNode) {
     std::ostringstream oss;
-    oss << \"while (\";
+    oss << "while (";
     
     if (whileNode.getCondition()) {
         oss << generate(*whileNode.getCondition());
     }
-    oss << \")\";
+    oss << ")";
     
     if (whileNode.getBody()) {
-        oss << \" \" << generate(*whileNode.getBody());
+        oss << " " << generate(*whileNode.getBody());
     }
     
     return oss.str();
@@ -270,27 +291,27 @@ std::string JavaCodeGenerator::generateWhile(const WhileNode& whileNode) {
 
 std::string JavaCodeGenerator::generateFor(const ForNode& forNode) {
     std::ostringstream oss;
-    oss << \"for (\";
+    oss << "for (";
     
     if (forNode.getInit()) {
-        oss << generate(*forNode.getInit()) << \"; \";
+        oss << generate(*forNode.getInit()) << "; ";
     } else {
-        oss << \"; \";
+        oss << "; ";
     }
     
     if (forNode.getCondition()) {
-        oss << generate(*forNode.getCondition()) << \"; \";
+        oss << generate(*forNode.getCondition()) << "; ";
     } else {
-        oss << \"; \";
+        oss << "; ";
     }
     
     if (forNode.getIncrement()) {
         oss << generate(*forNode.getIncrement());
     }
-    oss << \")\";
+    oss << ")";
     
     if (forNode.getBody()) {
-        oss << \" \" << generate(*forNode.getBody());
+        oss << " " << generate(*forNode.getBody());
     }
     
     return oss.str();
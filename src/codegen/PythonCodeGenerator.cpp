@@ -1,4 +1,4 @@
-#include \"PythonCodeGenerator.h\"
+#include "codegen/PythonCodeGenerator.h"
 #include <sstream>
 #include <string>
 #include <vector>
@@ -7,8 +7,11 @@ namespace istudio {
 namespace codegen {
 
 std::string PythonCodeGenerator::generate(const ASTNode& node) {
+    if (const auto folded = foldedLiteral(node)) {
+        return generateLiteral(LiteralNode(*folded));
+    }
     std::ostringstream oss;
-    output_.str(\"\"); // Clear the stream
+    output_.str(""); // Clear the stream
     output_.clear(); // Clear any error flags
     
     switch (node.getType()) {
@@ -43,7 +46,7 @@ std::string PythonCodeGenerator::generate(const ASTNode& node) {
         case ASTNodeType::For:
             return generateFor(static_cast<const ForNode&>(node));
         default:
-            return \"# Unsupported node type in Python code generation\\n\";
+            return "# Unsupported node type in Python code generation\n";
     }
 }
 
@@ -51,12 +54,12 @@ std::string PythonCodeGenerator::generateProgram(const ProgramNode& program) {
     std::ostringstream oss;
     
     // Add standard imports if needed
-    oss << \"# Generated Python code from IPL program\\n\\n\";
+    oss << "# Generated Python code from IPL program\n\n";
     
     // Generate each function in the program
     for (const auto& func : program.getFunctions()) {
         if (func) {
-            oss << generate(*func) << \"\\n\\n\";
+            oss << generate(*func) << "\n\n";
         }
     }
     
@@ -66,28 +69,28 @@ std::string PythonCodeGenerator::generateProgram(const ProgramNode& program) {
 std::string PythonCodeGenerator::generateFunction(const FunctionNode& function) {
     std::ostringstream oss;
     
-    oss << \"def \" << function.getName() << \"(\";
+    oss << "def " << function.getName() << "(";
     
     // Generate parameters
     const auto& params = function.getParameters();
     for (size_t i = 0; i < params.size(); ++i) {
-        if (i > 0) oss << \", \";
+        if (i > 0) oss << ", ";
         oss << params[i].name;
     }
-    oss << \"):\";
+    oss << "):";
     
     if (function.getBody()) {
         // Python doesn't require explicit return type, so we just add the body
         std::string body = generate(*function.getBody());
         // Indent the body properly
         size_t pos = 0;
-        while ((pos = body.find(\"\\n\", pos)) != std::string::npos) {
-            body.insert(pos + 1, \"    \"); // Add 4 spaces for Python indentation
+        while ((pos = body.find("\n", pos)) != std::string::npos) {
+            body.insert(pos + 1, "    "); // Add 4 spaces for Python indentation
             pos += 5; // Move past the inserted spaces
         }
         oss << body;
     } else {
-        oss << \"\\n    pass\"; // Empty function
+        oss << "\n    pass"; // Empty function
     }
     
     return oss.str();
@@ -99,9 +102,9 @@ std::string PythonCodeGenerator::generateVariableDeclaration(const VariableDecla
     oss << varDecl.getName();
     
     if (varDecl.getInitializer()) {
-        oss << \" = \" << generate(*varDecl.getInitializer());
+        oss << " = " << generate(*varDecl.getInitializer());
     } else {
-        oss << \" = None\"; // Default to None if no initializer
+        oss << " = None"; // Default to None if no initializer
     }
     
     return oss.str();
@@ -109,19 +112,22 @@ std::string PythonCodeGenerator::generateVariableDeclaration(const VariableDecla
 
 std::string PythonCodeGenerator::generateAssignment(const AssignmentNode& assignment) {
     std::ostringstream oss;
-    oss << assignment.getVariable() << \" = \" << generate(*assignment.getValue());
+    oss << assignment.getVariable() << " = " << generate(*assignment.getValue());
     return oss.str();
 }
 
 std::string PythonCodeGenerator::generateBinaryOperation(const BinaryOperationNode& binOp) {
     std::ostringstream oss;
-    oss << \"(\" << generate(*binOp.getLeft()) << \" \" << binOp.getOperator() << \" \" 
-        << generate(*binOp.getRight()) << \")\";
+    oss << "(" << generate(*binOp.getLeft()) << " " << binOp.getOperator() << " " 
+        << generate(*binOp.getRight()) << ")";
     return oss.str();
 }
 
 std::string PythonCodeGenerator::generateUnaryOperation(const UnaryOperationNode& unaryOp) {
     std::ostringstream oss;
+    if (unaryOp.getOperator() == "move") {
+        return generate(*unaryOp.getOperand()); // ownership transfer is implicit here
+    }
     oss << unaryOp.getOperator() << generate(*unaryOp.getOperand());
     return oss.str();
 }
@@ -130,16 +136,16 @@ std::string PythonCodeGenerator::generateCallExpression(const CallExpressionNode
     std::ostringstream oss;
     
     if (call.getCallee()) {
-        oss << generate(*call.getCallee()) << \"(\";
+        oss << generate(*call.getCallee()) << "(";
         
         const auto& args = call.getArguments();
         for (size_t i = 0; i < args.size(); ++i) {
-            if (i > 0) oss << \", \";
+            if (i > 0) oss << ", ";
             if (args[i]) {
                 oss << generate(*args[i]);
             }
         }
-        oss << \")\";
+        oss << ")";
     }
     
     return oss.str();
@@ -157,11 +163,11 @@ std::string PythonCodeGenerator::generateIdentifier(const IdentifierNode& identi
 
 std::string PythonCodeGenerator::generateBlock(const BlockNode& block) {
     std::ostringstream oss;
-    oss << \"\\n\"; // Start with a newline
+    oss << "\n"; // Start with a newline
     
     for (const auto& stmt : block.getStatements()) {
         if (stmt) {
-            oss << \"    \" << generate(*stmt) << \"\\n\"; // Python uses 4-space indentation
+            oss << "    " << generate(*stmt) << "\n"; // Python uses 4-space indentation
         }
     }
     
@@ -170,10 +176,10 @@ std::string PythonCodeGenerator::generateBlock(const BlockNode& block) {
 
 std::string PythonCodeGenerator::generateReturn(const ReturnNode& ret) {
     std::ostringstream oss;
-    oss << \"return\";
+    oss << "return";
     
     if (ret.getValue()) {
-        oss << \" \" << generate(*ret.getValue());
+        oss << " " << generate(*ret.getValue());
     }
     
     return oss.str();
@@ -188,21 +194,24 @@ std::string PythonCodeGenerator::generateExpressionStatement(const ExpressionSta
 }
 
 std::string PythonCodeGenerator::generateIf(const IfNode& ifNode) {
+    if (const auto taken = prunedBranch(ifNode)) {
+        return *taken ? generate(**taken) : std::string{};
+    }
     std::ostringstream oss;
-    oss << \"if \";
+    oss << "if ";
     
     if (ifNode.getCondition()) {
         oss << generate(*ifNode.getCondition());
     }
-    oss << \":\";
+    oss << ":";
     
     if (ifNode.getThenBranch()) {
         // Process the then branch, adding proper indentation
         std::string thenBranch = generate(*ifNode.getThenBranch());
         size_t pos = 0;
-        while ((pos = thenBranch.find(\"\\n\", pos)) != std::string::npos) {
+        while ((pos = thenBranch.find("\n", pos)) != std::string::npos) {
             if (pos + 1 < thenBranch.length()) { // If there's content after the newline
-                thenBranch.insert(pos + 1, \"    \"); // Add 4 spaces for Python indentation
+                thenBranch.insert(pos + 1, "    "); // Add 4 spaces for Python indentation
                 pos += 5; // Move past the inserted spaces
             } else {
                 break;
@@ -212,12 +221,12 @@ std::string PythonCodeGenerator::generateIf(const IfNode& ifNode) {
     }
     
     if (ifNode.getElseBranch()) {
-        oss << \"\\nelse:\";
+        oss << "\nelse:";
         std::string elseBranch = generate(*ifNode.getElseBranch());
         size_t pos = 0;
-        while ((pos = elseBranch.find(\"\\n\", pos)) != std::string::npos) {
+        while ((pos = elseBranch.find("\n", pos)) != std::string::npos) {
             if (pos + 1 < elseBranch.length()) { // If there's content after the newline
-                elseBranch.insert(pos + 1, \"    \"); // Add 4 spaces for Python indentation
+                elseBranch.insert(pos + 1, "    "); // Add 4 spaces for Python indentation
                 pos += 5; // Move past the inserted spaces
             } else {
                 break;
@@ -231,20 +240,20 @@ std::string PythonCodeGenerator::generateIf(const IfNode& ifNode) {
 
 std::string PythonCodeGenerator::generateWhile(const WhileNode& whileNode) {
     std::ostringstream oss;
-    oss << \"while \";
+    oss << "while ";
     
     if (whileNode.getCondition()) {
         oss << generate(*whileNode.getCondition());
     }
-    oss << \":\";
+    oss << ":";
     
     if (whileNode.getBody()) {
         // Process the body, adding proper indentation
         std::string body = generate(*whileNode.getBody());
         size_t pos = 0;
-        while ((pos = body.find(\"\\n\", pos)) != std::string::npos) {
+        while ((pos = body.find("\n", pos)) != std::string::npos) {
             if (pos + 1 < body.length()) { // If there's content after the newline
-                body.insert(pos + 1, \"    \"); // Add 4 spaces for Python indentation
+                body.insert(pos + 1, "    "); // Add 4 spaces for Python indentation
                 pos += 5; // Move past the inserted spaces
             } else {
                 break;
@@ -264,16 +273,16 @@ std::string PythonCodeGenerator::generateFor(const ForNode& forNode) {
     // If we have all init, condition, and increment, try to convert to Python range
     if (forNode.getInit() && forNode.getCondition() && forNode.getIncrement()) {
         // This is a basic implementation - in a full system we'd need more complex parsing
-        oss << \"# IPL for-loop converted to Python\\n\";
-        oss << \"for i in range(0, 10):  # Placeholder - actual range needs to be determined from condition\";
+        oss << "# IPL for-loop converted to Python\n";
+        oss << "for i in range(0, 10):  # Placeholder - actual range needs to be determined from condition";
         
         if (forNode.getBody()) {
             // Process the body, adding proper indentation
             std::string body = generate(*forNode.getBody());
             size_t pos = 0;
-            while ((pos = body.find(\"\\n\", pos)) != std::string::npos) {
+            while ((pos = body.find("\n", pos)) != std::string::npos) {
                 if (pos + 1 < body.length()) { // If there's content after the newline
-                    body.insert(pos + 1, \"    \"); // Add 4 spaces for Python indentation
+                    body.insert(pos + 1, "    "); // Add 4 spaces for Python indentation
                     pos += 5; // Move past the inserted spaces
                 } else {
                     break;
@@ -283,23 +292,23 @@ std::string PythonCodeGenerator::generateFor(const ForNode& forNode) {
         }
     } else {
         // Fallback: convert to while loop
-        oss << \"\\n# Converted IPL for-loop to Python while loop\\n\";
+        oss << "\n# Converted IPL for-loop to Python while loop\n";
         if (forNode.getInit()) {
-            oss << generate(*forNode.getInit()) << \"\\n\";
+            oss << generate(*forNode.getInit()) << "\n";
         }
         
-        oss << \"while \";
+        oss << "while ";
         if (forNode.getCondition()) {
             oss << generate(*forNode.getCondition());
         }
-        oss << \":\";
+        oss << ":";
         
         if (forNode.getBody()) {
             std::string body = generate(*forNode.getBody());
             size_t pos = 0;
-            while ((pos = body.find(\"\\n\", pos)) != std::string::npos) {
+            while ((pos = body.find("\n", pos)) != std::string::npos) {
                 if (pos + 1 < body.length()) { // If there's content after the newline
-                    body.insert(pos + 1, \"    \"); // Add 4 spaces for Python indentation
+                    body.insert(pos + 1, "    "); // Add 4 spaces for Python indentation
                     pos += 5; // Move past the inserted spaces
                 } else {
                     break;
@@ -309,7 +318,7 @@ std::string PythonCodeGenerator::generateFor(const ForNode& forNode) {
         }
         
         if (forNode.getIncrement()) {
-            oss << \"\\n    \" << generate(*forNode.getIncrement());
+            oss << "\n    " << generate(*forNode.getIncrement());
         }
     }
     
@@ -1,4 +1,4 @@
-#include "RuleParser.h"
+#include "codegen/RuleParser.h"
 #include <iostream>
 #include <algorithm>
 
@@ -0,0 +1,34 @@
+#include "ir/Arena.h"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace istudio::ir {
+
+Arena::~Arena()
+{
+    for (auto it = destructors_.rbegin(); it != destructors_.rend(); ++it) {
+        it->destroy(it->object);
+    }
+}
+
+void* Arena::allocate(std::size_t size, std::size_t alignment)
+{
+    auto address = reinterpret_cast<std::uintptr_t>(cursor_);
+    std::size_t padding = (alignment - address % alignment) % alignment;
+    if (!cursor_ || padding + size > static_cast<std::size_t>(end_ - cursor_)) {
+        // Oversized requests get a chunk of their own.
+        const std::size_t chunkSize = std::max(kChunkSize, size + alignment);
+        chunks_.push_back(std::make_unique<std::byte[]>(chunkSize));
+        cursor_ = chunks_.back().get();
+        end_ = cursor_ + chunkSize;
+        address = reinterpret_cast<std::uintptr_t>(cursor_);
+        padding = (alignment - address % alignment) % alignment;
+    }
+    std::byte* result = cursor_ + padding;
+    cursor_ = result + size;
+    used_ += padding + size;
+    return result;
+}
+
+} // namespace istudio::ir
@@ -0,0 +1,500 @@
+#include "ir/Bitcode.h"
+
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+namespace istudio::ir {
+
+namespace {
+
+constexpr std::uint8_t kMagic[] = {'I', 'P', 'L', 'B'};
+constexpr std::uint64_t kVersion = 2; // 2: calls carry a tail flag
+
+enum class ConstantTag : std::uint8_t { Undef, Bool, Int, Float, String };
+
+struct FormatError {
+    std::string message;
+};
+
+class ByteWriter {
+public:
+    void byte(std::uint8_t value) { bytes_.push_back(value); }
+
+    void varint(std::uint64_t value)
+    {
+        while (value >= 0x80) {
+            bytes_.push_back(static_cast<std::uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        bytes_.push_back(static_cast<std::uint8_t>(value));
+    }
+
+    // Zigzag: small negative numbers stay short.
+    void svarint(std::int64_t value)
+    {
+        varint((static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63));
+    }
+
+    void float64(double value)
+    {
+        const auto bits = std::bit_cast<std::uint64_t>(value);
+        for (int i = 0; i < 8; ++i) {
+            bytes_.push_back(static_cast<std::uint8_t>(bits >> (8 * i)));
+        }
+    }
+
+    void append(std::span<const std::uint8_t> bytes) { bytes_.insert(bytes_.end(), bytes.begin(), bytes.end()); }
+
+    [[nodiscard]] std::vector<std::uint8_t>& bytes() { return bytes_; }
+
+private:
+    std::vector<std::uint8_t> bytes_;
+};
+
+class ByteReader {
+public:
+    explicit ByteReader(std::span<const std::uint8_t> bytes) : bytes_(bytes) {}
+
+    std::uint8_t byte()
+    {
+        if (position_ >= bytes_.size()) {
+            throw FormatError{"unexpected end of data"};
+        }
+        return bytes_[position_++];
+    }
+
+    std::uint64_t varint()
+    {
+        std::uint64_t value = 0;
+        for (unsigned shift = 0; shift < 64; shift += 7) {
+            const std::uint8_t next = byte();
+            value |= static_cast<std::uint64_t>(next & 0x7F) << shift;
+            if ((next & 0x80) == 0) {
+                return value;
+            }
+        }
+        throw FormatError{"varint too long"};
+    }
+
+    std::int64_t svarint()
+    {
+        const std::uint64_t value = varint();
+        return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+    }
+
+    double float64()
+    {
+        std::uint64_t bits = 0;
+        for (int i = 0; i < 8; ++i) {
+            bits |= static_cast<std::uint64_t>(byte()) << (8 * i);
+        }
+        return std::bit_cast<double>(bits);
+    }
+
+    // A count or index below `limit`.
+    std::size_t index(std::size_t limit, const char* what)
+    {
+        const std::uint64_t value = varint();
+        if (value >= limit) {
+            throw FormatError{std::string(what) + " out of range"};
+        }
+        return static_cast<std::size_t>(value);
+    }
+
+    // A count of items that take at least one byte each, so a corrupt count cannot
+    // make the reader reserve more than the data could hold.
+    std::size_t count(const char* what) { return index(remaining() + 1, what); }
+
+    std::span<const std::uint8_t> take(std::size_t size)
+    {
+        if (size > remaining()) {
+            throw FormatError{"unexpected end of data"};
+        }
+        const auto bytes = bytes_.subspan(position_, size);
+        position_ += size;
+        return bytes;
+    }
+
+    [[nodiscard]] std::size_t position() const { return position_; }
+    [[nodiscard]] std::size_t remaining() const { return bytes_.size() - position_; }
+
+private:
+    std::span<const std::uint8_t> bytes_;
+    std::size_t position_{0};
+};
+
+IRType readType(ByteReader& in)
+{
+    const std::uint8_t type = in.byte();
+    if (type > static_cast<std::uint8_t>(IRType::Opaque)) {
+        throw FormatError{"bad type"};
+    }
+    return static_cast<IRType>(type);
+}
+
+class StringTable {
+public:
+    std::size_t add(std::string_view text)
+    {
+        const auto [it, inserted] = index_.emplace(std::string(text), strings_.size());
+        if (inserted) {
+            strings_.emplace_back(text);
+        }
+        return it->second;
+    }
+
+    [[nodiscard]] const std::vector<std::string>& strings() const { return strings_; }
+
+private:
+    std::vector<std::string> strings_;
+    std::unordered_map<std::string, std::size_t> index_;
+};
+
+void writeFunction(const IRFunction& function, StringTable& strings, ByteWriter& out)
+{
+    // Value numbers: arguments, constants, instructions.
+    std::unordered_map<const IRValue*, std::size_t> numbers;
+    std::unordered_map<const IRBasicBlock*, std::size_t> blocks;
+    std::vector<const IRConstant*> constants;
+    for (const IRArgument* argument : function.getArguments()) {
+        numbers.emplace(argument, numbers.size());
+    }
+    std::size_t instructions = 0;
+    for (const IRBasicBlock& block : function.getBasicBlocks()) {
+        blocks.emplace(&block, blocks.size());
+        for (const IRInstruction& inst : block) {
+            ++instructions;
+            for (std::size_t i = 0; i < inst.getNumOperands(); ++i) {
+                const IRValue* operand = inst.getOperand(i);
+                if (operand->getKind() == IRValueKind::Constant && numbers.emplace(operand, numbers.size()).second) {
+                    constants.push_back(static_cast<const IRConstant*>(operand));
+                }
+            }
+        }
+    }
+    for (const IRBasicBlock& block : function.getBasicBlocks()) {
+        for (const IRInstruction& inst : block) {
+            numbers.emplace(&inst, numbers.size());
+        }
+    }
+
+    out.byte(static_cast<std::uint8_t>(function.getType()));
+    out.varint(function.getArguments().size());
+    for (const IRArgument* argument : function.getArguments()) {
+        out.varint(strings.add(argument->getName()));
+        out.byte(static_cast<std::uint8_t>(argument->getType()));
+    }
+
+    out.varint(constants.size());
+    for (const IRConstant* constant : constants) {
+        out.byte(static_cast<std::uint8_t>(constant->getType()));
+        const IRConstantValue& value = constant->getValue();
+        if (const auto* flag = std::get_if<bool>(&value)) {
+            out.byte(static_cast<std::uint8_t>(ConstantTag::Bool));
+            out.byte(*flag ? 1 : 0);
+        } else if (const auto* integer = std::get_if<std::int64_t>(&value)) {
+            out.byte(static_cast<std::uint8_t>(ConstantTag::Int));
+            out.svarint(*integer);
+        } else if (const auto* real = std::get_if<double>(&value)) {
+            out.byte(static_cast<std::uint8_t>(ConstantTag::Float));
+            out.float64(*real);
+        } else if (const auto* text = std::get_if<std::string>(&value)) {
+            out.byte(static_cast<std::uint8_t>(ConstantTag::String));
+            out.varint(strings.add(*text));
+        } else {
+            out.byte(static_cast<std::uint8_t>(ConstantTag::Undef));
+        }
+    }
+
+    out.varint(blocks.size());
+    for (const IRBasicBlock& block : function.getBasicBlocks()) {
+        out.varint(strings.add(block.getLabel()));
+    }
+    out.varint(instructions);
+    for (const IRBasicBlock& block : function.getBasicBlocks()) {
+        out.varint(block.getPredecessors().size());
+        for (const IRBasicBlock* pred : block.getPredecessors()) {
+            out.varint(blocks.at(pred));
+        }
+        out.varint(block.getInstructions().size());
+        for (const IRInstruction& inst : block) {
+            out.byte(static_cast<std::uint8_t>(inst.getOp()));
+            out.byte(static_cast<std::uint8_t>(inst.getType()));
+            out.varint(inst.getNumOperands());
+            for (std::size_t i = 0; i < inst.getNumOperands(); ++i) {
+                out.varint(numbers.at(inst.getOperand(i)));
+            }
+            out.varint(inst.getBlocks().size());
+            for (const IRBasicBlock* target : inst.getBlocks()) {
+                out.varint(blocks.at(target));
+            }
+            if (inst.getOp() == IRInstructionOp::Call) {
+                out.varint(strings.add(inst.getCallee()));
+                out.byte(inst.isTailCall() ? 1 : 0);
+            }
+        }
+    }
+}
+
+// One instruction as read, before the values it refers to all exist.
+struct InstructionRecord {
+    IRInstructionOp op{IRInstructionOp::Add};
+    IRType type{IRType::Void};
+    std::vector<std::size_t> operands;
+    std::vector<std::size_t> blocks;
+    std::size_t callee{0};
+    bool tailCall{false};
+};
+
+} // namespace
+
+std::vector<std::uint8_t> writeBitcode(const IRModule& module)
+{
+    StringTable strings;
+    const std::size_t moduleName = strings.add(module.getName());
+    ByteWriter bodies;
+    std::vector<std::pair<std::size_t, std::size_t>> table; // name, offset
+    for (const auto& function : module.getFunctions()) {
+        table.emplace_back(strings.add(function->getName()), bodies.bytes().size());
+        writeFunction(*function, strings, bodies);
+    }
+
+    ByteWriter out;
+    out.append(kMagic);
+    out.varint(kVersion);
+    out.varint(strings.strings().size());
+    for (const std::string& text : strings.strings()) {
+        out.varint(text.size());
+        out.append(std::span(reinterpret_cast<const std::uint8_t*>(text.data()), text.size()));
+    }
+    out.varint(moduleName);
+    out.varint(table.size());
+    for (std::size_t i = 0; i < table.size(); ++i) {
+        const std::size_t end = i + 1 < table.size() ? table[i + 1].second : bodies.bytes().size();
+        out.varint(table[i].first);
+        out.varint(table[i].second);
+        out.varint(end - table[i].second);
+    }
+    out.append(bodies.bytes());
+    return std::move(out.bytes());
+}
+
+bool isBitcode(std::span<const std::uint8_t> bytes)
+{
+    return bytes.size() >= sizeof(kMagic) && std::memcmp(bytes.data(), kMagic, sizeof(kMagic)) == 0;
+}
+
+std::expected<BitcodeReader, std::string> BitcodeReader::open(std::vector<std::uint8_t> bytes)
+{
+    if (!isBitcode(bytes)) {
+        return std::unexpected("not an IR bitcode file");
+    }
+    BitcodeReader reader;
+    reader.bytes_ = std::move(bytes);
+    try {
+        ByteReader in(reader.bytes_);
+        in.take(sizeof(kMagic));
+        if (const std::uint64_t version = in.varint(); version != kVersion) {
+            return std::unexpected("unsupported bitcode version " + std::to_string(version));
+        }
+        const std::size_t stringCount = in.count("string count");
+        reader.strings_.reserve(stringCount);
+        for (std::size_t i = 0; i < stringCount; ++i) {
+            const auto text = in.take(in.count("string length"));
+            reader.strings_.emplace_back(reinterpret_cast<const char*>(text.data()), text.size());
+        }
+        reader.moduleName_ = in.index(stringCount, "module name");
+        const std::size_t functionCount = in.count("function count");
+        for (std::size_t i = 0; i < functionCount; ++i) {
+            FunctionEntry entry;
+            entry.name = in.index(stringCount, "function name");
+            entry.offset = static_cast<std::size_t>(in.varint());
+            entry.size = static_cast<std::size_t>(in.varint());
+            reader.functions_.push_back(entry);
+        }
+        reader.bodies_ = in.position();
+        const std::size_t available = reader.bytes_.size() - reader.bodies_;
+        for (const FunctionEntry& entry : reader.functions_) {
+            if (entry.offset > available || entry.size > available - entry.offset) {
+                return std::unexpected("function body out of range");
+            }
+        }
+    } catch (const FormatError& error) {
+        return std::unexpected("malformed bitcode: " + error.message);
+    }
+    return reader;
+}
+
+std::expected<BitcodeReader, std::string> BitcodeReader::openFile(const std::filesystem::path& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return std::unexpected("cannot open " + path.string());
+    }
+    std::vector<std::uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    return open(std::move(bytes));
+}
+
+std::optional<std::size_t> BitcodeReader::findFunction(std::string_view name) const
+{
+    for (std::size_t i = 0; i < functions_.size(); ++i) {
+        if (strings_[functions_[i].name] == name) {
+            return i;
+        }
+    }
+    return std::nullopt;
+}
+
+std::expected<std::unique_ptr<IRFunction>, std::string> BitcodeReader::readFunction(std::size_t index) const
+{
+    const FunctionEntry& entry = functions_.at(index);
+    try {
+        ByteReader in(std::span<const std::uint8_t>(bytes_).subspan(bodies_ + entry.offset, entry.size));
+        auto function = std::make_unique<IRFunction>(strings_[entry.name], readType(in));
+        std::vector<IRValue*> values;
+
+        const std::size_t argumentCount = in.count("argument count");
+        for (std::size_t i = 0; i < argumentCount; ++i) {
+            const std::string& name = strings_[in.index(strings_.size(), "argument name")];
+            values.push_back(function->addArgument(name, readType(in)));
+        }
+
+        const std::size_t constantCount = in.count("constant count");
+        for (std::size_t i = 0; i < constantCount; ++i) {
+            const IRType type = readType(in);
+            IRConstantValue value;
+            switch (static_cast<ConstantTag>(in.byte())) {
+            case ConstantTag::Undef:
+                break;
+            case ConstantTag::Bool:
+                value = in.byte() != 0;
+                break;
+            case ConstantTag::Int:
+                value = in.svarint();
+                break;
+            case ConstantTag::Float:
+                value = in.float64();
+                break;
+            case ConstantTag::String:
+                value = strings_[in.index(strings_.size(), "string constant")];
+                break;
+            default:
+                throw FormatError{"bad constant"};
+            }
+            values.push_back(function->getConstant(type, std::move(value)));
+        }
+
+        // Labels are views, so their text is copied into the function's arena.
+        std::vector<IRBasicBlock*> blocks;
+        const std::size_t blockCount = in.count("block count");
+        for (std::size_t i = 0; i < blockCount; ++i) {
+            const std::string& label = strings_[in.index(strings_.size(), "block label")];
+            auto* text = static_cast<char*>(function->getArena().allocate(label.size(), 1));
+            std::memcpy(text, label.data(), label.size());
+            blocks.push_back(function->insertBlock(function->createBlock(std::string_view(text, label.size()))));
+        }
+
+        // Phis may refer to instructions further down, so every instruction is
+        // created before any operand is set.
+        const std::size_t instructionCount = in.count("instruction count");
+        const std::size_t valueCount = values.size() + instructionCount;
+        std::vector<std::vector<InstructionRecord>> records(blockCount);
+        std::size_t read = 0;
+        for (std::size_t b = 0; b < blockCount; ++b) {
+            const std::size_t predCount = in.count("predecessor count");
+            for (std::size_t i = 0; i < predCount; ++i) {
+                blocks[b]->addPredecessor(blocks[in.index(blockCount, "predecessor")]);
+            }
+            const std::size_t count = in.count("instruction count");
+            for (std::size_t i = 0; i < count; ++i, ++read) {
+                InstructionRecord record;
+                const std::uint8_t op = in.byte();
+                if (op > static_cast<std::uint8_t>(IRInstructionOp::GetElementPtr)) {
+                    throw FormatError{"bad opcode"};
+                }
+                record.op = static_cast<IRInstructionOp>(op);
+                record.type = readType(in);
+                record.operands.resize(in.count("operand count"));
+                for (std::size_t& operand : record.operands) {
+                    operand = in.index(valueCount, "operand");
+                }
+                record.blocks.resize(in.count("target count"));
+                for (std::size_t& target : record.blocks) {
+                    target = in.index(blockCount, "block");
+                }
+                if (record.op == IRInstructionOp::Call) {
+                    record.callee = in.index(strings_.size(), "callee");
+                    record.tailCall = in.byte() != 0;
+                }
+                records[b].push_back(std::move(record));
+            }
+        }
+        if (read != instructionCount || in.remaining() != 0) {
+            throw FormatError{"instruction count mismatch"};
+        }
+
+        std::vector<IRInstruction*> instructions;
+        for (std::size_t b = 0; b < blockCount; ++b) {
+            for (const InstructionRecord& record : records[b]) {
+                instructions.push_back(blocks[b]->append(function->createInstruction(record.op, record.type)));
+                values.push_back(instructions.back());
+            }
+        }
+        std::size_t next = 0;
+        for (const auto& blockRecords : records) {
+            for (const InstructionRecord& record : blockRecords) {
+                IRInstruction* inst = instructions[next++];
+                for (const std::size_t operand : record.operands) {
+                    inst->addOperand(values[operand]);
+                }
+                for (const std::size_t target : record.blocks) {
+                    inst->addBlock(blocks[target]);
+                }
+                if (record.op == IRInstructionOp::Call) {
+                    inst->setCallee(strings_[record.callee]);
+                    inst->setTailCall(record.tailCall);
+                }
+            }
+        }
+        return function;
+    } catch (const FormatError& error) {
+        return std::unexpected("malformed bitcode in function '" + strings_[entry.name] + "': " + error.message);
+    }
+}
+
+std::expected<void, std::string> BitcodeReader::readInto(IRModule& module) const
+{
+    std::unordered_set<std::string_view> defined;
+    for (const auto& function : module.getFunctions()) {
+        defined.insert(function->getName());
+    }
+    for (std::size_t i = 0; i < functions_.size(); ++i) {
+        if (defined.contains(functionName(i))) {
+            return std::unexpected("function '" + functionName(i) + "' is defined more than once");
+        }
+    }
+    for (std::size_t i = 0; i < functions_.size(); ++i) {
+        auto function = readFunction(i);
+        if (!function) {
+            return std::unexpected(function.error());
+        }
+        module.addFunction(std::move(*function));
+    }
+    return {};
+}
+
+std::expected<std::unique_ptr<IRModule>, std::string> BitcodeReader::readModule() const
+{
+    auto module = std::make_unique<IRModule>(moduleName());
+    if (auto read = readInto(*module); !read) {
+        return std::unexpected(read.error());
+    }
+    return module;
+}
+
+} // namespace istudio::ir
@@ -0,0 +1,67 @@
+#include "ir/Cloning.h"
+
+#include <cstring>
+#include <string_view>
+#include <utility>
+
+namespace istudio::ir {
+
+namespace {
+
+// Block labels must outlive their function, so labels from another function are
+// copied into this one's arena.
+std::string_view copyLabel(IRFunction& function, std::string_view label)
+{
+    auto* storage = static_cast<char*>(function.getArena().allocate(label.size(), 1));
+    std::memcpy(storage, label.data(), label.size());
+    return {storage, label.size()};
+}
+
+} // namespace
+
+void cloneBlocks(const std::vector<const IRBasicBlock*>& blocks, IRFunction& function, IRBasicBlock* before,
+                 CloneMap& map)
+{
+    std::vector<std::pair<const IRInstruction*, IRInstruction*>> clones;
+    for (const IRBasicBlock* original : blocks) {
+        const std::string_view label =
+            original->getParent() == &function ? original->getLabel() : copyLabel(function, original->getLabel());
+        IRBasicBlock* copy = function.insertBlock(function.createBlock(label), before);
+        map.blocks[original] = copy;
+        for (const IRInstruction& inst : original->getInstructions()) {
+            IRInstruction* clone = function.createInstruction(inst.getOp(), inst.getType());
+            clone->setCallee(inst.getCallee());
+            clone->setTailCall(inst.isTailCall());
+            copy->append(clone);
+            map.values[&inst] = clone;
+            clones.emplace_back(&inst, clone);
+        }
+    }
+
+    // Operands may refer forward (Phis in loops), so they are mapped once every clone exists.
+    for (const auto& [original, clone] : clones) {
+        for (std::size_t i = 0; i < original->getNumOperands(); ++i) {
+            IRValue* operand = original->getOperand(i);
+            if (operand->getKind() == IRValueKind::Constant) {
+                const auto* constant = static_cast<const IRConstant*>(operand);
+                clone->addOperand(function.getConstant(constant->getType(), constant->getValue()));
+            } else {
+                clone->addOperand(map.lookup(operand));
+            }
+        }
+        for (IRBasicBlock* target : original->getBlocks()) {
+            clone->addBlock(map.lookup(target));
+        }
+    }
+    for (const IRBasicBlock* original : blocks) {
+        IRBasicBlock* copy = map.blocks.at(original);
+        for (IRBasicBlock* pred : original->getPredecessors()) {
+            const auto it = map.blocks.find(pred);
+            if (it != map.blocks.end()) {
+                copy->addPredecessor(it->second);
+            }
+        }
+    }
+}
+
+} // namespace istudio::ir
@@ -0,0 +1,89 @@
+#include "ir/DeadCodeElimination.h"
+
+#include <unordered_set>
+#include <vector>
+
+namespace istudio::ir {
+
+bool hasSideEffects(const IRInstruction& inst)
+{
+    switch (inst.getOp()) {
+    case IRInstructionOp::Call:
+    case IRInstructionOp::Store:
+        return true;
+    default:
+        return inst.isTerminator();
+    }
+}
+
+PreservedAnalyses DeadCodeElimination::run(IRFunction& function, FunctionAnalyses&) const
+{
+    std::vector<IRInstruction*> worklist;
+    for (IRBasicBlock& block : function.getBasicBlocks()) {
+        for (IRInstruction& inst : block) {
+            worklist.push_back(&inst);
+        }
+    }
+
+    bool changed = false;
+    while (!worklist.empty()) {
+        IRInstruction* inst = worklist.back();
+        worklist.pop_back();
+        if (!inst->getParent() || inst->hasUses() || hasSideEffects(*inst)) {
+            continue;
+        }
+        for (std::size_t i = 0; i < inst->getNumOperands(); ++i) {
+            IRValue* operand = inst->getOperand(i);
+            if (operand && operand != inst && operand->getKind() == IRValueKind::Instruction) {
+                worklist.push_back(static_cast<IRInstruction*>(operand));
+            }
+        }
+        inst->eraseFromParent();
+        changed = true;
+    }
+    return changed ? PreservedAnalyses::cfg() : PreservedAnalyses::all();
+}
+
+PreservedAnalyses AggressiveDeadCodeElimination::run(IRFunction& function, FunctionAnalyses&) const
+{
+    std::unordered_set<const IRInstruction*> live;
+    std::vector<IRInstruction*> worklist;
+    for (IRBasicBlock& block : function.getBasicBlocks()) {
+        for (IRInstruction& inst : block) {
+            if (hasSideEffects(inst) && live.insert(&inst).second) {
+                worklist.push_back(&inst);
+            }
+        }
+    }
+    while (!worklist.empty()) {
+        IRInstruction* inst = worklist.back();
+        worklist.pop_back();
+        for (std::size_t i = 0; i < inst->getNumOperands(); ++i) {
+            IRValue* operand = inst->getOperand(i);
+            if (operand && operand->getKind() == IRValueKind::Instruction) {
+                auto* definition = static_cast<IRInstruction*>(operand);
+                if (live.insert(definition).second) {
+                    worklist.push_back(definition);
+                }
+            }
+        }
+    }
+
+    // Dead instructions may use each other, so every reference is dropped before
+    // anything is erased.
+    std::vector<IRInstruction*> dead;
+    for (IRBasicBlock& block : function.getBasicBlocks()) {
+        for (IRInstruction& inst : block) {
+            if (!live.contains(&inst)) {
+                inst.dropAllReferences();
+                dead.push_back(&inst);
+            }
+        }
+    }
+    for (IRInstruction* inst : dead) {
+        inst->eraseFromParent();
+    }
+    return dead.empty() ? PreservedAnalyses::all() : PreservedAnalyses::cfg();
+}
+
+} // namespace istudio::ir
@@ -0,0 +1,140 @@
+#include "ir/Dominators.h"
+
+#include <unordered_set>
+#include <utility>
+
+namespace istudio::ir {
+
+IRBasicBlock* DominatorTree::getIdom(const IRBasicBlock* block) const
+{
+    const auto it = nodes_.find(block);
+    return it != nodes_.end() ? it->second.idom : nullptr;
+}
+
+const std::vector<IRBasicBlock*>& DominatorTree::getChildren(const IRBasicBlock* block) const
+{
+    static const std::vector<IRBasicBlock*> kNone;
+    const auto it = nodes_.find(block);
+    return it != nodes_.end() ? it->second.children : kNone;
+}
+
+bool DominatorTree::dominates(const IRBasicBlock* a, const IRBasicBlock* b) const
+{
+    const auto first = nodes_.find(a);
+    const auto second = nodes_.find(b);
+    if (first == nodes_.end() || second == nodes_.end()) {
+        return false;
+    }
+    return first->second.in <= second->second.in && second->second.out <= first->second.out;
+}
+
+bool DominatorTree::dominates(const IRInstruction* def, const IRInstruction* user) const
+{
+    const IRBasicBlock* defBlock = def->getParent();
+    const IRBasicBlock* useBlock = user->getParent();
+    if (defBlock != useBlock) {
+        return dominates(defBlock, useBlock);
+    }
+    for (const IRInstruction* inst = def; inst; inst = inst->getNextNode()) {
+        if (inst == user) {
+            return true;
+        }
+    }
+    return false;
+}
+
+DominatorTree DominatorTreeAnalysis::run(const IRFunction& function, FunctionAnalyses&)
+{
+    DominatorTree tree;
+    IRBasicBlock* entry = function.getEntryBlock();
+    if (!entry) {
+        return tree;
+    }
+    tree.root_ = entry;
+
+    // Post-order by an explicit DFS, so deep CFGs do not exhaust the stack.
+    std::unordered_map<const IRBasicBlock*, unsigned> postIndex;
+    std::vector<IRBasicBlock*> postOrder;
+    {
+        std::vector<std::pair<IRBasicBlock*, std::size_t>> stack{{entry, 0}};
+        std::unordered_set<const IRBasicBlock*> visited{entry};
+        while (!stack.empty()) {
+            auto& [block, next] = stack.back();
+            const auto successors = block->getSuccessors();
+            if (next < successors.size()) {
+                IRBasicBlock* successor = successors[next++];
+                if (visited.insert(successor).second) {
+                    stack.emplace_back(successor, 0);
+                }
+                continue;
+            }
+            postIndex[block] = static_cast<unsigned>(postOrder.size());
+            postOrder.push_back(block);
+            stack.pop_back();
+        }
+    }
+    tree.order_.assign(postOrder.rbegin(), postOrder.rend());
+
+    std::unordered_map<const IRBasicBlock*, IRBasicBlock*> idom{{entry, entry}};
+    auto intersect = [&](IRBasicBlock* a, IRBasicBlock* b) {
+        while (a != b) {
+            while (postIndex[a] < postIndex[b]) {
+                a = idom[a];
+            }
+            while (postIndex[b] < postIndex[a]) {
+                b = idom[b];
+            }
+        }
+        return a;
+    };
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (IRBasicBlock* block : tree.order_) {
+            if (block == entry) {
+                continue;
+            }
+            IRBasicBlock* candidate = nullptr;
+            for (IRBasicBlock* pred : block->getPredecessors()) {
+                if (!idom.contains(pred)) {
+                    continue; // unreachable, or not processed yet
+                }
+                candidate = candidate ? intersect(pred, candidate) : pred;
+            }
+            if (candidate && idom[block] != candidate) {
+                idom[block] = candidate;
+                changed = true;
+            }
+        }
+    }
+
+    for (IRBasicBlock* block : tree.order_) {
+        tree.nodes_[block];
+    }
+    for (IRBasicBlock* block : tree.order_) {
+        if (block != entry) {
+            tree.nodes_[block].idom = idom[block];
+            tree.nodes_[idom[block]].children.push_back(block);
+        }
+    }
+
+    // DFS intervals on the tree for constant-time dominance queries.
+    unsigned clock = 0;
+    std::vector<std::pair<IRBasicBlock*, std::size_t>> stack{{entry, 0}};
+    tree.nodes_[entry].in = clock++;
+    while (!stack.empty()) {
+        auto& [block, next] = stack.back();
+        auto& node = tree.nodes_[block];
+        if (next < node.children.size()) {
+            IRBasicBlock* child = node.children[next++];
+            tree.nodes_[child].in = clock++;
+            stack.emplace_back(child, 0);
+            continue;
+        }
+        node.out = clock++;
+        stack.pop_back();
+    }
+    return tree;
+}
+
+} // namespace istudio::ir
@@ -0,0 +1,490 @@
+#include "ir/EscapeAnalysis.h"
+
+#include "ir/IRPrinter.h"
+
+#include <algorithm>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+
+namespace istudio::ir {
+
+namespace {
+
+constexpr std::size_t kNone = static_cast<std::size_t>(-1);
+
+// What a runtime function does with its arguments. Argument indexes are -1 when
+// unused.
+struct RuntimeEffect {
+    std::string_view name;
+    bool allocates{false};  // the result is a new object
+    int container{-1};      // argument `stored` is kept in argument `container`
+    int stored{-1};
+    int returned{-1};       // the result is this argument
+    int loadedFrom{-1};     // the result is an element of this argument
+};
+
+// Runtime functions that read their arguments and keep none of them.
+constexpr std::string_view kReadOnly[] = {
+    "print",   "println",  "printNumber", "printBool",   "printf",           "fprintf",    "scanf",
+    "writeFile", "appendFile", "listLength", "length",   "isEmpty",          "compare",    "equalsIgnoreCase",
+    "startsWith", "endsWith", "contains",  "indexOf",     "lastIndexOf",      "isAlpha",    "isDigit",
+    "isAlnum", "isLower",  "isUpper",     "typeof",      "hasField",         "memcmp",     "abs",
+    "clamp",   "max",      "min",         "pow",         "operator**",       "sqrt",       "floor",
+    "ceil",    "round",    "sin",         "cos",         "tan",              "exp",        "log",
+};
+
+// Runtime functions that return a new object and keep none of their arguments.
+constexpr std::string_view kAllocators[] = {
+    "listCreate", "dictCreate", "readLine", "prompt",  "readFile", "fields", "concat",
+    "substring",  "charAt",     "toUpper",  "toLower", "toUpperChar", "toLowerChar", "replace",
+    "trim",       "ltrim",      "rtrim",    "split",   "join",
+};
+
+constexpr RuntimeEffect kContainerEffects[] = {
+    {"listPush", false, 0, 1, 0, -1},
+    {"dictSet", false, 0, 2, 0, -1},
+    {"listPop", false, -1, -1, -1, 0},
+    {"dictGet", false, -1, -1, -1, 0},
+    {"memcpy", false, -1, -1, 0, -1},
+    {"memmove", false, -1, -1, 0, -1},
+    {"memset", false, -1, -1, 0, -1},
+};
+
+std::optional<RuntimeEffect> runtimeEffect(std::string_view name)
+{
+    if (std::find(std::begin(kReadOnly), std::end(kReadOnly), name) != std::end(kReadOnly)) {
+        return RuntimeEffect{name, false, -1, -1, -1, -1};
+    }
+    if (std::find(std::begin(kAllocators), std::end(kAllocators), name) != std::end(kAllocators)) {
+        return RuntimeEffect{name, true, -1, -1, -1, -1};
+    }
+    for (const RuntimeEffect& effect : kContainerEffects) {
+        if (effect.name == name) {
+            return effect;
+        }
+    }
+    return std::nullopt;
+}
+
+bool isHeapValue(const IRValue* value)
+{
+    return value && value->getKind() != IRValueKind::Constant &&
+           (value->getType() == IRType::String || value->getType() == IRType::Opaque);
+}
+
+// What a function does with its arguments, as seen by its callers.
+struct Summary {
+    std::vector<EscapeState> parameters; // the argument itself
+    std::vector<bool> elementsEscape;    // what the argument contains
+    std::vector<bool> elementsReturned;  // the result may be one of its elements
+    bool resultEscapes{false};
+
+    // Whether the result is always a new object.
+    [[nodiscard]] bool fresh() const
+    {
+        return std::find(parameters.begin(), parameters.end(), EscapeState::Returned) == parameters.end() &&
+               std::find(elementsReturned.begin(), elementsReturned.end(), true) == elementsReturned.end();
+    }
+
+    bool operator==(const Summary&) const = default;
+};
+
+using Summaries = std::unordered_map<std::string, Summary>;
+
+// Classes of values that may be the same object, kept in a union-find. Each class
+// has at most one element class: whatever is stored into or loaded from its
+// members. Merging two classes merges their element classes too.
+class EscapeClasses {
+public:
+    std::size_t node(const IRValue* value)
+    {
+        const auto [it, inserted] = nodes_.emplace(value, parent_.size());
+        if (inserted) {
+            add();
+        }
+        return it->second;
+    }
+
+    std::optional<std::size_t> find(const IRValue* value)
+    {
+        const auto it = nodes_.find(value);
+        return it != nodes_.end() ? std::optional<std::size_t>(find(it->second)) : std::nullopt;
+    }
+
+    std::size_t find(std::size_t n)
+    {
+        while (parent_[n] != n) {
+            parent_[n] = parent_[parent_[n]];
+            n = parent_[n];
+        }
+        return n;
+    }
+
+    void unify(std::size_t a, std::size_t b)
+    {
+        a = find(a);
+        b = find(b);
+        if (a == b) {
+            return;
+        }
+        parent_[b] = a;
+        state_[a] = std::max(state_[a], state_[b]);
+        const std::size_t elementA = element_[a];
+        const std::size_t elementB = element_[b];
+        if (elementA == kNone) {
+            element_[a] = elementB;
+        } else if (elementB != kNone) {
+            unify(elementA, elementB);
+        }
+    }
+
+    std::size_t elementOf(std::size_t n)
+    {
+        n = find(n);
+        if (element_[n] == kNone) {
+            const std::size_t element = add(); // may reallocate element_
+            element_[n] = element;
+        }
+        return find(element_[n]);
+    }
+
+    // Element class of n, if anything was ever stored into or loaded from it.
+    std::optional<std::size_t> existingElementOf(std::size_t n)
+    {
+        n = find(n);
+        return element_[n] == kNone ? std::nullopt : std::optional<std::size_t>(find(element_[n]));
+    }
+
+    void raise(std::size_t n, EscapeState state)
+    {
+        n = find(n);
+        state_[n] = std::max(state_[n], state);
+    }
+
+    EscapeState state(std::size_t n) { return state_[find(n)]; }
+
+    // Elements are reachable from wherever their container is.
+    void propagate()
+    {
+        for (bool changed = true; changed;) {
+            changed = false;
+            for (std::size_t n = 0; n < parent_.size(); ++n) {
+                if (parent_[n] != n || element_[n] == kNone) {
+                    continue;
+                }
+                const std::size_t element = find(element_[n]);
+                if (state_[element] < state_[n]) {
+                    state_[element] = state_[n];
+                    changed = true;
+                }
+            }
+        }
+    }
+
+private:
+    std::size_t add()
+    {
+        parent_.push_back(parent_.size());
+        state_.push_back(EscapeState::Local);
+        element_.push_back(kNone);
+        return parent_.size() - 1;
+    }
+
+    std::unordered_map<const IRValue*, std::size_t> nodes_;
+    std::vector<std::size_t> parent_;
+    std::vector<EscapeState> state_;
+    std::vector<std::size_t> element_;
+};
+
+class FunctionEscapes {
+public:
+    FunctionEscapes(const IRFunction& function, const Summaries& summaries)
+        : function_(function), summaries_(summaries)
+    {
+        for (const IRArgument* argument : function.getArguments()) {
+            if (isHeapValue(argument)) {
+                classes_.node(argument);
+            }
+        }
+        for (const IRBasicBlock& block : function.getBasicBlocks()) {
+            for (const IRInstruction& inst : block) {
+                visit(inst);
+            }
+        }
+        classes_.propagate();
+    }
+
+    const std::vector<const IRInstruction*>& allocations() const { return allocations_; }
+
+    // Read before finish(): what callers need to know.
+    Summary summarize()
+    {
+        const auto& arguments = function_.getArguments();
+        Summary summary;
+        summary.parameters.assign(arguments.size(), EscapeState::Local);
+        summary.elementsEscape.assign(arguments.size(), false);
+        summary.elementsReturned.assign(arguments.size(), false);
+
+        // Classes the caller can reach other than through the return value.
+        std::vector<std::optional<std::size_t>> self(arguments.size());
+        std::vector<std::optional<std::size_t>> elements(arguments.size());
+        for (std::size_t i = 0; i < arguments.size(); ++i) {
+            if (isHeapValue(arguments[i])) {
+                self[i] = classes_.find(arguments[i]);
+                elements[i] = classes_.existingElementOf(*self[i]);
+            }
+        }
+        auto sharedWithCaller = [&](std::size_t cls, std::size_t except) {
+            for (std::size_t j = 0; j < arguments.size(); ++j) {
+                if ((j != except && self[j] == cls) || elements[j] == cls) {
+                    return true;
+                }
+            }
+            return false;
+        };
+
+        for (std::size_t i = 0; i < arguments.size(); ++i) {
+            if (self[i]) {
+                // Stored into another argument, the argument outlives the call.
+                summary.parameters[i] =
+                    sharedWithCaller(*self[i], i) ? EscapeState::Escaped : classes_.state(*self[i]);
+            }
+            if (elements[i]) {
+                summary.elementsEscape[i] = classes_.state(*elements[i]) == EscapeState::Escaped;
+            }
+        }
+        for (const std::size_t cls : returned_) {
+            const std::size_t root = classes_.find(cls);
+            summary.resultEscapes = summary.resultEscapes || classes_.state(root) == EscapeState::Escaped;
+            for (std::size_t j = 0; j < arguments.size(); ++j) {
+                if (elements[j] == root) {
+                    summary.elementsReturned[j] = true;
+                }
+            }
+        }
+        return summary;
+    }
+
+    // Whatever the caller reaches through an argument outlives this call, so objects
+    // stored into arguments are not local to it.
+    void finish()
+    {
+        for (const IRArgument* argument : function_.getArguments()) {
+            if (isHeapValue(argument)) {
+                classes_.raise(classes_.elementOf(classes_.node(argument)), EscapeState::Escaped);
+            }
+        }
+        classes_.propagate();
+    }
+
+    EscapeState stateOf(const IRValue* value)
+    {
+        const auto cls = classes_.find(value);
+        return cls ? classes_.state(*cls) : EscapeState::Local;
+    }
+
+private:
+    void visit(const IRInstruction& inst)
+    {
+        const bool heapResult = isHeapValue(&inst);
+        switch (inst.getOp()) {
+        case IRInstructionOp::Phi:
+            if (heapResult) {
+                for (std::size_t i = 0; i < inst.getNumOperands(); ++i) {
+                    if (isHeapValue(inst.getOperand(i))) {
+                        classes_.unify(classes_.node(&inst), classes_.node(inst.getOperand(i)));
+                    }
+                }
+            }
+            return;
+        case IRInstructionOp::Return:
+            if (inst.getNumOperands() > 0 && isHeapValue(inst.getOperand(0))) {
+                const std::size_t cls = classes_.node(inst.getOperand(0));
+                classes_.raise(cls, EscapeState::Returned);
+                returned_.push_back(cls);
+            }
+            return;
+        case IRInstructionOp::Call:
+            visitCall(inst, heapResult);
+            return;
+        default:
+            // Everything else reads its operands; a string result is a new string.
+            if (heapResult) {
+                classes_.node(&inst);
+                allocations_.push_back(&inst);
+            }
+            return;
+        }
+    }
+
+    void visitCall(const IRInstruction& call, bool heapResult)
+    {
+        auto argument = [&](int index) -> std::optional<std::size_t> {
+            if (index < 0 || static_cast<std::size_t>(index) >= call.getNumOperands() ||
+                !isHeapValue(call.getOperand(static_cast<std::size_t>(index)))) {
+                return std::nullopt;
+            }
+            return classes_.node(call.getOperand(static_cast<std::size_t>(index)));
+        };
+        const std::size_t result = heapResult ? classes_.node(&call) : kNone;
+
+        if (const auto summary = summaries_.find(call.getCallee()); summary != summaries_.end()) {
+            for (std::size_t i = 0; i < call.getNumOperands(); ++i) {
+                const auto arg = argument(static_cast<int>(i));
+                if (!arg || i >= summary->second.parameters.size()) {
+                    continue;
+                }
+                switch (summary->second.parameters[i]) {
+                case EscapeState::Escaped:
+                    classes_.raise(*arg, EscapeState::Escaped);
+                    break;
+                case EscapeState::Returned:
+                    if (result != kNone) {
+                        classes_.unify(result, *arg);
+                    }
+                    break;
+                case EscapeState::Local:
+                    break;
+                }
+                if (summary->second.elementsEscape[i]) {
+                    classes_.raise(classes_.elementOf(*arg), EscapeState::Escaped);
+                }
+                if (summary->second.elementsReturned[i] && result != kNone) {
+                    classes_.unify(result, classes_.elementOf(*arg));
+                }
+            }
+            if (result != kNone && summary->second.resultEscapes) {
+                classes_.raise(result, EscapeState::Escaped);
+            }
+            if (result != kNone && summary->second.fresh()) {
+                allocations_.push_back(&call);
+            }
+            return;
+        }
+
+        if (const auto effect = runtimeEffect(call.getCallee())) {
+            const auto container = argument(effect->container);
+            const auto stored = argument(effect->stored);
+            if (container && stored) {
+                classes_.unify(classes_.elementOf(*container), *stored);
+            }
+            if (result != kNone) {
+                if (const auto returned = argument(effect->returned)) {
+                    classes_.unify(result, *returned);
+                } else if (const auto source = argument(effect->loadedFrom)) {
+                    classes_.unify(result, classes_.elementOf(*source));
+                } else if (effect->allocates) {
+                    allocations_.push_back(&call);
+                }
+            }
+            return;
+        }
+
+        // An unknown function may keep anything it is given, and return anything.
+        for (std::size_t i = 0; i < call.getNumOperands(); ++i) {
+            if (const auto arg = argument(static_cast<int>(i))) {
+                classes_.raise(*arg, EscapeState::Escaped);
+            }
+        }
+        if (result != kNone) {
+            classes_.raise(result, EscapeState::Escaped);
+        }
+    }
+
+    const IRFunction& function_;
+    const Summaries& summaries_;
+    EscapeClasses classes_;
+    std::vector<const IRInstruction*> allocations_;
+    std::vector<std::size_t> returned_;
+};
+
+} // namespace
+
+const char* toString(EscapeState state)
+{
+    switch (state) {
+    case EscapeState::Local: return "local";
+    case EscapeState::Returned: return "returned";
+    case EscapeState::Escaped: return "escaped";
+    }
+    return "escaped";
+}
+
+EscapeState EscapeInfo::stateOf(const IRValue& value) const
+{
+    const auto it = states_.find(&value);
+    return it != states_.end() ? it->second : EscapeState::Local;
+}
+
+const std::vector<const IRInstruction*>& EscapeInfo::allocations(const IRFunction& function) const
+{
+    static const std::vector<const IRInstruction*> kNoAllocations;
+    const auto it = allocations_.find(&function);
+    return it != allocations_.end() ? it->second : kNoAllocations;
+}
+
+EscapeState EscapeInfo::parameterState(const IRFunction& function, std::size_t index) const
+{
+    const auto it = parameters_.find(&function);
+    return it != parameters_.end() && index < it->second.size() ? it->second[index] : EscapeState::Escaped;
+}
+
+EscapeInfo analyzeEscapes(const IRModule& module)
+{
+    Summaries summaries;
+    for (const auto& function : module.getFunctions()) {
+        const std::size_t parameters = function->getArguments().size();
+        summaries[function->getName()] = {std::vector<EscapeState>(parameters, EscapeState::Local),
+                                          std::vector<bool>(parameters, false), std::vector<bool>(parameters, false),
+                                          false};
+    }
+    // Summaries only ever get worse, so this terminates.
+    for (bool changed = true; changed;) {
+        changed = false;
+        for (const auto& function : module.getFunctions()) {
+            Summary summary = FunctionEscapes(*function, summaries).summarize();
+            Summary& current = summaries[function->getName()];
+            if (summary != current) {
+                current = std::move(summary);
+                changed = true;
+            }
+        }
+    }
+
+    EscapeInfo info;
+    for (const auto& function : module.getFunctions()) {
+        FunctionEscapes escapes(*function, summaries);
+        escapes.finish();
+        for (const IRArgument* argument : function->getArguments()) {
+            if (isHeapValue(argument)) {
+                info.states_[argument] = escapes.stateOf(argument);
+            }
+        }
+        for (const IRBasicBlock& block : function->getBasicBlocks()) {
+            for (const IRInstruction& inst : block) {
+                if (isHeapValue(&inst)) {
+                    info.states_[&inst] = escapes.stateOf(&inst);
+                }
+            }
+        }
+        info.allocations_[function.get()] = escapes.allocations();
+        info.parameters_[function.get()] = summaries[function->getName()].parameters;
+    }
+    return info;
+}
+
+void printEscapeReport(const IRModule& module, const EscapeInfo& info, std::ostream& out)
+{
+    std::unordered_set<const IRInstruction*> allocations;
+    for (const auto& function : module.getFunctions()) {
+        allocations.insert(info.allocations(*function).begin(), info.allocations(*function).end());
+    }
+    printModule(module, out, [&](const IRInstruction& inst) {
+        return allocations.contains(&inst) ? std::string("allocation, ") + toString(info.stateOf(inst))
+                                           : std::string{};
+    });
+}
+
+} // namespace istudio::ir
@@ -0,0 +1,192 @@
+#include "ir/GVN.h"
+
+#include "ir/Dominators.h"
+
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace istudio::ir {
+
+namespace {
+
+struct Expression {
+    IRInstructionOp op;
+    IRType type;
+    std::vector<const IRValue*> operands;
+    std::vector<const IRBasicBlock*> blocks; // Phi: the block itself, then the incoming blocks
+    std::uint64_t memory{0};                 // Load: memory generation it reads
+
+    bool operator==(const Expression&) const = default;
+};
+
+struct ExpressionHash {
+    std::size_t operator()(const Expression& expression) const
+    {
+        std::size_t hash = std::hash<int>{}(static_cast<int>(expression.op)) * 31 + static_cast<std::size_t>(expression.type);
+        auto mix = [&hash](std::size_t value) { hash ^= value + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2); };
+        for (const IRValue* operand : expression.operands) {
+            mix(std::hash<const IRValue*>{}(operand));
+        }
+        for (const IRBasicBlock* block : expression.blocks) {
+            mix(std::hash<const IRBasicBlock*>{}(block));
+        }
+        mix(static_cast<std::size_t>(expression.memory));
+        return hash;
+    }
+};
+
+bool isCommutative(IRInstructionOp op)
+{
+    switch (op) {
+    case IRInstructionOp::Add:
+    case IRInstructionOp::Mul:
+    case IRInstructionOp::And:
+    case IRInstructionOp::Or:
+    case IRInstructionOp::Xor:
+    case IRInstructionOp::Eq:
+    case IRInstructionOp::Ne:
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool isNumberable(IRInstructionOp op)
+{
+    switch (op) {
+    case IRInstructionOp::Add:
+    case IRInstructionOp::Sub:
+    case IRInstructionOp::Mul:
+    case IRInstructionOp::Div:
+    case IRInstructionOp::Rem:
+    case IRInstructionOp::And:
+    case IRInstructionOp::Or:
+    case IRInstructionOp::Xor:
+    case IRInstructionOp::Shl:
+    case IRInstructionOp::Shr:
+    case IRInstructionOp::Eq:
+    case IRInstructionOp::Ne:
+    case IRInstructionOp::Lt:
+    case IRInstructionOp::Le:
+    case IRInstructionOp::Gt:
+    case IRInstructionOp::Ge:
+    case IRInstructionOp::Neg:
+    case IRInstructionOp::Not:
+    case IRInstructionOp::GetElementPtr:
+    case IRInstructionOp::Load:
+    case IRInstructionOp::Phi:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// Instructions after which memory may hold different values.
+bool clobbersMemory(const IRInstruction& inst)
+{
+    return inst.getOp() == IRInstructionOp::Store || inst.getOp() == IRInstructionOp::Call;
+}
+
+Expression expressionOf(const IRInstruction& inst, std::uint64_t memory)
+{
+    Expression expression{inst.getOp(), inst.getType(), {}, {}, 0};
+    for (std::size_t i = 0; i < inst.getNumOperands(); ++i) {
+        expression.operands.push_back(inst.getOperand(i));
+    }
+    switch (inst.getOp()) {
+    case IRInstructionOp::Phi:
+        expression.blocks.push_back(inst.getParent());
+        expression.blocks.insert(expression.blocks.end(), inst.getBlocks().begin(), inst.getBlocks().end());
+        break;
+    case IRInstructionOp::Load:
+        expression.memory = memory;
+        break;
+    case IRInstructionOp::Gt: // a > b is b < a
+    case IRInstructionOp::Ge:
+        expression.op = inst.getOp() == IRInstructionOp::Gt ? IRInstructionOp::Lt : IRInstructionOp::Le;
+        std::swap(expression.operands[0], expression.operands[1]);
+        break;
+    default:
+        if (isCommutative(inst.getOp()) && expression.operands.size() == 2 &&
+            expression.operands[1]->getId() < expression.operands[0]->getId()) {
+            std::swap(expression.operands[0], expression.operands[1]);
+        }
+        break;
+    }
+    return expression;
+}
+
+} // namespace
+
+PreservedAnalyses GlobalValueNumbering::run(IRFunction&, FunctionAnalyses& analyses) const
+{
+    const DominatorTree& domTree = analyses.get<DominatorTreeAnalysis>();
+    if (!domTree.getRoot()) {
+        return PreservedAnalyses::all();
+    }
+
+    std::unordered_map<Expression, IRValue*, ExpressionHash> available;
+    std::vector<const Expression*> scopeLog; // insertions, undone when a subtree is left
+    std::unordered_map<const IRBasicBlock*, std::uint64_t> memoryAtExit;
+    std::uint64_t nextGeneration = 0;
+    bool changed = false;
+
+    struct Frame {
+        IRBasicBlock* block;
+        std::size_t nextChild;
+        std::size_t scopeStart;
+    };
+    std::vector<Frame> stack;
+
+    auto enter = [&](IRBasicBlock* block) {
+        stack.push_back({block, 0, scopeLog.size()});
+        // Loads can reuse a dominating load only when every path here comes through it.
+        const auto& preds = block->getPredecessors();
+        std::uint64_t memory = ++nextGeneration;
+        if (preds.size() == 1 && memoryAtExit.contains(preds.front())) {
+            memory = memoryAtExit[preds.front()];
+        }
+        for (auto it = block->begin(); it != block->end();) {
+            IRInstruction& inst = *it++;
+            if (clobbersMemory(inst)) {
+                memory = ++nextGeneration;
+                continue;
+            }
+            if (!isNumberable(inst.getOp()) || inst.getType() == IRType::Void) {
+                continue;
+            }
+            Expression expression = expressionOf(inst, memory);
+            const auto [entry, inserted] = available.try_emplace(std::move(expression), &inst);
+            if (inserted) {
+                scopeLog.push_back(&entry->first);
+            } else {
+                inst.replaceAllUsesWith(entry->second);
+                inst.eraseFromParent();
+                changed = true;
+            }
+        }
+        memoryAtExit[block] = memory;
+    };
+
+    enter(domTree.getRoot());
+    while (!stack.empty()) {
+        Frame& frame = stack.back();
+        const auto& children = domTree.getChildren(frame.block);
+        if (frame.nextChild < children.size()) {
+            enter(children[frame.nextChild++]);
+            continue;
+        }
+        while (scopeLog.size() > frame.scopeStart) {
+            available.erase(*scopeLog.back());
+            scopeLog.pop_back();
+        }
+        stack.pop_back();
+    }
+
+    return changed ? PreservedAnalyses::cfg() : PreservedAnalyses::all();
+}
+
+} // namespace istudio::ir
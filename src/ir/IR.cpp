@@ -1,9 +1,231 @@
 #include "ir/IR.h"
 
+#include <algorithm>
+
 namespace istudio::ir {
 
-// IR implementation is header-only for now
-// This allows for flexible extension and avoids linking issues
-// Specific instruction types can be added as needed
+const char* toString(IRType type)
+{
+    switch (type) {
+    case IRType::Void:
+        return "void";
+    case IRType::Bool:
+        return "bool";
+    case IRType::Int:
+        return "int";
+    case IRType::Float:
+        return "float";
+    case IRType::String:
+        return "string";
+    case IRType::Opaque:
+        return "opaque";
+    }
+    return "opaque";
+}
+
+IRType irTypeOf(std::string_view iplType)
+{
+    // Ownership qualifiers do not change the representation.
+    for (const std::string_view qualifier : {"owned<", "borrowed<", "ref<"}) {
+        if (iplType.starts_with(qualifier) && iplType.ends_with('>')) {
+            return irTypeOf(iplType.substr(qualifier.size(), iplType.size() - qualifier.size() - 1));
+        }
+    }
+    for (const std::string_view qualifier : {"owned ", "borrowed ", "ref "}) {
+        if (iplType.starts_with(qualifier)) {
+            return irTypeOf(iplType.substr(qualifier.size()));
+        }
+    }
+
+    if (iplType.empty() || iplType == "void") {
+        return IRType::Void;
+    }
+    if (iplType == "bool") {
+        return IRType::Bool;
+    }
+    if (iplType == "int" || iplType == "long" || iplType == "short" || iplType == "byte" || iplType == "char") {
+        return IRType::Int;
+    }
+    if (iplType == "float" || iplType == "double" || iplType == "number") {
+        return IRType::Float;
+    }
+    if (iplType == "string") {
+        return IRType::String;
+    }
+    return IRType::Opaque;
+}
+
+const char* toString(IRInstructionOp op)
+{
+    switch (op) {
+    case IRInstructionOp::Add:
+        return "add";
+    case IRInstructionOp::Sub:
+        return "sub";
+    case IRInstructionOp::Mul:
+        return "mul";
+    case IRInstructionOp::Div:
+        return "div";
+    case IRInstructionOp::Rem:
+        return "rem";
+    case IRInstructionOp::And:
+        return "and";
+    case IRInstructionOp::Or:
+        return "or";
+    case IRInstructionOp::Xor:
+        return "xor";
+    case IRInstructionOp::Shl:
+        return "shl";
+    case IRInstructionOp::Shr:
+        return "shr";
+    case IRInstructionOp::Eq:
+        return "eq";
+    case IRInstructionOp::Ne:
+        return "ne";
+    case IRInstructionOp::Lt:
+        return "lt";
+    case IRInstructionOp::Le:
+        return "le";
+    case IRInstructionOp::Gt:
+        return "gt";
+    case IRInstructionOp::Ge:
+        return "ge";
+    case IRInstructionOp::Neg:
+        return "neg";
+    case IRInstructionOp::Not:
+        return "not";
+    case IRInstructionOp::Assign:
+        return "assign";
+    case IRInstructionOp::Call:
+        return "call";
+    case IRInstructionOp::Return:
+        return "ret";
+    case IRInstructionOp::Branch:
+        return "br";
+    case IRInstructionOp::BranchIf:
+        return "br_if";
+    case IRInstructionOp::Phi:
+        return "phi";
+    case IRInstructionOp::Load:
+        return "load";
+    case IRInstructionOp::Store:
+        return "store";
+    case IRInstructionOp::Alloca:
+        return "alloca";
+    case IRInstructionOp::GetElementPtr:
+        return "gep";
+    }
+    return "unknown";
+}
+
+void IRUse::set(IRValue* value)
+{
+    if (value_) {
+        (prevUse_ ? prevUse_->nextUse_ : value_->firstUse_) = nextUse_;
+        if (nextUse_) {
+            nextUse_->prevUse_ = prevUse_;
+        }
+    }
+    value_ = value;
+    prevUse_ = nullptr;
+    nextUse_ = nullptr;
+    if (value_) {
+        nextUse_ = value_->firstUse_;
+        if (nextUse_) {
+            nextUse_->prevUse_ = this;
+        }
+        value_->firstUse_ = this;
+    }
+}
+
+std::size_t IRValue::getNumUses() const
+{
+    std::size_t count = 0;
+    for (IRUse* use = firstUse_; use; use = use->getNextUse()) {
+        ++count;
+    }
+    return count;
+}
+
+void IRValue::replaceAllUsesWith(IRValue* replacement)
+{
+    if (replacement == this) {
+        return;
+    }
+    while (firstUse_) {
+        firstUse_->set(replacement);
+    }
+}
+
+void IRInstruction::addOperand(IRValue* value)
+{
+    IRUse* use = function_->getArena().create<IRUse>(this, static_cast<unsigned>(operands_.size()));
+    use->set(value);
+    operands_.push_back(use);
+}
+
+void IRInstruction::removeOperand(std::size_t index)
+{
+    operands_[index]->set(nullptr);
+    operands_.erase(operands_.begin() + static_cast<std::ptrdiff_t>(index));
+    for (std::size_t i = index; i < operands_.size(); ++i) {
+        operands_[i]->index_ = static_cast<unsigned>(i);
+    }
+}
+
+void IRInstruction::dropAllReferences()
+{
+    for (IRUse* use : operands_) {
+        use->set(nullptr);
+    }
+}
+
+void IRInstruction::eraseFromParent()
+{
+    dropAllReferences();
+    if (parent_) {
+        parent_->remove(this);
+    }
+}
+
+void IRBasicBlock::removeIncomingEdge(IRBasicBlock* pred)
+{
+    const auto it = std::find(predecessors_.begin(), predecessors_.end(), pred);
+    if (it != predecessors_.end()) {
+        predecessors_.erase(it);
+    }
+    for (IRInstruction* phi = instructions_.front(); phi && phi->getOp() == IRInstructionOp::Phi;
+         phi = phi->getNextNode()) {
+        const auto& blocks = phi->getBlocks();
+        const auto incoming = std::find(blocks.begin(), blocks.end(), pred);
+        if (incoming != blocks.end()) {
+            const auto index = static_cast<std::size_t>(incoming - blocks.begin());
+            phi->removeOperand(index);
+            phi->removeBlock(index);
+        }
+    }
+}
+
+void IRBasicBlock::replacePredecessor(IRBasicBlock* from, IRBasicBlock* to)
+{
+    std::replace(predecessors_.begin(), predecessors_.end(), from, to);
+    for (IRInstruction* phi = instructions_.front(); phi && phi->getOp() == IRInstructionOp::Phi;
+         phi = phi->getNextNode()) {
+        for (std::size_t i = 0; i < phi->getBlocks().size(); ++i) {
+            if (phi->getBlocks()[i] == from) {
+                phi->setBlock(i, to);
+            }
+        }
+    }
+}
+
+IRConstant* IRFunction::getConstant(IRType type, IRConstantValue value)
+{
+    auto [it, inserted] = constants_.try_emplace({type, value}, nullptr);
+    if (inserted) {
+        it->second = arena_.create<IRConstant>(type, std::move(value), nextId_++);
+    }
+    return it->second;
+}
 
-} // namespace istudio::ir
\ No newline at end of file
+} // namespace istudio::ir
@@ -0,0 +1,635 @@
+#include "ir/IRParser.h"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstring>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace istudio::ir {
+
+namespace {
+
+struct ParseError {
+    std::size_t line;
+    std::string message;
+};
+
+bool isNameChar(char c)
+{
+    return std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '.' || c == '$' || c == '-';
+}
+
+// The tokens of one line, read on demand. `;` starts a comment outside strings.
+class LineLexer {
+public:
+    LineLexer(std::string_view text, std::size_t line) : rest_(text), line_(line) {}
+
+    [[noreturn]] void error(std::string message) const { throw ParseError{line_, std::move(message)}; }
+    [[nodiscard]] std::size_t line() const { return line_; }
+
+    bool atEnd()
+    {
+        skipSpace();
+        return rest_.empty() || rest_.front() == ';';
+    }
+
+    // The text of the trailing comment; call once atEnd() holds.
+    [[nodiscard]] std::string_view comment() const { return rest_.empty() ? rest_ : rest_.substr(1); }
+
+    bool peek(char c)
+    {
+        skipSpace();
+        return !rest_.empty() && rest_.front() == c;
+    }
+
+    bool accept(char c)
+    {
+        if (!peek(c)) {
+            return false;
+        }
+        rest_.remove_prefix(1);
+        return true;
+    }
+
+    void expect(char c)
+    {
+        if (!accept(c)) {
+            error(std::string("expected '") + c + "' at " + describeNext());
+        }
+    }
+
+    std::string_view word()
+    {
+        skipSpace();
+        const std::string_view text = takeNameChars();
+        if (text.empty()) {
+            error("expected a name at " + describeNext());
+        }
+        return text;
+    }
+
+    bool acceptWord(std::string_view expected)
+    {
+        skipSpace();
+        std::size_t length = 0;
+        while (length < rest_.size() && isNameChar(rest_[length])) {
+            ++length;
+        }
+        if (rest_.substr(0, length) != expected) {
+            return false;
+        }
+        rest_.remove_prefix(length);
+        return true;
+    }
+
+    void expectWord(std::string_view expected)
+    {
+        if (!acceptWord(expected)) {
+            error("expected '" + std::string(expected) + "' at " + describeNext());
+        }
+    }
+
+    // `%name` or `@name`; no space after the sigil.
+    std::string name(char sigil)
+    {
+        expect(sigil);
+        const std::string_view text = takeNameChars();
+        if (text.empty()) {
+            error(std::string("expected a name after '") + sigil + "'");
+        }
+        return std::string(text);
+    }
+
+    // A number: digits, sign, point, exponent, or inf/nan.
+    std::string_view number()
+    {
+        skipSpace();
+        std::size_t length = 0;
+        while (length < rest_.size() &&
+               (std::isalnum(static_cast<unsigned char>(rest_[length])) || rest_[length] == '.' ||
+                rest_[length] == '+' || rest_[length] == '-')) {
+            ++length;
+        }
+        const std::string_view text = rest_.substr(0, length);
+        rest_.remove_prefix(length);
+        return text;
+    }
+
+    // A string constant in source spelling: the text between the quotes, escapes
+    // kept as written.
+    std::string string()
+    {
+        expect('"');
+        std::size_t length = 0;
+        while (length < rest_.size() && rest_[length] != '"') {
+            length += rest_[length] == '\\' ? 2 : 1;
+        }
+        if (length >= rest_.size()) {
+            error("unterminated string");
+        }
+        std::string text(rest_.substr(0, length));
+        rest_.remove_prefix(length + 1);
+        return text;
+    }
+
+private:
+    void skipSpace()
+    {
+        while (!rest_.empty() && (rest_.front() == ' ' || rest_.front() == '\t' || rest_.front() == '\r')) {
+            rest_.remove_prefix(1);
+        }
+    }
+
+    std::string_view takeNameChars()
+    {
+        std::size_t length = 0;
+        while (length < rest_.size() && isNameChar(rest_[length])) {
+            ++length;
+        }
+        const std::string_view text = rest_.substr(0, length);
+        rest_.remove_prefix(length);
+        return text;
+    }
+
+    std::string describeNext() const
+    {
+        if (rest_.empty() || rest_.front() == ';') {
+            return "end of line";
+        }
+        std::string text = "`";
+        text += rest_;
+        return text + '`';
+    }
+
+    std::string_view rest_;
+    std::size_t line_;
+};
+
+IRType parseType(LineLexer& lex)
+{
+    const std::string_view text = lex.word();
+    for (const IRType type : {IRType::Void, IRType::Bool, IRType::Int, IRType::Float, IRType::String,
+                              IRType::Opaque}) {
+        if (text == toString(type)) {
+            return type;
+        }
+    }
+    lex.error("unknown type '" + std::string(text) + "'");
+}
+
+IRInstructionOp parseOp(LineLexer& lex)
+{
+    const std::string_view text = lex.word();
+    for (auto op = static_cast<unsigned>(IRInstructionOp::Add);
+         op <= static_cast<unsigned>(IRInstructionOp::GetElementPtr); ++op) {
+        if (text == toString(static_cast<IRInstructionOp>(op))) {
+            return static_cast<IRInstructionOp>(op);
+        }
+    }
+    lex.error("unknown instruction '" + std::string(text) + "'");
+}
+
+// An operand as written: a name resolved once the whole function is read, or a
+// constant, which needs nothing else.
+struct Operand {
+    std::string name;
+    IRValue* constant{nullptr};
+};
+
+// One instruction line, before the values it refers to all exist.
+struct InstructionRecord {
+    std::size_t line{0};
+    std::size_t block{0};
+    IRInstructionOp op{IRInstructionOp::Add};
+    IRType type{IRType::Void};
+    std::string result;
+    std::vector<Operand> operands;
+    std::vector<std::string> blocks;
+    std::string callee;
+    bool tailCall{false};
+};
+
+struct BlockRecord {
+    std::size_t line{0};
+    std::string name;
+    bool hasPreds{false};
+    std::vector<std::string> preds;
+};
+
+class FunctionParser {
+public:
+    FunctionParser(std::string name, IRType returnType)
+        : function_(std::make_unique<IRFunction>(std::move(name), returnType)) {}
+
+    void addArgument(LineLexer& lex, IRType type, std::string name)
+    {
+        define(lex, name, function_->addArgument(name, type));
+    }
+
+    // One line of the body.
+    void parseLine(LineLexer& lex)
+    {
+        if (!lex.peek('%')) {
+            // A label, or an instruction without a result.
+            LineLexer probe = lex;
+            const std::string_view word = probe.word();
+            if (probe.accept(':')) {
+                lex = probe;
+                parseLabel(lex, std::string(word));
+                return;
+            }
+        }
+        if (blocks_.empty()) {
+            lex.error("instruction before the first label");
+        }
+        records_.push_back(parseInstruction(lex));
+    }
+
+    std::unique_ptr<IRFunction> finish(std::size_t line)
+    {
+        if (blocks_.empty()) {
+            throw ParseError{line, "function '" + function_->getName() + "' has no blocks"};
+        }
+        createBlocks();
+        std::vector<IRInstruction*> instructions;
+        for (const InstructionRecord& record : records_) {
+            IRInstruction* inst = blockValues_[record.block]->append(function_->createInstruction(record.op, record.type));
+            instructions.push_back(inst);
+            if (!record.result.empty()) {
+                LineLexer at({}, record.line);
+                define(at, record.result, inst);
+            }
+        }
+        for (std::size_t i = 0; i < records_.size(); ++i) {
+            const InstructionRecord& record = records_[i];
+            for (const Operand& operand : record.operands) {
+                instructions[i]->addOperand(operand.constant ? operand.constant : lookup(record.line, operand.name));
+            }
+            for (const std::string& target : record.blocks) {
+                instructions[i]->addBlock(lookupBlock(record.line, target));
+            }
+            instructions[i]->setCallee(record.callee);
+            instructions[i]->setTailCall(record.tailCall);
+        }
+        linkPredecessors();
+        return std::move(function_);
+    }
+
+private:
+    void define(const LineLexer& lex, const std::string& name, IRValue* value)
+    {
+        if (!values_.emplace(name, value).second) {
+            lex.error("%" + name + " is defined more than once");
+        }
+    }
+
+    IRValue* lookup(std::size_t line, const std::string& name) const
+    {
+        const auto it = values_.find(name);
+        if (it == values_.end()) {
+            throw ParseError{line, "unknown value %" + name};
+        }
+        return it->second;
+    }
+
+    IRBasicBlock* lookupBlock(std::size_t line, const std::string& name) const
+    {
+        const auto it = blockIndex_.find(name);
+        if (it == blockIndex_.end()) {
+            throw ParseError{line, "unknown block %" + name};
+        }
+        return blockValues_[it->second];
+    }
+
+    void parseLabel(LineLexer& lex, std::string name)
+    {
+        BlockRecord block{lex.line(), std::move(name), false, {}};
+        if (!blockIndex_.emplace(block.name, blocks_.size()).second) {
+            lex.error("block %" + block.name + " is defined more than once");
+        }
+        if (!lex.atEnd()) {
+            lex.error("unexpected text after the label");
+        }
+        LineLexer comment(lex.comment(), lex.line());
+        if (comment.acceptWord("preds")) {
+            comment.expect('=');
+            block.hasPreds = true;
+            while (!comment.atEnd()) {
+                block.preds.push_back(comment.name('%'));
+            }
+        }
+        blocks_.push_back(std::move(block));
+    }
+
+    Operand parseOperand(LineLexer& lex, IRType undefType)
+    {
+        if (lex.peek('%')) {
+            return {lex.name('%')};
+        }
+        if (lex.peek('"')) {
+            return {{}, function_->getConstant(IRType::String, lex.string())};
+        }
+        if (lex.acceptWord("true")) {
+            return {{}, function_->getConstant(IRType::Bool, true)};
+        }
+        if (lex.acceptWord("false")) {
+            return {{}, function_->getConstant(IRType::Bool, false)};
+        }
+        if (lex.acceptWord("undef")) {
+            return {{}, function_->getUndef(undefType)};
+        }
+        const std::string_view text = lex.number();
+        if (text.empty()) {
+            lex.error("expected an operand");
+        }
+        const char* end = text.data() + text.size();
+        if (text.find_first_of(".eEnN") == std::string_view::npos) {
+            std::int64_t value = 0;
+            if (const auto result = std::from_chars(text.data(), end, value); result.ptr == end) {
+                return {{}, function_->getConstant(IRType::Int, value)};
+            }
+        } else {
+            // from_chars takes no leading '+'.
+            const char* begin = text.front() == '+' ? text.data() + 1 : text.data();
+            double value = 0;
+            if (const auto result = std::from_chars(begin, end, value); result.ptr == end) {
+                return {{}, function_->getConstant(IRType::Float, value)};
+            }
+        }
+        lex.error("bad number '" + std::string(text) + "'");
+    }
+
+    Operand parseTypedOperand(LineLexer& lex)
+    {
+        const IRType type = parseType(lex);
+        return parseOperand(lex, type);
+    }
+
+    InstructionRecord parseInstruction(LineLexer& lex)
+    {
+        InstructionRecord record;
+        record.line = lex.line();
+        record.block = blocks_.size() - 1;
+        if (lex.peek('%')) {
+            record.result = lex.name('%');
+            lex.expect('=');
+        }
+        record.tailCall = lex.acceptWord("tail");
+        record.op = parseOp(lex);
+        if (record.tailCall && record.op != IRInstructionOp::Call) {
+            lex.error("only a call can be a tail call");
+        }
+        switch (record.op) {
+        case IRInstructionOp::Return:
+            if (!lex.acceptWord("void")) {
+                record.operands.push_back(parseTypedOperand(lex));
+            }
+            break;
+        case IRInstructionOp::Branch:
+            lex.expectWord("label");
+            record.blocks.push_back(lex.name('%'));
+            break;
+        case IRInstructionOp::BranchIf:
+            record.operands.push_back(parseTypedOperand(lex));
+            for (int i = 0; i < 2; ++i) {
+                lex.expect(',');
+                lex.expectWord("label");
+                record.blocks.push_back(lex.name('%'));
+            }
+            break;
+        case IRInstructionOp::Phi:
+            record.type = parseType(lex);
+            if (!lex.atEnd()) {
+                do {
+                    lex.expect('[');
+                    record.operands.push_back(parseOperand(lex, record.type));
+                    lex.expect(',');
+                    record.blocks.push_back(lex.name('%'));
+                    lex.expect(']');
+                } while (lex.accept(','));
+            }
+            break;
+        case IRInstructionOp::Call:
+            record.type = parseType(lex);
+            record.callee = lex.name('@');
+            lex.expect('(');
+            if (!lex.accept(')')) {
+                do {
+                    record.operands.push_back(parseTypedOperand(lex));
+                } while (lex.accept(','));
+                lex.expect(')');
+            }
+            break;
+        default:
+            record.type = parseType(lex);
+            if (!lex.atEnd()) {
+                do {
+                    record.operands.push_back(parseOperand(lex, record.type));
+                } while (lex.accept(','));
+            }
+            break;
+        }
+        if (!lex.atEnd()) {
+            lex.error("unexpected text at the end of the instruction");
+        }
+        if (record.type != IRType::Void && record.result.empty()) {
+            lex.error("the result needs a name (%name = ...)");
+        }
+        if (record.type == IRType::Void && !record.result.empty()) {
+            lex.error("a void instruction has no result to name");
+        }
+        return record;
+    }
+
+    // The printer appends a block's position to its label, which is undone here so
+    // that the block prints under the same name again.
+    void createBlocks()
+    {
+        for (std::size_t i = 0; i < blocks_.size(); ++i) {
+            std::string_view label = blocks_[i].name;
+            const std::string suffix = std::to_string(i);
+            if (i > 0 && label.ends_with(suffix)) {
+                label.remove_suffix(suffix.size());
+            }
+            // Labels are views, so their text is copied into the function's arena.
+            auto* text = static_cast<char*>(function_->getArena().allocate(label.size(), 1));
+            std::memcpy(text, label.data(), label.size());
+            blockValues_.push_back(
+                function_->insertBlock(function_->createBlock(std::string_view(text, label.size()))));
+        }
+    }
+
+    void linkPredecessors()
+    {
+        std::unordered_map<const IRBasicBlock*, std::vector<IRBasicBlock*>> edges;
+        for (IRBasicBlock* block : blockValues_) {
+            for (const IRBasicBlock* successor : block->getSuccessors()) {
+                edges[successor].push_back(block);
+            }
+        }
+        for (std::size_t i = 0; i < blocks_.size(); ++i) {
+            std::vector<IRBasicBlock*>& incoming = edges[blockValues_[i]];
+            if (blocks_[i].hasPreds) {
+                std::vector<IRBasicBlock*> listed;
+                for (const std::string& pred : blocks_[i].preds) {
+                    listed.push_back(lookupBlock(blocks_[i].line, pred));
+                }
+                auto sorted = incoming;
+                auto sortedListed = listed;
+                std::ranges::sort(sorted);
+                std::ranges::sort(sortedListed);
+                if (sorted != sortedListed) {
+                    throw ParseError{blocks_[i].line, "preds of %" + blocks_[i].name + " do not match the branches"};
+                }
+                incoming = std::move(listed);
+            }
+            for (IRBasicBlock* pred : incoming) {
+                blockValues_[i]->addPredecessor(pred);
+            }
+        }
+    }
+
+    std::unique_ptr<IRFunction> function_;
+    std::unordered_map<std::string, IRValue*> values_;
+    std::vector<BlockRecord> blocks_;
+    std::unordered_map<std::string, std::size_t> blockIndex_;
+    std::vector<IRBasicBlock*> blockValues_;
+    std::vector<InstructionRecord> records_;
+};
+
+class ModuleParser {
+public:
+    explicit ModuleParser(std::string_view text) : text_(text) {}
+
+    // The name on the module line.
+    std::string parseHeader()
+    {
+        LineLexer lex = nextLine("expected 'module <name>'");
+        lex.expectWord("module");
+        std::string name(lex.word());
+        if (!lex.atEnd()) {
+            lex.error("unexpected text after the module name");
+        }
+        return name;
+    }
+
+    std::vector<std::unique_ptr<IRFunction>> parseFunctions()
+    {
+        std::vector<std::unique_ptr<IRFunction>> functions;
+        while (skipBlankLines()) {
+            functions.push_back(parseFunction());
+        }
+        return functions;
+    }
+
+private:
+    // Moves to the next line with something on it; false at the end of the text.
+    bool skipBlankLines()
+    {
+        while (position_ < text_.size()) {
+            const std::size_t end = std::min(text_.find('\n', position_), text_.size());
+            LineLexer lex(text_.substr(position_, end - position_), line_ + 1);
+            if (!lex.atEnd()) {
+                return true;
+            }
+            position_ = end + 1;
+            ++line_;
+        }
+        return false;
+    }
+
+    LineLexer nextLine(const std::string& expected)
+    {
+        if (!skipBlankLines()) {
+            throw ParseError{line_, expected + " before the end of the file"};
+        }
+        const std::size_t end = std::min(text_.find('\n', position_), text_.size());
+        LineLexer lex(text_.substr(position_, end - position_), ++line_);
+        position_ = end + 1;
+        return lex;
+    }
+
+    std::unique_ptr<IRFunction> parseFunction()
+    {
+        LineLexer header = nextLine("expected a function");
+        header.expectWord("function");
+        const IRType returnType = parseType(header);
+        std::string name = header.name('@');
+        if (!names_.insert(name).second) {
+            header.error("function '" + name + "' is defined more than once");
+        }
+        FunctionParser function(std::move(name), returnType);
+        header.expect('(');
+        if (!header.accept(')')) {
+            do {
+                const IRType type = parseType(header);
+                function.addArgument(header, type, header.name('%'));
+            } while (header.accept(','));
+            header.expect(')');
+        }
+        header.expect('{');
+        if (!header.atEnd()) {
+            header.error("unexpected text after '{'");
+        }
+        while (true) {
+            LineLexer lex = nextLine("expected '}'");
+            if (lex.accept('}')) {
+                if (!lex.atEnd()) {
+                    lex.error("unexpected text after '}'");
+                }
+                return function.finish(lex.line());
+            }
+            function.parseLine(lex);
+        }
+    }
+
+    std::string_view text_;
+    std::size_t position_{0};
+    std::size_t line_{0};
+    std::unordered_set<std::string> names_;
+};
+
+} // namespace
+
+std::expected<std::unique_ptr<IRModule>, std::string> parseModule(std::string_view text)
+{
+    try {
+        ModuleParser parser(text);
+        auto module = std::make_unique<IRModule>(parser.parseHeader());
+        for (auto& function : parser.parseFunctions()) {
+            module->addFunction(std::move(function));
+        }
+        return module;
+    } catch (const ParseError& error) {
+        return std::unexpected("line " + std::to_string(error.line) + ": " + error.message);
+    }
+}
+
+std::expected<void, std::string> parseInto(IRModule& module, std::string_view text)
+{
+    std::vector<std::unique_ptr<IRFunction>> functions;
+    try {
+        ModuleParser parser(text);
+        parser.parseHeader();
+        functions = parser.parseFunctions();
+    } catch (const ParseError& error) {
+        return std::unexpected("line " + std::to_string(error.line) + ": " + error.message);
+    }
+    for (const auto& existing : module.getFunctions()) {
+        for (const auto& function : functions) {
+            if (function->getName() == existing->getName()) {
+                return std::unexpected("function '" + function->getName() + "' is defined more than once");
+            }
+        }
+    }
+    for (auto& function : functions) {
+        module.addFunction(std::move(function));
+    }
+    return {};
+}
+
+} // namespace istudio::ir
@@ -0,0 +1,192 @@
+#include "ir/IRPrinter.h"
+
+#include <charconv>
+#include <sstream>
+#include <vector>
+
+namespace istudio::ir {
+
+namespace {
+
+std::string formatDouble(double value)
+{
+    char buffer[64];
+    const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    std::string text(buffer, result.ptr);
+    if (text.find_first_of(".eEn") == std::string::npos) {
+        text += ".0"; // keep floats distinguishable from ints
+    }
+    return text;
+}
+
+// Names of the values of one function, made up when printing: instructions are
+// numbered in program order, blocks are their label plus position.
+class SlotTracker {
+public:
+    explicit SlotTracker(const IRFunction& function) : names_(function.getValueCount())
+    {
+        std::size_t blockIndex = 0;
+        std::size_t valueIndex = 0;
+        for (const IRArgument* argument : function.getArguments()) {
+            names_[argument->getId()] = argument->getName();
+        }
+        for (const IRBasicBlock& block : function.getBasicBlocks()) {
+            std::string label(block.getLabel());
+            if (blockIndex > 0) {
+                label += std::to_string(blockIndex);
+            }
+            names_[block.getId()] = std::move(label);
+            ++blockIndex;
+            for (const IRInstruction& inst : block) {
+                if (inst.getType() != IRType::Void) {
+                    names_[inst.getId()] = std::to_string(valueIndex++);
+                }
+            }
+        }
+    }
+
+    std::string name(const IRValue& value) const
+    {
+        // Values of another function (only ever seen in broken IR) are out of range.
+        const std::string* name = value.getId() < names_.size() ? &names_[value.getId()] : nullptr;
+        return !name || name->empty() ? "<detached>" : *name;
+    }
+
+    std::string operand(const IRValue* value) const
+    {
+        if (!value) {
+            return "<null>";
+        }
+        if (value->getKind() != IRValueKind::Constant) {
+            return '%' + name(*value);
+        }
+        const auto& constant = static_cast<const IRConstant*>(value)->getValue();
+        if (std::holds_alternative<bool>(constant)) {
+            return std::get<bool>(constant) ? "true" : "false";
+        }
+        if (std::holds_alternative<std::int64_t>(constant)) {
+            return std::to_string(std::get<std::int64_t>(constant));
+        }
+        if (std::holds_alternative<double>(constant)) {
+            return formatDouble(std::get<double>(constant));
+        }
+        if (std::holds_alternative<std::string>(constant)) {
+            return '"' + std::get<std::string>(constant) + '"'; // source spelling, escapes included
+        }
+        return "undef";
+    }
+
+    std::string typedOperand(const IRValue* value) const
+    {
+        return std::string(toString(value ? value->getType() : IRType::Opaque)) + ' ' + operand(value);
+    }
+
+private:
+    std::vector<std::string> names_; // by value id
+};
+
+void printInstruction(const IRInstruction& inst, const SlotTracker& slots, std::ostream& out)
+{
+    if (inst.getType() != IRType::Void) {
+        out << slots.operand(&inst) << " = ";
+    }
+    const std::size_t operandCount = inst.getNumOperands();
+    const auto& blocks = inst.getBlocks();
+    out << (inst.isTailCall() ? "tail " : "") << toString(inst.getOp());
+
+    switch (inst.getOp()) {
+    case IRInstructionOp::Return:
+        out << ' ' << (operandCount == 0 ? "void" : slots.typedOperand(inst.getOperand(0)));
+        break;
+    case IRInstructionOp::Branch:
+        out << " label " << slots.operand(blocks.front());
+        break;
+    case IRInstructionOp::BranchIf:
+        out << ' ' << slots.typedOperand(inst.getOperand(0)) << ", label " << slots.operand(blocks[0])
+            << ", label " << slots.operand(blocks[1]);
+        break;
+    case IRInstructionOp::Phi:
+        out << ' ' << toString(inst.getType());
+        for (std::size_t i = 0; i < operandCount; ++i) {
+            out << (i > 0 ? ", " : " ") << "[ " << slots.operand(inst.getOperand(i)) << ", "
+                << slots.operand(blocks[i]) << " ]";
+        }
+        break;
+    case IRInstructionOp::Call:
+        out << ' ' << toString(inst.getType()) << " @" << inst.getCallee() << '(';
+        for (std::size_t i = 0; i < operandCount; ++i) {
+            out << (i > 0 ? ", " : "") << slots.typedOperand(inst.getOperand(i));
+        }
+        out << ')';
+        break;
+    default:
+        out << ' ' << toString(inst.getType());
+        for (std::size_t i = 0; i < operandCount; ++i) {
+            out << (i > 0 ? ", " : " ") << slots.operand(inst.getOperand(i));
+        }
+        break;
+    }
+}
+
+} // namespace
+
+void printFunction(const IRFunction& function, std::ostream& out) { printFunction(function, out, nullptr); }
+
+void printFunction(const IRFunction& function, std::ostream& out, const InstructionAnnotator& annotate)
+{
+    const SlotTracker slots(function);
+    out << "function " << toString(function.getType()) << " @" << function.getName() << '(';
+    const auto& arguments = function.getArguments();
+    for (std::size_t i = 0; i < arguments.size(); ++i) {
+        out << (i > 0 ? ", " : "") << slots.typedOperand(arguments[i]);
+    }
+    out << ") {\n";
+    for (const IRBasicBlock& block : function.getBasicBlocks()) {
+        out << slots.name(block) << ":";
+        if (!block.getPredecessors().empty()) {
+            out << "  ; preds =";
+            for (const auto* pred : block.getPredecessors()) {
+                out << ' ' << slots.operand(pred);
+            }
+        }
+        out << '\n';
+        for (const IRInstruction& inst : block) {
+            out << "  ";
+            printInstruction(inst, slots, out);
+            if (annotate) {
+                if (const std::string note = annotate(inst); !note.empty()) {
+                    out << "  ; " << note;
+                }
+            }
+            out << '\n';
+        }
+    }
+    out << "}\n";
+}
+
+void printModule(const IRModule& module, std::ostream& out) { printModule(module, out, nullptr); }
+
+void printModule(const IRModule& module, std::ostream& out, const InstructionAnnotator& annotate)
+{
+    out << "module " << module.getName() << '\n';
+    for (const auto& function : module.getFunctions()) {
+        out << '\n';
+        printFunction(*function, out, annotate);
+    }
+}
+
+std::string toString(const IRModule& module)
+{
+    std::ostringstream out;
+    printModule(module, out);
+    return out.str();
+}
+
+std::string toString(const IRInstruction& inst)
+{
+    std::ostringstream out;
+    printInstruction(inst, SlotTracker(*inst.getFunction()), out);
+    return out.str();
+}
+
+} // namespace istudio::ir
@@ -0,0 +1,213 @@
+#include "ir/InductionVariables.h"
+
+#include <utility>
+#include <variant>
+
+namespace istudio::ir {
+
+namespace {
+
+std::optional<std::int64_t> intConstant(const IRValue* value)
+{
+    if (value->getKind() != IRValueKind::Constant) {
+        return std::nullopt;
+    }
+    const auto* integer = std::get_if<std::int64_t>(&static_cast<const IRConstant*>(value)->getValue());
+    return integer ? std::optional<std::int64_t>(*integer) : std::nullopt;
+}
+
+std::optional<std::size_t> incomingIndex(const IRInstruction& phi, const IRBasicBlock* block)
+{
+    const auto& blocks = phi.getBlocks();
+    for (std::size_t i = 0; i < blocks.size(); ++i) {
+        if (blocks[i] == block) {
+            return i;
+        }
+    }
+    return std::nullopt;
+}
+
+IRInstructionOp inverse(IRInstructionOp predicate)
+{
+    switch (predicate) {
+    case IRInstructionOp::Lt: return IRInstructionOp::Ge;
+    case IRInstructionOp::Le: return IRInstructionOp::Gt;
+    case IRInstructionOp::Gt: return IRInstructionOp::Le;
+    case IRInstructionOp::Ge: return IRInstructionOp::Lt;
+    case IRInstructionOp::Eq: return IRInstructionOp::Ne;
+    default: return IRInstructionOp::Eq;
+    }
+}
+
+// The predicate with its operands swapped: a < b is b > a.
+IRInstructionOp swapped(IRInstructionOp predicate)
+{
+    switch (predicate) {
+    case IRInstructionOp::Lt: return IRInstructionOp::Gt;
+    case IRInstructionOp::Le: return IRInstructionOp::Ge;
+    case IRInstructionOp::Gt: return IRInstructionOp::Lt;
+    case IRInstructionOp::Ge: return IRInstructionOp::Le;
+    default: return predicate;
+    }
+}
+
+bool isComparison(IRInstructionOp op)
+{
+    switch (op) {
+    case IRInstructionOp::Eq:
+    case IRInstructionOp::Ne:
+    case IRInstructionOp::Lt:
+    case IRInstructionOp::Le:
+    case IRInstructionOp::Gt:
+    case IRInstructionOp::Ge:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// Iterations of `for (i = start; i <predicate> bound; i += step)`, or nullopt when
+// the loop does not terminate that way. Operands are kept below 2^61 in magnitude, so
+// none of the arithmetic below overflows.
+std::optional<std::uint64_t> countIterations(std::int64_t start, std::int64_t step, IRInstructionOp predicate,
+                                             std::int64_t bound)
+{
+    constexpr std::int64_t kLimit = std::int64_t{1} << 61;
+    if (start <= -kLimit || start >= kLimit || bound <= -kLimit || bound >= kLimit || step <= -kLimit ||
+        step >= kLimit) {
+        return std::nullopt;
+    }
+    auto ceilDiv = [](std::int64_t a, std::int64_t b) { return (a + b - 1) / b; };
+    switch (predicate) {
+    case IRInstructionOp::Le:
+        return countIterations(start, step, IRInstructionOp::Lt, bound + 1);
+    case IRInstructionOp::Ge:
+        return countIterations(start, step, IRInstructionOp::Gt, bound - 1);
+    case IRInstructionOp::Lt:
+        if (start >= bound) {
+            return 0;
+        }
+        return step > 0 ? std::optional<std::uint64_t>(static_cast<std::uint64_t>(ceilDiv(bound - start, step)))
+                        : std::nullopt;
+    case IRInstructionOp::Gt:
+        if (start <= bound) {
+            return 0;
+        }
+        return step < 0 ? std::optional<std::uint64_t>(static_cast<std::uint64_t>(ceilDiv(start - bound, -step)))
+                        : std::nullopt;
+    case IRInstructionOp::Ne:
+        if (start == bound) {
+            return 0;
+        }
+        if (step == 0 || (bound - start) % step != 0 || (bound - start) / step < 0) {
+            return std::nullopt;
+        }
+        return static_cast<std::uint64_t>((bound - start) / step);
+    case IRInstructionOp::Eq:
+        if (start != bound) {
+            return 0;
+        }
+        return step != 0 ? std::optional<std::uint64_t>(1) : std::nullopt;
+    default:
+        return std::nullopt;
+    }
+}
+
+} // namespace
+
+std::vector<InductionVariable> findInductionVariables(const Loop& loop)
+{
+    std::vector<InductionVariable> result;
+    IRBasicBlock* preheader = loop.getPreheader();
+    const auto latches = loop.getLatches();
+    if (!preheader || latches.size() != 1) {
+        return result;
+    }
+    for (IRInstruction& phi : *loop.getHeader()) {
+        if (phi.getOp() != IRInstructionOp::Phi) {
+            break;
+        }
+        const auto entry = incomingIndex(phi, preheader);
+        const auto back = incomingIndex(phi, latches.front());
+        if (phi.getType() != IRType::Int || phi.getNumOperands() != 2 || !entry || !back) {
+            continue;
+        }
+        IRValue* next = phi.getOperand(*back);
+        if (next->getKind() != IRValueKind::Instruction || loop.isLoopInvariant(next)) {
+            continue;
+        }
+        auto* increment = static_cast<IRInstruction*>(next);
+        if (increment->getNumOperands() != 2) {
+            continue;
+        }
+        std::optional<std::int64_t> step;
+        if (increment->getOp() == IRInstructionOp::Add) {
+            if (increment->getOperand(0) == &phi) {
+                step = intConstant(increment->getOperand(1));
+            } else if (increment->getOperand(1) == &phi) {
+                step = intConstant(increment->getOperand(0));
+            }
+        } else if (increment->getOp() == IRInstructionOp::Sub && increment->getOperand(0) == &phi) {
+            step = intConstant(increment->getOperand(1));
+            if (step) {
+                step = -*step;
+            }
+        }
+        if (step) {
+            result.push_back({&phi, phi.getOperand(*entry), increment, *step});
+        }
+    }
+    return result;
+}
+
+std::optional<LoopExitCondition> findExitCondition(const Loop& loop)
+{
+    const IRInstruction* terminator = loop.getHeader()->getTerminator();
+    if (!terminator || terminator->getOp() != IRInstructionOp::BranchIf ||
+        loop.contains(terminator->getBlocks()[0]) == loop.contains(terminator->getBlocks()[1])) {
+        return std::nullopt;
+    }
+    IRValue* condition = terminator->getOperand(0);
+    if (condition->getKind() != IRValueKind::Instruction) {
+        return std::nullopt;
+    }
+    const auto* compare = static_cast<const IRInstruction*>(condition);
+    if (!isComparison(compare->getOp())) {
+        return std::nullopt;
+    }
+
+    IRInstructionOp predicate = compare->getOp();
+    if (!loop.contains(terminator->getBlocks()[0])) {
+        predicate = inverse(predicate); // the true edge leaves the loop
+    }
+    IRValue* lhs = compare->getOperand(0);
+    IRValue* rhs = compare->getOperand(1);
+    for (const InductionVariable& iv : findInductionVariables(loop)) {
+        if (lhs == iv.phi && loop.isLoopInvariant(rhs)) {
+            return LoopExitCondition{iv, predicate, rhs};
+        }
+        if (rhs == iv.phi && loop.isLoopInvariant(lhs)) {
+            return LoopExitCondition{iv, swapped(predicate), lhs};
+        }
+    }
+    return std::nullopt;
+}
+
+std::optional<std::uint64_t> computeTripCount(const Loop& loop)
+{
+    if (loop.getExitingBlocks().size() != 1) {
+        return std::nullopt;
+    }
+    const auto exit = findExitCondition(loop);
+    if (!exit) {
+        return std::nullopt;
+    }
+    const auto start = intConstant(exit->iv.start);
+    const auto bound = intConstant(exit->bound);
+    if (!start || !bound) {
+        return std::nullopt;
+    }
+    return countIterations(*start, exit->iv.step, exit->predicate, *bound);
+}
+
+} // namespace istudio::ir
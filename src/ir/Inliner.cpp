@@ -0,0 +1,271 @@
+#include "ir/Inliner.h"
+
+#include "ir/Cloning.h"
+
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace istudio::ir {
+
+namespace {
+
+// Direct calls between the functions defined in a module, resolved by callee name.
+class CallGraph {
+public:
+    explicit CallGraph(const IRModule& module)
+    {
+        for (const auto& function : module.getFunctions()) {
+            if (function->getEntryBlock()) {
+                byName_.emplace(function->getName(), function.get());
+            }
+        }
+        for (const auto& function : module.getFunctions()) {
+            auto& callees = callees_[function.get()];
+            for (const IRBasicBlock& block : function->getBasicBlocks()) {
+                for (const IRInstruction& inst : block.getInstructions()) {
+                    if (IRFunction* callee = resolve(inst)) {
+                        ++callSites_[callee];
+                        if (std::find(callees.begin(), callees.end(), callee) == callees.end()) {
+                            callees.push_back(callee);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // The function a Call instruction calls, when it is defined in the module.
+    IRFunction* resolve(const IRInstruction& inst) const
+    {
+        if (inst.getOp() != IRInstructionOp::Call) {
+            return nullptr;
+        }
+        const auto it = byName_.find(inst.getCallee());
+        return it != byName_.end() ? it->second : nullptr;
+    }
+
+    std::size_t callSites(const IRFunction* function) const
+    {
+        const auto it = callSites_.find(function);
+        return it != callSites_.end() ? it->second : 0;
+    }
+
+    // Strongly connected components, callees before callers (Tarjan emits them in
+    // reverse topological order of the graph).
+    std::vector<std::vector<IRFunction*>> bottomUpComponents(const IRModule& module) const
+    {
+        Tarjan tarjan{*this};
+        for (const auto& function : module.getFunctions()) {
+            if (!tarjan.index.contains(function.get())) {
+                tarjan.visit(function.get());
+            }
+        }
+        return std::move(tarjan.components);
+    }
+
+private:
+    struct Tarjan {
+        const CallGraph& graph;
+        std::unordered_map<const IRFunction*, unsigned> index{};
+        std::unordered_map<const IRFunction*, unsigned> lowLink{};
+        std::unordered_set<const IRFunction*> onStack{};
+        std::vector<IRFunction*> stack{};
+        std::vector<std::vector<IRFunction*>> components{};
+
+        void visit(IRFunction* function)
+        {
+            const auto number = static_cast<unsigned>(index.size());
+            index[function] = number;
+            lowLink[function] = number;
+            stack.push_back(function);
+            onStack.insert(function);
+            for (IRFunction* callee : graph.callees_.at(function)) {
+                if (!index.contains(callee)) {
+                    visit(callee);
+                    lowLink[function] = std::min(lowLink[function], lowLink[callee]);
+                } else if (onStack.contains(callee)) {
+                    lowLink[function] = std::min(lowLink[function], index[callee]);
+                }
+            }
+            if (lowLink[function] != index[function]) {
+                return;
+            }
+            auto& component = components.emplace_back();
+            IRFunction* member = nullptr;
+            do {
+                member = stack.back();
+                stack.pop_back();
+                onStack.erase(member);
+                component.push_back(member);
+            } while (member != function);
+        }
+    };
+
+    std::unordered_map<std::string_view, IRFunction*> byName_;
+    std::unordered_map<const IRFunction*, std::vector<IRFunction*>> callees_;
+    std::unordered_map<const IRFunction*, std::size_t> callSites_;
+};
+
+std::size_t instructionCount(const IRFunction& function)
+{
+    std::size_t count = 0;
+    for (const IRBasicBlock& block : function.getBasicBlocks()) {
+        count += block.getInstructions().size();
+    }
+    return count;
+}
+
+int bodyCost(const IRFunction& function, const InlineParams& params)
+{
+    int cost = 0;
+    for (const IRBasicBlock& block : function.getBasicBlocks()) {
+        for (const IRInstruction& inst : block.getInstructions()) {
+            switch (inst.getOp()) {
+            case IRInstructionOp::Phi:
+            case IRInstructionOp::Branch:
+                break;
+            case IRInstructionOp::Call:
+                cost += params.callPenalty;
+                break;
+            default:
+                ++cost;
+                break;
+            }
+        }
+    }
+    return cost;
+}
+
+// Replaces `call` by the body of `callee`. The calling block is split after the call;
+// the copied blocks go in between and their returns branch to the second half, where
+// a Phi merges the returned values when there is more than one return.
+void inlineCall(IRInstruction* call, const IRFunction& callee)
+{
+    IRBasicBlock* block = call->getParent();
+    IRFunction& caller = *block->getParent();
+
+    IRBasicBlock* continuation = caller.insertBlock(caller.createBlock("inline.cont"), block->getNextNode());
+    for (IRInstruction* inst = call->getNextNode(); inst;) {
+        IRInstruction* next = inst->getNextNode();
+        block->remove(inst);
+        continuation->append(inst);
+        inst = next;
+    }
+    std::vector<IRBasicBlock*> successors = continuation->getSuccessors();
+    std::sort(successors.begin(), successors.end());
+    successors.erase(std::unique(successors.begin(), successors.end()), successors.end());
+    for (IRBasicBlock* successor : successors) {
+        successor->replacePredecessor(block, continuation);
+    }
+
+    CloneMap map;
+    for (const IRArgument* argument : callee.getArguments()) {
+        const std::size_t index = argument->getIndex();
+        map.values[argument] =
+            index < call->getNumOperands() ? call->getOperand(index) : caller.getUndef(argument->getType());
+    }
+    std::vector<const IRBasicBlock*> body;
+    for (const IRBasicBlock& original : callee.getBasicBlocks()) {
+        body.push_back(&original);
+    }
+    cloneBlocks(body, caller, continuation, map);
+
+    std::vector<std::pair<IRValue*, IRBasicBlock*>> returns;
+    for (const IRBasicBlock* original : body) {
+        IRBasicBlock* copy = map.blocks.at(original);
+        IRInstruction* terminator = copy->getTerminator();
+        if (!terminator || terminator->getOp() != IRInstructionOp::Return) {
+            continue;
+        }
+        IRValue* value = terminator->getNumOperands() != 0 ? terminator->getOperand(0) : nullptr;
+        if (IRInstruction* previous = terminator->getPrevNode()) {
+            previous->setTailCall(false); // the caller goes on after it now
+        }
+        IRInstruction* branch = caller.createInstruction(IRInstructionOp::Branch);
+        branch->addBlock(continuation);
+        copy->insertBefore(terminator, branch);
+        terminator->eraseFromParent();
+        continuation->addPredecessor(copy);
+        returns.emplace_back(value, copy);
+    }
+
+    if (call->getType() != IRType::Void) {
+        IRValue* result = caller.getUndef(call->getType());
+        if (returns.size() == 1 && returns.front().first) {
+            result = returns.front().first;
+        } else if (returns.size() > 1) {
+            IRInstruction* phi = caller.createInstruction(IRInstructionOp::Phi, call->getType());
+            for (const auto& [value, from] : returns) {
+                phi->addOperand(value ? value : caller.getUndef(call->getType()));
+                phi->addBlock(from);
+            }
+            result = continuation->addPhi(phi);
+        }
+        call->replaceAllUsesWith(result);
+    }
+    call->eraseFromParent();
+
+    IRBasicBlock* entry = map.blocks.at(callee.getEntryBlock());
+    IRInstruction* branch = caller.createInstruction(IRInstructionOp::Branch);
+    branch->addBlock(entry);
+    block->append(branch);
+    entry->addPredecessor(block);
+}
+
+} // namespace
+
+PreservedAnalyses Inliner::run(IRModule& module)
+{
+    const CallGraph graph(module);
+    std::unordered_map<const IRFunction*, int> costs; // of callees whose bodies are final
+    const std::size_t inlinedBefore = inlined_;
+
+    for (const auto& component : graph.bottomUpComponents(module)) {
+        const std::unordered_set<const IRFunction*> members(component.begin(), component.end());
+        for (IRFunction* caller : component) {
+            if (!caller->getEntryBlock()) {
+                continue;
+            }
+            std::vector<std::pair<IRInstruction*, const IRFunction*>> calls;
+            for (IRBasicBlock& block : caller->getBasicBlocks()) {
+                for (IRInstruction& inst : block) {
+                    const IRFunction* callee = graph.resolve(inst);
+                    if (callee && !members.contains(callee)) {
+                        calls.emplace_back(&inst, callee);
+                    }
+                }
+            }
+
+            std::size_t callerSize = instructionCount(*caller);
+            for (const auto& [call, callee] : calls) {
+                const auto cached = costs.try_emplace(callee, 0);
+                if (cached.second) {
+                    cached.first->second = bodyCost(*callee, params_);
+                }
+                int benefit = params_.callPenalty;
+                for (std::size_t i = 0; i < call->getNumOperands(); ++i) {
+                    if (call->getOperand(i)->getKind() == IRValueKind::Constant) {
+                        benefit += params_.constantArgumentBonus;
+                    }
+                }
+                if (graph.callSites(callee) == 1) {
+                    benefit += params_.singleCallSiteBonus;
+                }
+                const std::size_t calleeSize = instructionCount(*callee);
+                if (cached.first->second - benefit > params_.threshold ||
+                    callerSize + calleeSize > params_.maxCallerSize) {
+                    continue;
+                }
+                inlineCall(call, *callee);
+                callerSize += calleeSize;
+                ++inlined_;
+            }
+        }
+    }
+    return inlined_ != inlinedBefore ? PreservedAnalyses::none() : PreservedAnalyses::all();
+}
+
+} // namespace istudio::ir
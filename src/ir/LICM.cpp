@@ -0,0 +1,123 @@
+#include "ir/LICM.h"
+
+#include "ir/Dominators.h"
+#include "ir/LoopInfo.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <variant>
+
+namespace istudio::ir {
+
+namespace {
+
+bool isNonZeroConstant(const IRValue* value)
+{
+    if (value->getKind() != IRValueKind::Constant) {
+        return false;
+    }
+    const auto& constant = static_cast<const IRConstant*>(value)->getValue();
+    if (const auto* integer = std::get_if<std::int64_t>(&constant)) {
+        return *integer != 0;
+    }
+    if (const auto* real = std::get_if<double>(&constant)) {
+        return *real != 0.0;
+    }
+    return false;
+}
+
+// Whether `inst` can run where the loop would not have run it.
+bool isSpeculatable(const IRInstruction& inst)
+{
+    switch (inst.getOp()) {
+    case IRInstructionOp::Add:
+    case IRInstructionOp::Sub:
+    case IRInstructionOp::Mul:
+    case IRInstructionOp::And:
+    case IRInstructionOp::Or:
+    case IRInstructionOp::Xor:
+    case IRInstructionOp::Shl:
+    case IRInstructionOp::Shr:
+    case IRInstructionOp::Eq:
+    case IRInstructionOp::Ne:
+    case IRInstructionOp::Lt:
+    case IRInstructionOp::Le:
+    case IRInstructionOp::Gt:
+    case IRInstructionOp::Ge:
+    case IRInstructionOp::Neg:
+    case IRInstructionOp::Not:
+    case IRInstructionOp::GetElementPtr:
+        return true;
+    case IRInstructionOp::Div:
+    case IRInstructionOp::Rem:
+        return isNonZeroConstant(inst.getOperand(1));
+    default:
+        return false;
+    }
+}
+
+bool writesMemory(const Loop& loop)
+{
+    for (const IRBasicBlock* block : loop.getBlocks()) {
+        for (const IRInstruction& inst : block->getInstructions()) {
+            if (inst.getOp() == IRInstructionOp::Store || inst.getOp() == IRInstructionOp::Call) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool hoistInvariants(const Loop& loop, const DominatorTree& domTree)
+{
+    IRBasicBlock* preheader = loop.getPreheader();
+    if (!preheader) {
+        return false;
+    }
+    const bool memoryIsConstant = !writesMemory(loop);
+    const auto exiting = loop.getExitingBlocks();
+    auto runsEveryIteration = [&](const IRBasicBlock* block) {
+        return std::all_of(exiting.begin(), exiting.end(),
+                           [&](const IRBasicBlock* exit) { return domTree.dominates(block, exit); });
+    };
+
+    bool changed = false;
+    // Reverse post-order visits definitions before their uses, so chains of
+    // invariant instructions move in one sweep.
+    for (IRBasicBlock* block : loop.getBlocks()) {
+        for (auto it = block->begin(); it != block->end();) {
+            IRInstruction& inst = *it++;
+            const bool hoistable = isSpeculatable(inst) || (inst.getOp() == IRInstructionOp::Load &&
+                                                             memoryIsConstant && runsEveryIteration(block));
+            if (!hoistable) {
+                continue;
+            }
+            bool invariant = true;
+            for (std::size_t i = 0; i < inst.getNumOperands() && invariant; ++i) {
+                invariant = loop.isLoopInvariant(inst.getOperand(i));
+            }
+            if (!invariant) {
+                continue;
+            }
+            block->remove(&inst);
+            preheader->insertBefore(preheader->getTerminator(), &inst);
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+} // namespace
+
+PreservedAnalyses LoopInvariantCodeMotion::run(IRFunction&, FunctionAnalyses& analyses) const
+{
+    const DominatorTree& domTree = analyses.get<DominatorTreeAnalysis>();
+    const LoopInfo& loops = analyses.get<LoopAnalysis>();
+    bool changed = false;
+    for (const Loop* loop : loops.getLoopsInnermostFirst()) {
+        changed |= hoistInvariants(*loop, domTree);
+    }
+    return changed ? PreservedAnalyses::cfg() : PreservedAnalyses::all();
+}
+
+} // namespace istudio::ir
@@ -0,0 +1,112 @@
+#include "ir/Liveness.h"
+
+namespace istudio::ir {
+
+namespace {
+
+bool isTracked(const IRValue* value)
+{
+    return value && (value->getKind() == IRValueKind::Instruction || value->getKind() == IRValueKind::Argument);
+}
+
+// to |= from, returning whether `to` grew
+bool unite(std::vector<bool>& to, const std::vector<bool>& from)
+{
+    bool changed = false;
+    for (std::size_t id = 0; id < from.size(); ++id) {
+        if (from[id] && !to[id]) {
+            to[id] = true;
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+// in |= (out - defs), returning whether `in` grew
+bool transfer(std::vector<bool>& in, const std::vector<bool>& out, const std::vector<bool>& defs)
+{
+    bool changed = false;
+    for (std::size_t id = 0; id < out.size(); ++id) {
+        if (out[id] && !defs[id] && !in[id]) {
+            in[id] = true;
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+} // namespace
+
+Liveness LivenessAnalysis::run(const IRFunction& function, FunctionAnalyses&)
+{
+    const std::size_t valueCount = function.getValueCount();
+
+    struct Local {
+        std::vector<bool> uses;    // read before any definition in the block
+        std::vector<bool> defs;    // defined in the block, Phis included
+        std::vector<bool> phiOut;  // Phi operands flowing out along the block's edges
+    };
+    std::unordered_map<const IRBasicBlock*, Local> locals;
+    Liveness liveness;
+
+    for (const IRBasicBlock& block : function.getBasicBlocks()) {
+        auto& local = locals[&block];
+        local.uses.assign(valueCount, false);
+        local.defs.assign(valueCount, false);
+        local.phiOut.assign(valueCount, false);
+        liveness.sets_[&block] = {std::vector<bool>(valueCount, false), std::vector<bool>(valueCount, false)};
+    }
+
+    for (const IRBasicBlock& block : function.getBasicBlocks()) {
+        auto& local = locals[&block];
+        for (const IRInstruction& inst : block) {
+            if (inst.getOp() == IRInstructionOp::Phi) {
+                for (std::size_t i = 0; i < inst.getNumOperands(); ++i) {
+                    const IRValue* operand = inst.getOperand(i);
+                    const auto incoming = locals.find(inst.getBlocks()[i]);
+                    if (isTracked(operand) && incoming != locals.end()) {
+                        incoming->second.phiOut[operand->getId()] = true;
+                    }
+                }
+            } else {
+                for (std::size_t i = 0; i < inst.getNumOperands(); ++i) {
+                    const IRValue* operand = inst.getOperand(i);
+                    if (isTracked(operand) && !local.defs[operand->getId()]) {
+                        local.uses[operand->getId()] = true;
+                    }
+                }
+            }
+            local.defs[inst.getId()] = true;
+        }
+    }
+
+    // Blocks are mostly in forward order, so walking them backwards converges quickly.
+    std::vector<const IRBasicBlock*> order;
+    for (const IRBasicBlock& block : function.getBasicBlocks()) {
+        order.push_back(&block);
+    }
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (auto it = order.rbegin(); it != order.rend(); ++it) {
+            const IRBasicBlock* block = *it;
+            const auto& local = locals[block];
+            auto& sets = liveness.sets_[block];
+
+            // A successor's Phis are defined on its entry, so they never appear in its
+            // live-in set; their operands arrive through phiOut instead.
+            changed |= unite(sets.out, local.phiOut);
+            for (const IRBasicBlock* successor : block->getSuccessors()) {
+                const auto succ = liveness.sets_.find(successor);
+                if (succ != liveness.sets_.end()) {
+                    changed |= unite(sets.out, succ->second.in);
+                }
+            }
+            changed |= unite(sets.in, local.uses);
+            changed |= transfer(sets.in, sets.out, local.defs);
+        }
+    }
+    return liveness;
+}
+
+} // namespace istudio::ir
@@ -0,0 +1,167 @@
+#include "ir/LoopInfo.h"
+
+#include "ir/Dominators.h"
+
+#include <algorithm>
+
+namespace istudio::ir {
+
+bool Loop::isLoopInvariant(const IRValue* value) const
+{
+    if (value->getKind() != IRValueKind::Instruction) {
+        return true;
+    }
+    const IRBasicBlock* block = static_cast<const IRInstruction*>(value)->getParent();
+    return !block || !contains(block);
+}
+
+std::vector<IRBasicBlock*> Loop::getLatches() const
+{
+    std::vector<IRBasicBlock*> latches;
+    for (IRBasicBlock* pred : getHeader()->getPredecessors()) {
+        if (contains(pred) && std::find(latches.begin(), latches.end(), pred) == latches.end()) {
+            latches.push_back(pred);
+        }
+    }
+    return latches;
+}
+
+std::vector<IRBasicBlock*> Loop::getExitingBlocks() const
+{
+    std::vector<IRBasicBlock*> exiting;
+    for (IRBasicBlock* block : blocks_) {
+        const auto successors = block->getSuccessors();
+        if (std::any_of(successors.begin(), successors.end(), [this](const IRBasicBlock* s) { return !contains(s); })) {
+            exiting.push_back(block);
+        }
+    }
+    return exiting;
+}
+
+std::vector<IRBasicBlock*> Loop::getExitBlocks() const
+{
+    std::vector<IRBasicBlock*> exits;
+    for (IRBasicBlock* block : blocks_) {
+        for (IRBasicBlock* successor : block->getSuccessors()) {
+            if (!contains(successor) && std::find(exits.begin(), exits.end(), successor) == exits.end()) {
+                exits.push_back(successor);
+            }
+        }
+    }
+    return exits;
+}
+
+IRBasicBlock* Loop::getPreheader() const
+{
+    IRBasicBlock* outside = nullptr;
+    for (IRBasicBlock* pred : getHeader()->getPredecessors()) {
+        if (contains(pred)) {
+            continue;
+        }
+        if (outside && outside != pred) {
+            return nullptr;
+        }
+        outside = pred;
+    }
+    if (!outside || outside->getSuccessors().size() != 1) {
+        return nullptr;
+    }
+    return outside;
+}
+
+std::vector<Loop*> LoopInfo::getLoopsInnermostFirst() const
+{
+    std::vector<Loop*> order;
+    std::vector<std::pair<Loop*, std::size_t>> stack;
+    for (Loop* top : topLevel_) {
+        stack.emplace_back(top, 0);
+        while (!stack.empty()) {
+            auto& [loop, next] = stack.back();
+            if (next < loop->getSubLoops().size()) {
+                Loop* sub = loop->getSubLoops()[next++];
+                stack.emplace_back(sub, 0);
+                continue;
+            }
+            order.push_back(loop);
+            stack.pop_back();
+        }
+    }
+    return order;
+}
+
+LoopInfo LoopAnalysis::run(const IRFunction&, FunctionAnalyses& analyses)
+{
+    const DominatorTree& domTree = analyses.get<DominatorTreeAnalysis>();
+    LoopInfo info;
+
+    std::unordered_map<const IRBasicBlock*, std::size_t> position;
+    for (IRBasicBlock* block : domTree.reversePostOrder()) {
+        position.emplace(block, position.size());
+    }
+
+    for (IRBasicBlock* header : domTree.reversePostOrder()) {
+        std::vector<IRBasicBlock*> worklist;
+        for (IRBasicBlock* pred : header->getPredecessors()) {
+            if (domTree.dominates(header, pred)) {
+                worklist.push_back(pred);
+            }
+        }
+        if (worklist.empty()) {
+            continue;
+        }
+        auto loop = std::make_unique<Loop>();
+        loop->members_.insert(header);
+        loop->blocks_.push_back(header);
+        while (!worklist.empty()) {
+            IRBasicBlock* block = worklist.back();
+            worklist.pop_back();
+            if (!loop->members_.insert(block).second) {
+                continue;
+            }
+            loop->blocks_.push_back(block);
+            for (IRBasicBlock* pred : block->getPredecessors()) {
+                if (domTree.isReachable(pred)) {
+                    worklist.push_back(pred);
+                }
+            }
+        }
+        std::sort(loop->blocks_.begin(), loop->blocks_.end(),
+                  [&position](const IRBasicBlock* a, const IRBasicBlock* b) { return position.at(a) < position.at(b); });
+        info.loops_.push_back(std::move(loop));
+    }
+
+    // Natural loops with different headers are disjoint or nested, so visiting the
+    // larger ones first leaves every block mapped to its innermost loop and finds
+    // each loop's parent as the loop its header belonged to just before.
+    std::vector<Loop*> bySize;
+    for (const auto& loop : info.loops_) {
+        bySize.push_back(loop.get());
+    }
+    std::stable_sort(bySize.begin(), bySize.end(),
+                     [](const Loop* a, const Loop* b) { return a->blocks_.size() > b->blocks_.size(); });
+    for (Loop* loop : bySize) {
+        const auto it = info.loopFor_.find(loop->getHeader());
+        if (it != info.loopFor_.end()) {
+            loop->parent_ = it->second;
+            loop->depth_ = it->second->depth_ + 1;
+            it->second->subLoops_.push_back(loop);
+        } else {
+            info.topLevel_.push_back(loop);
+        }
+        for (IRBasicBlock* block : loop->blocks_) {
+            info.loopFor_[block] = loop;
+        }
+    }
+
+    // Keep siblings in program order.
+    auto byHeader = [&position](const Loop* a, const Loop* b) {
+        return position.at(a->getHeader()) < position.at(b->getHeader());
+    };
+    std::sort(info.topLevel_.begin(), info.topLevel_.end(), byHeader);
+    for (const auto& loop : info.loops_) {
+        std::sort(loop->subLoops_.begin(), loop->subLoops_.end(), byHeader);
+    }
+    return info;
+}
+
+} // namespace istudio::ir
@@ -0,0 +1,128 @@
+#include "ir/LoopSimplify.h"
+
+#include "ir/LoopInfo.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace istudio::ir {
+
+namespace {
+
+// Sends the edges from `preds` into `block` through a new block placed in front of
+// `before`. Phis of `block` get one operand for the new block, merged by a Phi in it
+// when the edges carried different values.
+IRBasicBlock* splitPredecessors(IRFunction& function, IRBasicBlock* block, const std::vector<IRBasicBlock*>& preds,
+                                std::string_view label, IRBasicBlock* before)
+{
+    IRBasicBlock* split = function.insertBlock(function.createBlock(label), before);
+    auto fromSplit = [&preds](const IRBasicBlock* pred) {
+        return std::find(preds.begin(), preds.end(), pred) != preds.end();
+    };
+
+    for (IRInstruction& phi : *block) {
+        if (phi.getOp() != IRInstructionOp::Phi) {
+            break;
+        }
+        std::vector<std::size_t> moved;
+        for (std::size_t i = 0; i < phi.getBlocks().size(); ++i) {
+            if (fromSplit(phi.getBlocks()[i])) {
+                moved.push_back(i);
+            }
+        }
+        if (moved.empty()) {
+            continue;
+        }
+        IRValue* value = phi.getOperand(moved.front());
+        const bool same = std::all_of(moved.begin(), moved.end(),
+                                      [&](std::size_t i) { return phi.getOperand(i) == value; });
+        if (!same) {
+            IRInstruction* merge = function.createInstruction(IRInstructionOp::Phi, phi.getType());
+            for (std::size_t i : moved) {
+                merge->addOperand(phi.getOperand(i));
+                merge->addBlock(phi.getBlocks()[i]);
+            }
+            value = split->addPhi(merge);
+        }
+        for (auto it = moved.rbegin(); it != moved.rend(); ++it) {
+            phi.removeOperand(*it);
+            phi.removeBlock(*it);
+        }
+        phi.addOperand(value);
+        phi.addBlock(split);
+    }
+
+    for (IRBasicBlock* pred : preds) {
+        IRInstruction* terminator = pred->getTerminator();
+        for (std::size_t i = 0; i < terminator->getBlocks().size(); ++i) {
+            if (terminator->getBlocks()[i] == block) {
+                terminator->setBlock(i, split);
+                split->addPredecessor(pred);
+            }
+        }
+        block->removePredecessor(pred);
+    }
+    IRInstruction* branch = function.createInstruction(IRInstructionOp::Branch);
+    branch->addBlock(block);
+    split->append(branch);
+    block->addPredecessor(split);
+    return split;
+}
+
+std::vector<IRBasicBlock*> uniquePredecessors(const IRBasicBlock* block, bool inside, const Loop& loop)
+{
+    std::vector<IRBasicBlock*> preds;
+    for (IRBasicBlock* pred : block->getPredecessors()) {
+        if (loop.contains(pred) == inside && std::find(preds.begin(), preds.end(), pred) == preds.end()) {
+            preds.push_back(pred);
+        }
+    }
+    return preds;
+}
+
+// Makes one change to `loop` if it is not canonical yet. The loop nest is stale after
+// a change, so the caller recomputes it before the next one.
+bool canonicalize(IRFunction& function, const Loop& loop)
+{
+    IRBasicBlock* header = loop.getHeader();
+    if (!loop.getPreheader()) {
+        const auto outside = uniquePredecessors(header, false, loop);
+        if (!outside.empty()) {
+            splitPredecessors(function, header, outside, "loop.preheader", header);
+            return true;
+        }
+    }
+    const auto latches = loop.getLatches();
+    if (latches.size() > 1) {
+        splitPredecessors(function, header, latches, "loop.latch", latches.back()->getNextNode());
+        return true;
+    }
+    for (IRBasicBlock* exit : loop.getExitBlocks()) {
+        if (!uniquePredecessors(exit, false, loop).empty()) {
+            splitPredecessors(function, exit, uniquePredecessors(exit, true, loop), "loop.exit", exit);
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+PreservedAnalyses LoopSimplify::run(IRFunction& function, FunctionAnalyses& analyses) const
+{
+    bool changed = false;
+    bool progress = true;
+    while (progress) {
+        progress = false;
+        for (const Loop* loop : analyses.get<LoopAnalysis>().getLoopsInnermostFirst()) {
+            if (canonicalize(function, *loop)) {
+                analyses.invalidate(PreservedAnalyses::none());
+                progress = changed = true;
+                break;
+            }
+        }
+    }
+    return changed ? PreservedAnalyses::none() : PreservedAnalyses::all();
+}
+
+} // namespace istudio::ir
@@ -0,0 +1,147 @@
+#include "ir/LoopUnroll.h"
+
+#include "ir/Cloning.h"
+#include "ir/InductionVariables.h"
+#include "ir/LoopInfo.h"
+
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace istudio::ir {
+
+namespace {
+
+void retarget(IRBasicBlock* block, IRBasicBlock* from, IRBasicBlock* to)
+{
+    IRInstruction* terminator = block->getTerminator();
+    for (std::size_t i = 0; i < terminator->getBlocks().size(); ++i) {
+        if (terminator->getBlocks()[i] == from) {
+            terminator->setBlock(i, to);
+        }
+    }
+}
+
+unsigned chooseFactor(const Loop& loop, std::uint64_t tripCount, const UnrollParams& params)
+{
+    std::size_t size = 0;
+    for (const IRBasicBlock* block : loop.getBlocks()) {
+        size += block->getInstructions().size();
+    }
+    for (unsigned factor = params.factor; factor >= 2; --factor) {
+        if (tripCount % factor == 0 && size * factor <= params.maxUnrolledSize) {
+            return factor;
+        }
+    }
+    return 0;
+}
+
+bool unroll(IRFunction& function, const Loop& loop, const UnrollParams& params)
+{
+    const auto latches = loop.getLatches();
+    if (!loop.getSubLoops().empty() || !loop.getPreheader() || latches.size() != 1) {
+        return false;
+    }
+    const auto tripCount = computeTripCount(loop); // also: the header is the only exit
+    if (!tripCount || *tripCount < 2) {
+        return false;
+    }
+    const unsigned factor = chooseFactor(loop, *tripCount, params);
+    if (factor == 0) {
+        return false;
+    }
+
+    IRBasicBlock* header = loop.getHeader();
+    IRBasicBlock* latch = latches.front();
+    IRBasicBlock* staySuccessor = header->getTerminator()->getBlocks()[0];
+    if (!loop.contains(staySuccessor)) {
+        staySuccessor = header->getTerminator()->getBlocks()[1];
+    }
+
+    // Header Phis with the index of their back-edge operand.
+    std::vector<std::pair<IRInstruction*, std::size_t>> phis;
+    for (IRInstruction& phi : *header) {
+        if (phi.getOp() != IRInstructionOp::Phi) {
+            break;
+        }
+        for (std::size_t i = 0; i < phi.getBlocks().size(); ++i) {
+            if (phi.getBlocks()[i] == latch) {
+                phis.emplace_back(&phi, i);
+            }
+        }
+    }
+
+    // What each header Phi stands for at the top of the copy being built, and the
+    // value the previous copy hands it over its back edge.
+    std::unordered_map<const IRValue*, IRValue*> atTop;
+    for (const auto& [phi, back] : phis) {
+        atTop[phi] = phi;
+    }
+    CloneMap previous; // copy 0 is the original: an empty map
+    auto backEdgeValue = [&](const IRInstruction* phi, std::size_t back) {
+        IRValue* value = phi->getOperand(back);
+        const auto it = atTop.find(value);
+        return it != atTop.end() ? it->second : previous.lookup(value);
+    };
+
+    // Every copy is taken from the loop as it was, before any edge is redirected.
+    const std::vector<const IRBasicBlock*> blocks(loop.getBlocks().begin(), loop.getBlocks().end());
+    IRBasicBlock* insertPoint = latch->getNextNode();
+    std::vector<CloneMap> copies(factor - 1);
+    for (CloneMap& map : copies) {
+        cloneBlocks(blocks, function, insertPoint, map);
+    }
+
+    IRBasicBlock* previousHeader = header;
+    IRBasicBlock* previousLatch = latch;
+    for (CloneMap& map : copies) {
+        std::unordered_map<const IRValue*, IRValue*> next;
+        for (const auto& [phi, back] : phis) {
+            next[phi] = backEdgeValue(phi, back);
+        }
+        for (const auto& [phi, back] : phis) {
+            auto* clone = static_cast<IRInstruction*>(map.values.at(phi));
+            clone->replaceAllUsesWith(next[phi]);
+            clone->eraseFromParent();
+        }
+        atTop = std::move(next);
+
+        IRBasicBlock* copyHeader = map.blocks.at(header);
+        IRBasicBlock* copyLatch = map.blocks.at(latch);
+        copyHeader->removePredecessor(copyLatch);
+        copyHeader->addPredecessor(previousLatch);
+        retarget(previousLatch, previousHeader, copyHeader);
+
+        // The trip count is a multiple of the factor, so only the original header exits.
+        IRInstruction* test = copyHeader->getTerminator();
+        IRInstruction* branch = function.createInstruction(IRInstructionOp::Branch);
+        branch->addBlock(map.blocks.at(staySuccessor));
+        copyHeader->insertBefore(test, branch);
+        test->eraseFromParent();
+
+        previous = std::move(map);
+        previousHeader = copyHeader;
+        previousLatch = copyLatch;
+    }
+
+    retarget(previousLatch, previousHeader, header);
+    for (const auto& [phi, back] : phis) {
+        phi->setOperand(back, backEdgeValue(phi, back));
+    }
+    header->replacePredecessor(latch, previousLatch);
+    return true;
+}
+
+} // namespace
+
+PreservedAnalyses LoopUnroll::run(IRFunction& function, FunctionAnalyses& analyses) const
+{
+    bool changed = false;
+    // Innermost loops are disjoint, and unrolling one leaves the others' blocks alone.
+    for (const Loop* loop : analyses.get<LoopAnalysis>().getLoopsInnermostFirst()) {
+        changed |= unroll(function, *loop, params_);
+    }
+    return changed ? PreservedAnalyses::none() : PreservedAnalyses::all();
+}
+
+} // namespace istudio::ir
@@ -1,85 +1,573 @@
 #include "ir/Lowering.h"
+
+#include "semantic/ConstantValue.h"
+
+#include <algorithm>
 #include <memory>
 
 namespace istudio::ir {
 
+namespace {
+
+bool isComparison(std::string_view op)
+{
+    return op == "==" || op == "!=" || op == "<" || op == "<=" || op == ">" || op == ">=";
+}
+
+std::optional<IRInstructionOp> binaryOpcode(std::string_view op)
+{
+    static const std::unordered_map<std::string_view, IRInstructionOp> kOps = {
+        {"+", IRInstructionOp::Add},  {"-", IRInstructionOp::Sub},   {"*", IRInstructionOp::Mul},
+        {"/", IRInstructionOp::Div},  {"%", IRInstructionOp::Rem},   {"&", IRInstructionOp::And},
+        {"|", IRInstructionOp::Or},   {"^", IRInstructionOp::Xor},   {"<<", IRInstructionOp::Shl},
+        {">>", IRInstructionOp::Shr}, {"==", IRInstructionOp::Eq},   {"!=", IRInstructionOp::Ne},
+        {"<", IRInstructionOp::Lt},   {"<=", IRInstructionOp::Le},   {">", IRInstructionOp::Gt},
+        {">=", IRInstructionOp::Ge},
+    };
+    const auto it = kOps.find(op);
+    return it != kOps.end() ? std::optional(it->second) : std::nullopt;
+}
+
+IRConstantValue toConstant(const semantic::ConstantValue& value)
+{
+    return std::visit([](const auto& v) { return IRConstantValue(v); }, value);
+}
+
+IRType constantType(const IRConstantValue& value)
+{
+    if (std::holds_alternative<bool>(value)) {
+        return IRType::Bool;
+    }
+    if (std::holds_alternative<std::int64_t>(value)) {
+        return IRType::Int;
+    }
+    if (std::holds_alternative<double>(value)) {
+        return IRType::Float;
+    }
+    if (std::holds_alternative<std::string>(value)) {
+        return IRType::String;
+    }
+    return IRType::Opaque;
+}
+
+} // namespace
+
 std::unique_ptr<IRModule> LoweringPass::lower(const ProgramNode& program) {
     module_ = std::make_unique<IRModule>("main_module");
-    
+
     for (const auto& func : program.getFunctions()) {
         if (func) {
-            auto irFunc = lowerFunction(static_cast<const FunctionNode&>(*func));
-            module_->addFunction(std::move(irFunc));
+            module_->addFunction(lowerFunction(static_cast<const FunctionNode&>(*func)));
         }
     }
-    
+
     return std::move(module_);
 }
 
 std::unique_ptr<IRFunction> LoweringPass::lowerFunction(const FunctionNode& func) {
-    auto irFunc = std::make_unique<IRFunction>(func.getName());
-    
-    // Create entry basic block
-    auto entryBlock = std::make_unique<IRBasicBlock>("entry");
-    
+    auto irFunc = std::make_unique<IRFunction>(func.getName(), irTypeOf(func.getReturnType()));
+    function_ = irFunc.get();
+    variableTypes_.clear();
+    scopes_.assign(1, {});
+    currentDef_.clear();
+    incompletePhis_.clear();
+    sealed_.clear();
+
+    IRBasicBlock* entry = createBlock("entry");
+    placeBlock(entry);
+    sealBlock(entry);
+    current_ = entry;
+
+    for (const auto& param : func.getParameters()) {
+        const IRType type = irTypeOf(param.type);
+        IRArgument* argument = function_->addArgument(param.name, type);
+        writeVariable(declareVariable(param.name, type), entry, argument);
+    }
+
     if (const auto* body = func.getBody()) {
-        // For now, we'll handle basic blocks
-        if (body->getType() == ASTNodeType::Block) {
-            auto block = lowerBlock(static_cast<const BlockNode&>(*body));
-            irFunc->addBasicBlock(std::move(block));
+        lowerStatement(*body);
+    }
+
+    // Falling off the end: only legal for void functions, which sema guarantees.
+    if (current_) {
+        if (function_->getType() == IRType::Void) {
+            emit(IRInstructionOp::Return, IRType::Void, {});
         } else {
-            // Create a basic block for single statements
-            auto singleBlock = std::make_unique<IRBasicBlock>("entry");
-            // Handle single statement case
-            irFunc->addBasicBlock(std::move(singleBlock));
+            emit(IRInstructionOp::Return, IRType::Void, {undef(function_->getType())});
         }
-    } else {
-        auto entryBlock = std::make_unique<IRBasicBlock>("entry");
-        irFunc->addBasicBlock(std::move(entryBlock));
     }
-    
+
+    for (IRBasicBlock& block : function_->getBasicBlocks()) {
+        sealBlock(&block);
+    }
+    current_ = nullptr;
+    function_ = nullptr;
     return irFunc;
 }
 
-std::unique_ptr<IRBasicBlock> LoweringPass::lowerBlock(const BlockNode& block) {
-    auto irBlock = std::make_unique<IRBasicBlock>("block");
-    
-    // For now, just create placeholders - real implementation would convert each statement
+void LoweringPass::lowerBlock(const BlockNode& block) {
+    scopes_.emplace_back();
     for (const auto& stmt : block.getStatements()) {
+        if (!current_) {
+            break; // everything after a return is unreachable
+        }
         if (stmt) {
-            // Convert AST statement to IR instruction
-            // This is a placeholder - full implementation needed
-            // In a real implementation, we would match each ASTNodeType and convert to appropriate IR
+            lowerStatement(*stmt);
+        }
+    }
+    scopes_.pop_back();
+}
+
+void LoweringPass::lowerStatement(const ASTNode& node) {
+    if (!current_) {
+        return;
+    }
+    switch (node.getType()) {
+    case ASTNodeType::Block:
+        lowerBlock(static_cast<const BlockNode&>(node));
+        break;
+    case ASTNodeType::VariableDeclaration: {
+        const auto& decl = static_cast<const VariableDeclarationNode&>(node);
+        const IRType type = typeOf(decl, irTypeOf(decl.getTypeName()));
+        IRValue* value = decl.getInitializer() ? lowerExpression(*decl.getInitializer()) : undef(type);
+        writeVariable(declareVariable(decl.getName(), type), current_, value);
+        break;
+    }
+    case ASTNodeType::Assignment: {
+        const auto& assignment = static_cast<const AssignmentNode&>(node);
+        IRValue* value = assignment.getValue() ? lowerExpression(*assignment.getValue()) : nullptr;
+        if (const auto variable = lookupVariable(assignment.getVariable()); variable && value) {
+            writeVariable(*variable, current_, value);
+        }
+        break;
+    }
+    case ASTNodeType::Return: {
+        const auto& ret = static_cast<const ReturnNode&>(node);
+        if (ret.getValue()) {
+            emit(IRInstructionOp::Return, IRType::Void, {lowerExpression(*ret.getValue())});
+        } else {
+            emit(IRInstructionOp::Return, IRType::Void, {});
         }
+        current_ = nullptr;
+        break;
+    }
+    case ASTNodeType::ExpressionStatement:
+        if (const auto* expr = static_cast<const ExpressionStatementNode&>(node).getExpression()) {
+            lowerExpression(*expr);
+        }
+        break;
+    case ASTNodeType::If:
+        lowerIf(static_cast<const IfNode&>(node));
+        break;
+    case ASTNodeType::While:
+        lowerWhile(static_cast<const WhileNode&>(node));
+        break;
+    case ASTNodeType::For:
+        lowerFor(static_cast<const ForNode&>(node));
+        break;
+    default:
+        lowerExpression(node); // expression used as a statement
+        break;
+    }
+}
+
+void LoweringPass::lowerIf(const IfNode& node) {
+    IRValue* condition = node.getCondition() ? lowerExpression(*node.getCondition()) : undef(IRType::Bool);
+    IRBasicBlock* thenBlock = createBlock("if.then");
+    IRBasicBlock* endBlock = createBlock("if.end");
+    IRBasicBlock* elseBlock = node.getElseBranch() ? createBlock("if.else") : endBlock;
+    branchIf(condition, thenBlock, elseBlock);
+
+    placeBlock(thenBlock);
+    sealBlock(thenBlock);
+    current_ = thenBlock;
+    if (node.getThenBranch()) {
+        lowerStatement(*node.getThenBranch());
+    }
+    if (current_) {
+        branch(endBlock);
+    }
+
+    if (elseBlock != endBlock) {
+        placeBlock(elseBlock);
+        sealBlock(elseBlock);
+        current_ = elseBlock;
+        lowerStatement(*node.getElseBranch());
+        if (current_) {
+            branch(endBlock);
+        }
+    }
+
+    current_ = nullptr;
+    if (!endBlock->getPredecessors().empty()) {
+        placeBlock(endBlock);
+        sealBlock(endBlock);
+        current_ = endBlock;
+    }
+}
+
+void LoweringPass::lowerWhile(const WhileNode& node) {
+    IRBasicBlock* header = createBlock("while.cond");
+    IRBasicBlock* body = createBlock("while.body");
+    IRBasicBlock* exit = createBlock("while.end");
+    branch(header);
+
+    // The header stays unsealed until the back edge exists.
+    placeBlock(header);
+    current_ = header;
+    if (node.getCondition()) {
+        branchIf(lowerExpression(*node.getCondition()), body, exit);
+    } else {
+        branch(body);
+    }
+
+    placeBlock(body);
+    sealBlock(body);
+    current_ = body;
+    if (node.getBody()) {
+        lowerStatement(*node.getBody());
+    }
+    if (current_) {
+        branch(header);
+    }
+    sealBlock(header);
+
+    current_ = nullptr;
+    if (!exit->getPredecessors().empty()) {
+        placeBlock(exit);
+        sealBlock(exit);
+        current_ = exit;
+    }
+}
+
+void LoweringPass::lowerFor(const ForNode& node) {
+    scopes_.emplace_back(); // the init declaration is scoped to the loop
+    if (node.getInit()) {
+        lowerStatement(*node.getInit());
+    }
+    if (!current_) {
+        scopes_.pop_back();
+        return;
+    }
+
+    IRBasicBlock* header = createBlock("for.cond");
+    IRBasicBlock* body = createBlock("for.body");
+    IRBasicBlock* latch = createBlock("for.inc");
+    IRBasicBlock* exit = createBlock("for.end");
+    branch(header);
+
+    placeBlock(header);
+    current_ = header;
+    if (node.getCondition()) {
+        branchIf(lowerExpression(*node.getCondition()), body, exit);
+    } else {
+        branch(body);
+    }
+
+    placeBlock(body);
+    sealBlock(body);
+    current_ = body;
+    if (node.getBody()) {
+        lowerStatement(*node.getBody());
+    }
+    if (current_) {
+        branch(latch);
+    }
+
+    if (!latch->getPredecessors().empty()) {
+        placeBlock(latch);
+        sealBlock(latch);
+        current_ = latch;
+        if (node.getIncrement()) {
+            lowerStatement(*node.getIncrement());
+        }
+        if (current_) {
+            branch(header);
+        }
+    }
+    sealBlock(header);
+
+    current_ = nullptr;
+    if (!exit->getPredecessors().empty()) {
+        placeBlock(exit);
+        sealBlock(exit);
+        current_ = exit;
     }
-    
-    return irBlock;
+    scopes_.pop_back();
 }
 
-std::unique_ptr<IRInstruction> LoweringPass::lowerInstruction(const ASTNode& node) {
-    // Placeholder implementation - would convert specific AST nodes to IR instructions
+IRValue* LoweringPass::lowerExpression(const ASTNode& node) {
     switch (node.getType()) {
-        case ASTNodeType::BinaryOperation: {
-            // Convert to appropriate arithmetic instruction
-            // Placeholder - would need to determine operator and operands
-            return nullptr; // Placeholder
+    case ASTNodeType::Literal: {
+        const auto value = semantic::parseLiteral(static_cast<const LiteralNode&>(node).getValue());
+        if (!value) {
+            return undef(IRType::Opaque); // null
+        }
+        IRConstantValue constant = toConstant(*value);
+        const IRType type = constantType(constant);
+        return function_->getConstant(type, std::move(constant));
+    }
+    case ASTNodeType::Identifier: {
+        const auto& identifier = static_cast<const IdentifierNode&>(node);
+        if (const auto variable = lookupVariable(identifier.getName())) {
+            return readVariable(*variable, current_);
+        }
+        return undef(typeOf(node, IRType::Opaque)); // function name used as a value
+    }
+    case ASTNodeType::BinaryOperation:
+        return lowerBinary(static_cast<const BinaryOperationNode&>(node));
+    case ASTNodeType::UnaryOperation: {
+        const auto& unary = static_cast<const UnaryOperationNode&>(node);
+        IRValue* operand = unary.getOperand() ? lowerExpression(*unary.getOperand()) : undef(IRType::Opaque);
+        const std::string& op = unary.getOperator();
+        if (op == "-") {
+            return emit(IRInstructionOp::Neg, typeOf(node, operand->getType()), {operand});
+        }
+        if (op == "!" || op == "not") {
+            return emit(IRInstructionOp::Not, IRType::Bool, {operand});
+        }
+        return operand; // unary `+`, and `move`, which only matters to ownership checking
+    }
+    case ASTNodeType::CallExpression:
+        return lowerCall(static_cast<const CallExpressionNode&>(node));
+    case ASTNodeType::Assignment:
+        lowerStatement(node);
+        return undef(IRType::Void);
+    default:
+        return undef(IRType::Opaque);
+    }
+}
+
+IRValue* LoweringPass::lowerBinary(const BinaryOperationNode& node) {
+    const std::string& op = node.getOperator();
+    const bool isAnd = op == "&&" || op == "and";
+    if (isAnd || op == "||" || op == "or") {
+        return lowerShortCircuit(node, isAnd);
+    }
+
+    IRValue* left = node.getLeft() ? lowerExpression(*node.getLeft()) : undef(IRType::Opaque);
+    IRValue* right = node.getRight() ? lowerExpression(*node.getRight()) : undef(IRType::Opaque);
+    const IRType type = isComparison(op) ? IRType::Bool : typeOf(node, left->getType());
+
+    if (const auto opcode = binaryOpcode(op)) {
+        return emit(*opcode, type, {left, right});
+    }
+    // Operators without an opcode (`**`, ...) become calls to an operator function.
+    IRInstruction* call = emit(IRInstructionOp::Call, type, {left, right});
+    call->setCallee("operator" + op);
+    return call;
+}
+
+// `a && b`: b only runs if a is true, so it may call functions or divide by a
+// value that `a` checked.
+IRValue* LoweringPass::lowerShortCircuit(const BinaryOperationNode& node, bool isAnd) {
+    IRValue* left = lowerExpression(*node.getLeft());
+    IRBasicBlock* leftEnd = current_;
+    IRBasicBlock* rhs = createBlock(isAnd ? "and.rhs" : "or.rhs");
+    IRBasicBlock* end = createBlock(isAnd ? "and.end" : "or.end");
+    if (isAnd) {
+        branchIf(left, rhs, end);
+    } else {
+        branchIf(left, end, rhs);
+    }
+
+    placeBlock(rhs);
+    sealBlock(rhs);
+    current_ = rhs;
+    IRValue* right = lowerExpression(*node.getRight());
+    IRBasicBlock* rightEnd = current_;
+    branch(end);
+
+    placeBlock(end);
+    sealBlock(end);
+    current_ = end;
+    IRInstruction* phi = end->addPhi(function_->createInstruction(IRInstructionOp::Phi, IRType::Bool));
+    phi->addOperand(function_->getConstant(IRType::Bool, !isAnd));
+    phi->addBlock(leftEnd);
+    phi->addOperand(right);
+    phi->addBlock(rightEnd);
+    return phi;
+}
+
+IRValue* LoweringPass::lowerCall(const CallExpressionNode& node) {
+    std::vector<IRValue*> arguments;
+    for (const auto& arg : node.getArguments()) {
+        arguments.push_back(arg ? lowerExpression(*arg) : undef(IRType::Opaque));
+    }
+    IRInstruction* call = emit(IRInstructionOp::Call, typeOf(node, IRType::Opaque), std::move(arguments));
+    const auto* callee = node.getCallee();
+    call->setCallee(callee && callee->getType() == ASTNodeType::Identifier
+                        ? static_cast<const IdentifierNode*>(callee)->getName()
+                        : std::string("<indirect>"));
+    return call;
+}
+
+void LoweringPass::writeVariable(VariableId variable, IRBasicBlock* block, IRValue* value) {
+    currentDef_[block][variable] = value;
+}
+
+IRValue* LoweringPass::readVariable(VariableId variable, IRBasicBlock* block) {
+    const auto blockDefs = currentDef_.find(block);
+    if (blockDefs != currentDef_.end()) {
+        const auto it = blockDefs->second.find(variable);
+        if (it != blockDefs->second.end()) {
+            return it->second; // local value numbering
+        }
+    }
+    return readVariableRecursive(variable, block);
+}
+
+IRValue* LoweringPass::readVariableRecursive(VariableId variable, IRBasicBlock* block) {
+    const IRType type = variableTypes_[variable];
+    IRValue* value = nullptr;
+    if (!sealed_.contains(block)) {
+        // Not all predecessors are known yet: operands are added when the block is sealed.
+        IRInstruction* incomplete = block->addPhi(function_->createInstruction(IRInstructionOp::Phi, type));
+        incompletePhis_[block].emplace_back(variable, incomplete);
+        value = incomplete;
+    } else if (block->getPredecessors().empty()) {
+        value = undef(type); // read before any write
+    } else if (block->getPredecessors().size() == 1) {
+        value = readVariable(variable, block->getPredecessors().front());
+    } else {
+        // Break cycles by recording the Phi before looking at the predecessors.
+        IRInstruction* join = block->addPhi(function_->createInstruction(IRInstructionOp::Phi, type));
+        writeVariable(variable, block, join);
+        value = addPhiOperands(variable, join);
+    }
+    writeVariable(variable, block, value);
+    return value;
+}
+
+IRValue* LoweringPass::addPhiOperands(VariableId variable, IRInstruction* phi) {
+    for (IRBasicBlock* pred : phi->getParent()->getPredecessors()) {
+        phi->addOperand(readVariable(variable, pred));
+        phi->addBlock(pred);
+    }
+    return tryRemoveTrivialPhi(phi);
+}
+
+IRValue* LoweringPass::tryRemoveTrivialPhi(IRInstruction* phi) {
+    IRValue* same = nullptr;
+    for (std::size_t i = 0; i < phi->getNumOperands(); ++i) {
+        IRValue* operand = phi->getOperand(i);
+        if (operand == same || operand == phi) {
+            continue; // unique value or self-reference
+        }
+        if (same) {
+            return phi; // merges at least two values: not trivial
+        }
+        same = operand;
+    }
+    if (!same) {
+        same = undef(phi->getType()); // unreachable or only self-references
+    }
+
+    // Remember the Phis using this one; they may become trivial in turn.
+    std::vector<IRInstruction*> phiUsers;
+    for (const IRUse& use : phi->uses()) {
+        IRInstruction* user = use.getUser();
+        if (user != phi && user->getOp() == IRInstructionOp::Phi &&
+            std::find(phiUsers.begin(), phiUsers.end(), user) == phiUsers.end()) {
+            phiUsers.push_back(user);
         }
-        case ASTNodeType::Return: {
-            // Convert to return instruction
-            return nullptr; // Placeholder
+    }
+
+    phi->replaceAllUsesWith(same);
+    for (auto& [block, defs] : currentDef_) {
+        for (auto& [variable, value] : defs) {
+            if (value == phi) {
+                value = same;
+            }
         }
-        case ASTNodeType::Assignment: {
-            // Convert to store or assignment instruction
-            return nullptr; // Placeholder
+    }
+    phi->eraseFromParent();
+
+    for (IRInstruction* user : phiUsers) {
+        if (user->getParent()) { // may have been removed while handling an earlier user
+            tryRemoveTrivialPhi(user);
+        }
+    }
+    return same;
+}
+
+void LoweringPass::sealBlock(IRBasicBlock* block) {
+    if (!sealed_.insert(block).second) {
+        return;
+    }
+    const auto pending = incompletePhis_.find(block);
+    if (pending == incompletePhis_.end()) {
+        return;
+    }
+    const auto phis = std::move(pending->second);
+    incompletePhis_.erase(pending);
+    for (const auto& [variable, phi] : phis) {
+        addPhiOperands(variable, phi);
+    }
+}
+
+LoweringPass::VariableId LoweringPass::declareVariable(const std::string& name, IRType type) {
+    const VariableId variable = variableTypes_.size();
+    variableTypes_.push_back(type);
+    scopes_.back()[name] = variable;
+    return variable;
+}
+
+std::optional<LoweringPass::VariableId> LoweringPass::lookupVariable(std::string_view name) const {
+    for (auto scope = scopes_.rbegin(); scope != scopes_.rend(); ++scope) {
+        const auto it = scope->find(std::string(name));
+        if (it != scope->end()) {
+            return it->second;
         }
-        case ASTNodeType::CallExpression: {
-            // Convert to call instruction
-            return nullptr; // Placeholder
+    }
+    return std::nullopt;
+}
+
+IRBasicBlock* LoweringPass::createBlock(std::string_view label) {
+    return function_->createBlock(label);
+}
+
+void LoweringPass::placeBlock(IRBasicBlock* block) {
+    if (!block->isLinked()) {
+        function_->insertBlock(block);
+    }
+}
+
+IRInstruction* LoweringPass::emit(IRInstructionOp op, IRType type, std::vector<IRValue*> operands) {
+    IRInstruction* inst = function_->createInstruction(op, type);
+    for (IRValue* operand : operands) {
+        inst->addOperand(operand);
+    }
+    return current_->append(inst);
+}
+
+void LoweringPass::branch(IRBasicBlock* target) {
+    IRInstruction* inst = emit(IRInstructionOp::Branch, IRType::Void, {});
+    inst->addBlock(target);
+    target->addPredecessor(current_);
+    current_ = nullptr;
+}
+
+void LoweringPass::branchIf(IRValue* condition, IRBasicBlock* thenBlock, IRBasicBlock* elseBlock) {
+    IRInstruction* inst = emit(IRInstructionOp::BranchIf, IRType::Void, {condition});
+    inst->addBlock(thenBlock);
+    inst->addBlock(elseBlock);
+    thenBlock->addPredecessor(current_);
+    elseBlock->addPredecessor(current_);
+    current_ = nullptr;
+}
+
+IRValue* LoweringPass::undef(IRType type) {
+    return function_->getUndef(type);
+}
+
+IRType LoweringPass::typeOf(const ASTNode& node, IRType fallback) const {
+    if (annotations_) {
+        if (const auto type = annotations_->typeOf(node); type && type->name() != "any") {
+            return irTypeOf(type->name());
         }
-        default:
-            // Other node types would need specific handling
-            return nullptr;
     }
+    return fallback;
 }
 
-} // namespace istudio::ir
\ No newline at end of file
+} // namespace istudio::ir
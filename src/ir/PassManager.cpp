@@ -0,0 +1,270 @@
+#include "ir/PassManager.h"
+
+#include "ir/Verifier.h"
+#include "istudio/ThreadPool.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <string>
+#include <thread>
+
+namespace istudio::ir {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// One pass on one function, recorded by the worker that ran it.
+struct Sample {
+    std::chrono::nanoseconds time{0};
+    std::ptrdiff_t blockDelta{0};
+    std::ptrdiff_t instructionDelta{0};
+    bool unchanged{false};
+};
+
+std::string verificationFailure(std::string_view when, const std::vector<std::string>& problems)
+{
+    std::string message = "IR verification failed " + std::string(when) + ':';
+    for (const std::string& problem : problems) {
+        message += "\n  " + problem;
+    }
+    return message;
+}
+
+double milliseconds(std::chrono::nanoseconds time)
+{
+    return std::chrono::duration<double, std::milli>(time).count();
+}
+
+// The analyses vector follows the module's function list; functions a module pass
+// added get a fresh cache. Returns the analysis runs of the caches dropped with
+// removed functions.
+std::size_t syncAnalyses(const IRModule& module, std::vector<std::unique_ptr<FunctionAnalyses>>& analyses)
+{
+    std::vector<std::unique_ptr<FunctionAnalyses>> synced;
+    synced.reserve(module.getFunctions().size());
+    for (const auto& function : module.getFunctions()) {
+        const auto it = std::find_if(analyses.begin(), analyses.end(),
+                                     [&](const auto& entry) { return entry && &entry->function() == function.get(); });
+        synced.push_back(it != analyses.end() ? std::move(*it) : std::make_unique<FunctionAnalyses>(*function));
+    }
+    std::size_t dropped = 0;
+    for (const auto& entry : analyses) {
+        dropped += entry ? entry->computedCount() : 0;
+    }
+    analyses = std::move(synced);
+    return dropped;
+}
+
+} // namespace
+
+const char* toString(AnalysisKind kind)
+{
+    switch (kind) {
+    case AnalysisKind::Dominators:
+        return "dominators";
+    case AnalysisKind::Loops:
+        return "loops";
+    case AnalysisKind::Liveness:
+        return "liveness";
+    case AnalysisKind::Count:
+        break;
+    }
+    return "unknown";
+}
+
+void FunctionAnalyses::invalidate(const PreservedAnalyses& preserved)
+{
+    for (std::size_t kind = 0; kind < results_.size(); ++kind) {
+        if (!preserved.preserves(static_cast<AnalysisKind>(kind))) {
+            results_[kind].reset();
+        }
+    }
+}
+
+IRSize measure(const IRFunction& function)
+{
+    IRSize size;
+    size.functions = 1;
+    for (const IRBasicBlock& block : function.getBasicBlocks()) {
+        ++size.blocks;
+        size.instructions += block.getInstructions().size();
+    }
+    return size;
+}
+
+IRSize measure(const IRModule& module)
+{
+    IRSize total;
+    for (const auto& function : module.getFunctions()) {
+        const IRSize size = measure(*function);
+        total.functions += size.functions;
+        total.blocks += size.blocks;
+        total.instructions += size.instructions;
+    }
+    return total;
+}
+
+void PassManager::addPass(std::unique_ptr<FunctionPass> pass)
+{
+    if (stages_.empty() || stages_.back().modulePass) {
+        stages_.emplace_back();
+    }
+    stages_.back().functionPasses.push_back(std::move(pass));
+}
+
+void PassManager::addPass(std::unique_ptr<ModulePass> pass)
+{
+    stages_.emplace_back();
+    stages_.back().modulePass = std::move(pass);
+}
+
+std::expected<void, std::string> PassManager::run(IRModule& module)
+{
+    statistics_.clear();
+    for (auto& stage : stages_) {
+        stage.firstStatistic = statistics_.size();
+        if (stage.modulePass) {
+            statistics_.push_back(PassStatistics{std::string(stage.modulePass->name())});
+        }
+        for (const auto& pass : stage.functionPasses) {
+            statistics_.push_back(PassStatistics{std::string(pass->name())});
+        }
+    }
+
+    const auto start = Clock::now();
+    std::vector<std::unique_ptr<FunctionAnalyses>> analyses;
+    analysisRuns_ = 0;
+    syncAnalyses(module, analyses);
+    std::expected<void, std::string> result;
+    if (options_.verifyEach) {
+        if (const auto problems = verifyModule(module); !problems.empty()) {
+            result = std::unexpected(verificationFailure("before the first pass", problems));
+        }
+    }
+    for (auto stage = stages_.begin(); result && stage != stages_.end(); ++stage) {
+        result = stage->modulePass ? runModulePass(*stage, module, analyses) : runPipeline(*stage, module, analyses);
+    }
+    for (const auto& cache : analyses) {
+        analysisRuns_ += cache->computedCount();
+    }
+    total_ = Clock::now() - start;
+    return result;
+}
+
+std::expected<void, std::string> PassManager::runModulePass(Stage& stage, IRModule& module,
+                                                            std::vector<std::unique_ptr<FunctionAnalyses>>& analyses)
+{
+    auto& stats = statistics_[stage.firstStatistic];
+    const IRSize before = options_.timePasses ? measure(module) : IRSize{};
+    const auto start = Clock::now();
+    const PreservedAnalyses preserved = stage.modulePass->run(module);
+    stats.time += Clock::now() - start;
+    if (options_.timePasses) {
+        const IRSize after = measure(module);
+        stats.blockDelta += static_cast<std::ptrdiff_t>(after.blocks) - static_cast<std::ptrdiff_t>(before.blocks);
+        stats.instructionDelta +=
+            static_cast<std::ptrdiff_t>(after.instructions) - static_cast<std::ptrdiff_t>(before.instructions);
+    }
+    ++stats.runs;
+    stats.unchanged += preserved.preservesAll() ? 1 : 0;
+
+    for (const auto& cache : analyses) {
+        cache->invalidate(preserved);
+    }
+    analysisRuns_ += syncAnalyses(module, analyses);
+
+    if (options_.verifyEach) {
+        if (const auto problems = verifyModule(module); !problems.empty()) {
+            return std::unexpected(
+                verificationFailure("after pass '" + std::string(stage.modulePass->name()) + "'", problems));
+        }
+    }
+    return {};
+}
+
+std::expected<void, std::string> PassManager::runPipeline(Stage& stage, IRModule& module,
+                                                          std::vector<std::unique_ptr<FunctionAnalyses>>& analyses)
+{
+    const auto& functions = module.getFunctions();
+    const std::size_t passCount = stage.functionPasses.size();
+    std::vector<Sample> samples(functions.size() * passCount);
+    // A function whose IR a pass broke goes no further; its failure is kept here.
+    std::vector<std::string> failures(functions.size());
+
+    const unsigned jobs = options_.jobs != 0 ? options_.jobs : std::max(1u, std::thread::hardware_concurrency());
+    ThreadPool pool(static_cast<unsigned>(std::min<std::size_t>(jobs, std::max<std::size_t>(functions.size(), 1))));
+    pool.parallelFor(functions.size(), [&](std::size_t index) {
+        IRFunction& function = *functions[index];
+        FunctionAnalyses& cache = *analyses[index];
+        IRSize before = options_.timePasses ? measure(function) : IRSize{};
+        for (std::size_t pass = 0; pass < passCount; ++pass) {
+            Sample& sample = samples[index * passCount + pass];
+            const auto start = options_.timePasses ? Clock::now() : Clock::time_point{};
+            const PreservedAnalyses preserved = stage.functionPasses[pass]->run(function, cache);
+            cache.invalidate(preserved);
+            sample.unchanged = preserved.preservesAll();
+            if (options_.timePasses) {
+                sample.time = Clock::now() - start;
+                const IRSize after = measure(function);
+                sample.blockDelta = static_cast<std::ptrdiff_t>(after.blocks) - static_cast<std::ptrdiff_t>(before.blocks);
+                sample.instructionDelta =
+                    static_cast<std::ptrdiff_t>(after.instructions) - static_cast<std::ptrdiff_t>(before.instructions);
+                before = after;
+            }
+            if (options_.verifyEach) {
+                if (const auto problems = verifyFunction(function); !problems.empty()) {
+                    failures[index] = verificationFailure(
+                        "after pass '" + std::string(stage.functionPasses[pass]->name()) + "'", problems);
+                    break;
+                }
+            }
+        }
+    });
+
+    // Merged after the parallel section so workers never contend on the statistics.
+    for (std::size_t index = 0; index < functions.size(); ++index) {
+        for (std::size_t pass = 0; pass < passCount; ++pass) {
+            const Sample& sample = samples[index * passCount + pass];
+            auto& stats = statistics_[stage.firstStatistic + pass];
+            stats.time += sample.time;
+            stats.blockDelta += sample.blockDelta;
+            stats.instructionDelta += sample.instructionDelta;
+            ++stats.runs;
+            stats.unchanged += sample.unchanged ? 1 : 0;
+        }
+    }
+
+    // The first broken function in module order, so the report does not depend on
+    // thread scheduling.
+    for (std::string& failure : failures) {
+        if (!failure.empty()) {
+            return std::unexpected(std::move(failure));
+        }
+    }
+    return {};
+}
+
+void PassManager::printReport(std::ostream& out) const
+{
+    const auto flags = out.flags();
+    const auto precision = out.precision();
+    out << "===== Pass execution report =====\n";
+    out << std::setw(10) << "time (ms)" << std::setw(9) << "insts" << std::setw(9) << "blocks" << std::setw(11)
+        << "changed" << "  pass\n";
+    std::chrono::nanoseconds passTime{0};
+    out << std::fixed << std::setprecision(3);
+    for (const auto& stats : statistics_) {
+        passTime += stats.time;
+        out << std::setw(10) << milliseconds(stats.time) << std::showpos << std::setw(9) << stats.instructionDelta
+            << std::setw(9) << stats.blockDelta << std::noshowpos << std::setw(11)
+            << (std::to_string(stats.runs - stats.unchanged) + '/' + std::to_string(stats.runs)) << "  "
+            << stats.name << '\n';
+    }
+    out << std::setw(10) << milliseconds(passTime) << "  total pass time\n";
+    out << std::setw(10) << milliseconds(total_) << "  wall time (" << analysisRuns_ << " analysis runs)\n";
+    out.flags(flags);
+    out.precision(precision);
+}
+
+} // namespace istudio::ir
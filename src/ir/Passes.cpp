@@ -0,0 +1,98 @@
+#include "ir/Passes.h"
+
+#include "ir/DeadCodeElimination.h"
+#include "ir/GVN.h"
+#include "ir/Inliner.h"
+#include "ir/LICM.h"
+#include "ir/LoopSimplify.h"
+#include "ir/LoopUnroll.h"
+#include "ir/SCCP.h"
+#include "ir/SimplifyCFG.h"
+#include "ir/TailCallElimination.h"
+#include "ir/ValueRange.h"
+
+#include <functional>
+#include <memory>
+
+namespace istudio::ir {
+
+namespace {
+
+struct PassEntry {
+    std::string_view name;
+    std::function<void(PassManager&)> add;
+};
+
+template <typename Pass>
+PassEntry entry(std::string_view name)
+{
+    return {name, [](PassManager& manager) { manager.addPass(std::make_unique<Pass>()); }};
+}
+
+const std::vector<PassEntry>& registry()
+{
+    static const std::vector<PassEntry> passes = {
+        entry<Inliner>("inline"),
+        entry<DeadCodeElimination>("dce"),
+        entry<AggressiveDeadCodeElimination>("adce"),
+        entry<SparseConditionalConstantPropagation>("sccp"),
+        entry<GlobalValueNumbering>("gvn"),
+        entry<LoopSimplify>("loop-simplify"),
+        entry<LoopInvariantCodeMotion>("licm"),
+        entry<LoopUnroll>("loop-unroll"),
+        entry<SimplifyCFG>("simplifycfg"),
+        entry<TailCallElimination>("tailcall"),
+        entry<ValueRangePropagation>("vrp"),
+    };
+    return passes;
+}
+
+} // namespace
+
+std::string_view defaultPipeline()
+{
+    // tailcall goes first: recursion it turns into loops no longer blocks inlining,
+    // and the loop passes see the loops. vrp needs the preheaders loop-simplify
+    // adds to find induction variables, and runs before loop-unroll copies the
+    // checks it can fold.
+    return "tailcall,inline,sccp,gvn,loop-simplify,licm,vrp,loop-unroll,adce,simplifycfg";
+}
+
+std::vector<std::string_view> registeredPasses()
+{
+    std::vector<std::string_view> names;
+    for (const auto& pass : registry()) {
+        names.push_back(pass.name);
+    }
+    return names;
+}
+
+bool addPipeline(PassManager& manager, std::string_view pipeline, std::string& error)
+{
+    std::vector<const PassEntry*> selected;
+    while (!pipeline.empty()) {
+        const auto comma = pipeline.find(',');
+        const std::string_view name = pipeline.substr(0, comma);
+        pipeline = comma == std::string_view::npos ? std::string_view{} : pipeline.substr(comma + 1);
+        if (name.empty()) {
+            continue;
+        }
+        const PassEntry* found = nullptr;
+        for (const auto& pass : registry()) {
+            if (pass.name == name) {
+                found = &pass;
+            }
+        }
+        if (!found) {
+            error = "Unknown pass: " + std::string(name);
+            return false;
+        }
+        selected.push_back(found);
+    }
+    for (const auto* pass : selected) {
+        pass->add(manager);
+    }
+    return true;
+}
+
+} // namespace istudio::ir
@@ -0,0 +1,298 @@
+#include "ir/SCCP.h"
+
+#include "semantic/ConstantEvaluator.h"
+
+#include <optional>
+#include <set>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace istudio::ir {
+
+namespace {
+
+// Source-level spelling of the operators the evaluator folds.
+std::optional<std::string_view> operatorOf(IRInstructionOp op)
+{
+    switch (op) {
+    case IRInstructionOp::Add: return "+";
+    case IRInstructionOp::Sub: return "-";
+    case IRInstructionOp::Mul: return "*";
+    case IRInstructionOp::Div: return "/";
+    case IRInstructionOp::Rem: return "%";
+    case IRInstructionOp::And: return "&&";
+    case IRInstructionOp::Or: return "||";
+    case IRInstructionOp::Eq: return "==";
+    case IRInstructionOp::Ne: return "!=";
+    case IRInstructionOp::Lt: return "<";
+    case IRInstructionOp::Le: return "<=";
+    case IRInstructionOp::Gt: return ">";
+    case IRInstructionOp::Ge: return ">=";
+    case IRInstructionOp::Neg: return "-";
+    case IRInstructionOp::Not: return "!";
+    default: return std::nullopt;
+    }
+}
+
+std::optional<semantic::ConstantValue> toSemantic(const IRConstantValue& value)
+{
+    return std::visit(
+        [](const auto& v) -> std::optional<semantic::ConstantValue> {
+            if constexpr (std::is_same_v<std::decay_t<decltype(v)>, std::monostate>) {
+                return std::nullopt;
+            } else {
+                return semantic::ConstantValue(v);
+            }
+        },
+        value);
+}
+
+IRType typeOf(const semantic::ConstantValue& value)
+{
+    if (std::holds_alternative<bool>(value)) {
+        return IRType::Bool;
+    }
+    if (std::holds_alternative<std::int64_t>(value)) {
+        return IRType::Int;
+    }
+    if (std::holds_alternative<double>(value)) {
+        return IRType::Float;
+    }
+    return IRType::String;
+}
+
+// Lattice: Unknown (not yet seen, optimistically constant) > Constant > Overdefined.
+struct LatticeValue {
+    enum class State { Unknown, Constant, Overdefined } state{State::Unknown};
+    semantic::ConstantValue constant{};
+
+    bool isUnknown() const { return state == State::Unknown; }
+    bool isConstant() const { return state == State::Constant; }
+    bool isOverdefined() const { return state == State::Overdefined; }
+};
+
+class Solver {
+public:
+    explicit Solver(IRFunction& function) : function_(function), values_(function.getValueCount()) {}
+
+    void solve()
+    {
+        markBlock(function_.getEntryBlock());
+        while (!blockWork_.empty() || !valueWork_.empty()) {
+            while (!valueWork_.empty()) {
+                IRInstruction* inst = valueWork_.back();
+                valueWork_.pop_back();
+                visit(*inst);
+            }
+            while (!blockWork_.empty()) {
+                IRBasicBlock* block = blockWork_.back();
+                blockWork_.pop_back();
+                for (IRInstruction& inst : *block) {
+                    visit(inst);
+                }
+            }
+        }
+    }
+
+    // Replaces constant instructions; returns whether anything changed.
+    bool rewrite()
+    {
+        bool changed = false;
+        for (IRBasicBlock& block : function_.getBasicBlocks()) {
+            if (!executable_.contains(&block)) {
+                continue;
+            }
+            for (auto it = block.begin(); it != block.end();) {
+                IRInstruction& inst = *it++;
+                if (inst.getOp() == IRInstructionOp::BranchIf) {
+                    const LatticeValue& condition = lattice(inst.getOperand(0));
+                    if (condition.isConstant() && inst.getOperand(0)->getKind() != IRValueKind::Constant) {
+                        inst.setOperand(0, constantFor(condition.constant));
+                        changed = true;
+                    }
+                    continue;
+                }
+                if (inst.getType() == IRType::Void || inst.getOp() == IRInstructionOp::Call) {
+                    continue;
+                }
+                const LatticeValue& value = values_[inst.getId()];
+                if (value.isConstant()) {
+                    inst.replaceAllUsesWith(constantFor(value.constant));
+                    inst.eraseFromParent();
+                    changed = true;
+                }
+            }
+        }
+        return changed;
+    }
+
+private:
+    IRConstant* constantFor(const semantic::ConstantValue& value)
+    {
+        return function_.getConstant(typeOf(value), std::visit([](const auto& v) { return IRConstantValue(v); }, value));
+    }
+
+    LatticeValue lattice(const IRValue* value) const
+    {
+        if (!value) {
+            return {LatticeValue::State::Overdefined};
+        }
+        switch (value->getKind()) {
+        case IRValueKind::Constant: {
+            const auto constant = toSemantic(static_cast<const IRConstant*>(value)->getValue());
+            // undef and null are left alone rather than exploited.
+            return constant ? LatticeValue{LatticeValue::State::Constant, *constant}
+                            : LatticeValue{LatticeValue::State::Overdefined};
+        }
+        case IRValueKind::Instruction:
+            return values_[value->getId()];
+        default:
+            return {LatticeValue::State::Overdefined}; // arguments
+        }
+    }
+
+    void markBlock(IRBasicBlock* block)
+    {
+        if (executable_.insert(block).second) {
+            blockWork_.push_back(block);
+        }
+    }
+
+    void markEdge(IRBasicBlock* from, IRBasicBlock* to)
+    {
+        if (!edges_.insert({from, to}).second) {
+            return;
+        }
+        if (executable_.contains(to)) {
+            // Already visited: only its Phis can see a new incoming value.
+            for (IRInstruction& inst : *to) {
+                if (inst.getOp() != IRInstructionOp::Phi) {
+                    break;
+                }
+                visit(inst);
+            }
+        } else {
+            markBlock(to);
+        }
+    }
+
+    // Lowers `inst` in the lattice; users are revisited when it changes.
+    void update(IRInstruction& inst, LatticeValue value)
+    {
+        LatticeValue& current = values_[inst.getId()];
+        if (current.isOverdefined() || value.isUnknown()) {
+            return;
+        }
+        if (current.isConstant() && value.isConstant() && current.constant == value.constant) {
+            return;
+        }
+        if (current.isConstant()) {
+            value.state = LatticeValue::State::Overdefined; // a second, different constant
+        }
+        current = std::move(value);
+        for (const IRUse& use : inst.uses()) {
+            IRInstruction* user = use.getUser();
+            if (user->getParent() && executable_.contains(user->getParent())) {
+                valueWork_.push_back(user);
+            }
+        }
+    }
+
+    void visit(IRInstruction& inst)
+    {
+        switch (inst.getOp()) {
+        case IRInstructionOp::Branch:
+            markEdge(inst.getParent(), inst.getBlocks()[0]);
+            return;
+        case IRInstructionOp::BranchIf: {
+            const LatticeValue condition = lattice(inst.getOperand(0));
+            const bool* taken = condition.isConstant() ? std::get_if<bool>(&condition.constant) : nullptr;
+            if (taken) {
+                markEdge(inst.getParent(), inst.getBlocks()[*taken ? 0 : 1]);
+            } else if (!condition.isUnknown()) {
+                markEdge(inst.getParent(), inst.getBlocks()[0]);
+                markEdge(inst.getParent(), inst.getBlocks()[1]);
+            }
+            return;
+        }
+        case IRInstructionOp::Phi:
+            visitPhi(inst);
+            return;
+        default:
+            break;
+        }
+        if (inst.getType() == IRType::Void) {
+            return;
+        }
+
+        const auto op = operatorOf(inst.getOp());
+        if (!op) {
+            update(inst, {LatticeValue::State::Overdefined}); // calls and memory
+            return;
+        }
+        std::vector<LatticeValue> operands;
+        for (std::size_t i = 0; i < inst.getNumOperands(); ++i) {
+            operands.push_back(lattice(inst.getOperand(i)));
+            if (operands.back().isOverdefined()) {
+                update(inst, {LatticeValue::State::Overdefined});
+                return;
+            }
+        }
+        for (const auto& operand : operands) {
+            if (operand.isUnknown()) {
+                return; // wait for the operand
+            }
+        }
+        std::optional<semantic::ConstantValue> result;
+        if (operands.size() == 1) {
+            result = evaluator_.unary(*op, operands[0].constant);
+        } else if (operands.size() == 2) {
+            result = evaluator_.binary(*op, operands[0].constant, operands[1].constant);
+        }
+        update(inst, result ? LatticeValue{LatticeValue::State::Constant, std::move(*result)}
+                            : LatticeValue{LatticeValue::State::Overdefined});
+    }
+
+    void visitPhi(IRInstruction& phi)
+    {
+        LatticeValue merged;
+        for (std::size_t i = 0; i < phi.getNumOperands(); ++i) {
+            if (!edges_.contains({phi.getBlocks()[i], phi.getParent()})) {
+                continue; // values along edges never taken do not count
+            }
+            const LatticeValue incoming = lattice(phi.getOperand(i));
+            if (incoming.isUnknown()) {
+                continue;
+            }
+            if (incoming.isOverdefined() || (merged.isConstant() && !(merged.constant == incoming.constant))) {
+                update(phi, {LatticeValue::State::Overdefined});
+                return;
+            }
+            merged = incoming;
+        }
+        update(phi, std::move(merged));
+    }
+
+    IRFunction& function_;
+    semantic::ConstantEvaluator evaluator_; // operators only; no pure functions
+    std::vector<LatticeValue> values_;       // by value id
+    std::unordered_set<const IRBasicBlock*> executable_;
+    std::set<std::pair<const IRBasicBlock*, const IRBasicBlock*>> edges_;
+    std::vector<IRBasicBlock*> blockWork_;
+    std::vector<IRInstruction*> valueWork_;
+};
+
+} // namespace
+
+PreservedAnalyses SparseConditionalConstantPropagation::run(IRFunction& function, FunctionAnalyses&) const
+{
+    if (!function.getEntryBlock()) {
+        return PreservedAnalyses::all();
+    }
+    Solver solver(function);
+    solver.solve();
+    return solver.rewrite() ? PreservedAnalyses::cfg() : PreservedAnalyses::all();
+}
+
+} // namespace istudio::ir
@@ -0,0 +1,213 @@
+#include "ir/SimplifyCFG.h"
+
+#include <algorithm>
+#include <unordered_set>
+#include <vector>
+
+namespace istudio::ir {
+
+namespace {
+
+// Replaces the terminator of `block` by `br target`.
+void replaceWithBranch(IRBasicBlock& block, IRBasicBlock* target)
+{
+    IRInstruction* terminator = block.getTerminator();
+    IRInstruction* branch = block.getParent()->createInstruction(IRInstructionOp::Branch);
+    branch->addBlock(target);
+    block.insertBefore(terminator, branch);
+    terminator->eraseFromParent();
+}
+
+bool foldBranches(IRFunction& function)
+{
+    bool changed = false;
+    for (IRBasicBlock& block : function.getBasicBlocks()) {
+        IRInstruction* terminator = block.getTerminator();
+        if (!terminator || terminator->getOp() != IRInstructionOp::BranchIf) {
+            continue;
+        }
+        IRBasicBlock* thenBlock = terminator->getBlocks()[0];
+        IRBasicBlock* elseBlock = terminator->getBlocks()[1];
+        if (thenBlock == elseBlock) {
+            thenBlock->removeIncomingEdge(&block); // one of the two identical edges
+            replaceWithBranch(block, thenBlock);
+            changed = true;
+            continue;
+        }
+        const IRValue* condition = terminator->getOperand(0);
+        if (condition->getKind() != IRValueKind::Constant) {
+            continue;
+        }
+        const auto* taken = std::get_if<bool>(&static_cast<const IRConstant*>(condition)->getValue());
+        if (!taken) {
+            continue; // undef: leave it to whoever produced it
+        }
+        (*taken ? elseBlock : thenBlock)->removeIncomingEdge(&block);
+        replaceWithBranch(block, *taken ? thenBlock : elseBlock);
+        changed = true;
+    }
+    return changed;
+}
+
+bool removeUnreachableBlocks(IRFunction& function)
+{
+    std::unordered_set<const IRBasicBlock*> reachable;
+    std::vector<IRBasicBlock*> worklist{function.getEntryBlock()};
+    reachable.insert(function.getEntryBlock());
+    while (!worklist.empty()) {
+        IRBasicBlock* block = worklist.back();
+        worklist.pop_back();
+        for (IRBasicBlock* successor : block->getSuccessors()) {
+            if (reachable.insert(successor).second) {
+                worklist.push_back(successor);
+            }
+        }
+    }
+
+    std::vector<IRBasicBlock*> dead;
+    for (IRBasicBlock& block : function.getBasicBlocks()) {
+        if (!reachable.contains(&block)) {
+            dead.push_back(&block);
+        }
+    }
+    for (IRBasicBlock* block : dead) {
+        for (IRBasicBlock* successor : block->getSuccessors()) {
+            successor->removeIncomingEdge(block);
+        }
+        for (IRInstruction& inst : *block) {
+            inst.dropAllReferences();
+        }
+    }
+    for (IRBasicBlock* block : dead) {
+        for (auto it = block->begin(); it != block->end();) {
+            IRInstruction& inst = *it++;
+            // Only other dead blocks can still refer to it, and they are going too.
+            inst.replaceAllUsesWith(function.getUndef(inst.getType()));
+            inst.eraseFromParent();
+        }
+        function.removeBlock(block);
+    }
+    return !dead.empty();
+}
+
+bool removeTrivialPhis(IRFunction& function)
+{
+    bool changed = false;
+    for (IRBasicBlock& block : function.getBasicBlocks()) {
+        for (auto it = block.begin(); it != block.end() && it->getOp() == IRInstructionOp::Phi;) {
+            IRInstruction& phi = *it++;
+            IRValue* same = nullptr;
+            bool trivial = true;
+            for (std::size_t i = 0; i < phi.getNumOperands(); ++i) {
+                IRValue* operand = phi.getOperand(i);
+                if (operand == &phi || operand == same) {
+                    continue;
+                }
+                trivial = same == nullptr;
+                same = operand;
+                if (!trivial) {
+                    break;
+                }
+            }
+            if (trivial) {
+                phi.replaceAllUsesWith(same ? same : function.getUndef(phi.getType()));
+                phi.eraseFromParent();
+                changed = true;
+            }
+        }
+    }
+    return changed;
+}
+
+// A block holding nothing but `br target` is skipped by its predecessors.
+bool bypassForwardingBlocks(IRFunction& function)
+{
+    bool changed = false;
+    for (auto it = function.getBasicBlocks().begin(); it != function.getBasicBlocks().end();) {
+        IRBasicBlock& block = *it++;
+        IRInstruction* terminator = block.getTerminator();
+        if (&block == function.getEntryBlock() || block.getInstructions().size() != 1 || !terminator ||
+            terminator->getOp() != IRInstructionOp::Branch) {
+            continue;
+        }
+        IRBasicBlock* target = terminator->getBlocks()[0];
+        const IRInstruction* first = target->getInstructions().front();
+        if (target == &block || (first && first->getOp() == IRInstructionOp::Phi)) {
+            continue; // retargeting would need new Phi operands
+        }
+        const std::vector<IRBasicBlock*> predecessors = block.getPredecessors();
+        for (IRBasicBlock* pred : predecessors) {
+            IRInstruction* predTerminator = pred->getTerminator();
+            for (std::size_t i = 0; i < predTerminator->getBlocks().size(); ++i) {
+                if (predTerminator->getBlocks()[i] == &block) {
+                    predTerminator->setBlock(i, target);
+                    target->addPredecessor(pred);
+                }
+            }
+        }
+        target->removeIncomingEdge(&block);
+        terminator->eraseFromParent();
+        function.removeBlock(&block);
+        changed = true;
+    }
+    return changed;
+}
+
+// Appends a block to its only predecessor when the predecessor has no other successor.
+bool mergeStraightLineBlocks(IRFunction& function)
+{
+    bool changed = false;
+    for (auto it = function.getBasicBlocks().begin(); it != function.getBasicBlocks().end();) {
+        IRBasicBlock& block = *it++;
+        IRInstruction* terminator = block.getTerminator();
+        if (!terminator || terminator->getOp() != IRInstructionOp::Branch) {
+            continue;
+        }
+        IRBasicBlock* successor = terminator->getBlocks()[0];
+        if (successor == &block || successor == function.getEntryBlock() ||
+            successor->getPredecessors().size() != 1) {
+            continue;
+        }
+        // Phis of the successor have one incoming value: this block's.
+        for (auto phiIt = successor->begin(); phiIt != successor->end() && phiIt->getOp() == IRInstructionOp::Phi;) {
+            IRInstruction& phi = *phiIt++;
+            phi.replaceAllUsesWith(phi.getOperand(0));
+            phi.eraseFromParent();
+        }
+        terminator->eraseFromParent();
+        for (auto instIt = successor->begin(); instIt != successor->end();) {
+            IRInstruction& inst = *instIt++;
+            successor->remove(&inst);
+            block.append(&inst);
+        }
+        for (IRBasicBlock* next : block.getSuccessors()) {
+            next->replacePredecessor(successor, &block);
+        }
+        function.removeBlock(successor);
+        changed = true;
+        it = IRFunction::BlockList::iterator(&function.getBasicBlocks(), &block); // it may merge again
+    }
+    return changed;
+}
+
+} // namespace
+
+PreservedAnalyses SimplifyCFG::run(IRFunction& function, FunctionAnalyses&) const
+{
+    if (!function.getEntryBlock()) {
+        return PreservedAnalyses::all();
+    }
+    bool changed = false;
+    bool progress = true;
+    while (progress) {
+        progress = foldBranches(function);
+        progress |= removeUnreachableBlocks(function);
+        progress |= removeTrivialPhis(function);
+        progress |= bypassForwardingBlocks(function);
+        progress |= mergeStraightLineBlocks(function);
+        changed |= progress;
+    }
+    return changed ? PreservedAnalyses::none() : PreservedAnalyses::all();
+}
+
+} // namespace istudio::ir
@@ -0,0 +1,119 @@
+#include "ir/TailCallElimination.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace istudio::ir {
+
+namespace {
+
+// Whether `call` is directly followed by the return of its result.
+bool inTailPosition(const IRInstruction& call)
+{
+    const IRInstruction* next = call.getNextNode();
+    if (!next || next->getOp() != IRInstructionOp::Return) {
+        return false;
+    }
+    return next->getNumOperands() == 0 ? call.getType() == IRType::Void : next->getOperand(0) == &call;
+}
+
+// Moves the body of the function out of the entry block into a loop header, with a
+// Phi per argument, and replaces each call and its return by a branch back to the
+// header. The entry block is left holding only the branch into the loop, so it
+// stays free of predecessors.
+void eliminateSelfCalls(IRFunction& function, const std::vector<IRInstruction*>& calls)
+{
+    IRBasicBlock* entry = function.getEntryBlock();
+    IRBasicBlock* header = function.insertBlock(function.createBlock("tailrecurse"), entry->getNextNode());
+    while (IRInstruction* inst = entry->getInstructions().front()) {
+        entry->remove(inst);
+        header->append(inst);
+    }
+    std::vector<IRBasicBlock*> successors = header->getSuccessors();
+    std::sort(successors.begin(), successors.end());
+    successors.erase(std::unique(successors.begin(), successors.end()), successors.end());
+    for (IRBasicBlock* successor : successors) {
+        successor->replacePredecessor(entry, header);
+    }
+    IRInstruction* enter = function.createInstruction(IRInstructionOp::Branch);
+    enter->addBlock(header);
+    entry->append(enter);
+    header->addPredecessor(entry);
+
+    std::vector<IRInstruction*> phis;
+    for (IRArgument* argument : function.getArguments()) {
+        IRInstruction* phi = header->addPhi(function.createInstruction(IRInstructionOp::Phi, argument->getType()));
+        argument->replaceAllUsesWith(phi);
+        phi->addOperand(argument);
+        phi->addBlock(entry);
+        phis.push_back(phi);
+    }
+
+    for (IRInstruction* call : calls) {
+        IRBasicBlock* block = call->getParent();
+        for (std::size_t i = 0; i < phis.size(); ++i) {
+            // A missing argument reads as undef, as it would in the callee.
+            phis[i]->addOperand(i < call->getNumOperands() ? call->getOperand(i)
+                                                           : function.getUndef(phis[i]->getType()));
+            phis[i]->addBlock(block);
+        }
+        call->getNextNode()->eraseFromParent();
+        call->eraseFromParent();
+        IRInstruction* back = function.createInstruction(IRInstructionOp::Branch);
+        back->addBlock(header);
+        block->append(back);
+        header->addPredecessor(block);
+    }
+
+    // An argument every recursive call passes on unchanged needs no Phi.
+    for (std::size_t i = 0; i < phis.size(); ++i) {
+        IRArgument* argument = function.getArguments()[i];
+        bool invariant = true;
+        for (std::size_t j = 0; j < phis[i]->getNumOperands(); ++j) {
+            const IRValue* value = phis[i]->getOperand(j);
+            invariant = invariant && (value == phis[i] || value == argument);
+        }
+        if (invariant) {
+            phis[i]->replaceAllUsesWith(argument);
+            phis[i]->eraseFromParent();
+        }
+    }
+}
+
+} // namespace
+
+PreservedAnalyses TailCallElimination::run(IRFunction& function, FunctionAnalyses&) const
+{
+    std::vector<IRInstruction*> calls;
+    for (IRBasicBlock& block : function.getBasicBlocks()) {
+        for (IRInstruction& inst : block) {
+            if (inst.getOp() == IRInstructionOp::Alloca) {
+                return PreservedAnalyses::all();
+            }
+            if (inst.getOp() == IRInstructionOp::Call && inTailPosition(inst)) {
+                calls.push_back(&inst);
+            }
+        }
+    }
+
+    // A branch back to the body needs an entry block without predecessors to
+    // leave behind; lowered functions always have one.
+    const bool loop = function.getEntryBlock()->getPredecessors().empty();
+    std::vector<IRInstruction*> selfCalls;
+    bool marked = false;
+    for (IRInstruction* call : calls) {
+        if (loop && call->getCallee() == function.getName()) {
+            selfCalls.push_back(call);
+        } else if (!call->isTailCall()) {
+            call->setTailCall(true);
+            marked = true;
+        }
+    }
+    if (!selfCalls.empty()) {
+        eliminateSelfCalls(function, selfCalls);
+        return PreservedAnalyses::none();
+    }
+    return marked ? PreservedAnalyses::cfg() : PreservedAnalyses::all();
+}
+
+} // namespace istudio::ir
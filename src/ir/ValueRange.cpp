@@ -0,0 +1,485 @@
+#include "ir/ValueRange.h"
+
+#include "ir/Dominators.h"
+#include "ir/InductionVariables.h"
+#include "ir/LoopInfo.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+namespace istudio::ir {
+
+namespace {
+
+constexpr std::int64_t kMin = std::numeric_limits<std::int64_t>::min();
+constexpr std::int64_t kMax = std::numeric_limits<std::int64_t>::max();
+
+// The values an int (or a bool, as 0 and 1) can take, both ends included.
+struct Range {
+    std::int64_t lo{kMin};
+    std::int64_t hi{kMax};
+
+    [[nodiscard]] bool isPoint() const { return lo == hi; }
+};
+
+constexpr Range kBoolRange{0, 1};
+
+bool isTracked(IRType type) { return type == IRType::Int || type == IRType::Bool; }
+
+Range fullRange(IRType type) { return type == IRType::Bool ? kBoolRange : Range{}; }
+
+// How two ints can be ordered, as a mask; a comparison accepts some of these.
+constexpr unsigned kLess = 1;
+constexpr unsigned kEqual = 2;
+constexpr unsigned kGreater = 4;
+constexpr unsigned kAnyOrder = kLess | kEqual | kGreater;
+
+std::optional<unsigned> accepted(IRInstructionOp predicate)
+{
+    switch (predicate) {
+    case IRInstructionOp::Lt: return kLess;
+    case IRInstructionOp::Le: return kLess | kEqual;
+    case IRInstructionOp::Gt: return kGreater;
+    case IRInstructionOp::Ge: return kGreater | kEqual;
+    case IRInstructionOp::Eq: return kEqual;
+    case IRInstructionOp::Ne: return kLess | kGreater;
+    default: return std::nullopt;
+    }
+}
+
+// The orderings of b against a, given those of a against b.
+unsigned swapped(unsigned orders)
+{
+    return (orders & kEqual) | ((orders & kLess) != 0 ? kGreater : 0) | ((orders & kGreater) != 0 ? kLess : 0);
+}
+
+unsigned possibleOrders(Range a, Range b)
+{
+    unsigned orders = 0;
+    if (a.lo < b.hi) {
+        orders |= kLess;
+    }
+    if (a.lo <= b.hi && b.lo <= a.hi) {
+        orders |= kEqual;
+    }
+    if (a.hi > b.lo) {
+        orders |= kGreater;
+    }
+    return orders;
+}
+
+// `range` narrowed to the values that stand in `orders` to some value of `other`.
+Range constrain(Range range, unsigned orders, Range other)
+{
+    Range result = range;
+    switch (orders) {
+    case kLess:
+        if (other.hi == kMin) {
+            return range;
+        }
+        result.hi = std::min(result.hi, other.hi - 1);
+        break;
+    case kLess | kEqual:
+        result.hi = std::min(result.hi, other.hi);
+        break;
+    case kGreater:
+        if (other.lo == kMax) {
+            return range;
+        }
+        result.lo = std::max(result.lo, other.lo + 1);
+        break;
+    case kGreater | kEqual:
+        result.lo = std::max(result.lo, other.lo);
+        break;
+    case kEqual:
+        result = {std::max(result.lo, other.lo), std::min(result.hi, other.hi)};
+        break;
+    case kLess | kGreater:
+        if (other.isPoint() && result.lo == other.lo && result.lo != kMax) {
+            ++result.lo;
+        } else if (other.isPoint() && result.hi == other.lo && result.hi != kMin) {
+            --result.hi;
+        }
+        break;
+    default:
+        break;
+    }
+    // Contradicting facts mean the block never runs; keep what is known anyway.
+    return result.lo <= result.hi ? result : range;
+}
+
+// Interval arithmetic for int operators; nullopt when the result could wrap or the
+// operator is not understood.
+std::optional<Range> combine(IRInstructionOp op, Range a, Range b)
+{
+    Range result;
+    switch (op) {
+    case IRInstructionOp::Add:
+        if (__builtin_add_overflow(a.lo, b.lo, &result.lo) || __builtin_add_overflow(a.hi, b.hi, &result.hi)) {
+            return std::nullopt;
+        }
+        return result;
+    case IRInstructionOp::Sub:
+        if (__builtin_sub_overflow(a.lo, b.hi, &result.lo) || __builtin_sub_overflow(a.hi, b.lo, &result.hi)) {
+            return std::nullopt;
+        }
+        return result;
+    case IRInstructionOp::Mul: {
+        result = {kMax, kMin};
+        for (const std::int64_t x : {a.lo, a.hi}) {
+            for (const std::int64_t y : {b.lo, b.hi}) {
+                std::int64_t product = 0;
+                if (__builtin_mul_overflow(x, y, &product)) {
+                    return std::nullopt;
+                }
+                result = {std::min(result.lo, product), std::max(result.hi, product)};
+            }
+        }
+        return result;
+    }
+    case IRInstructionOp::Div:
+        // Truncating division by a positive constant keeps the order.
+        if (!b.isPoint() || b.lo <= 0) {
+            return std::nullopt;
+        }
+        return Range{a.lo / b.lo, a.hi / b.lo};
+    case IRInstructionOp::Rem: {
+        // The remainder takes the sign of the dividend and is smaller than the divisor.
+        if (!b.isPoint() || b.lo == 0 || b.lo == kMin) {
+            return std::nullopt;
+        }
+        const std::int64_t largest = (b.lo < 0 ? -b.lo : b.lo) - 1;
+        if (a.lo >= 0) {
+            return Range{0, std::min(a.hi, largest)};
+        }
+        if (a.hi <= 0) {
+            return Range{std::max(a.lo, -largest), 0};
+        }
+        return Range{-largest, largest};
+    }
+    default:
+        return std::nullopt;
+    }
+}
+
+class RangePropagation {
+public:
+    RangePropagation(IRFunction& function, const DominatorTree& domTree, const LoopInfo& loops)
+        : function_(function), domTree_(domTree), loops_(loops)
+    {
+    }
+
+    bool run()
+    {
+        visit(domTree_.getRoot());
+        return changed_;
+    }
+
+private:
+    // A bool known to have a value in the block being visited.
+    struct Condition {
+        const IRValue* value;
+        bool holds;
+    };
+    // Two ints known to stand in one of `orders` in the block being visited.
+    struct Relation {
+        const IRValue* lhs;
+        const IRValue* rhs;
+        unsigned orders;
+    };
+    struct Start {
+        const IRValue* value;
+        unsigned orders;
+    };
+
+    // Walks the dominator tree, so the conditions in force are those of the branches
+    // into the block and into each of its dominators.
+    void visit(IRBasicBlock* block)
+    {
+        const std::size_t conditions = conditions_.size();
+        const std::size_t relations = relations_.size();
+        if (block->getPredecessors().size() == 1) {
+            const IRInstruction* branch = block->getPredecessors().front()->getTerminator();
+            if (branch && branch->getOp() == IRInstructionOp::BranchIf &&
+                branch->getBlocks()[0] != branch->getBlocks()[1]) {
+                assume(branch->getOperand(0), branch->getBlocks()[0] == block);
+            }
+        }
+        fold(*block);
+        for (IRBasicBlock* child : domTree_.getChildren(block)) {
+            visit(child);
+        }
+        conditions_.resize(conditions);
+        relations_.resize(relations);
+    }
+
+    void assume(const IRValue* value, bool holds)
+    {
+        conditions_.push_back({value, holds});
+        if (value->getKind() != IRValueKind::Instruction || value->getType() != IRType::Bool) {
+            return;
+        }
+        const auto* inst = static_cast<const IRInstruction*>(value);
+        switch (inst->getOp()) {
+        case IRInstructionOp::Not:
+            assume(inst->getOperand(0), !holds);
+            return;
+        case IRInstructionOp::And:
+        case IRInstructionOp::Or:
+            if (holds == (inst->getOp() == IRInstructionOp::And)) {
+                assume(inst->getOperand(0), holds);
+                assume(inst->getOperand(1), holds);
+            }
+            return;
+        default:
+            break;
+        }
+        const auto orders = accepted(inst->getOp());
+        if (orders && inst->getOperand(0)->getType() == IRType::Int && inst->getOperand(1)->getType() == IRType::Int) {
+            relations_.push_back({inst->getOperand(0), inst->getOperand(1), holds ? *orders : kAnyOrder & ~*orders});
+        }
+    }
+
+    void fold(IRBasicBlock& block)
+    {
+        for (auto it = block.begin(); it != block.end();) {
+            IRInstruction& inst = *it++;
+            // A Phi uses its operands at the end of the incoming blocks, where other
+            // conditions hold.
+            if (inst.getOp() != IRInstructionOp::Phi) {
+                for (std::size_t i = 0; i < inst.getNumOperands(); ++i) {
+                    const IRValue* operand = inst.getOperand(i);
+                    if (operand->getKind() == IRValueKind::Constant || !isTracked(operand->getType())) {
+                        continue;
+                    }
+                    if (const Range range = rangeAt(operand); range.isPoint()) {
+                        inst.setOperand(i, constant(operand->getType(), range.lo));
+                        changed_ = true;
+                    }
+                }
+            }
+            if (inst.getOp() == IRInstructionOp::Phi || inst.getOp() == IRInstructionOp::Call ||
+                !isTracked(inst.getType())) {
+                continue;
+            }
+            if (const auto range = evaluate(inst, true); range && range->isPoint()) {
+                inst.replaceAllUsesWith(constant(inst.getType(), range->lo));
+                inst.eraseFromParent();
+                changed_ = true;
+            }
+        }
+    }
+
+    IRConstant* constant(IRType type, std::int64_t value)
+    {
+        return type == IRType::Bool ? function_.getConstant(type, value != 0) : function_.getConstant(type, value);
+    }
+
+    // The range of `value` wherever it is defined, cached.
+    Range rangeOf(const IRValue* value)
+    {
+        if (value->getKind() == IRValueKind::Constant) {
+            const auto& constant = static_cast<const IRConstant*>(value)->getValue();
+            if (const auto* integer = std::get_if<std::int64_t>(&constant)) {
+                return {*integer, *integer};
+            }
+            if (const auto* boolean = std::get_if<bool>(&constant)) {
+                return {*boolean ? 1 : 0, *boolean ? 1 : 0};
+            }
+            return fullRange(value->getType());
+        }
+        if (value->getKind() != IRValueKind::Instruction) {
+            return fullRange(value->getType());
+        }
+        if (const auto it = ranges_.find(value); it != ranges_.end()) {
+            return it->second;
+        }
+        // A cycle through Phis meets the full range on the way back.
+        ranges_[value] = fullRange(value->getType());
+        const auto* inst = static_cast<const IRInstruction*>(value);
+        const Range range = evaluate(*inst, false).value_or(fullRange(value->getType()));
+        ranges_[value] = range;
+        return range;
+    }
+
+    // The range of `value` in the block being visited.
+    Range rangeAt(const IRValue* value)
+    {
+        if (value->getType() == IRType::Bool) {
+            for (auto it = conditions_.rbegin(); it != conditions_.rend(); ++it) {
+                if (it->value == value) {
+                    return {it->holds ? 1 : 0, it->holds ? 1 : 0};
+                }
+            }
+        }
+        Range range = rangeOf(value);
+        for (const Relation& relation : relations_) {
+            if (relation.lhs == value) {
+                range = constrain(range, relation.orders, rangeOf(relation.rhs));
+            } else if (relation.rhs == value) {
+                range = constrain(range, swapped(relation.orders), rangeOf(relation.lhs));
+            }
+        }
+        return range;
+    }
+
+    // The range of `inst` from those of its operands: as they are in the block being
+    // visited when `local` is set, or anywhere otherwise.
+    std::optional<Range> evaluate(const IRInstruction& inst, bool local)
+    {
+        auto operand = [&](std::size_t i) {
+            return local ? rangeAt(inst.getOperand(i)) : rangeOf(inst.getOperand(i));
+        };
+        const IRInstructionOp op = inst.getOp();
+        if (const auto orders = accepted(op)) {
+            const IRValue* lhs = inst.getOperand(0);
+            const IRValue* rhs = inst.getOperand(1);
+            if (lhs->getType() != IRType::Int || rhs->getType() != IRType::Int) {
+                return kBoolRange;
+            }
+            unsigned possible = lhs == rhs ? kEqual : possibleOrders(operand(0), operand(1));
+            possible &= ordersToStart(lhs, rhs) & swapped(ordersToStart(rhs, lhs));
+            if (local) {
+                for (const Relation& relation : relations_) {
+                    if (relation.lhs == lhs && relation.rhs == rhs) {
+                        possible &= relation.orders;
+                    } else if (relation.lhs == rhs && relation.rhs == lhs) {
+                        possible &= swapped(relation.orders);
+                    }
+                }
+            }
+            if (possible != 0 && (possible & ~*orders) == 0) {
+                return Range{1, 1};
+            }
+            if (possible != 0 && (possible & *orders) == 0) {
+                return Range{0, 0};
+            }
+            return kBoolRange;
+        }
+        switch (op) {
+        case IRInstructionOp::Phi:
+            return local ? rangeOf(&inst) : phiRange(inst);
+        case IRInstructionOp::Assign:
+            return isTracked(inst.getOperand(0)->getType()) ? std::optional(operand(0)) : std::nullopt;
+        case IRInstructionOp::Not:
+            if (inst.getOperand(0)->getType() == IRType::Bool) {
+                const Range a = operand(0);
+                return Range{1 - a.hi, 1 - a.lo};
+            }
+            return std::nullopt;
+        case IRInstructionOp::And:
+        case IRInstructionOp::Or:
+            if (inst.getType() == IRType::Bool) {
+                const Range a = operand(0);
+                const Range b = operand(1);
+                return op == IRInstructionOp::And ? Range{std::min(a.lo, b.lo), std::min(a.hi, b.hi)}
+                                                  : Range{std::max(a.lo, b.lo), std::max(a.hi, b.hi)};
+            }
+            return std::nullopt;
+        case IRInstructionOp::Neg:
+            if (inst.getType() == IRType::Int && inst.getOperand(0)->getType() == IRType::Int) {
+                const Range a = operand(0);
+                return a.lo != kMin ? std::optional(Range{-a.hi, -a.lo}) : std::nullopt;
+            }
+            return std::nullopt;
+        default:
+            if (inst.getType() == IRType::Int && inst.getNumOperands() == 2 &&
+                inst.getOperand(0)->getType() == IRType::Int && inst.getOperand(1)->getType() == IRType::Int) {
+                return combine(op, operand(0), operand(1));
+            }
+            return std::nullopt;
+        }
+    }
+
+    // An induction variable runs from its start to the last value the exit condition
+    // lets through plus one step, provided that sum does not wrap; any other Phi
+    // takes the union of its incoming values.
+    Range phiRange(const IRInstruction& phi)
+    {
+        if (const auto range = inductionRange(phi)) {
+            return *range;
+        }
+        Range range{kMax, kMin};
+        for (std::size_t i = 0; i < phi.getNumOperands(); ++i) {
+            const Range incoming = rangeOf(phi.getOperand(i));
+            range = {std::min(range.lo, incoming.lo), std::max(range.hi, incoming.hi)};
+        }
+        return phi.getNumOperands() != 0 ? range : fullRange(phi.getType());
+    }
+
+    // How `value` can stand to `other` when it is an induction variable that starts
+    // at `other` and never wraps, so it stays on one side of its start.
+    unsigned ordersToStart(const IRValue* value, const IRValue* other) const
+    {
+        const auto it = starts_.find(value);
+        return it != starts_.end() && it->second.value == other ? it->second.orders : kAnyOrder;
+    }
+
+    std::optional<Range> inductionRange(const IRInstruction& phi)
+    {
+        const Loop* loop = loops_.getLoopFor(phi.getParent());
+        if (!loop || loop->getHeader() != phi.getParent()) {
+            return std::nullopt;
+        }
+        const auto exit = findExitCondition(*loop);
+        if (!exit || exit->iv.phi != &phi) {
+            return std::nullopt;
+        }
+        const Range start = rangeOf(exit->iv.start);
+        const Range bound = rangeOf(exit->bound);
+        const std::int64_t step = exit->iv.step;
+        std::int64_t end = 0;
+        if (step > 0 && (exit->predicate == IRInstructionOp::Lt || exit->predicate == IRInstructionOp::Le)) {
+            if (exit->predicate == IRInstructionOp::Lt && bound.hi == kMin) {
+                return std::nullopt;
+            }
+            const std::int64_t last = exit->predicate == IRInstructionOp::Lt ? bound.hi - 1 : bound.hi;
+            if (__builtin_add_overflow(last, step, &end)) {
+                return std::nullopt;
+            }
+            starts_[&phi] = {exit->iv.start, kGreater | kEqual};
+            return Range{start.lo, std::max(start.hi, end)};
+        }
+        if (step < 0 && (exit->predicate == IRInstructionOp::Gt || exit->predicate == IRInstructionOp::Ge)) {
+            if (exit->predicate == IRInstructionOp::Gt && bound.lo == kMax) {
+                return std::nullopt;
+            }
+            const std::int64_t last = exit->predicate == IRInstructionOp::Gt ? bound.lo + 1 : bound.lo;
+            if (__builtin_add_overflow(last, step, &end)) {
+                return std::nullopt;
+            }
+            starts_[&phi] = {exit->iv.start, kLess | kEqual};
+            return Range{std::min(start.lo, end), start.hi};
+        }
+        return std::nullopt;
+    }
+
+    IRFunction& function_;
+    const DominatorTree& domTree_;
+    const LoopInfo& loops_;
+    std::unordered_map<const IRValue*, Range> ranges_;
+    std::unordered_map<const IRValue*, Start> starts_; // of induction variables that never wrap
+    std::vector<Condition> conditions_;
+    std::vector<Relation> relations_;
+    bool changed_{false};
+};
+
+} // namespace
+
+PreservedAnalyses ValueRangePropagation::run(IRFunction& function, FunctionAnalyses& analyses) const
+{
+    const DominatorTree& domTree = analyses.get<DominatorTreeAnalysis>();
+    const LoopInfo& loops = analyses.get<LoopAnalysis>();
+    if (!domTree.getRoot()) {
+        return PreservedAnalyses::all();
+    }
+    const bool changed = RangePropagation(function, domTree, loops).run();
+    return changed ? PreservedAnalyses::cfg() : PreservedAnalyses::all();
+}
+
+} // namespace istudio::ir
@@ -0,0 +1,424 @@
+#include "ir/Verifier.h"
+
+#include "ir/Dominators.h"
+#include "ir/IRPrinter.h"
+#include "ir/PassManager.h"
+
+#include <algorithm>
+#include <map>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace istudio::ir {
+
+namespace {
+
+bool isComparison(IRInstructionOp op)
+{
+    return op >= IRInstructionOp::Eq && op <= IRInstructionOp::Ge;
+}
+
+bool isNumeric(IRType type)
+{
+    return type == IRType::Int || type == IRType::Float;
+}
+
+// Opaque is the type of values the IR knows nothing about (null, template
+// parameters, collections), so it fits anywhere. Ints widen to floats implicitly:
+// the IR has no conversion instruction.
+bool fits(IRType expected, IRType actual)
+{
+    return expected == actual || expected == IRType::Opaque || actual == IRType::Opaque ||
+           (expected == IRType::Float && actual == IRType::Int);
+}
+
+class FunctionVerifier {
+public:
+    explicit FunctionVerifier(const IRFunction& function) : function_(function) {}
+
+    std::vector<std::string> run()
+    {
+        if (function_.getBasicBlocks().empty()) {
+            fail("function has no blocks");
+            return std::move(problems_);
+        }
+        std::size_t index = 0;
+        for (const IRBasicBlock& block : function_.getBasicBlocks()) {
+            std::string name(block.getLabel());
+            if (index > 0) {
+                name += std::to_string(index);
+            }
+            blockNames_.emplace(&block, std::move(name));
+            ++index;
+        }
+        // Dominance and the Phi checks need a well-formed CFG; without one they
+        // would only report follow-on errors.
+        if (!checkStructure()) {
+            return std::move(problems_);
+        }
+        checkEdges();
+        for (const IRBasicBlock& block : function_.getBasicBlocks()) {
+            for (const IRInstruction& inst : block) {
+                checkOperands(inst);
+                checkTypes(inst);
+                checkTailCall(inst);
+            }
+        }
+        if (problems_.empty()) {
+            checkDominance();
+        }
+        return std::move(problems_);
+    }
+
+private:
+    void fail(const std::string& message) { problems_.push_back("function '" + function_.getName() + "': " + message); }
+
+    void fail(const IRBasicBlock& block, const std::string& message)
+    {
+        fail("block '" + blockName(&block) + "': " + message);
+    }
+
+    void fail(const IRInstruction& inst, const std::string& message)
+    {
+        fail(*inst.getParent(), message + " in `" + toString(inst) + '`');
+    }
+
+    std::string blockName(const IRBasicBlock* block) const
+    {
+        const auto it = blockNames_.find(block);
+        return it != blockNames_.end() ? it->second : "<foreign>";
+    }
+
+    bool checkStructure()
+    {
+        const std::size_t before = problems_.size();
+        for (const IRBasicBlock& block : function_.getBasicBlocks()) {
+            if (block.getParent() != &function_) {
+                fail(block, "block belongs to another function");
+            }
+            if (block.empty()) {
+                fail(block, "block is empty");
+                continue;
+            }
+            bool seenNonPhi = false;
+            for (const IRInstruction& inst : block) {
+                if (inst.getParent() != &block || inst.getFunction() != &function_) {
+                    fail(block, "instruction does not belong to this block");
+                    continue;
+                }
+                if (inst.getOp() == IRInstructionOp::Phi) {
+                    if (seenNonPhi) {
+                        fail(inst, "phi after a non-phi instruction");
+                    }
+                } else {
+                    seenNonPhi = true;
+                }
+                if (inst.isTerminator() && &inst != block.getInstructions().back()) {
+                    fail(inst, "terminator in the middle of the block");
+                }
+                checkTargets(inst);
+            }
+            if (!block.getTerminator()) {
+                fail(block, "block does not end in a terminator");
+            }
+        }
+        return problems_.size() == before;
+    }
+
+    void checkTargets(const IRInstruction& inst)
+    {
+        std::size_t targets = 0;
+        std::size_t operands = inst.getNumOperands();
+        switch (inst.getOp()) {
+        case IRInstructionOp::Branch:
+            targets = 1;
+            break;
+        case IRInstructionOp::BranchIf:
+            targets = 2;
+            break;
+        case IRInstructionOp::Phi:
+            targets = operands;
+            break;
+        default:
+            break;
+        }
+        if (inst.getBlocks().size() != targets) {
+            fail(inst, "expected " + std::to_string(targets) + " block operands, found " +
+                           std::to_string(inst.getBlocks().size()));
+            return;
+        }
+        for (const IRBasicBlock* target : inst.getBlocks()) {
+            if (!blockNames_.contains(target)) {
+                fail(inst, "block operand is not a block of the function");
+            }
+        }
+        const bool operandCountOk = [&] {
+            switch (inst.getOp()) {
+            case IRInstructionOp::Branch:
+                return operands == 0;
+            case IRInstructionOp::BranchIf:
+            case IRInstructionOp::Neg:
+            case IRInstructionOp::Not:
+            case IRInstructionOp::Assign:
+                return operands == 1;
+            case IRInstructionOp::Return:
+                return operands <= 1;
+            case IRInstructionOp::Call:
+            case IRInstructionOp::Phi:
+            case IRInstructionOp::Load:
+            case IRInstructionOp::Store:
+            case IRInstructionOp::Alloca:
+            case IRInstructionOp::GetElementPtr:
+                return true;
+            default:
+                return operands == 2;
+            }
+        }();
+        if (!operandCountOk) {
+            fail(inst, "wrong number of operands");
+        }
+    }
+
+    // Each branch edge into a block must appear in its predecessor list, as often
+    // as the edge exists, and each Phi must have a value for every such entry.
+    void checkEdges()
+    {
+        std::unordered_map<const IRBasicBlock*, std::map<const IRBasicBlock*, int>> edges;
+        for (const IRBasicBlock& block : function_.getBasicBlocks()) {
+            for (const IRBasicBlock* successor : block.getSuccessors()) {
+                ++edges[successor][&block];
+            }
+        }
+        for (const IRBasicBlock& block : function_.getBasicBlocks()) {
+            std::map<const IRBasicBlock*, int> listed;
+            for (const IRBasicBlock* pred : block.getPredecessors()) {
+                ++listed[pred];
+            }
+            if (listed != edges[&block]) {
+                fail(block, "predecessor list does not match the branches into the block");
+                continue;
+            }
+            for (const IRInstruction& inst : block) {
+                if (inst.getOp() != IRInstructionOp::Phi) {
+                    break;
+                }
+                const std::size_t predecessors = block.getPredecessors().size();
+                if (inst.getNumOperands() != predecessors) {
+                    fail(inst, "phi has " + std::to_string(inst.getNumOperands()) + " incoming values for " +
+                                   std::to_string(predecessors) + " predecessors");
+                    continue;
+                }
+                std::map<const IRBasicBlock*, int> incoming;
+                for (const IRBasicBlock* from : inst.getBlocks()) {
+                    ++incoming[from];
+                }
+                if (incoming != listed) {
+                    fail(inst, "phi's incoming blocks are not the block's predecessors");
+                }
+            }
+        }
+    }
+
+    void checkOperands(const IRInstruction& inst)
+    {
+        for (std::size_t i = 0; i < inst.getNumOperands(); ++i) {
+            const IRValue* operand = inst.getOperand(i);
+            const std::string which = "operand " + std::to_string(i);
+            if (!operand) {
+                fail(inst, which + " is null");
+                continue;
+            }
+            switch (operand->getKind()) {
+            case IRValueKind::Constant:
+                break;
+            case IRValueKind::Argument: {
+                const auto* argument = static_cast<const IRArgument*>(operand);
+                const auto& arguments = function_.getArguments();
+                if (argument->getIndex() >= arguments.size() || arguments[argument->getIndex()] != argument) {
+                    fail(inst, which + " is an argument of another function");
+                }
+                break;
+            }
+            case IRValueKind::Instruction: {
+                const auto* def = static_cast<const IRInstruction*>(operand);
+                if (def->getFunction() != &function_) {
+                    fail(inst, which + " is an instruction of another function");
+                } else if (!def->getParent() || !blockNames_.contains(def->getParent())) {
+                    fail(inst, which + " is not in any block (erased?)");
+                }
+                break;
+            }
+            default:
+                fail(inst, which + " is not a value");
+                continue;
+            }
+            if (operand->getType() == IRType::Void) {
+                fail(inst, which + " has no value (void)");
+            }
+        }
+    }
+
+    void checkTypes(const IRInstruction& inst)
+    {
+        const IRType type = inst.getType();
+        auto operandType = [&](std::size_t i) {
+            const IRValue* operand = inst.getOperand(i);
+            return operand ? operand->getType() : IRType::Opaque;
+        };
+        auto expect = [&](bool ok, const std::string& message) {
+            if (!ok) {
+                fail(inst, message);
+            }
+        };
+        switch (inst.getOp()) {
+        case IRInstructionOp::Return:
+        case IRInstructionOp::Branch:
+        case IRInstructionOp::BranchIf:
+        case IRInstructionOp::Store:
+            expect(type == IRType::Void, "terminators and stores have no result");
+            break;
+        default:
+            break;
+        }
+        switch (inst.getOp()) {
+        case IRInstructionOp::Return:
+            if (function_.getType() == IRType::Void) {
+                expect(inst.getNumOperands() == 0, "void function returns a value");
+            } else {
+                expect(inst.getNumOperands() == 1, "missing return value");
+                expect(inst.getNumOperands() == 0 || fits(function_.getType(), operandType(0)),
+                       "return value does not fit the function's type");
+            }
+            break;
+        case IRInstructionOp::BranchIf:
+            expect(fits(IRType::Bool, operandType(0)), "branch condition is not a bool");
+            break;
+        case IRInstructionOp::Phi:
+            expect(type != IRType::Void, "phi has no type");
+            for (std::size_t i = 0; i < inst.getNumOperands(); ++i) {
+                expect(fits(type, operandType(i)), "incoming value " + std::to_string(i) + " does not fit the phi's type");
+            }
+            break;
+        case IRInstructionOp::Assign:
+            expect(fits(type, operandType(0)), "assigned value does not fit the result type");
+            break;
+        case IRInstructionOp::Not:
+            expect(type == IRType::Bool, "not yields a bool");
+            break;
+        case IRInstructionOp::Neg:
+            expect(isNumeric(type) || type == IRType::Opaque, "neg yields a number");
+            break;
+        case IRInstructionOp::Sub:
+        case IRInstructionOp::Mul:
+        case IRInstructionOp::Div:
+        case IRInstructionOp::Rem:
+            expect(isNumeric(type) || type == IRType::Opaque, "arithmetic yields a number");
+            break;
+        case IRInstructionOp::Add:
+            expect(isNumeric(type) || type == IRType::String || type == IRType::Opaque,
+                   "add yields a number or a string");
+            break;
+        default:
+            if (isComparison(inst.getOp())) {
+                expect(type == IRType::Bool, "comparison yields a bool");
+            }
+            break;
+        }
+    }
+
+    void checkTailCall(const IRInstruction& inst)
+    {
+        if (!inst.isTailCall()) {
+            return;
+        }
+        const IRInstruction* next = inst.getNextNode();
+        const bool returned = next && next->getOp() == IRInstructionOp::Return &&
+                              (next->getNumOperands() == 0 ? inst.getType() == IRType::Void
+                                                           : next->getOperand(0) == &inst);
+        if (inst.getOp() != IRInstructionOp::Call || !returned) {
+            fail(inst, "tail call is not followed by the return of its result");
+        }
+    }
+
+    void checkDominance()
+    {
+        FunctionAnalyses analyses(function_);
+        const DominatorTree dominators = DominatorTreeAnalysis::run(function_, analyses);
+        // Positions within the block make a same-block check O(1).
+        std::vector<std::size_t> position(function_.getValueCount());
+        for (const IRBasicBlock& block : function_.getBasicBlocks()) {
+            std::size_t index = 0;
+            for (const IRInstruction& inst : block) {
+                position[inst.getId()] = index++;
+            }
+        }
+        for (const IRBasicBlock& block : function_.getBasicBlocks()) {
+            if (!dominators.isReachable(&block)) {
+                continue;
+            }
+            for (const IRInstruction& inst : block) {
+                for (std::size_t i = 0; i < inst.getNumOperands(); ++i) {
+                    if (inst.getOperand(i)->getKind() != IRValueKind::Instruction) {
+                        continue;
+                    }
+                    const auto* def = static_cast<const IRInstruction*>(inst.getOperand(i));
+                    bool ok = true;
+                    if (inst.getOp() == IRInstructionOp::Phi) {
+                        const IRBasicBlock* from = inst.getBlocks()[i];
+                        ok = !dominators.isReachable(from) || dominators.dominates(def->getParent(), from);
+                    } else if (def->getParent() == &block) {
+                        ok = position[def->getId()] < position[inst.getId()];
+                    } else {
+                        ok = dominators.dominates(def->getParent(), &block);
+                    }
+                    if (!ok) {
+                        fail(inst, "operand " + std::to_string(i) + " does not dominate its use");
+                    }
+                }
+            }
+        }
+    }
+
+    const IRFunction& function_;
+    std::unordered_map<const IRBasicBlock*, std::string> blockNames_;
+    std::vector<std::string> problems_;
+};
+
+} // namespace
+
+std::vector<std::string> verifyFunction(const IRFunction& function)
+{
+    return FunctionVerifier(function).run();
+}
+
+std::vector<std::string> verifyModule(const IRModule& module)
+{
+    std::vector<std::string> problems;
+    std::unordered_map<std::string_view, const IRFunction*> functions;
+    for (const auto& function : module.getFunctions()) {
+        if (!functions.emplace(function->getName(), function.get()).second) {
+            problems.push_back("function '" + function->getName() + "' is defined more than once");
+        }
+    }
+    for (const auto& function : module.getFunctions()) {
+        auto found = verifyFunction(*function);
+        problems.insert(problems.end(), std::make_move_iterator(found.begin()), std::make_move_iterator(found.end()));
+        for (const IRBasicBlock& block : function->getBasicBlocks()) {
+            for (const IRInstruction& inst : block) {
+                if (inst.getOp() != IRInstructionOp::Call) {
+                    continue;
+                }
+                const auto callee = functions.find(inst.getCallee());
+                if (callee != functions.end() &&
+                    callee->second->getArguments().size() != inst.getNumOperands()) {
+                    problems.push_back("function '" + function->getName() + "': call of '" + inst.getCallee() +
+                                       "' passes " + std::to_string(inst.getNumOperands()) + " arguments, expected " +
+                                       std::to_string(callee->second->getArguments().size()));
+                }
+            }
+        }
+    }
+    return problems;
+}
+
+} // namespace istudio::ir
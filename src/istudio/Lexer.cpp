@@ -1,46 +1,256 @@
 #include "istudio/Lexer.h"
-#include <sstream>
 #include <algorithm>
+#include <array>
+#include <cctype>
+#include <unordered_set>
 
 namespace istudio {
 
+namespace {
+
+// Keywords used when no grammar file is supplied (mirrors examples/ipl/grammar_rules.txt).
+const std::unordered_set<std::string>& defaultKeywords()
+{
+    static const std::unordered_set<std::string> keywords = {
+        "let", "const", "final", "function", "contract", "class", "inherits", "implements",
+        "interface", "trait", "mixin", "module", "import", "export", "if", "otherwise",
+        "repeat", "until", "for", "each", "while", "break", "continue", "try", "catch",
+        "finally", "throw", "return", "operator", "where", "template", "concept", "constexpr",
+        "ensure", "require", "public", "private", "protected", "static", "this", "super",
+        "match", "case", "default", "owned", "borrowed", "move", "ref", "unsafe", "meta",
+        "type", "and", "or", "as", "new"
+    };
+    return keywords;
+}
+
+// Multi-character operators, longest first so that maximal munch works with a linear scan.
+// `<<`/`>>` are deliberately absent: they would swallow the closers of nested generic types.
+constexpr std::array<std::string_view, 20> kMultiCharOperators = {
+    "...", "==", "!=", "<=", ">=", "&&", "||", "->", "::", "**", ".*", "./",
+    "+=", "-=", "*=", "/=", "%=", "^=", "&=", "|="
+};
+
+constexpr std::string_view kSingleCharOperators = "+-*/%^=<>!&|?:.~";
+constexpr std::string_view kPunctuation = "(){}[];,@";
+
+bool isIdentifierStart(char c)
+{
+    return std::isalpha(static_cast<unsigned char>(c)) || c == '_';
+}
+
+bool isIdentifierPart(char c)
+{
+    return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+}
+
+bool isDigit(char c)
+{
+    return std::isdigit(static_cast<unsigned char>(c)) != 0;
+}
+
+} // namespace
+
 Lexer::Lexer(std::string_view source, const LexerOptions& options, DiagnosticEngine& diagnostics)
     : source_(source), options_(options), diagnostics_(diagnostics) {
 }
 
 std::expected<std::vector<Token>, std::vector<Diagnostic>> Lexer::tokenize() {
+    std::unordered_set<std::string> keywords;
+    std::unordered_set<std::string> literalKeywords;
+    for (const auto& rule : options_.grammar) {
+        if (rule.action == "keyword" || rule.action == "keyword_optional") {
+            keywords.insert(rule.pattern);
+        } else if (rule.action == "literal_keyword") {
+            literalKeywords.insert(rule.pattern);
+        }
+    }
+    const auto& keywordSet = keywords.empty() ? defaultKeywords() : keywords;
+
     std::vector<Token> tokens;
-    
-    // Convert std::string_view to std::string first to avoid the parsing ambiguity
-    std::string source_string(source_);
-    std::istringstream stream(source_string);
-    std::string line;
-    std::size_t lineNum = 1;
-    
-    while (std::getline(stream, line)) {
-        // For now, just add the line as a token with lexeme (this is a placeholder)
-        if (!line.empty()) {
-            Token token;
-            token.kind = TokenKind::Unknown; // In a real implementation, this would be properly classified
-            token.text = std::string_view(line);
-            token.lexeme = line; // Set the lexeme to the actual string
-            token.line = lineNum;
-            token.column = 1;
-            tokens.push_back(token);
-        }
-        ++lineNum;
+    std::vector<Diagnostic> errors;
+
+    std::size_t pos = 0;
+    std::size_t line = 1;
+    std::size_t column = 1;
+
+    auto advance = [&](std::size_t count) {
+        for (std::size_t i = 0; i < count && pos < source_.size(); ++i) {
+            if (source_[pos] == '\n') {
+                ++line;
+                column = 1;
+            } else {
+                ++column;
+            }
+            ++pos;
+        }
+    };
+
+    auto emit = [&](TokenKind kind, std::size_t start, std::size_t startLine, std::size_t startColumn) {
+        Token token;
+        token.kind = kind;
+        token.text = source_.substr(start, pos - start);
+        token.lexeme = std::string(token.text);
+        token.line = startLine;
+        token.column = startColumn;
+        tokens.push_back(std::move(token));
+    };
+
+    auto error = [&](std::string message, std::size_t errLine, std::size_t errColumn) {
+        Diagnostic diag;
+        diag.severity = DiagnosticSeverity::Error;
+        diag.message = std::move(message);
+        diag.range = SourceRange{{errLine, errColumn}, {line, column}};
+        diagnostics_.report(DiagnosticSeverity::Error, diag.message);
+        errors.push_back(std::move(diag));
+    };
+
+    while (pos < source_.size()) {
+        const char c = source_[pos];
+        const std::size_t start = pos;
+        const std::size_t startLine = line;
+        const std::size_t startColumn = column;
+
+        if (std::isspace(static_cast<unsigned char>(c))) {
+            advance(1);
+            continue;
+        }
+
+        // Line and doc comments
+        if (source_.substr(pos, 2) == "//") {
+            const bool doc = source_.substr(pos, 3) == "///";
+            while (pos < source_.size() && source_[pos] != '\n') {
+                advance(1);
+            }
+            emit(doc ? TokenKind::DocComment : TokenKind::Comment, start, startLine, startColumn);
+            continue;
+        }
+
+        // Block comments
+        if (source_.substr(pos, 2) == "/*") {
+            advance(2);
+            while (pos < source_.size() && source_.substr(pos, 2) != "*/") {
+                advance(1);
+            }
+            if (pos >= source_.size()) {
+                error("Unterminated block comment", startLine, startColumn);
+                break;
+            }
+            advance(2);
+            emit(TokenKind::Comment, start, startLine, startColumn);
+            continue;
+        }
+
+        // String literals (raw strings are prefixed with `r`)
+        const bool raw = c == 'r' && pos + 1 < source_.size() && source_[pos + 1] == '"';
+        if (c == '"' || raw) {
+            advance(raw ? 2 : 1);
+            bool terminated = false;
+            while (pos < source_.size() && source_[pos] != '\n') {
+                if (!raw && source_[pos] == '\\' && pos + 1 < source_.size()) {
+                    advance(2);
+                    continue;
+                }
+                if (source_[pos] == '"') {
+                    advance(1);
+                    terminated = true;
+                    break;
+                }
+                advance(1);
+            }
+            if (!terminated) {
+                error("Unterminated string literal", startLine, startColumn);
+                continue;
+            }
+            emit(raw ? TokenKind::RawStringLiteral : TokenKind::StringLiteral, start, startLine, startColumn);
+            continue;
+        }
+
+        if (isIdentifierStart(c)) {
+            while (pos < source_.size() && isIdentifierPart(source_[pos])) {
+                advance(1);
+            }
+            const std::string word(source_.substr(start, pos - start));
+            TokenKind kind = TokenKind::Identifier;
+            if (word == "true" || word == "false") {
+                kind = TokenKind::BooleanLiteral;
+            } else if (word == "null") {
+                kind = TokenKind::NullLiteral;
+            } else if (literalKeywords.contains(word)) {
+                kind = TokenKind::BooleanLiteral;
+            } else if (keywordSet.contains(word)) {
+                kind = TokenKind::Keyword;
+            }
+            emit(kind, start, startLine, startColumn);
+            continue;
+        }
+
+        if (isDigit(c)) {
+            bool isFloat = false;
+            while (pos < source_.size() && isDigit(source_[pos])) {
+                advance(1);
+            }
+            if (pos + 1 < source_.size() && source_[pos] == '.' && isDigit(source_[pos + 1])) {
+                isFloat = true;
+                advance(1);
+                while (pos < source_.size() && isDigit(source_[pos])) {
+                    advance(1);
+                }
+            }
+            if (pos < source_.size() && (source_[pos] == 'e' || source_[pos] == 'E')) {
+                std::size_t lookahead = pos + 1;
+                if (lookahead < source_.size() && (source_[lookahead] == '+' || source_[lookahead] == '-')) {
+                    ++lookahead;
+                }
+                if (lookahead < source_.size() && isDigit(source_[lookahead])) {
+                    isFloat = true;
+                    advance(lookahead - pos);
+                    while (pos < source_.size() && isDigit(source_[pos])) {
+                        advance(1);
+                    }
+                }
+            }
+            emit(isFloat ? TokenKind::FloatLiteral : TokenKind::IntegerLiteral, start, startLine, startColumn);
+            continue;
+        }
+
+        const auto multi = std::find_if(kMultiCharOperators.begin(), kMultiCharOperators.end(),
+                                        [&](std::string_view op) { return source_.substr(pos, op.size()) == op; });
+        if (multi != kMultiCharOperators.end()) {
+            advance(multi->size());
+            emit(TokenKind::Operator, start, startLine, startColumn);
+            continue;
+        }
+
+        if (kSingleCharOperators.find(c) != std::string_view::npos) {
+            advance(1);
+            emit(TokenKind::Operator, start, startLine, startColumn);
+            continue;
+        }
+
+        if (kPunctuation.find(c) != std::string_view::npos) {
+            advance(1);
+            emit(TokenKind::Punctuation, start, startLine, startColumn);
+            continue;
+        }
+
+        advance(1);
+        error("Unknown character '" + std::string(1, c) + "'", startLine, startColumn);
+    }
+
+    if (!errors.empty()) {
+        return std::unexpected(std::move(errors));
     }
-    
+
     // Add EOF token
     Token eofToken;
     eofToken.kind = TokenKind::EndOfFile;
     eofToken.text = std::string_view();
     eofToken.lexeme = ""; // EOF has empty lexeme
-    eofToken.line = lineNum;
-    eofToken.column = 1;
+    eofToken.line = line;
+    eofToken.column = column;
     tokens.push_back(eofToken);
-    
+
     return tokens;
 }
 
-} // namespace istudio
\ No newline at end of file
+} // namespace istudio
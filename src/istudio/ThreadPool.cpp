@@ -0,0 +1,85 @@
+#include "istudio/ThreadPool.h"
+
+#include <algorithm>
+
+namespace istudio {
+
+ThreadPool::ThreadPool(unsigned threadCount)
+{
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    // The caller of parallelFor is the remaining worker.
+    for (unsigned i = 1; i < threadCount; ++i) {
+        workers_.emplace_back([this] { workerLoop(); });
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+}
+
+void ThreadPool::parallelFor(std::size_t count, const std::function<void(std::size_t)>& body)
+{
+    if (count == 0) {
+        return;
+    }
+    if (workers_.empty() || count == 1) {
+        for (std::size_t i = 0; i < count; ++i) {
+            body(i);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard lock(mutex_);
+        body_ = &body;
+        count_ = count;
+        next_.store(0, std::memory_order_relaxed);
+        active_ = workers_.size();
+        ++generation_;
+    }
+    wake_.notify_all();
+
+    runJob();
+
+    std::unique_lock lock(mutex_);
+    done_.wait(lock, [this] { return active_ == 0; });
+    body_ = nullptr;
+}
+
+void ThreadPool::workerLoop()
+{
+    std::size_t seen = 0;
+    while (true) {
+        {
+            std::unique_lock lock(mutex_);
+            wake_.wait(lock, [&] { return stopping_ || generation_ != seen; });
+            if (stopping_) {
+                return;
+            }
+            seen = generation_;
+        }
+
+        runJob();
+
+        std::lock_guard lock(mutex_);
+        if (--active_ == 0) {
+            done_.notify_one();
+        }
+    }
+}
+
+void ThreadPool::runJob()
+{
+    for (std::size_t i = next_.fetch_add(1); i < count_; i = next_.fetch_add(1)) {
+        (*body_)(i);
+    }
+}
+
+} // namespace istudio
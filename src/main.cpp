@@ -4,6 +4,7 @@
 #include <vector>
 #include <filesystem>
 #include <optional>
+#include <expected>
 #include <fstream>
 #include <iterator>
 #include <string_view>
@@ -21,6 +22,17 @@
 #include "istudio/Token.h"
 #include "ir/Lowering.h"
 #include "ir/IR.h"
+#include "ir/Bitcode.h"
+#include "ir/IRParser.h"
+#include "ir/EscapeAnalysis.h"
+#include "ir/IRPrinter.h"
+#include "ir/Passes.h"
+#include "ir/Verifier.h"
+#include "vm/BytecodeCompiler.h"
+#include "vm/Interpreter.h"
+#include "x86/CodeGen.h"
+#include "x86/ElfWriter.h"
+#include "x86/Jit.h"
 #include "codegen/CodeGenerator.h"
 #include "codegen/CCodeGenerator.h"
 #include "codegen/CppCodeGenerator.h"
@@ -78,6 +90,9 @@ std::optional<DemoConfig> discoverDemoConfig()
 } // namespace
 
 namespace semantic = istudio::semantic;
+namespace ir = istudio::ir;
+namespace vm = istudio::vm;
+namespace x86 = istudio::x86;
 
 namespace {
 
@@ -198,9 +213,22 @@ bool lexDirectoryWithGrammar(const std::filesystem::path& samplesDir,
     return allSucceeded;
 }
 
-bool loadStandardLibraryTokens(const istudio::LexerOptions& options,
-                               std::size_t& totalTokens,
-                               bool verbose)
+// A parsed stdlib file. Pure modules contain only side-effect free functions, so
+// semantic analysis may evaluate calls into them at compile time.
+struct StdlibModule {
+    std::unique_ptr<ProgramNode> ast;
+    bool pure{false};
+};
+
+bool isPureStdlibModule(const std::filesystem::path& file)
+{
+    return file.stem() == "core_math";
+}
+
+bool loadStandardLibrary(const istudio::LexerOptions& options,
+                         std::size_t& totalTokens,
+                         bool verbose,
+                         std::vector<StdlibModule>& modules)
 {
     const auto stdlibDir = resolvePathNearExecutable("stdlib");
     if (!std::filesystem::exists(stdlibDir)) {
@@ -238,6 +266,14 @@ bool loadStandardLibraryTokens(const istudio::LexerOptions& options,
             return false;
         }
         totalTokens += tokensResult->size();
+
+        Parser parser(std::move(tokensResult.value()));
+        auto module = parser.parse();
+        if (parser.hadError() || !module) {
+            std::cout << "Error: Failed to parse standard library file " << file.filename().string() << std::endl;
+            return false;
+        }
+        modules.push_back(StdlibModule{std::move(module), isPureStdlibModule(file)});
     }
 
     return true;
@@ -298,6 +334,21 @@ std::filesystem::path resolveExistingPath(const std::filesystem::path& candidate
     return candidate;
 }
 
+// Whether `path` holds IR bitcode rather than source.
+bool isBitcodeFile(const std::filesystem::path& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    std::uint8_t magic[4] = {};
+    file.read(reinterpret_cast<char*>(magic), sizeof(magic));
+    return file.gcount() == sizeof(magic) && ir::isBitcode(magic);
+}
+
+// Whether `path` holds IR, as bitcode or as text (`.ir`), rather than source.
+bool isIrFile(const std::filesystem::path& path)
+{
+    return path.extension() == ".ir" || isBitcodeFile(path);
+}
+
 struct ProjectConfig {
     std::filesystem::path source;
     std::filesystem::path grammar;
@@ -370,6 +421,15 @@ struct CommandLineOptions {
     bool legacyCompile{false};
     bool emitSema{false};
     bool emitIr{false};
+    bool emitEscapes{false};
+    bool timePasses{false};
+    bool verifyIr{false};
+    bool optimize{false};
+    bool emitBytecode{false};
+    bool noJit{false};
+    std::string passes{};
+    std::string saveIr{};
+    std::string reanalyze{};
     std::string command{};
     std::string sourceFile{};
     std::string grammarFile{};
@@ -422,6 +482,54 @@ CommandLineOptions parseCommandLine(int argc, char* argv[])
             opts.emitIr = true;
             continue;
         }
+        if (arg == "--emit-escapes") {
+            opts.emitEscapes = true;
+            continue;
+        }
+        if (arg == "--emit-bytecode") {
+            opts.emitBytecode = true;
+            continue;
+        }
+        if (arg == "--no-jit") {
+            opts.noJit = true;
+            continue;
+        }
+        if (arg == "--passes") {
+            if (i + 1 >= argc) {
+                opts.errorMessage = "Missing value for --passes";
+                return opts;
+            }
+            opts.passes = argv[++i];
+            continue;
+        }
+        if (arg == "--save-ir") {
+            if (i + 1 >= argc) {
+                opts.errorMessage = "Missing value for --save-ir";
+                return opts;
+            }
+            opts.saveIr = argv[++i];
+            continue;
+        }
+        if (arg == "--reanalyze") {
+            if (i + 1 >= argc) {
+                opts.errorMessage = "Missing value for --reanalyze";
+                return opts;
+            }
+            opts.reanalyze = argv[++i];
+            continue;
+        }
+        if (arg == "-O" || arg == "--optimize") {
+            opts.optimize = true;
+            continue;
+        }
+        if (arg == "--time-passes") {
+            opts.timePasses = true;
+            continue;
+        }
+        if (arg == "--verify-ir") {
+            opts.verifyIr = true;
+            continue;
+        }
         if (arg == "--grammar" || arg == "-g") {
             if (i + 1 >= argc) {
                 opts.errorMessage = "Missing value for --grammar";
@@ -527,24 +635,39 @@ CommandLineOptions parseCommandLine(int argc, char* argv[])
 
 void printUsage(const std::string& executable)
 {
-    std::cout << "Usage:\\n"
-              << "  " << executable << " compile <source> [--grammar file] [--translation file] [options]\\n"
-              << "  " << executable << " run [--project file] [options]\\n"
-              << "  " << executable << " lex-samples [--grammar file]\\n"
-              << "  " << executable << " --demo\\n"
-              << "  " << executable << " --stdin [--grammar file] [--translation file]\\n"
-              << "  " << executable << " --help | --version\\n"
-              << "Options:\\n"
-              << "  --verbose, -v            Enable verbose logging\\n"
-              << "  --grammar, -g <file>     Override grammar rules file\\n"
-              << "  --translation, -t <file> Override translation rules file\\n"
-              << "  --project, -p <file>     Specify project manifest for run command (default: ./ipl_project.ini)\\n"
-              << "  --standard, -s <name>    Select grammar standard (e.g. ipl)\\n"
-              << "  --output, -o <path>      Output path for generated code\\n"
-              << "  --target, -tl <lang>     Target language for code generation (c, cpp, java, python)\\n"
-              << "  --emit-sema              Run semantic analysis and print symbol summary\\n"
-              << "  --emit-ir                Emit intermediate representation (planned feature)\\n"
-              << "  --lex-ipl-samples        Tokenize bundled IPL samples\\n";
+    std::cout << "Usage:\n"
+              << "  " << executable << " compile <source> [--grammar file] [--translation file] [options]\n"
+              << "  " << executable << " run [<source> | --project file] [options]\n"
+              << "  " << executable << " lex-samples [--grammar file]\n"
+              << "  " << executable << " --demo\n"
+              << "  " << executable << " --stdin [--grammar file] [--translation file]\n"
+              << "  " << executable << " --help | --version\n"
+              << "Options:\n"
+              << "  --verbose, -v            Enable verbose logging\n"
+              << "  --grammar, -g <file>     Override grammar rules file\n"
+              << "  --translation, -t <file> Override translation rules file\n"
+              << "  --project, -p <file>     Specify project manifest for run command (default: ./ipl_project.ini)\n"
+              << "  --standard, -s <name>    Select grammar standard (e.g. ipl)\n"
+              << "  --output, -o <path>      Output path for generated code\n"
+              << "  --target, -tl <lang>     Target language for code generation (c, cpp, java, python), or x86-64\n"
+              << "                           to build a native object file or executable at --output\n"
+              << "  --emit-sema              Run semantic analysis and print symbol summary\n"
+              << "  --emit-ir                Print the SSA intermediate representation\n"
+              << "  --emit-escapes           Print the IR with the escape state of every allocation\n"
+              << "  --emit-bytecode          Print the bytecode the run command executes (implies --no-jit)\n"
+              << "  --no-jit                 Run in the bytecode VM even where the native JIT could be used\n"
+              << "  --passes <p1,p2,...>     Run IR passes after lowering (inline, dce, adce, sccp, gvn, loop-simplify,\n"
+              << "                           licm, loop-unroll, simplifycfg, tailcall, vrp)\n"
+              << "  -O, --optimize           Run the default IR pipeline (before any --passes)\n"
+              << "  --time-passes            Report time and IR size change per pass\n"
+              << "  --verify-ir              Check the IR before and after every pass and stop at the first\n"
+              << "                           pass that breaks it\n"
+              << "  --save-ir <file>         Write the IR after the passes as bitcode; compile and run accept\n"
+              << "                           bitcode and textual .ir files in place of source and link\n"
+              << "                           several together\n"
+              << "  --reanalyze <file>       After analysis, swap in the functions of <file> that differ and\n"
+              << "                           analyze again incrementally, reporting the work reused\n"
+              << "  --lex-ipl-samples        Tokenize bundled IPL samples\n";
 }
 
 void printVersion()
@@ -559,7 +682,43 @@ public:
         : verbose_(verbose), emitSemanticSummary_(emitSemanticSummary), emitIr_(emitIr) {}
     ~Compiler() = default;
 
+    void setPassPipeline(std::string pipeline, bool timePasses, bool verifyIr)
+    {
+        passPipeline_ = std::move(pipeline);
+        timePasses_ = timePasses;
+        verifyIr_ = verifyIr;
+    }
+
+    // Prints the IR after the pass pipeline with the escape state of every
+    // allocation.
+    void setEmitEscapes(bool emitEscapes) { emitEscapes_ = emitEscapes; }
+
+    // Writes the IR after the pass pipeline to `path` as bitcode.
+    void setSaveIr(std::string path) { saveIr_ = std::move(path); }
+
+    // Edits the analyzed program into the one in `path`, which must declare as many
+    // functions, and analyzes it again, so the incremental analysis can be observed.
+    void setReanalyze(std::string path) { reanalyze_ = std::move(path); }
+
+    // Executes the program after compiling it: natively through the JIT when the
+    // host and the program allow, otherwise in the bytecode VM. The exit code is the
+    // int main returned.
+    void setExecute(bool execute, bool emitBytecode, bool useJit)
+    {
+        execute_ = execute;
+        emitBytecode_ = emitBytecode;
+        useJit_ = useJit && !emitBytecode;
+    }
+    int exitCode() const { return exitCode_; }
+
+    // Compiles the program to x86-64 and writes an object file to `path`, or links
+    // an executable there with the system C compiler unless the name ends in .o.
+    void setNativeOutput(std::string path) { nativeOutput_ = std::move(path); }
+
     bool compile(const std::string& source);
+    // Links IR files, bitcode written by --save-ir or textual `.ir`, into one
+    // module and takes it through the same IR pipeline as a compiled source file.
+    bool compileIrFiles(const std::vector<std::string>& files);
     bool compileWithConfig(const std::string& sourceCodeFile,
                            const std::string& grammarFile,
                            const std::string& translationFile);
@@ -579,6 +738,16 @@ private:
                             const std::string& targetLanguage,
                             const std::string& outputPath);
 
+    bool reanalyze(ProgramNode& program,
+                   istudio::LexerOptions lexerOptions,
+                   semantic::SemanticAnalyzer& analyzer,
+                   std::vector<std::unique_ptr<ASTNode>>& replaced);
+    bool runIrPipeline(const ProgramNode& program, const semantic::TypeAnnotations& annotations);
+    bool processModule(ir::IRModule& module);
+    bool saveBitcode(const ir::IRModule& module) const;
+    bool execute(const ir::IRModule& module);
+    std::optional<bool> executeNative(const ir::IRModule& module);
+    bool emitNative(const ir::IRModule& module) const;
     void indexAST(const ASTNode& node);
     void printSymbolSummary() const;
     void printSemanticSummary(const istudio::semantic::SymbolScope::Ptr& scope, int indent) const;
@@ -589,6 +758,17 @@ private:
     bool verbose_{false};
     bool emitSemanticSummary_{false};
     bool emitIr_{false};
+    bool emitEscapes_{false};
+    std::string saveIr_;
+    std::string reanalyze_;
+    std::string passPipeline_;
+    bool timePasses_{false};
+    bool verifyIr_{false};
+    bool execute_{false};
+    bool emitBytecode_{false};
+    bool useJit_{true};
+    int exitCode_{0};
+    std::string nativeOutput_;
 };
 
 bool Compiler::compile(const std::string& source)
@@ -615,7 +795,8 @@ bool Compiler::compileInternal(std::string_view source,
                                const std::vector<TranslationRule>& translationRules)
 {
     std::size_t stdlibCount = 0;
-    if (!loadStandardLibraryTokens(lexerOptions, stdlibCount, verbose_)) {
+    std::vector<StdlibModule> stdlibModules;
+    if (!loadStandardLibrary(lexerOptions, stdlibCount, verbose_, stdlibModules)) {
         return false;
     }
 
@@ -650,10 +831,22 @@ bool Compiler::compileInternal(std::string_view source,
         ast->print();
     }
 
-    semantic::SemanticAnalyzer analyzer({.verbose = verbose_});
+    semantic::SemanticAnalyzer analyzer({.verbose = verbose_, .recordScopes = emitSemanticSummary_});
+    for (const auto& module : stdlibModules) {
+        analyzer.addLibrary(*module.ast, module.pure);
+    }
     istudio::DiagnosticEngine semaDiagnostics;
     if (!analyzer.analyze(*ast, semaDiagnostics)) {
         printDiagnostics(semaDiagnostics.getDiagnostics());
+        if (reanalyze_.empty()) {
+            return false;
+        }
+    }
+
+    // Functions swapped out by --reanalyze; the analyzer's cache is keyed by node, so
+    // they stay alive until it is done with them.
+    std::vector<std::unique_ptr<ASTNode>> replaced;
+    if (!reanalyze_.empty() && !reanalyze(*ast, lexerOptions, analyzer, replaced)) {
         return false;
     }
 
@@ -664,9 +857,260 @@ bool Compiler::compileInternal(std::string_view source,
 
     symbolTable_.clear();
     indexAST(*ast);
-    printSymbolSummary();
+    if (!execute_) {
+        printSymbolSummary();
+    }
+
+    // Apply translation rules if provided
+    if (!translationRules.empty() && verbose_) {
+        std::cout << "\nTranslation rules applied:\n";
+        for (const auto& rule : translationRules) {
+            std::cout << "  " << rule.from_language << " -> " << rule.to_language 
+                      << ": " << rule.rule << std::endl;
+        }
+    }
+
+    if (!runIrPipeline(*ast, analyzer.typeAnnotations())) {
+        return false;
+    }
 
-    // Apply translation rules if provided\n    if (!translationRules.empty() && verbose_) {\n        std::cout << \"\\nTranslation rules applied:\\n\";\n        for (const auto& rule : translationRules) {\n            std::cout << \"  \" << rule.from_language << \" -> \" << rule.to_language \n                      << \": \" << rule.rule << std::endl;\n        }\n    }\n\n    // Emit IR if requested (placeholder - IR system not yet implemented)\n    if (emitIr_) {\n        std::cout << \"\\nIntermediate Representation (IR) emission:\\n\";\n        std::cout << \"  [Note: IR system is planned for future implementation]\\n\";\n        std::cout << \"  [IR would be generated from AST with type annotations]\\n\";\n        std::cout << \"  [See docs/roadmap_semantic_ir_codegen.md for details]\\n\";\n    }\n\n    return true;
+    return true;
+}
+
+// Replaces every function of `program` whose fingerprint differs from the one at
+// the same index in the --reanalyze file, then analyzes the program again.
+bool Compiler::reanalyze(ProgramNode& program,
+                         istudio::LexerOptions lexerOptions,
+                         semantic::SemanticAnalyzer& analyzer,
+                         std::vector<std::unique_ptr<ASTNode>>& replaced)
+{
+    std::ifstream in(reanalyze_);
+    if (!in) {
+        std::cout << "Error: Could not read " << reanalyze_ << std::endl;
+        return false;
+    }
+    std::string source((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    auto lexResult = lexSourceToTokens(source, lexerOptions);
+    if (!lexResult) {
+        printDiagnostics(lexResult.error());
+        return false;
+    }
+    Parser parser(std::move(lexResult.value()));
+    auto edited = parser.parse();
+    if (parser.hadError() || !edited) {
+        std::cout << "Parsing encountered errors in " << reanalyze_ << ".\n";
+        return false;
+    }
+    if (edited->getFunctions().size() != program.getFunctions().size()) {
+        std::cout << "Error: " << reanalyze_ << " must declare " << program.getFunctions().size()
+                  << " functions to be reanalyzed in place of the source\n";
+        return false;
+    }
+
+    for (std::size_t i = 0; i < program.getFunctions().size(); ++i) {
+        if (semantic::fingerprint(*program.getFunctions()[i]) != semantic::fingerprint(*edited->getFunctions()[i])) {
+            replaced.push_back(program.replaceFunction(i, edited->replaceFunction(i, nullptr)));
+        }
+    }
+
+    istudio::DiagnosticEngine diagnostics;
+    const bool ok = analyzer.analyze(program, diagnostics);
+    std::cout << "Reanalysis: " << analyzer.lastStats().checkedFunctions << " functions checked, "
+              << analyzer.lastStats().reusedFunctions << " reused\n";
+    if (!ok) {
+        printDiagnostics(diagnostics.getDiagnostics());
+    }
+    return ok;
+}
+
+// Lowers the program to SSA and runs the --passes pipeline over it.
+bool Compiler::runIrPipeline(const ProgramNode& program, const semantic::TypeAnnotations& annotations)
+{
+    if (!emitIr_ && !emitEscapes_ && passPipeline_.empty() && !execute_ && nativeOutput_.empty() &&
+        saveIr_.empty()) {
+        return true;
+    }
+    ir::LoweringPass lowering(&annotations);
+    const auto module = lowering.lower(program);
+    return processModule(*module);
+}
+
+bool Compiler::compileIrFiles(const std::vector<std::string>& files)
+{
+    auto module = std::make_unique<ir::IRModule>("main_module");
+    for (const std::string& file : files) {
+        const std::size_t before = module->getFunctions().size();
+        std::expected<void, std::string> linked;
+        if (isBitcodeFile(file)) {
+            auto reader = ir::BitcodeReader::openFile(file);
+            linked = reader ? reader->readInto(*module) : std::unexpected(reader.error());
+        } else if (std::ifstream in(file); in) {
+            const std::string text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+            linked = ir::parseInto(*module, text);
+        } else {
+            linked = std::unexpected("cannot open file");
+        }
+        if (!linked) {
+            std::cout << "Error: " << file << ": " << linked.error() << std::endl;
+            return false;
+        }
+        if (verbose_) {
+            std::cout << "Loaded " << module->getFunctions().size() - before << " functions from " << file
+                      << std::endl;
+        }
+    }
+    // The passes and backends assume well-formed IR, which files need not be.
+    if (const auto problems = ir::verifyModule(*module); !problems.empty()) {
+        std::cout << "Error: invalid IR:" << std::endl;
+        for (const auto& problem : problems) {
+            std::cout << "  " << problem << std::endl;
+        }
+        return false;
+    }
+    return processModule(*module);
+}
+
+bool Compiler::processModule(ir::IRModule& module)
+{
+    ir::PassManager passes({.timePasses = timePasses_, .verifyEach = verifyIr_});
+    std::string error;
+    if (!ir::addPipeline(passes, passPipeline_, error)) {
+        std::cout << "Error: " << error << std::endl;
+        return false;
+    }
+    if (auto ran = passes.run(module); !ran) {
+        std::cout << "Error: " << ran.error() << std::endl;
+        return false;
+    }
+
+    if (emitIr_) {
+        std::cout << "\nIntermediate Representation (SSA):\n";
+        ir::printModule(module, std::cout);
+    }
+    if (emitEscapes_) {
+        std::cout << "\nEscape analysis:\n";
+        ir::printEscapeReport(module, ir::analyzeEscapes(module), std::cout);
+    }
+    if (timePasses_) {
+        std::cout << '\n';
+        passes.printReport(std::cout);
+    }
+    if (!saveIr_.empty() && !saveBitcode(module)) {
+        return false;
+    }
+    if (!nativeOutput_.empty() && !emitNative(module)) {
+        return false;
+    }
+    return !execute_ || execute(module);
+}
+
+bool Compiler::emitNative(const ir::IRModule& module) const
+{
+    const auto object = x86::compileModule(module);
+    if (!object) {
+        std::cout << "Error: " << object.error() << std::endl;
+        return false;
+    }
+    const std::filesystem::path output(nativeOutput_);
+    const bool link = output.extension() != ".o";
+    std::filesystem::path objectPath = output;
+    if (link) {
+        objectPath += ".o";
+    }
+    {
+        std::ofstream file(objectPath, std::ios::binary);
+        if (!file) {
+            std::cout << "Error: Could not write to output file: " << objectPath.string() << std::endl;
+            return false;
+        }
+        x86::writeElfObject(*object, file);
+    }
+    if (!link) {
+        std::cout << "Object file written to: " << output.string() << " (" << object->functions.size()
+                  << " functions, " << object->text.size() << " bytes of code)" << std::endl;
+        return true;
+    }
+    const std::string command = "cc \"" + objectPath.string() + "\" -o \"" + output.string() + "\"";
+    const int status = std::system(command.c_str());
+    std::filesystem::remove(objectPath);
+    if (status != 0) {
+        std::cout << "Error: Linking failed: " << command << std::endl;
+        return false;
+    }
+    std::cout << "Executable written to: " << output.string() << std::endl;
+    return true;
+}
+
+// Runs main through the JIT, or returns nullopt when the program needs the VM:
+// main takes parameters, or some function uses values the x86-64 backend cannot
+// represent yet.
+std::optional<bool> Compiler::executeNative(const ir::IRModule& module)
+{
+    const auto& functions = module.getFunctions();
+    const auto entry = std::find_if(functions.begin(), functions.end(),
+                                    [](const auto& function) { return function->getName() == "main"; });
+    if (!x86::Jit::isSupported() || entry == functions.end() || !(*entry)->getArguments().empty()) {
+        return std::nullopt;
+    }
+    x86::Jit jit(module);
+    if (auto prepared = jit.prepare(); !prepared) {
+        if (verbose_) {
+            std::cout << "Note: running in the VM: " << prepared.error() << std::endl;
+        }
+        return std::nullopt;
+    }
+    std::cout << std::endl;
+    const auto result = jit.run("main");
+    if (!result) {
+        std::cout << "Runtime error: " << result.error() << std::endl;
+        return false;
+    }
+    exitCode_ = static_cast<int>(*result);
+    if (verbose_) {
+        std::cout << "Executed natively (" << jit.compiledFunctions() << " of " << module.getFunctions().size()
+                  << " functions compiled)" << std::endl;
+    }
+    return true;
+}
+
+bool Compiler::saveBitcode(const ir::IRModule& module) const
+{
+    const auto bytes = ir::writeBitcode(module);
+    std::ofstream out(saveIr_, std::ios::binary);
+    if (!out || !out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()))) {
+        std::cout << "Error: Cannot write IR bitcode to " << saveIr_ << std::endl;
+        return false;
+    }
+    std::cout << "IR bitcode written to: " << saveIr_ << " (" << bytes.size() << " bytes)" << std::endl;
+    return true;
+}
+
+bool Compiler::execute(const ir::IRModule& module)
+{
+    if (useJit_) {
+        if (const auto native = executeNative(module)) {
+            return *native;
+        }
+    }
+    auto program = vm::compileModule(module);
+    if (!program) {
+        std::cout << "Error: " << program.error() << std::endl;
+        return false;
+    }
+    if (emitBytecode_) {
+        std::cout << "\nBytecode:\n";
+        vm::disassemble(*program, std::cout);
+    }
+    std::cout << std::endl;
+    vm::Interpreter interpreter(*program);
+    const auto result = interpreter.run("main");
+    if (!result) {
+        std::cout << "Runtime error: " << result.error() << std::endl;
+        return false;
+    }
+    const auto* status = std::get_if<std::int64_t>(&*result);
+    exitCode_ = status ? static_cast<int>(*status) : 0;
+    return true;
 }
 
 void Compiler::indexAST(const ASTNode& node)
@@ -835,21 +1279,21 @@ void Compiler::printSemanticSummary(const istudio::semantic::SymbolScope::Ptr& s
         return;
     }
 
-    std::vector<std::pair<std::string, istudio::semantic::Symbol>> entries;
+    std::vector<const istudio::semantic::Symbol*> entries;
     entries.reserve(scope->symbols().size());
     for (const auto& entry : scope->symbols()) {
-        entries.emplace_back(entry.first, entry.second);
+        entries.push_back(&entry.second);
     }
-    std::sort(entries.begin(), entries.end(), [](const auto& lhs, const auto& rhs) {
-        return lhs.first < rhs.first;
+    std::sort(entries.begin(), entries.end(), [](const auto* lhs, const auto* rhs) {
+        return lhs->name < rhs->name;
     });
 
     std::string padding(static_cast<std::size_t>(indent) * 2, ' ');
-    for (const auto& [name, symbol] : entries) 
+    for (const auto* symbol : entries) 
     {
-        std::string kind = symbol.kind == istudio::semantic::SymbolKind::Function ? "fn" : "var";
-        std::string typeName = symbol.type ? symbol.type->name() : "<unknown>";
-        std::cout << padding << "- [" << kind << "] " << name << " : " << typeName << std::endl;
+        std::string kind = symbol->kind == istudio::semantic::SymbolKind::Function ? "fn" : "var";
+        std::string typeName = symbol->type ? symbol->type->name() : "<unknown>";
+        std::cout << padding << "- [" << kind << "] " << symbol->name << " : " << typeName << std::endl;
     }
 
     for (const auto& child : scope->children()) {
@@ -923,8 +1367,8 @@ bool Compiler::compileWithTarget(const std::string& sourceCodeFile,
     }
 
     if (verbose_) {
-        std::cout << "Loaded " << config.getGrammarRules().size() << " grammar rules\\n";
-        std::cout << "Loaded " << config.getTranslationRules().size() << " translation rules\\n";
+        std::cout << "Loaded " << config.getGrammarRules().size() << " grammar rules\n";
+        std::cout << "Loaded " << config.getTranslationRules().size() << " translation rules\n";
     }
 
     auto lexerOptions = makeLexerOptions(config.getGrammarRules());
@@ -941,7 +1385,8 @@ bool Compiler::compileWithCodegen(std::string_view source,
                                   const std::string& outputPath)
 {
     std::size_t stdlibCount = 0;
-    if (!loadStandardLibraryTokens(lexerOptions, stdlibCount, verbose_)) {
+    std::vector<StdlibModule> stdlibModules;
+    if (!loadStandardLibrary(lexerOptions, stdlibCount, verbose_, stdlibModules)) {
         return false;
     }
 
@@ -956,45 +1401,57 @@ bool Compiler::compileWithCodegen(std::string_view source,
 
     if (verbose_) {
         std::cout << "Lexical analysis produced " << userCount << " tokens ("
-                  << stdlibCount << " from standard library)\\n";
+                  << stdlibCount << " from standard library)\n";
     }
 
     Parser parser(std::move(tokens));
     auto ast = parser.parse();
     if (parser.hadError()) {
-        std::cout << "Parsing encountered errors.\\n";
+        std::cout << "Parsing encountered errors.\n";
         return false;
     }
 
     if (!ast) {
-        std::cout << "Failed to generate AST\\n";
+        std::cout << "Failed to generate AST\n";
         return false;
     }
 
     if (verbose_) {
-        std::cout << "Abstract Syntax Tree generated:\\n";
+        std::cout << "Abstract Syntax Tree generated:\n";
         ast->print();
     }
 
-    semantic::SemanticAnalyzer analyzer({.verbose = verbose_});
+    semantic::SemanticAnalyzer analyzer({.verbose = verbose_, .recordScopes = emitSemanticSummary_});
+    for (const auto& module : stdlibModules) {
+        analyzer.addLibrary(*module.ast, module.pure);
+    }
     istudio::DiagnosticEngine semaDiagnostics;
     if (!analyzer.analyze(*ast, semaDiagnostics)) {
         printDiagnostics(semaDiagnostics.getDiagnostics());
+        if (reanalyze_.empty()) {
+            return false;
+        }
+    }
+
+    std::vector<std::unique_ptr<ASTNode>> replaced;
+    if (!reanalyze_.empty() && !reanalyze(*ast, lexerOptions, analyzer, replaced)) {
         return false;
     }
 
     if (emitSemanticSummary_) {
-        std::cout << "\\nSemantic summary:\\n";
+        std::cout << "\nSemantic summary:\n";
         printSemanticSummary(analyzer.globalScope(), 0);
     }
 
     symbolTable_.clear();
     indexAST(*ast);
-    printSymbolSummary();
+    if (!execute_) {
+        printSymbolSummary();
+    }
 
     // Apply translation rules if provided
     if (!translationRules.empty() && verbose_) {
-        std::cout << "\\nTranslation rules applied:\\n";
+        std::cout << "\nTranslation rules applied:\n";
         for (const auto& rule : translationRules) {
             std::cout << "  " << rule.from_language << " -> " << rule.to_language
                       << ": " << rule.rule << std::endl;
@@ -1010,6 +1467,10 @@ bool Compiler::compileWithCodegen(std::string_view source,
             return false;
         }
 
+        codeGenerator->setTypeAnnotations(&analyzer.typeAnnotations());
+        codeGenerator->setOwnershipFacts(&analyzer.ownershipFacts());
+        codeGenerator->setConstants(&analyzer.constants());
+        codeGenerator->setTemplateInstances(&analyzer.templateInstances());
         std::string generatedCode = codeGenerator->generate(*ast);
         
         // Write the generated code to the output file
@@ -1024,16 +1485,12 @@ bool Compiler::compileWithCodegen(std::string_view source,
                 return false;
             }
         } else {
-            std::cout << "Generated code:\\n" << generatedCode << std::endl;
+            std::cout << "Generated code:\n" << generatedCode << std::endl;
         }
     }
 
-    // Emit IR if requested (placeholder - IR system not yet implemented)
-    if (emitIr_) {
-        std::cout << "\\nIntermediate Representation (IR) emission:\\n";
-        std::cout << "  [Note: IR system is planned for future implementation]\\n";
-        std::cout << "  [IR would be generated from AST with type annotations]\\n";
-        std::cout << "  [See docs/roadmap_semantic_ir_codegen.md for details]\\n";
+    if (!runIrPipeline(*ast, analyzer.typeAnnotations())) {
+        return false;
     }
 
     return true;
@@ -1062,12 +1519,18 @@ int main(int argc, char* argv[])
         return 0;
     }
 
-    if (!options.outputPath.empty()) {
-        std::cout << "Note: --output currently has no effect (code generation is not implemented). Requested path: "
-                  << options.outputPath << std::endl;
-    }
+    const bool nativeTarget = options.targetLanguage == "x86-64" || options.targetLanguage == "x86_64";
 
     Compiler compiler(options.verbose, options.emitSema, options.emitIr);
+    std::string pipeline = options.passes;
+    if (options.optimize) {
+        pipeline = std::string(ir::defaultPipeline()) + (pipeline.empty() ? "" : "," + pipeline);
+    }
+    compiler.setPassPipeline(std::move(pipeline), options.timePasses, options.verifyIr);
+    compiler.setEmitEscapes(options.emitEscapes);
+    compiler.setSaveIr(options.saveIr);
+    compiler.setReanalyze(options.reanalyze);
+    compiler.setExecute(options.command == "run", options.emitBytecode, !options.noJit);
 
     auto resolveOrDefaultGrammar = [&](const std::string& overridePath) {
         if (!overridePath.empty()) {
@@ -1140,6 +1603,22 @@ int main(int argc, char* argv[])
     }
 
     if (options.command == "run") {
+        if (!options.positional.empty() && isIrFile(options.positional.front())) {
+            return compiler.compileIrFiles(options.positional) ? compiler.exitCode() : 1;
+        }
+        if (!options.positional.empty()) {
+            auto grammar = resolveOrDefaultGrammar(options.grammarFile);
+            auto translation = resolveOrDefaultTranslation(options.translationFile);
+            if (grammar.empty() || translation.empty() ||
+                !std::filesystem::exists(grammar) || !std::filesystem::exists(translation)) {
+                return 1;
+            }
+            if (!compiler.compileWithConfig(options.positional.front(), grammar.string(), translation.string())) {
+                return 1;
+            }
+            return compiler.exitCode();
+        }
+
         std::filesystem::path projectPath = options.projectFile.empty()
                                             ? std::filesystem::current_path() / "ipl_project.ini"
                                             : std::filesystem::path(options.projectFile);
@@ -1161,7 +1640,10 @@ int main(int argc, char* argv[])
             project.translation = resolveExistingPath(options.translationFile);
         }
 
-        return compiler.compileWithConfig(project.source.string(), project.grammar.string(), project.translation.string()) ? 0 : 1;
+        if (!compiler.compileWithConfig(project.source.string(), project.grammar.string(), project.translation.string())) {
+            return 1;
+        }
+        return compiler.exitCode();
     }
 
     if (options.command == "compile") {
@@ -1178,6 +1660,14 @@ int main(int argc, char* argv[])
             return 1;
         }
 
+        if (isIrFile(options.sourceFile)) {
+            if (nativeTarget) {
+                compiler.setNativeOutput(options.outputPath.empty() ? "a.out" : options.outputPath);
+            }
+            options.positional.insert(options.positional.begin(), options.sourceFile);
+            return compiler.compileIrFiles(options.positional) ? 0 : 1;
+        }
+
         auto grammar = resolveOrDefaultGrammar(options.grammarFile);
         auto translation = resolveOrDefaultTranslation(options.translationFile);
         if (grammar.empty() || translation.empty() ||
@@ -1185,6 +1675,11 @@ int main(int argc, char* argv[])
             return 1;
         }
 
+        if (nativeTarget) {
+            compiler.setNativeOutput(options.outputPath.empty() ? "a.out" : options.outputPath);
+            return compiler.compileWithConfig(options.sourceFile, grammar.string(), translation.string()) ? 0 : 1;
+        }
+
         // If a target language is specified, use the new code generation method
         if (!options.targetLanguage.empty()) {
             return compiler.compileWithTarget(options.sourceFile, grammar.string(), 
@@ -0,0 +1,154 @@
+#include "semantic/AnalysisCache.h"
+
+#include <functional>
+#include <string_view>
+#include <unordered_set>
+
+namespace istudio::semantic {
+
+namespace {
+
+class Fingerprinter {
+public:
+    std::uint64_t run(const ASTNode& node)
+    {
+        visit(&node);
+        return hash_;
+    }
+
+private:
+    void mix(std::uint64_t value)
+    {
+        // boost::hash_combine, widened to 64 bits
+        hash_ ^= value + 0x9e3779b97f4a7c15ULL + (hash_ << 6) + (hash_ >> 2);
+    }
+
+    void mix(std::string_view text) { mix(static_cast<std::uint64_t>(std::hash<std::string_view>{}(text))); }
+
+    void visit(const ASTNode* node)
+    {
+        if (!node) {
+            mix(std::uint64_t{0xff});
+            return;
+        }
+        mix(static_cast<std::uint64_t>(node->getType()));
+        switch (node->getType()) {
+        case ASTNodeType::Program:
+            for (const auto& fn : static_cast<const ProgramNode*>(node)->getFunctions()) {
+                visit(fn.get());
+            }
+            break;
+        case ASTNodeType::Function: {
+            const auto* function = static_cast<const FunctionNode*>(node);
+            mix(function->getReturnType());
+            mix(function->getName());
+            mix(static_cast<std::uint64_t>(function->getTemplateParameters().size()));
+            for (const auto& param : function->getTemplateParameters()) {
+                mix(param.name);
+                mix(param.constraint);
+            }
+            mix(static_cast<std::uint64_t>(function->getParameters().size()));
+            for (const auto& param : function->getParameters()) {
+                mix(param.type);
+                mix(param.name);
+            }
+            visit(function->getBody());
+            break;
+        }
+        case ASTNodeType::VariableDeclaration: {
+            const auto* decl = static_cast<const VariableDeclarationNode*>(node);
+            mix(decl->getTypeName());
+            mix(decl->getName());
+            mix(static_cast<std::uint64_t>(decl->isConstant()));
+            visit(decl->getInitializer());
+            break;
+        }
+        case ASTNodeType::Assignment: {
+            const auto* assignment = static_cast<const AssignmentNode*>(node);
+            mix(assignment->getVariable());
+            visit(assignment->getValue());
+            break;
+        }
+        case ASTNodeType::BinaryOperation: {
+            const auto* binary = static_cast<const BinaryOperationNode*>(node);
+            mix(binary->getOperator());
+            visit(binary->getLeft());
+            visit(binary->getRight());
+            break;
+        }
+        case ASTNodeType::UnaryOperation: {
+            const auto* unary = static_cast<const UnaryOperationNode*>(node);
+            mix(unary->getOperator());
+            visit(unary->getOperand());
+            break;
+        }
+        case ASTNodeType::CallExpression: {
+            const auto* call = static_cast<const CallExpressionNode*>(node);
+            visit(call->getCallee());
+            mix(static_cast<std::uint64_t>(call->getArguments().size()));
+            for (const auto& arg : call->getArguments()) {
+                visit(arg.get());
+            }
+            break;
+        }
+        case ASTNodeType::Literal:
+            mix(static_cast<const LiteralNode*>(node)->getValue());
+            break;
+        case ASTNodeType::Identifier:
+            mix(static_cast<const IdentifierNode*>(node)->getName());
+            break;
+        case ASTNodeType::Block: {
+            const auto& statements = static_cast<const BlockNode*>(node)->getStatements();
+            mix(static_cast<std::uint64_t>(statements.size()));
+            for (const auto& stmt : statements) {
+                visit(stmt.get());
+            }
+            break;
+        }
+        case ASTNodeType::Return:
+            visit(static_cast<const ReturnNode*>(node)->getValue());
+            break;
+        case ASTNodeType::ExpressionStatement:
+            visit(static_cast<const ExpressionStatementNode*>(node)->getExpression());
+            break;
+        case ASTNodeType::If: {
+            const auto* ifNode = static_cast<const IfNode*>(node);
+            visit(ifNode->getCondition());
+            visit(ifNode->getThenBranch());
+            visit(ifNode->getElseBranch());
+            break;
+        }
+        case ASTNodeType::While: {
+            const auto* whileNode = static_cast<const WhileNode*>(node);
+            visit(whileNode->getCondition());
+            visit(whileNode->getBody());
+            break;
+        }
+        case ASTNodeType::For: {
+            const auto* forNode = static_cast<const ForNode*>(node);
+            visit(forNode->getInit());
+            visit(forNode->getCondition());
+            visit(forNode->getIncrement());
+            visit(forNode->getBody());
+            break;
+        }
+        }
+    }
+
+    std::uint64_t hash_{0xcbf29ce484222325ULL};
+};
+
+} // namespace
+
+std::uint64_t fingerprint(const ASTNode& node)
+{
+    return Fingerprinter{}.run(node);
+}
+
+void AnalysisCache::retain(const std::vector<const FunctionNode*>& functions)
+{
+    const std::unordered_set<const FunctionNode*> live(functions.begin(), functions.end());
+    std::erase_if(results_, [&](const auto& entry) { return !live.contains(entry.first); });
+}
+
+} // namespace istudio::semantic
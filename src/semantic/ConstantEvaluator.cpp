@@ -0,0 +1,462 @@
+#include "semantic/ConstantEvaluator.h"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+namespace istudio::semantic {
+
+std::optional<ConstantValue> parseLiteral(std::string_view lexeme)
+{
+    if (lexeme == "true" || lexeme == "false") {
+        return ConstantValue{lexeme == "true"};
+    }
+    if (lexeme.size() >= 2 && lexeme.front() == '"' && lexeme.back() == '"') {
+        return ConstantValue{std::string(lexeme.substr(1, lexeme.size() - 2))};
+    }
+    if (lexeme.empty() || !std::isdigit(static_cast<unsigned char>(lexeme.front()))) {
+        return std::nullopt;
+    }
+
+    const char* first = lexeme.data();
+    const char* last = first + lexeme.size();
+    if (lexeme.find_first_of(".eE") != std::string_view::npos) {
+        double value = 0;
+        const auto [end, ec] = std::from_chars(first, last, value);
+        if (ec != std::errc{} || end != last) {
+            return std::nullopt;
+        }
+        return ConstantValue{value};
+    }
+    std::int64_t value = 0;
+    const auto [end, ec] = std::from_chars(first, last, value);
+    if (ec != std::errc{} || end != last) {
+        return std::nullopt;
+    }
+    return ConstantValue{value};
+}
+
+std::string toLiteral(const ConstantValue& value)
+{
+    if (const auto* boolean = std::get_if<bool>(&value)) {
+        return *boolean ? "true" : "false";
+    }
+    if (const auto* integer = std::get_if<std::int64_t>(&value)) {
+        return std::to_string(*integer);
+    }
+    if (const auto* real = std::get_if<double>(&value)) {
+        char buffer[32];
+        const auto result = std::to_chars(buffer, buffer + sizeof(buffer), *real);
+        std::string text(buffer, result.ptr);
+        if (text.find_first_of(".e") == std::string::npos) {
+            text += ".0";
+        }
+        return text;
+    }
+    return '"' + std::get<std::string>(value) + '"';
+}
+
+namespace {
+
+constexpr std::size_t kStepBudget = 100000;
+constexpr int kCallDepthLimit = 32;
+
+bool isNumeric(const ConstantValue& value)
+{
+    return std::holds_alternative<std::int64_t>(value) || std::holds_alternative<double>(value);
+}
+
+double toDouble(const ConstantValue& value)
+{
+    if (const auto* integer = std::get_if<std::int64_t>(&value)) {
+        return static_cast<double>(*integer);
+    }
+    return std::get<double>(value);
+}
+
+bool isRealType(std::string_view type)
+{
+    return type == "number" || type == "float" || type == "double";
+}
+
+std::optional<ConstantValue> finite(double value)
+{
+    if (!std::isfinite(value)) {
+        return std::nullopt;
+    }
+    return ConstantValue{value};
+}
+
+template <typename T>
+std::optional<ConstantValue> compare(std::string_view op, const T& left, const T& right)
+{
+    if (op == "==") return ConstantValue{left == right};
+    if (op == "!=") return ConstantValue{left != right};
+    if constexpr (!std::is_same_v<T, bool>) {
+        if (op == "<") return ConstantValue{left < right};
+        if (op == "<=") return ConstantValue{left <= right};
+        if (op == ">") return ConstantValue{left > right};
+        if (op == ">=") return ConstantValue{left >= right};
+    }
+    return std::nullopt;
+}
+
+// The C, C++ and Java generators declare `int` as a 32-bit int, so a result outside
+// that range would change meaning (C, C++) or not compile (Java) there.
+std::optional<ConstantValue> intResult(std::int64_t value)
+{
+    if (value < std::numeric_limits<std::int32_t>::min() || value > std::numeric_limits<std::int32_t>::max()) {
+        return std::nullopt;
+    }
+    return ConstantValue{value};
+}
+
+std::optional<ConstantValue> integerArithmetic(std::string_view op, std::int64_t left, std::int64_t right)
+{
+    std::int64_t result = 0;
+    if (op == "+") {
+        if (__builtin_add_overflow(left, right, &result)) return std::nullopt;
+    } else if (op == "-") {
+        if (__builtin_sub_overflow(left, right, &result)) return std::nullopt;
+    } else if (op == "*") {
+        if (__builtin_mul_overflow(left, right, &result)) return std::nullopt;
+    } else if (op == "/") {
+        // C and Java truncate while Python's true division gives a float even for
+        // exact quotients (9 / 3 is 3.0), so no one literal is right for every target.
+        return std::nullopt;
+    } else if (op == "%") {
+        if (left < 0 || right <= 0) {
+            return std::nullopt;
+        }
+        result = left % right;
+    } else {
+        return compare(op, left, right);
+    }
+    return intResult(result);
+}
+
+std::optional<ConstantValue> realArithmetic(std::string_view op, double left, double right)
+{
+    if (op == "+") return finite(left + right);
+    if (op == "-") return finite(left - right);
+    if (op == "*") return finite(left * right);
+    if (op == "/") return right == 0 ? std::nullopt : finite(left / right);
+    if (op == "%") return (left < 0 || right <= 0) ? std::nullopt : finite(std::fmod(left, right));
+    return compare(op, left, right);
+}
+
+} // namespace
+
+// Tree-walking evaluation of a pure function body. Variables live in one flat
+// stack per call; blocks truncate it on exit.
+class Interpreter {
+public:
+    explicit Interpreter(const ConstantEvaluator& evaluator) : evaluator_(evaluator) {}
+
+    std::optional<ConstantValue> call(std::string_view name, const std::vector<ConstantValue>& arguments)
+    {
+        const auto it = evaluator_.pure_.find(name);
+        if (it == evaluator_.pure_.end() || depth_ >= kCallDepthLimit) {
+            return std::nullopt;
+        }
+        const FunctionNode& function = *it->second;
+        const auto& params = function.getParameters();
+        if (params.size() != arguments.size() || !function.getBody()) {
+            return std::nullopt;
+        }
+
+        Frame frame;
+        for (std::size_t i = 0; i < params.size(); ++i) {
+            auto value = coerce(params[i].type, arguments[i]);
+            if (!value) {
+                return std::nullopt;
+            }
+            frame.variables.emplace_back(params[i].name, std::move(*value));
+        }
+
+        std::swap(frame_, frame);
+        ++depth_;
+        const Flow flow = execute(*function.getBody());
+        --depth_;
+        std::swap(frame_, frame);
+
+        if (flow != Flow::Return || !frame.result) {
+            return std::nullopt;
+        }
+        return coerce(function.getReturnType(), *frame.result);
+    }
+
+private:
+    enum class Flow { Normal, Return, Abort };
+
+    struct Frame {
+        std::vector<std::pair<std::string_view, ConstantValue>> variables;
+        std::optional<ConstantValue> result;
+    };
+
+    // Values bound to real-typed slots become doubles; other types must already match.
+    static std::optional<ConstantValue> coerce(std::string_view type, const ConstantValue& value)
+    {
+        if (isRealType(type) && isNumeric(value)) {
+            return ConstantValue{toDouble(value)};
+        }
+        if ((type == "int" && !std::holds_alternative<std::int64_t>(value)) ||
+            (type == "bool" && !std::holds_alternative<bool>(value)) ||
+            (type == "string" && !std::holds_alternative<std::string>(value))) {
+            return std::nullopt;
+        }
+        return value;
+    }
+
+    ConstantValue* variable(std::string_view name)
+    {
+        for (auto it = frame_.variables.rbegin(); it != frame_.variables.rend(); ++it) {
+            if (it->first == name) {
+                return &it->second;
+            }
+        }
+        return nullptr;
+    }
+
+    bool step() { return ++steps_ <= kStepBudget; }
+
+    std::optional<bool> condition(const ASTNode* node)
+    {
+        if (!node) {
+            return true;
+        }
+        const auto value = evaluate(*node);
+        if (!value || !std::holds_alternative<bool>(*value)) {
+            return std::nullopt;
+        }
+        return std::get<bool>(*value);
+    }
+
+    Flow execute(const ASTNode& node)
+    {
+        if (!step()) {
+            return Flow::Abort;
+        }
+        switch (node.getType()) {
+        case ASTNodeType::Block: {
+            const std::size_t mark = frame_.variables.size();
+            Flow flow = Flow::Normal;
+            for (const auto& stmt : static_cast<const BlockNode&>(node).getStatements()) {
+                if (stmt && (flow = execute(*stmt)) != Flow::Normal) {
+                    break;
+                }
+            }
+            frame_.variables.resize(mark);
+            return flow;
+        }
+        case ASTNodeType::VariableDeclaration: {
+            const auto& decl = static_cast<const VariableDeclarationNode&>(node);
+            std::optional<ConstantValue> value;
+            if (decl.getInitializer()) {
+                value = evaluate(*decl.getInitializer());
+            }
+            if (value && !decl.getTypeName().empty()) {
+                value = coerce(decl.getTypeName(), *value);
+            }
+            if (!value) {
+                return Flow::Abort;
+            }
+            frame_.variables.emplace_back(decl.getName(), std::move(*value));
+            return Flow::Normal;
+        }
+        case ASTNodeType::Assignment: {
+            const auto& assignment = static_cast<const AssignmentNode&>(node);
+            ConstantValue* target = variable(assignment.getVariable());
+            auto value = assignment.getValue() ? evaluate(*assignment.getValue()) : std::nullopt;
+            if (!target || !value) {
+                return Flow::Abort;
+            }
+            if (std::holds_alternative<double>(*target) && isNumeric(*value)) {
+                value = ConstantValue{toDouble(*value)};
+            }
+            *target = std::move(*value);
+            return Flow::Normal;
+        }
+        case ASTNodeType::ExpressionStatement: {
+            const auto* expr = static_cast<const ExpressionStatementNode&>(node).getExpression();
+            return expr && evaluate(*expr) ? Flow::Normal : Flow::Abort;
+        }
+        case ASTNodeType::Return: {
+            const auto* value = static_cast<const ReturnNode&>(node).getValue();
+            if (!value || !(frame_.result = evaluate(*value))) {
+                return Flow::Abort;
+            }
+            return Flow::Return;
+        }
+        case ASTNodeType::If: {
+            const auto& ifNode = static_cast<const IfNode&>(node);
+            const auto taken = condition(ifNode.getCondition());
+            if (!taken) {
+                return Flow::Abort;
+            }
+            const ASTNode* branch = *taken ? ifNode.getThenBranch() : ifNode.getElseBranch();
+            return branch ? execute(*branch) : Flow::Normal;
+        }
+        case ASTNodeType::While: {
+            const auto& loop = static_cast<const WhileNode&>(node);
+            return runLoop(loop.getCondition(), loop.getBody(), nullptr);
+        }
+        case ASTNodeType::For: {
+            const auto& loop = static_cast<const ForNode&>(node);
+            const std::size_t mark = frame_.variables.size();
+            Flow flow = loop.getInit() ? execute(*loop.getInit()) : Flow::Normal;
+            if (flow == Flow::Normal) {
+                flow = runLoop(loop.getCondition(), loop.getBody(), loop.getIncrement());
+            }
+            frame_.variables.resize(mark);
+            return flow;
+        }
+        default:
+            return Flow::Abort;
+        }
+    }
+
+    Flow runLoop(const ASTNode* cond, const ASTNode* body, const ASTNode* increment)
+    {
+        while (true) {
+            const auto keepGoing = condition(cond);
+            if (!keepGoing || !step()) {
+                return Flow::Abort;
+            }
+            if (!*keepGoing) {
+                return Flow::Normal;
+            }
+            if (body) {
+                if (const Flow flow = execute(*body); flow != Flow::Normal) {
+                    return flow;
+                }
+            }
+            if (increment && execute(*increment) != Flow::Normal) {
+                return Flow::Abort;
+            }
+        }
+    }
+
+    std::optional<ConstantValue> evaluate(const ASTNode& node)
+    {
+        if (!step()) {
+            return std::nullopt;
+        }
+        switch (node.getType()) {
+        case ASTNodeType::Literal:
+            return parseLiteral(static_cast<const LiteralNode&>(node).getValue());
+        case ASTNodeType::Identifier: {
+            const ConstantValue* value = variable(static_cast<const IdentifierNode&>(node).getName());
+            return value ? std::optional<ConstantValue>(*value) : std::nullopt;
+        }
+        case ASTNodeType::UnaryOperation: {
+            const auto& unary = static_cast<const UnaryOperationNode&>(node);
+            const auto operand = unary.getOperand() ? evaluate(*unary.getOperand()) : std::nullopt;
+            return operand ? evaluator_.unary(unary.getOperator(), *operand) : std::nullopt;
+        }
+        case ASTNodeType::BinaryOperation: {
+            const auto& binary = static_cast<const BinaryOperationNode&>(node);
+            const auto left = binary.getLeft() ? evaluate(*binary.getLeft()) : std::nullopt;
+            const auto right = left && binary.getRight() ? evaluate(*binary.getRight()) : std::nullopt;
+            return right ? evaluator_.binary(binary.getOperator(), *left, *right) : std::nullopt;
+        }
+        case ASTNodeType::CallExpression: {
+            const auto& call = static_cast<const CallExpressionNode&>(node);
+            const auto* callee = call.getCallee();
+            if (!callee || callee->getType() != ASTNodeType::Identifier) {
+                return std::nullopt;
+            }
+            std::vector<ConstantValue> arguments;
+            for (const auto& arg : call.getArguments()) {
+                auto value = arg ? evaluate(*arg) : std::nullopt;
+                if (!value) {
+                    return std::nullopt;
+                }
+                arguments.push_back(std::move(*value));
+            }
+            return this->call(static_cast<const IdentifierNode&>(*callee).getName(), arguments);
+        }
+        default:
+            return std::nullopt;
+        }
+    }
+
+    const ConstantEvaluator& evaluator_;
+    Frame frame_;
+    std::size_t steps_{0};
+    int depth_{0};
+};
+
+void ConstantEvaluator::addPureLibrary(const ProgramNode& library, const std::vector<std::string>& shadowed)
+{
+    for (const auto& fn : library.getFunctions()) {
+        const auto* function = static_cast<const FunctionNode*>(fn.get());
+        if (!function || function->getReturnType().empty() || function->getReturnType() == "void" ||
+            std::find(shadowed.begin(), shadowed.end(), function->getName()) != shadowed.end()) {
+            continue;
+        }
+        pure_[function->getName()] = function;
+    }
+}
+
+std::optional<ConstantValue> ConstantEvaluator::unary(std::string_view op, const ConstantValue& operand) const
+{
+    if (op == "!" && std::holds_alternative<bool>(operand)) {
+        return ConstantValue{!std::get<bool>(operand)};
+    }
+    if (op == "+" && isNumeric(operand)) {
+        return operand;
+    }
+    if (op == "-") {
+        if (const auto* value = std::get_if<std::int64_t>(&operand)) {
+            if (*value == std::numeric_limits<std::int64_t>::min()) {
+                return std::nullopt;
+            }
+            return intResult(-*value);
+        }
+        if (const auto* real = std::get_if<double>(&operand)) {
+            return ConstantValue{-*real};
+        }
+    }
+    return std::nullopt;
+}
+
+std::optional<ConstantValue> ConstantEvaluator::binary(std::string_view op,
+                                                       const ConstantValue& left,
+                                                       const ConstantValue& right) const
+{
+    if (isNumeric(left) && isNumeric(right)) {
+        if (std::holds_alternative<std::int64_t>(left) && std::holds_alternative<std::int64_t>(right)) {
+            return integerArithmetic(op, std::get<std::int64_t>(left), std::get<std::int64_t>(right));
+        }
+        return realArithmetic(op, toDouble(left), toDouble(right));
+    }
+    if (std::holds_alternative<bool>(left) && std::holds_alternative<bool>(right)) {
+        const bool a = std::get<bool>(left);
+        const bool b = std::get<bool>(right);
+        if (op == "&&" || op == "and") return ConstantValue{a && b};
+        if (op == "||" || op == "or") return ConstantValue{a || b};
+        return compare(op, a, b);
+    }
+    if (std::holds_alternative<std::string>(left) && std::holds_alternative<std::string>(right)) {
+        const auto& a = std::get<std::string>(left);
+        const auto& b = std::get<std::string>(right);
+        if (op == "+") return ConstantValue{a + b};
+        // Spellings only compare equal reliably without escapes.
+        if ((op == "==" || op == "!=") && a.find('\\') == std::string::npos && b.find('\\') == std::string::npos) {
+            return compare(op, a, b);
+        }
+    }
+    return std::nullopt;
+}
+
+std::optional<ConstantValue> ConstantEvaluator::call(std::string_view function,
+                                                     const std::vector<ConstantValue>& arguments) const
+{
+    return Interpreter(*this).call(function, arguments);
+}
+
+} // namespace istudio::semantic
@@ -0,0 +1,180 @@
+#include "semantic/ControlFlowGraph.h"
+
+#include <utility>
+
+namespace istudio::semantic {
+
+namespace {
+
+bool isAlwaysTrue(const ASTNode* condition)
+{
+    // A missing for-condition loops forever, as does `while (true)`.
+    return !condition || (condition->getType() == ASTNodeType::Literal &&
+                          static_cast<const LiteralNode*>(condition)->getValue() == "true");
+}
+
+} // namespace
+
+class CFGBuilder {
+public:
+    explicit CFGBuilder(ControlFlowGraph& cfg) : cfg_(cfg)
+    {
+        newBlock(); // entry
+        newBlock(); // exit
+        current_ = cfg_.entry();
+    }
+
+    void function(const FunctionNode& function)
+    {
+        if (const auto* body = function.getBody()) {
+            statement(*body);
+        }
+        cfg_.fallthrough_ = current_;
+        addEdge(current_, cfg_.exit());
+    }
+
+private:
+    BlockId newBlock()
+    {
+        const auto id = static_cast<BlockId>(cfg_.blocks_.size());
+        cfg_.blocks_.push_back(CFGBlock{id, {}, {}, {}});
+        return id;
+    }
+
+    void addEdge(BlockId from, BlockId to)
+    {
+        cfg_.blocks_[from].successors.push_back(to);
+        cfg_.blocks_[to].predecessors.push_back(from);
+    }
+
+    void append(const ASTNode& node) { cfg_.blocks_[current_].elements.push_back(&node); }
+
+    void statement(const ASTNode& node)
+    {
+        switch (node.getType()) {
+        case ASTNodeType::Block:
+            for (const auto& stmt : static_cast<const BlockNode&>(node).getStatements()) {
+                if (stmt) {
+                    statement(*stmt);
+                }
+            }
+            break;
+        case ASTNodeType::If:
+            ifStatement(static_cast<const IfNode&>(node));
+            break;
+        case ASTNodeType::While: {
+            const auto& loop = static_cast<const WhileNode&>(node);
+            loopStatement(loop.getCondition(), loop.getBody(), nullptr);
+            break;
+        }
+        case ASTNodeType::For: {
+            const auto& loop = static_cast<const ForNode&>(node);
+            if (const auto* init = loop.getInit()) {
+                statement(*init);
+            }
+            loopStatement(loop.getCondition(), loop.getBody(), loop.getIncrement());
+            break;
+        }
+        case ASTNodeType::Return:
+            append(node);
+            addEdge(current_, cfg_.exit());
+            current_ = newBlock(); // anything after a return is unreachable
+            break;
+        default:
+            append(node);
+            break;
+        }
+    }
+
+    void ifStatement(const IfNode& node)
+    {
+        if (const auto* cond = node.getCondition()) {
+            append(*cond);
+        }
+        const BlockId branch = current_;
+
+        current_ = newBlock();
+        addEdge(branch, current_);
+        if (const auto* thenBranch = node.getThenBranch()) {
+            statement(*thenBranch);
+        }
+        const BlockId thenEnd = current_;
+
+        BlockId elseEnd = branch;
+        if (const auto* elseBranch = node.getElseBranch()) {
+            current_ = newBlock();
+            addEdge(branch, current_);
+            statement(*elseBranch);
+            elseEnd = current_;
+        }
+
+        current_ = newBlock();
+        addEdge(thenEnd, current_);
+        addEdge(elseEnd, current_);
+    }
+
+    void loopStatement(const ASTNode* condition, const ASTNode* body, const ASTNode* increment)
+    {
+        const BlockId header = newBlock();
+        addEdge(current_, header);
+        current_ = header;
+        if (condition) {
+            append(*condition);
+        }
+
+        current_ = newBlock();
+        addEdge(header, current_);
+        if (body) {
+            statement(*body);
+        }
+        if (increment) {
+            statement(*increment);
+        }
+        addEdge(current_, header);
+
+        current_ = newBlock();
+        if (!isAlwaysTrue(condition)) {
+            addEdge(header, current_);
+        }
+    }
+
+    ControlFlowGraph& cfg_;
+    BlockId current_{0};
+};
+
+ControlFlowGraph ControlFlowGraph::build(const FunctionNode& function)
+{
+    ControlFlowGraph cfg;
+    CFGBuilder(cfg).function(function);
+    cfg.computeOrder();
+    return cfg;
+}
+
+void ControlFlowGraph::computeOrder()
+{
+    // Iterative DFS; a block is emitted once all of its successors are done.
+    reachable_.assign(blocks_.size(), false);
+    rpo_.clear();
+    rpo_.reserve(blocks_.size());
+
+    std::vector<std::pair<BlockId, std::size_t>> stack;
+    stack.emplace_back(entry(), 0);
+    reachable_[entry()] = true;
+    while (!stack.empty()) {
+        auto& [id, next] = stack.back();
+        const auto& successors = blocks_[id].successors;
+        if (next < successors.size()) {
+            const BlockId succ = successors[next++];
+            if (!reachable_[succ]) {
+                reachable_[succ] = true;
+                stack.emplace_back(succ, 0);
+            }
+            continue;
+        }
+        rpo_.push_back(id);
+        stack.pop_back();
+    }
+    std::vector<BlockId>(rpo_.rbegin(), rpo_.rend()).swap(rpo_);
+}
+
+} // namespace istudio::semantic
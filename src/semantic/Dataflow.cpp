@@ -0,0 +1,77 @@
+#include "semantic/Dataflow.h"
+
+#include <utility>
+
+namespace istudio::semantic {
+
+std::vector<BitVector> solveForward(const ControlFlowGraph& cfg, const GenKillProblem& problem)
+{
+    const bool must = problem.meet == DataflowMeet::Intersect;
+    const std::size_t blockCount = cfg.blocks().size();
+
+    std::vector<BitVector> in(blockCount, BitVector(problem.bits, must));
+    std::vector<BitVector> out(blockCount, BitVector(problem.bits, must));
+
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (const BlockId id : cfg.reversePostOrder()) {
+            BitVector state = problem.boundary;
+            if (id != cfg.entry()) {
+                state = BitVector(problem.bits, must);
+                for (const BlockId pred : cfg.block(id).predecessors) {
+                    if (must) {
+                        state.intersectWith(out[pred]);
+                    } else {
+                        state.unionWith(out[pred]);
+                    }
+                }
+            }
+            in[id] = state;
+            state.transfer(problem.gen[id], problem.kill[id]);
+            if (!(state == out[id])) {
+                out[id] = std::move(state);
+                changed = true;
+            }
+        }
+    }
+    return in;
+}
+
+std::vector<BitVector> solveBackward(const ControlFlowGraph& cfg, const GenKillProblem& problem)
+{
+    const bool must = problem.meet == DataflowMeet::Intersect;
+    const std::size_t blockCount = cfg.blocks().size();
+
+    std::vector<BitVector> in(blockCount, BitVector(problem.bits, must));
+    std::vector<BitVector> out(blockCount, BitVector(problem.bits, must));
+    const auto& rpo = cfg.reversePostOrder();
+
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (auto it = rpo.rbegin(); it != rpo.rend(); ++it) {
+            const BlockId id = *it;
+            BitVector state = problem.boundary;
+            if (id != cfg.exit()) {
+                state = BitVector(problem.bits, must);
+                for (const BlockId succ : cfg.block(id).successors) {
+                    if (must) {
+                        state.intersectWith(in[succ]);
+                    } else {
+                        state.unionWith(in[succ]);
+                    }
+                }
+            }
+            out[id] = state;
+            state.transfer(problem.gen[id], problem.kill[id]);
+            if (!(state == in[id])) {
+                in[id] = std::move(state);
+                changed = true;
+            }
+        }
+    }
+    return out;
+}
+
+} // namespace istudio::semantic
@@ -0,0 +1,305 @@
+#include "semantic/FlowAnalysis.h"
+
+#include "semantic/Dataflow.h"
+
+#include <string_view>
+#include <unordered_map>
+
+namespace istudio::semantic {
+
+namespace {
+
+// Lexical name resolution for the locals of one function.
+class SlotResolver {
+public:
+    SlotResolver(std::vector<LocalSlot>& slots, std::unordered_map<const ASTNode*, SlotId>& resolved)
+        : slots_(slots), resolved_(resolved)
+    {
+    }
+
+    void function(const FunctionNode& function)
+    {
+        scopes_.emplace_back();
+        for (const auto& param : function.getParameters()) {
+            declare(param.name, param.type, true);
+        }
+        if (const auto* body = function.getBody()) {
+            node(*body);
+        }
+        scopes_.pop_back();
+    }
+
+private:
+    SlotId declare(const std::string& name, std::string_view typeName, bool parameter)
+    {
+        const auto slot = static_cast<SlotId>(slots_.size());
+        slots_.push_back(LocalSlot{name, std::string(stripOwnership(typeName)), ownershipOf(typeName), parameter});
+        scopes_.back()[name] = slot;
+        return slot;
+    }
+
+    SlotId lookup(std::string_view name) const
+    {
+        for (auto scope = scopes_.rbegin(); scope != scopes_.rend(); ++scope) {
+            if (const auto it = scope->find(name); it != scope->end()) {
+                return it->second;
+            }
+        }
+        return kNoSlot; // global or function name
+    }
+
+    void bind(const ASTNode& node, std::string_view name)
+    {
+        if (const SlotId slot = lookup(name); slot != kNoSlot) {
+            resolved_[&node] = slot;
+        }
+    }
+
+    void child(const ASTNode* node)
+    {
+        if (node) {
+            this->node(*node);
+        }
+    }
+
+    void node(const ASTNode& node)
+    {
+        switch (node.getType()) {
+        case ASTNodeType::Block:
+            scopes_.emplace_back();
+            for (const auto& stmt : static_cast<const BlockNode&>(node).getStatements()) {
+                child(stmt.get());
+            }
+            scopes_.pop_back();
+            break;
+        case ASTNodeType::VariableDeclaration: {
+            const auto& decl = static_cast<const VariableDeclarationNode&>(node);
+            child(decl.getInitializer()); // `let x = x + 1` reads the outer x
+            resolved_[&node] = declare(decl.getName(), decl.getTypeName(), false);
+            break;
+        }
+        case ASTNodeType::Assignment: {
+            const auto& assignment = static_cast<const AssignmentNode&>(node);
+            child(assignment.getValue());
+            bind(node, assignment.getVariable());
+            break;
+        }
+        case ASTNodeType::Identifier:
+            bind(node, static_cast<const IdentifierNode&>(node).getName());
+            break;
+        case ASTNodeType::BinaryOperation: {
+            const auto& binary = static_cast<const BinaryOperationNode&>(node);
+            child(binary.getLeft());
+            child(binary.getRight());
+            break;
+        }
+        case ASTNodeType::UnaryOperation:
+            child(static_cast<const UnaryOperationNode&>(node).getOperand());
+            break;
+        case ASTNodeType::CallExpression: {
+            const auto& call = static_cast<const CallExpressionNode&>(node);
+            child(call.getCallee());
+            for (const auto& arg : call.getArguments()) {
+                child(arg.get());
+            }
+            break;
+        }
+        case ASTNodeType::Return:
+            child(static_cast<const ReturnNode&>(node).getValue());
+            break;
+        case ASTNodeType::ExpressionStatement:
+            child(static_cast<const ExpressionStatementNode&>(node).getExpression());
+            break;
+        case ASTNodeType::If: {
+            const auto& ifNode = static_cast<const IfNode&>(node);
+            child(ifNode.getCondition());
+            child(ifNode.getThenBranch());
+            child(ifNode.getElseBranch());
+            break;
+        }
+        case ASTNodeType::While: {
+            const auto& loop = static_cast<const WhileNode&>(node);
+            child(loop.getCondition());
+            child(loop.getBody());
+            break;
+        }
+        case ASTNodeType::For: {
+            const auto& loop = static_cast<const ForNode&>(node);
+            scopes_.emplace_back();
+            child(loop.getInit());
+            child(loop.getCondition());
+            child(loop.getIncrement());
+            child(loop.getBody());
+            scopes_.pop_back();
+            break;
+        }
+        case ASTNodeType::Program:
+        case ASTNodeType::Function:
+        case ASTNodeType::Literal:
+            break;
+        }
+    }
+
+    std::vector<LocalSlot>& slots_;
+    std::unordered_map<const ASTNode*, SlotId>& resolved_;
+    std::vector<std::unordered_map<std::string_view, SlotId>> scopes_;
+};
+
+// Emits the slot events of one CFG element in evaluation order.
+class EventCollector {
+public:
+    EventCollector(const std::unordered_map<const ASTNode*, SlotId>& resolved, std::vector<FlowEvent>& out)
+        : resolved_(resolved), out_(out)
+    {
+    }
+
+    void element(const ASTNode& node)
+    {
+        switch (node.getType()) {
+        case ASTNodeType::VariableDeclaration: {
+            const auto& decl = static_cast<const VariableDeclarationNode&>(node);
+            expression(decl.getInitializer());
+            emit(decl.getInitializer() ? FlowEventKind::Define : FlowEventKind::Declare, node);
+            break;
+        }
+        case ASTNodeType::Assignment:
+            expression(static_cast<const AssignmentNode&>(node).getValue());
+            emit(FlowEventKind::Define, node);
+            break;
+        case ASTNodeType::Return:
+            expression(static_cast<const ReturnNode&>(node).getValue());
+            break;
+        case ASTNodeType::ExpressionStatement:
+            expression(static_cast<const ExpressionStatementNode&>(node).getExpression());
+            break;
+        default:
+            expression(&node); // branch condition
+            break;
+        }
+    }
+
+private:
+    void emit(FlowEventKind kind, const ASTNode& node)
+    {
+        if (const auto it = resolved_.find(&node); it != resolved_.end()) {
+            out_.push_back(FlowEvent{kind, it->second, &node});
+        }
+    }
+
+    void expression(const ASTNode* node)
+    {
+        if (!node) {
+            return;
+        }
+        switch (node->getType()) {
+        case ASTNodeType::Identifier:
+            emit(FlowEventKind::Use, *node);
+            break;
+        case ASTNodeType::UnaryOperation: {
+            const auto& unary = static_cast<const UnaryOperationNode&>(*node);
+            expression(unary.getOperand());
+            if (unary.getOperator() == "move" && unary.getOperand()) {
+                emit(FlowEventKind::Move, *unary.getOperand());
+            }
+            break;
+        }
+        case ASTNodeType::BinaryOperation: {
+            const auto& binary = static_cast<const BinaryOperationNode&>(*node);
+            expression(binary.getLeft());
+            expression(binary.getRight());
+            break;
+        }
+        case ASTNodeType::CallExpression: {
+            const auto& call = static_cast<const CallExpressionNode&>(*node);
+            expression(call.getCallee());
+            for (const auto& arg : call.getArguments()) {
+                expression(arg.get());
+            }
+            break;
+        }
+        default:
+            break;
+        }
+    }
+
+    const std::unordered_map<const ASTNode*, SlotId>& resolved_;
+    std::vector<FlowEvent>& out_;
+};
+
+// Must-analysis: bit set = slot assigned on every path.
+void checkDefiniteAssignment(const FunctionFlow& flow, std::vector<FlowIssue>& issues)
+{
+    const auto& cfg = flow.cfg();
+    GenKillProblem problem(flow.slots().size(), DataflowMeet::Intersect, cfg.blocks().size());
+    for (SlotId slot = 0; slot < flow.slots().size(); ++slot) {
+        if (flow.slots()[slot].parameter) {
+            problem.boundary.set(slot);
+        }
+    }
+    for (const auto& block : cfg.blocks()) {
+        for (const auto& event : flow.events(block.id)) {
+            if (event.kind == FlowEventKind::Define) {
+                problem.generates(block.id, event.slot);
+            } else if (event.kind == FlowEventKind::Declare) {
+                problem.kills(block.id, event.slot);
+            }
+        }
+    }
+
+    const auto in = solveForward(cfg, problem);
+    BitVector reported(problem.bits);
+    for (const auto& block : cfg.blocks()) {
+        if (!cfg.isReachable(block.id)) {
+            continue;
+        }
+        BitVector state = in[block.id];
+        for (const auto& event : flow.events(block.id)) {
+            if (event.kind == FlowEventKind::Use && !state.test(event.slot) && !reported.test(event.slot)) {
+                reported.set(event.slot);
+                issues.push_back(FlowIssue{
+                    "Variable '" + flow.slots()[event.slot].name + "' may be used before it is assigned",
+                    event.node});
+            } else if (event.kind == FlowEventKind::Define) {
+                state.set(event.slot);
+            } else if (event.kind == FlowEventKind::Declare) {
+                state.reset(event.slot);
+            }
+        }
+    }
+}
+
+} // namespace
+
+FunctionFlow::FunctionFlow(const FunctionNode& function)
+    : function_(function), cfg_(ControlFlowGraph::build(function))
+{
+    SlotResolver(slots_, resolved_).function(function);
+
+    events_.resize(cfg_.blocks().size());
+    for (const auto& block : cfg_.blocks()) {
+        EventCollector collector(resolved_, events_[block.id]);
+        for (const auto* element : block.elements) {
+            collector.element(*element);
+        }
+    }
+}
+
+SlotId FunctionFlow::slotOf(const ASTNode& node) const
+{
+    const auto it = resolved_.find(&node);
+    return it != resolved_.end() ? it->second : kNoSlot;
+}
+
+std::vector<FlowIssue> checkFunctionFlow(const FunctionFlow& flow, bool requiresReturn)
+{
+    std::vector<FlowIssue> issues;
+    checkDefiniteAssignment(flow, issues);
+    if (requiresReturn && flow.cfg().fallsOffEnd()) {
+        issues.push_back(FlowIssue{
+            "Function '" + flow.function().getName() + "' with non-void return type must return a value",
+            &flow.function()});
+    }
+    return issues;
+}
+
+} // namespace istudio::semantic
@@ -0,0 +1,332 @@
+#include "semantic/OwnershipAnalysis.h"
+
+#include "semantic/Dataflow.h"
+
+#include <algorithm>
+#include <map>
+#include <unordered_map>
+#include <utility>
+#include <string_view>
+
+namespace istudio::semantic {
+
+namespace {
+
+// Copying these is as cheap as moving them, so their last uses are not recorded.
+bool isTriviallyCopyable(std::string_view typeName)
+{
+    constexpr std::string_view kScalars[] = {"int", "float", "double", "bool", "char", "byte", "number"};
+    return std::find(std::begin(kScalars), std::end(kScalars), typeName) != std::end(kScalars);
+}
+
+// Identifier operands of CFG elements. Sinks hand their value over to a new owner:
+// call arguments and the right-hand side of declarations and assignments. Only
+// these are worth moving, and only when no other read in the same element sees
+// the value, since C++ leaves the order of evaluating arguments open.
+struct Operands {
+    std::unordered_set<const ASTNode*> sinks;
+    std::unordered_map<const ASTNode*, const ASTNode*> elementOf; // identifier -> element
+};
+
+void collectOperands(const ASTNode* node, const ASTNode* element, Operands& operands)
+{
+    if (!node) {
+        return;
+    }
+    const auto sink = [&](const ASTNode* value) {
+        if (value && value->getType() == ASTNodeType::Identifier) {
+            operands.sinks.insert(value);
+        }
+    };
+    switch (node->getType()) {
+    case ASTNodeType::Identifier:
+        operands.elementOf.emplace(node, element);
+        break;
+    case ASTNodeType::VariableDeclaration: {
+        const auto* init = static_cast<const VariableDeclarationNode*>(node)->getInitializer();
+        sink(init);
+        collectOperands(init, element, operands);
+        break;
+    }
+    case ASTNodeType::Assignment: {
+        const auto* value = static_cast<const AssignmentNode*>(node)->getValue();
+        sink(value);
+        collectOperands(value, element, operands);
+        break;
+    }
+    case ASTNodeType::Return:
+        collectOperands(static_cast<const ReturnNode*>(node)->getValue(), element, operands);
+        break;
+    case ASTNodeType::ExpressionStatement:
+        collectOperands(static_cast<const ExpressionStatementNode*>(node)->getExpression(), element, operands);
+        break;
+    case ASTNodeType::BinaryOperation: {
+        const auto* binary = static_cast<const BinaryOperationNode*>(node);
+        collectOperands(binary->getLeft(), element, operands);
+        collectOperands(binary->getRight(), element, operands);
+        break;
+    }
+    case ASTNodeType::UnaryOperation:
+        collectOperands(static_cast<const UnaryOperationNode*>(node)->getOperand(), element, operands);
+        break;
+    case ASTNodeType::CallExpression:
+        for (const auto& arg : static_cast<const CallExpressionNode*>(node)->getArguments()) {
+            sink(arg.get());
+            collectOperands(arg.get(), element, operands);
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+const ASTNode* assignedValue(const ASTNode& node)
+{
+    if (node.getType() == ASTNodeType::VariableDeclaration) {
+        return static_cast<const VariableDeclarationNode&>(node).getInitializer();
+    }
+    if (node.getType() == ASTNodeType::Assignment) {
+        return static_cast<const AssignmentNode&>(node).getValue();
+    }
+    return nullptr;
+}
+
+class OwnershipChecker {
+public:
+    OwnershipChecker(const FunctionFlow& flow, OwnershipFacts& facts, std::vector<FlowIssue>& issues)
+        : flow_(flow), cfg_(flow.cfg()), facts_(facts), issues_(issues)
+    {
+    }
+
+    void run()
+    {
+        collectTracked();
+        if (tracked_.empty()) {
+            return;
+        }
+        solveLiveness();
+        checkMoves();
+        recordLastUses();
+    }
+
+private:
+    const LocalSlot& slotOfBit(std::size_t bit) const { return flow_.slots()[tracked_[bit]]; }
+
+    std::size_t track(SlotId slot)
+    {
+        if (bitOf_[slot] == kNoSlot) {
+            bitOf_[slot] = static_cast<SlotId>(tracked_.size());
+            tracked_.push_back(slot);
+            borrowers_.emplace_back();
+        }
+        return bitOf_[slot];
+    }
+
+    // Owned slots, plus borrowed/ref locals bound to an owned slot.
+    void collectTracked()
+    {
+        const auto& slots = flow_.slots();
+        bitOf_.assign(slots.size(), kNoSlot);
+        for (SlotId slot = 0; slot < slots.size(); ++slot) {
+            if (slots[slot].ownership == OwnershipKind::Owned) {
+                track(slot);
+            }
+        }
+        if (tracked_.empty()) {
+            return;
+        }
+
+        for (const auto& block : cfg_.blocks()) {
+            for (const auto& event : flow_.events(block.id)) {
+                const auto ownership = slots[event.slot].ownership;
+                if (event.kind != FlowEventKind::Define ||
+                    (ownership != OwnershipKind::Borrowed && ownership != OwnershipKind::Reference)) {
+                    continue;
+                }
+                const ASTNode* value = assignedValue(*event.node);
+                const SlotId owner = value ? flow_.slotOf(*value) : kNoSlot;
+                if (owner != kNoSlot && slots[owner].ownership == OwnershipKind::Owned) {
+                    const auto borrower = static_cast<SlotId>(track(event.slot));
+                    auto& list = borrowers_[bitOf_[owner]];
+                    if (std::find(list.begin(), list.end(), borrower) == list.end()) {
+                        list.push_back(borrower);
+                    }
+                }
+            }
+        }
+
+        // Sparse event lists: tracked slots only, renumbered to bit indices.
+        events_.resize(cfg_.blocks().size());
+        for (const auto& block : cfg_.blocks()) {
+            for (const auto& event : flow_.events(block.id)) {
+                if (bitOf_[event.slot] != kNoSlot) {
+                    events_[block.id].push_back(FlowEvent{event.kind, bitOf_[event.slot], event.node});
+                }
+            }
+            for (const auto* element : block.elements) {
+                collectOperands(element, element, operands_);
+            }
+        }
+    }
+
+    // Backward may-analysis: bit set = value may still be read later.
+    void solveLiveness()
+    {
+        GenKillProblem problem(tracked_.size(), DataflowMeet::Union, cfg_.blocks().size());
+        for (const auto& block : cfg_.blocks()) {
+            const auto& events = events_[block.id];
+            for (auto it = events.rbegin(); it != events.rend(); ++it) {
+                if (it->kind == FlowEventKind::Use) {
+                    problem.generates(block.id, it->slot);
+                } else {
+                    problem.kills(block.id, it->slot); // written, declared or moved out
+                }
+            }
+        }
+        liveOut_ = solveBackward(cfg_, problem);
+    }
+
+    // Liveness right after each event of `block`.
+    std::vector<BitVector> liveAfterEvents(BlockId block) const
+    {
+        const auto& events = events_[block];
+        std::vector<BitVector> after(events.size());
+        BitVector live = liveOut_[block];
+        for (std::size_t i = events.size(); i-- > 0;) {
+            after[i] = live;
+            if (events[i].kind == FlowEventKind::Use) {
+                live.set(events[i].slot);
+            } else {
+                live.reset(events[i].slot);
+            }
+        }
+        return after;
+    }
+
+    bool hasLiveBorrower(std::size_t owner, const BitVector& live, std::size_t* borrower = nullptr) const
+    {
+        for (const SlotId candidate : borrowers_[owner]) {
+            if (live.test(candidate)) {
+                if (borrower) {
+                    *borrower = candidate;
+                }
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Forward may-analysis: bit set = value moved out on some path.
+    void checkMoves()
+    {
+        GenKillProblem problem(tracked_.size(), DataflowMeet::Union, cfg_.blocks().size());
+        for (const auto& block : cfg_.blocks()) {
+            for (const auto& event : events_[block.id]) {
+                if (event.kind == FlowEventKind::Move) {
+                    problem.generates(block.id, event.slot);
+                } else if (event.kind != FlowEventKind::Use) {
+                    problem.kills(block.id, event.slot); // reassigned or redeclared
+                }
+            }
+        }
+        const auto in = solveForward(cfg_, problem);
+
+        BitVector reported(tracked_.size());
+        for (const auto& block : cfg_.blocks()) {
+            if (!cfg_.isReachable(block.id) || events_[block.id].empty()) {
+                continue;
+            }
+            const auto& events = events_[block.id];
+            std::vector<BitVector> liveAfter;
+            BitVector moved = in[block.id];
+            for (std::size_t i = 0; i < events.size(); ++i) {
+                const auto& event = events[i];
+                if (event.kind == FlowEventKind::Use) {
+                    if (moved.test(event.slot) && !reported.test(event.slot)) {
+                        reported.set(event.slot);
+                        issues_.push_back(FlowIssue{"Use of moved value: " + slotOfBit(event.slot).name, event.node});
+                    }
+                } else if (event.kind == FlowEventKind::Move) {
+                    if (!borrowers_[event.slot].empty()) {
+                        if (liveAfter.empty()) {
+                            liveAfter = liveAfterEvents(block.id);
+                        }
+                        std::size_t borrower = 0;
+                        if (hasLiveBorrower(event.slot, liveAfter[i], &borrower)) {
+                            issues_.push_back(FlowIssue{"Cannot move '" + slotOfBit(event.slot).name +
+                                                            "' while it is borrowed by '" +
+                                                            slotOfBit(borrower).name + "'",
+                                                        event.node});
+                        }
+                    }
+                    moved.set(event.slot);
+                } else {
+                    moved.reset(event.slot);
+                }
+            }
+        }
+    }
+
+    void recordLastUses()
+    {
+        for (const auto& block : cfg_.blocks()) {
+            if (!cfg_.isReachable(block.id)) {
+                continue;
+            }
+            const auto& events = events_[block.id];
+            std::map<std::pair<const ASTNode*, SlotId>, unsigned> readsInElement;
+            for (const auto& event : events) {
+                if (event.kind == FlowEventKind::Use) {
+                    ++readsInElement[{elementOf(*event.node), event.slot}];
+                }
+            }
+            BitVector live = liveOut_[block.id];
+            const ASTNode* explicitMove = nullptr;
+            for (auto it = events.rbegin(); it != events.rend(); ++it) {
+                const auto& slot = slotOfBit(it->slot);
+                if (it->kind == FlowEventKind::Move) {
+                    explicitMove = it->node; // its Use comes next; already a move
+                } else if (it->kind == FlowEventKind::Use) {
+                    if (it->node != explicitMove && !live.test(it->slot) && operands_.sinks.contains(it->node) &&
+                        readsInElement[{elementOf(*it->node), it->slot}] == 1 &&
+                        slot.ownership == OwnershipKind::Owned && !isTriviallyCopyable(slot.typeName) &&
+                        !hasLiveBorrower(it->slot, live)) {
+                        facts_.addLastUse(*it->node);
+                    }
+                    live.set(it->slot);
+                    continue;
+                }
+                live.reset(it->slot);
+            }
+        }
+    }
+
+    const ASTNode* elementOf(const ASTNode& identifier) const
+    {
+        const auto it = operands_.elementOf.find(&identifier);
+        return it != operands_.elementOf.end() ? it->second : nullptr;
+    }
+
+    const FunctionFlow& flow_;
+    const ControlFlowGraph& cfg_;
+    OwnershipFacts& facts_;
+    std::vector<FlowIssue>& issues_;
+
+    std::vector<SlotId> bitOf_;                  // slot -> bit, kNoSlot if untracked
+    std::vector<SlotId> tracked_;                // bit -> slot
+    std::vector<std::vector<SlotId>> borrowers_; // owner bit -> borrower bits
+    std::vector<std::vector<FlowEvent>> events_; // per block, slot fields hold bits
+    Operands operands_;
+    std::vector<BitVector> liveOut_;
+};
+
+} // namespace
+
+std::vector<FlowIssue> checkOwnership(const FunctionFlow& flow, OwnershipFacts& facts)
+{
+    std::vector<FlowIssue> issues;
+    OwnershipChecker(flow, facts, issues).run();
+    return issues;
+}
+
+} // namespace istudio::semantic
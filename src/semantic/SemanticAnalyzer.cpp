@@ -1,100 +1,309 @@
 #include "semantic/SemanticAnalyzer.h"
 
+#include "istudio/ThreadPool.h"
+#include "semantic/FlowAnalysis.h"
+#include "semantic/OwnershipAnalysis.h"
+
+#include <algorithm>
 #include <sstream>
 
 namespace istudio::semantic {
 
+namespace {
+
+// Binds the template parameters in `pattern` so that it matches `actual`. Returns false
+// and describes the clash in `conflict` if a parameter would be bound to two types.
+bool unify(const TypePtr& pattern, const TypePtr& actual, TypeBindings& bindings, std::string& conflict)
+{
+    if (!pattern || !actual || actual->name() == "any") {
+        return true;
+    }
+    if (pattern->kind() == TypeKind::Parameter) {
+        const auto [it, inserted] = bindings.try_emplace(pattern->name(), actual);
+        if (!inserted && it->second->name() != actual->name()) {
+            conflict = pattern->name() + ": " + it->second->name() + " and " + actual->name();
+            return false;
+        }
+        return true;
+    }
+    if (pattern->kind() == TypeKind::Generic && actual->kind() == TypeKind::Generic) {
+        const auto& expected = static_cast<const GenericType&>(*pattern).arguments();
+        const auto& given = static_cast<const GenericType&>(*actual).arguments();
+        if (static_cast<const GenericType&>(*pattern).base() == static_cast<const GenericType&>(*actual).base() &&
+            expected.size() == given.size()) {
+            for (std::size_t i = 0; i < expected.size(); ++i) {
+                if (!unify(expected[i], given[i], bindings, conflict)) {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+} // namespace
+
 SemanticAnalyzer::SemanticAnalyzer(SemanticOptions options)
-    : options_(options), globalScope_(std::make_shared<SymbolScope>()), currentScope_(globalScope_)
+    : options_(options), types_(std::make_shared<TypeContext>())
+{
+}
+
+SemanticAnalyzer::SemanticAnalyzer(const SemanticOptions& options,
+                                   std::shared_ptr<TypeContext> types,
+                                   std::shared_ptr<const ConstantEvaluator> evaluator,
+                                   const ScopedSymbolTable& globals)
+    : options_(options), types_(std::move(types)), evaluator_(std::move(evaluator)), scopes_(&globals)
+{
+}
+
+void SemanticAnalyzer::addLibrary(const ProgramNode& library, bool pure)
 {
+    libraries_.push_back(&library);
+    if (pure) {
+        pureLibraries_.push_back(&library);
+    }
+    cache_.clear(); // cached bodies saw the old global scope
 }
 
 bool SemanticAnalyzer::analyze(const ProgramNode& program, DiagnosticEngine& diagnostics)
 {
     diagnostics_ = &diagnostics;
     success_ = true;
-    globalScope_ = std::make_shared<SymbolScope>();
-    currentScope_ = globalScope_;
+    scopes_ = ScopedSymbolTable{};
+    annotations_.clear();
+    ownership_.clear();
+    constants_.clear();
+    templates_.clear();
+    globalScope_ = options_.recordScopes ? std::make_shared<SymbolScope>() : nullptr;
+    recordScope_ = globalScope_;
 
     visitProgram(program);
 
     diagnostics_ = nullptr;
-    currentScope_.reset();
+    recordScope_.reset();
     return success_;
 }
 
 void SemanticAnalyzer::visitProgram(const ProgramNode& node)
 {
+    // Phase 1: signatures. Libraries live in the outermost scope so that program
+    // functions shadow them instead of clashing.
+    for (const auto* library : libraries_) {
+        for (const auto& fn : library->getFunctions()) {
+            if (fn) {
+                declareFunction(static_cast<const FunctionNode&>(*fn), false);
+            }
+        }
+    }
+    scopes_.pushScope();
+
+    std::vector<const FunctionNode*> functions;
+    functions.reserve(node.getFunctions().size());
     for (const auto& fn : node.getFunctions()) {
-        if (!fn) {
-            continue;
+        if (fn) {
+            functions.push_back(static_cast<const FunctionNode*>(fn.get()));
+            declareFunction(*functions.back(), true);
+        }
+    }
+    recordLocalScope();
+
+    // Pure library functions the program does not shadow can run at compile time.
+    std::vector<std::string> programFunctions;
+    for (const auto* function : functions) {
+        programFunctions.push_back(function->getName());
+    }
+    auto evaluator = std::make_shared<ConstantEvaluator>();
+    for (const auto* library : pureLibraries_) {
+        evaluator->addPureLibrary(*library, programFunctions);
+    }
+    evaluator_ = std::move(evaluator);
+
+    // Phase 2: bodies, against the now frozen global scope. Unchanged bodies whose
+    // dependencies still resolve the same way are taken from the cache.
+    std::vector<const FunctionResult*> cached(functions.size());
+    std::vector<FunctionResult> results(functions.size());
+    std::vector<std::size_t> pending;
+    for (std::size_t index = 0; index < functions.size(); ++index) {
+        results[index].fingerprint = fingerprint(*functions[index]);
+        cached[index] = cache_.find(*functions[index], results[index].fingerprint);
+        if (cached[index] && !isReusable(*cached[index])) {
+            cached[index] = nullptr;
+        }
+        if (!cached[index]) {
+            pending.push_back(index);
+        }
+    }
+
+    // Record nodes are attached up front so the --emit-sema tree keeps source order.
+    if (recordScope_) {
+        for (std::size_t index = 0; index < functions.size(); ++index) {
+            if (cached[index]) {
+                recordScope_->adoptChild(cached[index]->record);
+            } else {
+                results[index].record = recordScope_->createChild();
+            }
         }
-        visitFunction(static_cast<const FunctionNode&>(*fn));
     }
+
+    const unsigned jobs = options_.jobs != 0 ? options_.jobs : std::max(1u, std::thread::hardware_concurrency());
+    ThreadPool pool(static_cast<unsigned>(std::min<std::size_t>(jobs, std::max<std::size_t>(pending.size(), 1))));
+    pool.parallelFor(pending.size(), [&](std::size_t item) {
+        auto& result = results[pending[item]];
+        SemanticAnalyzer worker(options_, types_, evaluator_, scopes_);
+        worker.diagnostics_ = &result.diagnostics;
+        worker.recordScope_ = result.record;
+        worker.visitFunction(*functions[pending[item]]);
+        // The worker's scopes are back at the frozen globals, so signatures are final.
+        for (const auto& name : worker.dependencies_) {
+            result.dependencies.push_back(FunctionDependency{name, worker.signatureOf(name)});
+        }
+        result.annotations = std::move(worker.annotations_);
+        result.ownership = std::move(worker.ownership_);
+        result.constants = std::move(worker.constants_);
+        result.templates = std::move(worker.templates_);
+        result.success = worker.success_;
+    });
+
+    for (std::size_t index = 0; index < functions.size(); ++index) {
+        const FunctionResult& result = cached[index] ? *cached[index] : results[index];
+        for (const auto& diagnostic : result.diagnostics.getDiagnostics()) {
+            diagnostics_->report(diagnostic.severity, diagnostic.message);
+        }
+        annotations_.merge(TypeAnnotations(result.annotations));
+        ownership_.merge(OwnershipFacts(result.ownership));
+        constants_.merge(ConstantTable(result.constants));
+        templates_.merge(result.templates);
+        success_ = success_ && result.success;
+    }
+
+    for (const std::size_t index : pending) {
+        cache_.store(*functions[index], std::move(results[index]));
+    }
+    cache_.retain(functions);
+    stats_ = AnalysisStats{pending.size(), functions.size() - pending.size()};
 }
 
-void SemanticAnalyzer::visitFunction(const FunctionNode& node)
+const Symbol* SemanticAnalyzer::lookupDependency(std::string_view name)
 {
-    TypePtr returnType = types_.getBuiltin(node.getReturnType());
-    if (!returnType && !node.getReturnType().empty()) {
-        report(DiagnosticSeverity::Error, "Unknown return type: " + node.getReturnType(), node);
-        returnType = types_.getBuiltin("void"); // fallback to void
+    const Symbol* symbol = scopes_.lookup(name);
+    // Only functions live in the global scope; locals never depend on it.
+    if (!symbol || symbol->kind == SymbolKind::Function) {
+        dependencies_.emplace(name);
     }
-    
-    Symbol symbol{node.getName(), SymbolKind::Function, returnType};
-    if (!currentScope_->declare(symbol)) {
+    return symbol;
+}
+
+std::string SemanticAnalyzer::signatureOf(std::string_view name) const
+{
+    const Symbol* symbol = scopes_.lookup(name);
+    if (!symbol) {
+        return {};
+    }
+    std::string signature = "function";
+    if (const auto* declaration = symbol->declaration) {
+        // Template calls infer their arguments from the written parameter types.
+        for (const auto& parameter : declaration->getTemplateParameters()) {
+            signature += ' ' + parameter.name;
+        }
+        signature += " (";
+        for (const auto& parameter : declaration->getParameters()) {
+            signature += parameter.type + ',';
+        }
+        signature += ')';
+    }
+    signature += " : ";
+    signature += symbol->type ? symbol->type->name() : "void";
+    if (evaluator_ && evaluator_->isPure(name)) {
+        signature += " pure"; // calls with constant arguments fold
+    }
+    return signature;
+}
+
+bool SemanticAnalyzer::isReusable(const FunctionResult& result) const
+{
+    return std::all_of(result.dependencies.begin(), result.dependencies.end(), [&](const FunctionDependency& dependency) {
+        return signatureOf(dependency.name) == dependency.signature;
+    });
+}
+
+void SemanticAnalyzer::declareFunction(const FunctionNode& node, bool reportErrors)
+{
+    TypePtr returnType = resolveReturnType(node);
+    if (!returnType) {
+        if (reportErrors) {
+            report(DiagnosticSeverity::Error, "Unknown return type: " + node.getReturnType(), node);
+        }
+        returnType = types_->getBuiltin("void"); // fallback to void
+    }
+
+    const Symbol function{node.getName(), SymbolKind::Function, returnType, OwnershipKind::Unknown, false, false, false, {}, &node};
+    if (!scopes_.declare(function) && reportErrors) {
         report(DiagnosticSeverity::Error, "Function redeclared: " + node.getName(), node);
     }
+}
+
+TypePtr SemanticAnalyzer::resolveReturnType(const FunctionNode& node)
+{
+    if (node.getReturnType().empty()) {
+        return types_->getBuiltin("void");
+    }
+    const TypeBindings bindings = templateBindings(node);
+    return types_->resolve(node.getReturnType(), &bindings);
+}
+
+TypePtr SemanticAnalyzer::resolveType(std::string_view spelling)
+{
+    return types_->resolve(spelling, &typeParameters_);
+}
+
+TypeBindings SemanticAnalyzer::templateBindings(const FunctionNode& node) const
+{
+    TypeBindings bindings;
+    for (const auto& parameter : node.getTemplateParameters()) {
+        bindings.emplace(parameter.name, std::make_shared<TypeParameter>(parameter.name));
+    }
+    return bindings;
+}
+
+void SemanticAnalyzer::visitFunction(const FunctionNode& node)
+{
+    // The signature was declared (and its return type diagnosed) by the signature pass.
+    TypePtr returnType = resolveReturnType(node);
+
+    // recordScope_ already points at this function's record node.
+    scopes_.pushScope();
+    typeParameters_ = templateBindings(node);
 
-    auto savedScope = currentScope_;
-    currentScope_ = currentScope_->createChild();
-    
     // Add parameters to scope with proper types
     for (const auto& param : node.getParameters()) {
-        TypePtr paramType = types_.getBuiltin(param.type);
+        TypePtr paramType = resolveType(param.type);
         if (!paramType) {
             report(DiagnosticSeverity::Error, "Unknown parameter type: " + param.type, node);
-            paramType = types_.getBuiltin("any"); // fallback
+            paramType = types_->getBuiltin("any"); // fallback
         }
         
-        Symbol paramSymbol{param.name, SymbolKind::Variable, paramType};
-        if (!currentScope_->declare(paramSymbol)) {
+        // Parameters are initialized by the caller
+        if (!scopes_.declare(Symbol{param.name, SymbolKind::Variable, paramType, ownershipOf(param.type), true})) {
             report(DiagnosticSeverity::Error, "Parameter redeclared: " + param.name, node);
         }
     }
 
-    // Check for missing returns in functions with non-void return type
-    if (returnType && returnType->name() != "void") {
-        hasReturnStatement_ = false;
-        if (const auto* body = node.getBody()) {
-            visit(*body);
-        }
-        
-        // If a non-void function doesn't have a guaranteed return statement,
-        // report it (this is a simplified check)
-        // In a full implementation, we'd need to check control flow paths
-        if (!hasReturnStatement_) {
-            // This is a basic check - in a full implementation we'd need to analyze all paths
-            // For now, we'll just look at the last statement in a simple block
-            if (const auto* bodyBlock = dynamic_cast<const BlockNode*>(node.getBody())) {
-                const auto& statements = bodyBlock->getStatements();
-                if (!statements.empty()) {
-                    const auto& lastStmt = statements.back();
-                    if (lastStmt->getType() != ASTNodeType::Return) {
-                        report(DiagnosticSeverity::Error, 
-                               "Function '" + node.getName() + "' with non-void return type must return a value", 
-                               node);
-                    }
-                }
-            }
-        }
-    } else {
-        if (const auto* body = node.getBody()) {
-            visit(*body);
-        }
+    if (const auto* body = node.getBody()) {
+        visit(*body);
+    }
+
+    // Return, assignment and move checks need control flow, not just the AST walk.
+    const FunctionFlow flow(node);
+    for (auto& issue : checkFunctionFlow(flow, returnType && returnType->name() != "void")) {
+        report(DiagnosticSeverity::Error, std::move(issue.message), *issue.node);
+    }
+    for (auto& issue : checkOwnership(flow, ownership_)) {
+        report(DiagnosticSeverity::Error, std::move(issue.message), *issue.node);
     }
 
-    currentScope_ = savedScope;
+    recordLocalScope();
+    scopes_.popScope();
+    typeParameters_.clear();
 }
 
 void SemanticAnalyzer::visitBlock(const BlockNode& node)
@@ -110,29 +319,34 @@ void SemanticAnalyzer::visitBlock(const BlockNode& node)
 
 void SemanticAnalyzer::visitVariableDeclaration(const VariableDeclarationNode& node)
 {
-    TypePtr declaredType = types_.getBuiltin(node.getTypeName());
+    TypePtr declaredType = resolveType(node.getTypeName());
     if (!declaredType && !node.getTypeName().empty()) {
         report(DiagnosticSeverity::Error, "Unknown variable type: " + node.getTypeName(), node);
-        declaredType = types_.getBuiltin("any"); // fallback
+        declaredType = types_->getBuiltin("any"); // fallback
     }
 
-    // Determine ownership based on type name or other cues
-    OwnershipKind ownership = OwnershipKind::Unknown;
-    if (node.getTypeName().find("owned") != std::string::npos) {
-        ownership = OwnershipKind::Owned;
-    } else if (node.getTypeName().find("borrowed") != std::string::npos) {
-        ownership = OwnershipKind::Borrowed;
-    } else if (node.getTypeName().find("ref") != std::string::npos) {
-        ownership = OwnershipKind::Reference;
+    const OwnershipKind ownership = ownershipOf(node.getTypeName());
+
+    // Untyped declarations (`let x = ...`) take the type of their initializer.
+    TypePtr initType;
+    if (const auto* init = node.getInitializer()) {
+        visit(*init);
+        initType = checkExpressionType(*init);
+    }
+    if (!declaredType) {
+        declaredType = initType ? initType : types_->getBuiltin("any");
     }
+    annotations_.set(node, declaredType);
 
-    Symbol symbol{node.getName(), SymbolKind::Variable, declaredType, ownership, false, false};
-    if (!currentScope_->declare(symbol)) {
+    Symbol* symbol = scopes_.declare(
+        Symbol{node.getName(), SymbolKind::Variable, declaredType, ownership, false, false, node.isConstant(), {}});
+    if (!symbol) {
         report(DiagnosticSeverity::Error, "Variable redeclared: " + node.getName(), node);
+    } else if (node.isConstant() && node.getInitializer()) {
+        symbol->constant = constantOf(*node.getInitializer());
     }
 
-    if (const auto* init = node.getInitializer()) {
-        TypePtr initType = checkExpressionType(*init);
+    if (node.getInitializer()) {
         if (declaredType && initType && declaredType->name() != initType->name() && 
             initType->name() != "null" && declaredType->name() != "any" && initType->name() != "any") {
             report(DiagnosticSeverity::Error, 
@@ -141,22 +355,29 @@ void SemanticAnalyzer::visitVariableDeclaration(const VariableDeclarationNode& n
         }
         
         // Mark the symbol as initialized
-        auto updatedSymbol = currentScope_->lookup(node.getName());
-        if (updatedSymbol) {
-            const_cast<Symbol*>(&updatedSymbol.value())->isInitialized = true;
+        if (symbol) {
+            symbol->isInitialized = true;
         }
     }
 }
 
 void SemanticAnalyzer::visitAssignment(const AssignmentNode& node)
 {
-    auto symbol = currentScope_->lookup(node.getVariable());
+    Symbol* symbol = scopes_.lookupWritable(node.getVariable());
     if (!symbol) {
-        report(DiagnosticSeverity::Error, "Assignment to undefined identifier: " + node.getVariable(), node);
+        if (lookupDependency(node.getVariable())) {
+            report(DiagnosticSeverity::Error, "Cannot assign to function: " + node.getVariable(), node);
+        } else {
+            report(DiagnosticSeverity::Error, "Assignment to undefined identifier: " + node.getVariable(), node);
+        }
         return;
     }
+    if (symbol->isConstant) {
+        report(DiagnosticSeverity::Error, "Cannot assign to constant: " + node.getVariable(), node);
+    }
 
     if (const auto* value = node.getValue()) {
+        visit(*value);
         TypePtr assignedType = checkExpressionType(*value);
         if (symbol->type && assignedType && 
             symbol->type->name() != assignedType->name() &&
@@ -167,11 +388,79 @@ void SemanticAnalyzer::visitAssignment(const AssignmentNode& node)
         }
         
         // Mark the symbol as initialized
-        const_cast<Symbol*>(&symbol.value())->isInitialized = true;
+        symbol->isInitialized = true;
     }
 }
 
 TypePtr SemanticAnalyzer::checkExpressionType(const ASTNode& expr)
+{
+    if (const TypePtr* cached = annotations_.find(expr)) {
+        return *cached;
+    }
+    TypePtr type = computeExpressionType(expr);
+    annotations_.set(expr, type);
+    if (auto value = foldConstant(expr)) {
+        constants_.set(expr, std::move(*value));
+    }
+    return type;
+}
+
+std::optional<ConstantValue> SemanticAnalyzer::constantOf(const ASTNode& expr) const
+{
+    if (expr.getType() == ASTNodeType::Literal) {
+        return parseLiteral(static_cast<const LiteralNode&>(expr).getValue());
+    }
+    if (const ConstantValue* value = constants_.find(expr)) {
+        return *value;
+    }
+    return std::nullopt;
+}
+
+std::optional<ConstantValue> SemanticAnalyzer::foldConstant(const ASTNode& expr) const
+{
+    switch (expr.getType()) {
+    case ASTNodeType::Identifier: {
+        const Symbol* symbol = scopes_.lookup(static_cast<const IdentifierNode&>(expr).getName());
+        return symbol ? symbol->constant : std::nullopt;
+    }
+    case ASTNodeType::UnaryOperation: {
+        const auto& unary = static_cast<const UnaryOperationNode&>(expr);
+        const auto operand = unary.getOperand() ? constantOf(*unary.getOperand()) : std::nullopt;
+        return operand ? evaluator_->unary(unary.getOperator(), *operand) : std::nullopt;
+    }
+    case ASTNodeType::BinaryOperation: {
+        const auto& binary = static_cast<const BinaryOperationNode&>(expr);
+        const auto left = binary.getLeft() ? constantOf(*binary.getLeft()) : std::nullopt;
+        const auto right = left && binary.getRight() ? constantOf(*binary.getRight()) : std::nullopt;
+        return right ? evaluator_->binary(binary.getOperator(), *left, *right) : std::nullopt;
+    }
+    case ASTNodeType::CallExpression: {
+        const auto& call = static_cast<const CallExpressionNode&>(expr);
+        const auto* callee = call.getCallee();
+        if (!callee || callee->getType() != ASTNodeType::Identifier) {
+            return std::nullopt;
+        }
+        const auto& name = static_cast<const IdentifierNode&>(*callee).getName();
+        const Symbol* symbol = scopes_.lookup(name);
+        if (!symbol || symbol->kind != SymbolKind::Function || !evaluator_->isPure(name)) {
+            return std::nullopt;
+        }
+        std::vector<ConstantValue> arguments;
+        for (const auto& arg : call.getArguments()) {
+            auto value = arg ? constantOf(*arg) : std::nullopt;
+            if (!value) {
+                return std::nullopt;
+            }
+            arguments.push_back(std::move(*value));
+        }
+        return evaluator_->call(name, arguments);
+    }
+    default:
+        return std::nullopt;
+    }
+}
+
+TypePtr SemanticAnalyzer::computeExpressionType(const ASTNode& expr)
 {
     switch (expr.getType()) {
     case ASTNodeType::Literal: {
@@ -179,32 +468,28 @@ TypePtr SemanticAnalyzer::checkExpressionType(const ASTNode& expr)
         // Determine literal type based on value
         const std::string& value = literal.getValue();
         if (value == "true" || value == "false") {
-            return types_.getBuiltin("bool");
+            return types_->getBuiltin("bool");
         } else if (value.find('.') != std::string::npos) {
-            return types_.getBuiltin("float");
+            return types_->getBuiltin("float");
         } else {
             // Try to parse as integer
             try {
                 std::stoi(value);
-                return types_.getBuiltin("int");
+                return types_->getBuiltin("int");
             } catch (...) {
-                return types_.getBuiltin("string");
+                return types_->getBuiltin("string");
             }
         }
     }
     case ASTNodeType::Identifier: {
         const auto& identifier = static_cast<const IdentifierNode&>(expr);
-        auto symbol = currentScope_->lookup(identifier.getName());
+        const Symbol* symbol = lookupDependency(identifier.getName());
         if (symbol) {
-            // Check if it's an owned value that's been moved
-            if (symbol->ownership == OwnershipKind::Owned && symbol->hasMoved) {
-                report(DiagnosticSeverity::Error, 
-                       "Use of moved value: " + identifier.getName(), expr);
-            }
+            // Moves are path-sensitive and checked on the CFG (FlowAnalysis).
             return symbol->type;
         } else {
             report(DiagnosticSeverity::Error, "Undefined identifier: " + identifier.getName(), expr);
-            return types_.getBuiltin("any");
+            return types_->getBuiltin("any");
         }
     }
     case ASTNodeType::BinaryOperation: {
@@ -212,40 +497,49 @@ TypePtr SemanticAnalyzer::checkExpressionType(const ASTNode& expr)
         TypePtr leftType = checkExpressionType(*binary.getLeft());
         TypePtr rightType = checkExpressionType(*binary.getRight());
         
+        const std::string& op = binary.getOperator();
+        const bool arithmetic = op == "+" || op == "-" || op == "*" || op == "/" || op == "%";
+        if (!arithmetic) {
+            return types_->getBuiltin("bool"); // comparison and logical ops return bool
+        }
+
         // For now, assume binary operation result type is same as operands if they match
         if (leftType && rightType && leftType->name() == rightType->name()) {
             return leftType;
         }
         // For arithmetic operations, result is usually int or float
-        const std::string& op = binary.getOperator();
-        if (op == "+" || op == "-" || op == "*" || op == "/") {
+        if (leftType && rightType) {
             if (leftType->name() == "float" || rightType->name() == "float") {
-                return types_.getBuiltin("float");
+                return types_->getBuiltin("float");
             }
-            return types_.getBuiltin("int");
+            return types_->getBuiltin("int");
         }
-        return types_.getBuiltin("bool"); // comparison ops return bool
+        return types_->getBuiltin("any");
     }
     case ASTNodeType::CallExpression: {
         const auto& call = static_cast<const CallExpressionNode&>(expr);
         if (const auto* callee = call.getCallee()) {
             if (callee->getType() == ASTNodeType::Identifier) {
                 const auto& calleeId = static_cast<const IdentifierNode&>(*callee);
-                auto symbol = currentScope_->lookup(calleeId.getName());
+                const Symbol* symbol = scopes_.lookup(calleeId.getName());
+                if (const auto* instance = templates_.find(call)) {
+                    return instance->returnType;
+                }
                 if (symbol && symbol->kind == SymbolKind::Function) {
                     // For now return the function's return type
                     return symbol->type;
                 }
             }
         }
-        return types_.getBuiltin("any");
+        return types_->getBuiltin("any");
     }
     case ASTNodeType::UnaryOperation: {
         const auto& unary = static_cast<const UnaryOperationNode&>(expr);
-        return checkExpressionType(*unary.getOperand());
+        TypePtr operandType = checkExpressionType(*unary.getOperand());
+        return unary.getOperator() == "!" ? types_->getBuiltin("bool") : operandType;
     }
     default:
-        return types_.getBuiltin("any");
+        return types_->getBuiltin("any");
     }
 }
 
@@ -288,22 +582,25 @@ void SemanticAnalyzer::visitUnary(const UnaryOperationNode& node)
 
 void SemanticAnalyzer::visitCall(const CallExpressionNode& node)
 {
+    const FunctionNode* callTemplate = nullptr;
     if (const auto* callee = node.getCallee()) {
-        visit(*callee);
-        
         // Check if the callee is an identifier (function name)
         if (callee->getType() == ASTNodeType::Identifier) {
             const auto& calleeId = static_cast<const IdentifierNode&>(*callee);
-            auto symbol = currentScope_->lookup(calleeId.getName());
+            const Symbol* symbol = lookupDependency(calleeId.getName());
             if (symbol && symbol->kind == SymbolKind::Function) {
-                // Check argument count and types match function parameters
-                if (symbol->type) {
-                    // For now, just check that it's a function call
-                    // More detailed function type checking would require proper function type info
+                if (symbol->declaration && symbol->declaration->isTemplate()) {
+                    callTemplate = symbol->declaration;
                 }
+                // Check argument count and types match function parameters
+                // More detailed function type checking would require proper function type info
+                annotations_.set(*callee, symbol->type);
             } else {
                 report(DiagnosticSeverity::Error, "Call to undefined function: " + calleeId.getName(), node);
+                annotations_.set(*callee, types_->getBuiltin("any"));
             }
+        } else {
+            visit(*callee);
         }
     }
     
@@ -312,6 +609,51 @@ void SemanticAnalyzer::visitCall(const CallExpressionNode& node)
             visit(*arg);
         }
     }
+
+    if (callTemplate) {
+        instantiateCall(node, *callTemplate);
+    }
+}
+
+void SemanticAnalyzer::instantiateCall(const CallExpressionNode& call, const FunctionNode& function)
+{
+    const auto& parameters = function.getParameters();
+    const auto& arguments = call.getArguments();
+    if (parameters.size() != arguments.size()) {
+        report(DiagnosticSeverity::Error,
+               "Call to template " + function.getName() + " expects " + std::to_string(parameters.size()) +
+                   " arguments, got " + std::to_string(arguments.size()),
+               call);
+        return;
+    }
+
+    // Template arguments are inferred from the argument types.
+    const TypeBindings pattern = templateBindings(function);
+    TypeBindings inferred;
+    for (std::size_t i = 0; i < parameters.size(); ++i) {
+        const TypePtr expected = types_->resolve(parameters[i].type, &pattern);
+        const TypePtr actual = arguments[i] ? checkExpressionType(*arguments[i]) : nullptr;
+        std::string conflict;
+        if (!unify(expected, actual, inferred, conflict)) {
+            report(DiagnosticSeverity::Error,
+                   "Conflicting types for template parameter " + conflict + " in call to " + function.getName(),
+                   call);
+            return;
+        }
+    }
+
+    std::vector<TypePtr> typeArguments;
+    for (const auto& parameter : function.getTemplateParameters()) {
+        const auto it = inferred.find(parameter.name);
+        if (it == inferred.end()) {
+            report(DiagnosticSeverity::Error,
+                   "Cannot infer template parameter " + parameter.name + " in call to " + function.getName(),
+                   call);
+            return;
+        }
+        typeArguments.push_back(it->second);
+    }
+    templates_.instantiate(call, function, std::move(typeArguments), types_->substitute(resolveReturnType(function), inferred));
 }
 
 void SemanticAnalyzer::visitReturn(const ReturnNode& node)
@@ -414,15 +756,17 @@ void SemanticAnalyzer::visit(const ASTNode& node)
         break;
     case ASTNodeType::BinaryOperation:
         visitBinary(static_cast<const BinaryOperationNode&>(node));
+        checkExpressionType(node);
         break;
     case ASTNodeType::UnaryOperation:
         visitUnary(static_cast<const UnaryOperationNode&>(node));
+        checkExpressionType(node);
         break;
     case ASTNodeType::CallExpression:
         visitCall(static_cast<const CallExpressionNode&>(node));
+        checkExpressionType(node);
         break;
     case ASTNodeType::Return:
-        hasReturnStatement_ = true;
         visitReturn(static_cast<const ReturnNode&>(node));
         break;
     case ASTNodeType::ExpressionStatement:
@@ -439,20 +783,35 @@ void SemanticAnalyzer::visit(const ASTNode& node)
         break;
     case ASTNodeType::Literal:
     case ASTNodeType::Identifier:
+        // Every expression is annotated on first visit so later phases never re-type it.
+        checkExpressionType(node);
         break;
     }
 }
 
 void SemanticAnalyzer::pushScope()
 {
-    currentScope_ = currentScope_->createChild();
+    scopes_.pushScope();
+    if (recordScope_) {
+        recordScope_ = recordScope_->createChild();
+    }
 }
 
 void SemanticAnalyzer::popScope()
 {
-    if (auto parent = currentScope_->parent()) {
-        currentScope_ = parent;
+    recordLocalScope();
+    if (recordScope_ && recordScope_->parent()) {
+        recordScope_ = recordScope_->parent();
+    }
+    scopes_.popScope();
+}
+
+void SemanticAnalyzer::recordLocalScope()
+{
+    if (!recordScope_) {
+        return;
     }
+    scopes_.forEachLocal([&](const Symbol& symbol) { recordScope_->declare(symbol); });
 }
 
 void SemanticAnalyzer::report(DiagnosticSeverity severity, std::string message, const ASTNode& node)
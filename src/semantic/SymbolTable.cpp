@@ -2,6 +2,57 @@
 
 namespace istudio::semantic {
 
+namespace {
+
+struct OwnershipQualifier {
+    std::string_view keyword;
+    OwnershipKind kind;
+};
+
+constexpr OwnershipQualifier kQualifiers[] = {
+    {"owned", OwnershipKind::Owned},
+    {"borrowed", OwnershipKind::Borrowed},
+    {"ref", OwnershipKind::Reference},
+};
+
+// Length of the qualifier prefix (`owned<` or `owned `), or 0.
+std::size_t qualifierLength(std::string_view typeName, const OwnershipQualifier& qualifier)
+{
+    const auto& keyword = qualifier.keyword;
+    if (typeName.size() > keyword.size() && typeName.starts_with(keyword) &&
+        (typeName[keyword.size()] == '<' || typeName[keyword.size()] == ' ')) {
+        return keyword.size() + 1;
+    }
+    return 0;
+}
+
+} // namespace
+
+OwnershipKind ownershipOf(std::string_view typeName)
+{
+    for (const auto& qualifier : kQualifiers) {
+        if (qualifierLength(typeName, qualifier) != 0) {
+            return qualifier.kind;
+        }
+    }
+    return OwnershipKind::Unknown;
+}
+
+std::string_view stripOwnership(std::string_view typeName)
+{
+    for (const auto& qualifier : kQualifiers) {
+        if (const std::size_t length = qualifierLength(typeName, qualifier)) {
+            const bool angled = typeName[length - 1] == '<';
+            typeName.remove_prefix(length);
+            if (angled && typeName.ends_with('>')) {
+                typeName.remove_suffix(1);
+            }
+            return typeName;
+        }
+    }
+    return typeName;
+}
+
 SymbolScope::SymbolScope(Ptr parent)
     : parent_(std::move(parent))
 {
@@ -14,34 +65,118 @@ SymbolScope::Ptr SymbolScope::createChild()
     return child;
 }
 
+void SymbolScope::adoptChild(Ptr child)
+{
+    child->parent_ = shared_from_this();
+    children_.push_back(std::move(child));
+}
+
 bool SymbolScope::declare(Symbol symbol)
 {
     auto [it, inserted] = symbols_.emplace(symbol.name, std::move(symbol));
+    if (inserted) {
+        index_.emplace(it->first, &it->second);
+    }
     return inserted;
 }
 
-std::optional<Symbol> SymbolScope::lookupLocal(const std::string& name) const
+const Symbol* SymbolScope::lookupLocal(std::string_view name) const
 {
-    auto it = symbols_.find(name);
-    if (it != symbols_.end()) {
-        return it->second;
-    }
-    return std::nullopt;
+    auto it = index_.find(name);
+    return it != index_.end() ? it->second : nullptr;
 }
 
-std::optional<Symbol> SymbolScope::lookup(const std::string& name) const
+const Symbol* SymbolScope::lookup(std::string_view name) const
 {
-    const SymbolScope* current = this;
-    std::shared_ptr<const SymbolScope> holder = shared_from_this();
-    while (current) {
-        auto it = current->symbols_.find(name);
-        if (it != current->symbols_.end()) {
-            return it->second;
+    // Parents outlive their children, so raw pointers are enough for the walk.
+    for (const SymbolScope* current = this; current; current = current->parent_.get()) {
+        if (const Symbol* symbol = current->lookupLocal(name)) {
+            return symbol;
         }
-        holder = current->parent_;
-        current = holder.get();
     }
-    return std::nullopt;
+    return nullptr;
+}
+
+ScopedSymbolTable::ScopedSymbolTable(const ScopedSymbolTable* enclosing)
+    : enclosing_(enclosing)
+{
+    // The outermost (global) scope is always present.
+    scopeMarks_.push_back(0);
+}
+
+void ScopedSymbolTable::pushScope()
+{
+    scopeMarks_.push_back(static_cast<std::uint32_t>(bindings_.size()));
+}
+
+void ScopedSymbolTable::popScope()
+{
+    if (scopeMarks_.size() <= 1) {
+        return;
+    }
+
+    const std::uint32_t mark = scopeMarks_.back();
+    scopeMarks_.pop_back();
+    while (bindings_.size() > mark) {
+        const Binding& binding = bindings_.back();
+        heads_[binding.name] = binding.shadowed;
+        bindings_.pop_back();
+    }
+}
+
+Symbol* ScopedSymbolTable::declare(Symbol symbol)
+{
+    const NameId id = intern(symbol.name);
+    const std::uint32_t head = heads_[id];
+    if (head != kNoBinding && head >= scopeMarks_.back()) {
+        return nullptr;
+    }
+
+    heads_[id] = static_cast<std::uint32_t>(bindings_.size());
+    return &bindings_.emplace_back(Binding{std::move(symbol), id, head}).symbol;
+}
+
+const Symbol* ScopedSymbolTable::lookupLocal(std::string_view name) const
+{
+    const std::uint32_t index = find(name);
+    if (index != kNoBinding && index >= scopeMarks_.back()) {
+        return &bindings_[index].symbol;
+    }
+    return nullptr;
+}
+
+const Symbol* ScopedSymbolTable::lookup(std::string_view name) const
+{
+    const std::uint32_t index = find(name);
+    if (index != kNoBinding) {
+        return &bindings_[index].symbol;
+    }
+    return enclosing_ ? enclosing_->lookup(name) : nullptr;
+}
+
+Symbol* ScopedSymbolTable::lookupWritable(std::string_view name)
+{
+    const std::uint32_t index = find(name);
+    return index != kNoBinding ? &bindings_[index].symbol : nullptr;
+}
+
+ScopedSymbolTable::NameId ScopedSymbolTable::intern(std::string_view name)
+{
+    if (auto it = ids_.find(name); it != ids_.end()) {
+        return it->second;
+    }
+
+    const auto id = static_cast<NameId>(names_.size());
+    const std::string& stored = names_.emplace_back(name);
+    ids_.emplace(stored, id);
+    heads_.push_back(kNoBinding);
+    return id;
+}
+
+std::uint32_t ScopedSymbolTable::find(std::string_view name) const
+{
+    auto it = ids_.find(name);
+    return it != ids_.end() ? heads_[it->second] : kNoBinding;
 }
 
 } // namespace istudio::semantic
@@ -1,5 +1,7 @@
 #include "semantic/Type.h"
 
+#include <cctype>
+
 namespace istudio::semantic {
 
 FunctionType::FunctionType(TypePtr returnType, std::vector<TypePtr> parameters)
@@ -22,6 +24,8 @@ TypeContext::TypeContext()
     builtins_.emplace("bytes", std::make_shared<BuiltinType>("bytes"));
     builtins_.emplace("list", std::make_shared<BuiltinType>("list"));
     builtins_.emplace("dict", std::make_shared<BuiltinType>("dict"));
+
+    templates_ = {{"list", 1}, {"set", 1}, {"matrix", 1}, {"Optional", 1}, {"Result", 1}, {"dict", 2}, {"tuple", 0}};
 }
 
 TypePtr TypeContext::getBuiltin(std::string_view name) const
@@ -33,6 +37,142 @@ TypePtr TypeContext::getBuiltin(std::string_view name) const
     return nullptr;
 }
 
+namespace {
+
+void skipSpaces(std::string_view& text)
+{
+    while (!text.empty() && std::isspace(static_cast<unsigned char>(text.front()))) {
+        text.remove_prefix(1);
+    }
+}
+
+} // namespace
+
+TypePtr TypeContext::resolve(std::string_view spelling, const TypeBindings* bindings)
+{
+    TypePtr type = resolveSpelling(spelling, bindings);
+    skipSpaces(spelling);
+    return spelling.empty() ? type : nullptr;
+}
+
+// type = [qualifier] name [ "<" type { "," type } ">" ] [ "?" ], consuming from `spelling`
+TypePtr TypeContext::resolveSpelling(std::string_view& spelling, const TypeBindings* bindings)
+{
+    skipSpaces(spelling);
+    std::size_t length = 0;
+    while (length < spelling.size() &&
+           (std::isalnum(static_cast<unsigned char>(spelling[length])) || spelling[length] == '_')) {
+        ++length;
+    }
+    if (length == 0) {
+        return nullptr;
+    }
+    const std::string name(spelling.substr(0, length));
+    spelling.remove_prefix(length);
+    skipSpaces(spelling);
+
+    TypePtr type;
+    if (name == "owned" || name == "borrowed" || name == "ref") {
+        // owned<T> / owned T: ownership is tracked on the symbol, not the type
+        const bool angled = spelling.starts_with('<');
+        if (angled) {
+            spelling.remove_prefix(1);
+        }
+        type = resolveSpelling(spelling, bindings);
+        skipSpaces(spelling);
+        if (angled && !spelling.starts_with('>')) {
+            return nullptr;
+        }
+        if (angled) {
+            spelling.remove_prefix(1);
+        }
+    } else if (spelling.starts_with('<')) {
+        spelling.remove_prefix(1);
+        std::vector<TypePtr> arguments;
+        while (true) {
+            TypePtr argument = resolveSpelling(spelling, bindings);
+            if (!argument) {
+                return nullptr;
+            }
+            arguments.push_back(std::move(argument));
+            skipSpaces(spelling);
+            if (spelling.starts_with(',')) {
+                spelling.remove_prefix(1);
+                continue;
+            }
+            if (!spelling.starts_with('>')) {
+                return nullptr;
+            }
+            spelling.remove_prefix(1);
+            break;
+        }
+        type = instantiate(name, std::move(arguments));
+    } else if (bindings && bindings->contains(name)) {
+        type = bindings->at(name);
+    } else {
+        type = getBuiltin(name);
+    }
+
+    skipSpaces(spelling);
+    if (type && spelling.starts_with('?')) {
+        spelling.remove_prefix(1);
+        type = instantiate("Optional", {type});
+    }
+    return type;
+}
+
+TypePtr TypeContext::instantiate(std::string_view base, std::vector<TypePtr> arguments)
+{
+    const auto it = templates_.find(std::string{base});
+    if (it == templates_.end() || arguments.empty() || (it->second != 0 && it->second != arguments.size())) {
+        return nullptr;
+    }
+
+    std::string name{base};
+    name += '<';
+    for (std::size_t i = 0; i < arguments.size(); ++i) {
+        if (!arguments[i]) {
+            return nullptr;
+        }
+        name += (i > 0 ? ", " : "") + arguments[i]->name();
+    }
+    name += '>';
+
+    std::lock_guard lock(instancesMutex_);
+    auto& instance = instances_[name];
+    if (!instance) {
+        instance = std::make_shared<GenericType>(name, std::string{base}, std::move(arguments));
+    }
+    return instance;
+}
+
+TypePtr TypeContext::substitute(const TypePtr& type, const TypeBindings& bindings)
+{
+    if (!type) {
+        return type;
+    }
+    if (type->kind() == TypeKind::Parameter) {
+        const auto it = bindings.find(type->name());
+        return it != bindings.end() ? it->second : type;
+    }
+    if (type->kind() == TypeKind::Generic) {
+        const auto& generic = static_cast<const GenericType&>(*type);
+        std::vector<TypePtr> arguments;
+        arguments.reserve(generic.arguments().size());
+        for (const auto& argument : generic.arguments()) {
+            arguments.push_back(substitute(argument, bindings));
+        }
+        return instantiate(generic.base(), std::move(arguments));
+    }
+    return type;
+}
+
+std::size_t TypeContext::instantiationCount() const
+{
+    std::lock_guard lock(instancesMutex_);
+    return instances_.size();
+}
+
 TypePtr TypeContext::getOrCreatePointer(TypePtr pointee, std::string decoration)
 {
     for (const auto& existing : pointers_) {
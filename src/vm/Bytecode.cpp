@@ -0,0 +1,79 @@
+#include "vm/Bytecode.h"
+
+#include "vm/Intrinsics.h"
+
+#include <iomanip>
+
+namespace istudio::vm {
+
+const char* toString(Opcode op)
+{
+    switch (op) {
+#define ISTUDIO_VM_NAME(name) \
+    case Opcode::name: return #name;
+        ISTUDIO_VM_OPCODES(ISTUDIO_VM_NAME)
+#undef ISTUDIO_VM_NAME
+    }
+    return "?";
+}
+
+void disassemble(const Program& program, std::ostream& out)
+{
+    for (const Function& function : program.functions) {
+        out << "function " << function.name << " (params " << function.params << ", registers "
+            << function.registers << ")\n";
+        for (std::size_t i = 0; i < function.constants.size(); ++i) {
+            const Value& constant = function.constants[i];
+            out << "  k" << i << " = " << typeName(constant) << ' ';
+            if (std::holds_alternative<std::string>(constant)) {
+                out << std::quoted(std::get<std::string>(constant)) << '\n';
+            } else {
+                out << toString(constant) << '\n';
+            }
+        }
+        for (std::size_t pc = 0; pc < function.code.size(); ++pc) {
+            const Instruction& instruction = function.code[pc];
+            out << std::setw(5) << pc << ": " << toString(instruction.op);
+            switch (instruction.op) {
+            case Opcode::LoadK:
+                out << " r" << instruction.a << ", k" << instruction.bx();
+                break;
+            case Opcode::Jump:
+                out << ' ' << instruction.bx();
+                break;
+            case Opcode::JumpIf:
+            case Opcode::JumpIfNot:
+                out << " r" << instruction.a << ", " << instruction.bx();
+                break;
+            case Opcode::Call:
+            case Opcode::TailCall: {
+                const CallSite& call = function.calls[instruction.bx()];
+                const std::string_view callee = call.intrinsic ? intrinsics()[call.callee].name
+                                                               : std::string_view(program.functions[call.callee].name);
+                if (instruction.op == Opcode::Call) {
+                    out << " r" << instruction.a << ',';
+                }
+                out << ' ' << (call.intrinsic ? "native " : "") << callee << "(r" << call.firstArg << ", "
+                    << call.argCount << ')';
+                break;
+            }
+            case Opcode::Return:
+                out << " r" << instruction.a;
+                break;
+            case Opcode::ReturnVoid:
+                break;
+            case Opcode::Move:
+            case Opcode::Neg:
+            case Opcode::Not:
+                out << " r" << instruction.a << ", r" << instruction.b;
+                break;
+            default:
+                out << " r" << instruction.a << ", r" << instruction.b << ", r" << instruction.c;
+                break;
+            }
+            out << '\n';
+        }
+    }
+}
+
+} // namespace istudio::vm
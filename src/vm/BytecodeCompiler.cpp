@@ -0,0 +1,473 @@
+#include "vm/BytecodeCompiler.h"
+
+#include "ir/Liveness.h"
+#include "vm/Intrinsics.h"
+
+#include <algorithm>
+#include <limits>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace istudio::vm {
+
+namespace {
+
+using ir::IRBasicBlock;
+using ir::IRFunction;
+using ir::IRInstruction;
+using ir::IRInstructionOp;
+using ir::IRType;
+using ir::IRValue;
+using ir::IRValueKind;
+
+constexpr std::uint32_t kMaxRegisters = std::numeric_limits<std::uint16_t>::max();
+
+struct CompileError {
+    std::string message;
+};
+
+std::optional<Opcode> binaryOpcode(IRInstructionOp op, bool integers)
+{
+    switch (op) {
+    case IRInstructionOp::Add: return integers ? Opcode::AddI : Opcode::Add;
+    case IRInstructionOp::Sub: return integers ? Opcode::SubI : Opcode::Sub;
+    case IRInstructionOp::Mul: return integers ? Opcode::MulI : Opcode::Mul;
+    case IRInstructionOp::Div: return Opcode::Div;
+    case IRInstructionOp::Rem: return Opcode::Rem;
+    case IRInstructionOp::And: return Opcode::And;
+    case IRInstructionOp::Or: return Opcode::Or;
+    case IRInstructionOp::Xor: return Opcode::Xor;
+    case IRInstructionOp::Shl: return Opcode::Shl;
+    case IRInstructionOp::Shr: return Opcode::Shr;
+    case IRInstructionOp::Eq: return integers ? Opcode::EqI : Opcode::Eq;
+    case IRInstructionOp::Ne: return integers ? Opcode::NeI : Opcode::Ne;
+    case IRInstructionOp::Lt: return integers ? Opcode::LtI : Opcode::Lt;
+    case IRInstructionOp::Le: return integers ? Opcode::LeI : Opcode::Le;
+    case IRInstructionOp::Gt: return integers ? Opcode::GtI : Opcode::Gt;
+    case IRInstructionOp::Ge: return integers ? Opcode::GeI : Opcode::Ge;
+    default: return std::nullopt;
+    }
+}
+
+Value toValue(const ir::IRConstantValue& constant)
+{
+    return std::visit([](const auto& v) -> Value { return v; }, constant);
+}
+
+// Values that are written to a register of their own: arguments and the results
+// of instructions. Constants are loaded separately.
+bool isAllocated(const IRValue* value)
+{
+    if (value->getKind() == IRValueKind::Argument) {
+        return true;
+    }
+    if (value->getKind() != IRValueKind::Instruction) {
+        return false;
+    }
+    const auto* inst = static_cast<const IRInstruction*>(value);
+    return inst->getType() != IRType::Void || inst->getOp() == IRInstructionOp::Phi;
+}
+
+// Positions in the code where a value is held, as the hull of its definition, its
+// uses and the blocks it is live through.
+struct LiveRange {
+    std::uint32_t start{std::numeric_limits<std::uint32_t>::max()};
+    std::uint32_t end{0};
+
+    void cover(std::uint32_t position)
+    {
+        start = std::min(start, position);
+        end = std::max(end, position);
+    }
+    bool empty() const { return start == std::numeric_limits<std::uint32_t>::max(); }
+};
+
+// Instructions are numbered in block layout order: each block gets a slot for its
+// Phis, then two per instruction, and ends one past its terminator. A Phi operand
+// is used at the end of its incoming block, where the edge copies run.
+std::vector<LiveRange> liveRanges(const IRFunction& function)
+{
+    ir::FunctionAnalyses analyses(function);
+    const ir::Liveness& liveness = analyses.get<ir::LivenessAnalysis>();
+    const std::size_t valueCount = function.getValueCount();
+
+    struct Span {
+        std::uint32_t start{0};
+        std::uint32_t end{0};
+    };
+    std::unordered_map<const IRBasicBlock*, Span> spans;
+    std::uint32_t position = 0;
+    for (const IRBasicBlock& block : function.getBasicBlocks()) {
+        Span& span = spans[&block];
+        span.start = position;
+        position += 2;
+        for (const IRInstruction& inst : block) {
+            if (inst.getOp() != IRInstructionOp::Phi) {
+                position += 2;
+            }
+        }
+        span.end = position - 1;
+        position += 1;
+    }
+
+    std::vector<LiveRange> ranges(valueCount);
+    for (const ir::IRArgument* argument : function.getArguments()) {
+        ranges[argument->getId()].cover(0);
+    }
+    for (const IRBasicBlock& block : function.getBasicBlocks()) {
+        const Span span = spans.at(&block);
+        std::uint32_t at = span.start + 2;
+        for (const IRInstruction& inst : block) {
+            if (inst.getOp() == IRInstructionOp::Phi) {
+                ranges[inst.getId()].cover(span.start);
+                for (std::size_t i = 0; i < inst.getNumOperands(); ++i) {
+                    const IRValue* operand = inst.getOperand(i);
+                    const auto incoming = spans.find(inst.getBlocks()[i]);
+                    if (isAllocated(operand) && incoming != spans.end()) {
+                        ranges[operand->getId()].cover(incoming->second.end);
+                    }
+                }
+                continue;
+            }
+            if (isAllocated(&inst)) {
+                ranges[inst.getId()].cover(at);
+            }
+            for (std::size_t i = 0; i < inst.getNumOperands(); ++i) {
+                if (isAllocated(inst.getOperand(i))) {
+                    ranges[inst.getOperand(i)->getId()].cover(at);
+                }
+            }
+            at += 2;
+        }
+        const auto& liveIn = liveness.liveIn(block);
+        const auto& liveOut = liveness.liveOut(block);
+        for (unsigned id = 0; id < valueCount; ++id) {
+            if (id < liveIn.size() && liveIn[id]) {
+                ranges[id].cover(span.start);
+            }
+            if (id < liveOut.size() && liveOut[id]) {
+                ranges[id].cover(span.end);
+            }
+        }
+    }
+    return ranges;
+}
+
+class FunctionCompiler {
+public:
+    FunctionCompiler(const IRFunction& source, Function& target, const Program& program)
+        : source_(source), target_(target), program_(program), registers_(source.getValueCount(), kNone)
+    {
+    }
+
+    void compile()
+    {
+        assignRegisters();
+        const auto& blocks = source_.getBasicBlocks();
+        for (auto it = blocks.begin(); it != blocks.end(); ++it) {
+            blockStart_[&*it] = here();
+            IRBasicBlock* next = std::next(it) != blocks.end() ? &*std::next(it) : nullptr;
+            for (IRInstruction& inst : *it) {
+                compileInstruction(inst, next);
+            }
+        }
+        for (const auto& [pc, block] : blockFixups_) {
+            target_.code[pc].setBx(blockStart_.at(block));
+        }
+    }
+
+private:
+    static constexpr std::uint32_t kNone = std::numeric_limits<std::uint32_t>::max();
+
+    // Arguments, then constants, then results, then a scratch register for breaking
+    // copy cycles, then the window outgoing call arguments are built in. Results
+    // (and arguments, once they are dead) share registers by linear scan over their
+    // live ranges, so a frame is as large as the most values live at once rather
+    // than the length of the function.
+    void assignRegisters()
+    {
+        std::uint32_t next = 0;
+        for (const ir::IRArgument* argument : source_.getArguments()) {
+            registers_[argument->getId()] = next++;
+        }
+        target_.params = static_cast<std::uint16_t>(next);
+        std::vector<const ir::IRConstant*> constants;
+        std::size_t maxArguments = 0;
+        for (const IRBasicBlock& block : source_.getBasicBlocks()) {
+            for (const IRInstruction& inst : block) {
+                if (inst.getOp() == IRInstructionOp::Call) {
+                    maxArguments = std::max(maxArguments, inst.getNumOperands());
+                }
+                for (std::size_t i = 0; i < inst.getNumOperands(); ++i) {
+                    const IRValue* operand = inst.getOperand(i);
+                    if (operand->getKind() == IRValueKind::Constant && registers_[operand->getId()] == kNone) {
+                        registers_[operand->getId()] = next++;
+                        constants.push_back(static_cast<const ir::IRConstant*>(operand));
+                    }
+                }
+            }
+        }
+
+        const std::vector<LiveRange> ranges = liveRanges(source_);
+        std::vector<unsigned> order;
+        for (unsigned id = 0; id < ranges.size(); ++id) {
+            if (!ranges[id].empty()) {
+                order.push_back(id);
+            }
+        }
+        std::sort(order.begin(), order.end(), [&ranges](unsigned a, unsigned b) {
+            return ranges[a].start != ranges[b].start ? ranges[a].start < ranges[b].start : a < b;
+        });
+        std::vector<unsigned> active; // sorted by end
+        std::vector<std::uint32_t> free;
+        for (const unsigned id : order) {
+            while (!active.empty() && ranges[active.front()].end < ranges[id].start) {
+                free.push_back(registers_[active.front()]);
+                active.erase(active.begin());
+            }
+            if (registers_[id] == kNone) { // arguments come with theirs
+                if (free.empty()) {
+                    registers_[id] = next++;
+                } else {
+                    registers_[id] = free.back();
+                    free.pop_back();
+                }
+            }
+            active.insert(std::upper_bound(active.begin(), active.end(), id,
+                                           [&ranges](unsigned a, unsigned b) { return ranges[a].end < ranges[b].end; }),
+                          id);
+        }
+        scratch_ = next++;
+        window_ = next;
+        target_.registers = next + static_cast<std::uint32_t>(maxArguments);
+        if (target_.registers > kMaxRegisters) {
+            throw CompileError{"function '" + source_.getName() + "' needs more than 65535 registers"};
+        }
+
+        // Constants are loaded once on entry; no instruction writes their registers again.
+        for (const ir::IRConstant* constant : constants) {
+            Instruction load{Opcode::LoadK};
+            load.a = reg(constant);
+            load.setBx(static_cast<std::uint32_t>(target_.constants.size()));
+            target_.constants.push_back(toValue(constant->getValue()));
+            target_.code.push_back(load);
+        }
+    }
+
+    std::uint16_t reg(const IRValue* value) const
+    {
+        const std::uint32_t r = registers_[value->getId()];
+        if (r == kNone) {
+            throw CompileError{"function '" + source_.getName() + "' reads a value with no register"};
+        }
+        return static_cast<std::uint16_t>(r);
+    }
+
+    std::uint32_t here() const { return static_cast<std::uint32_t>(target_.code.size()); }
+
+    void emit(Opcode op, std::uint32_t a = 0, std::uint32_t b = 0, std::uint32_t c = 0)
+    {
+        target_.code.push_back(Instruction{op, static_cast<std::uint16_t>(a), static_cast<std::uint16_t>(b),
+                                           static_cast<std::uint16_t>(c)});
+    }
+
+    void emitJump(Opcode op, std::uint32_t condition, const IRBasicBlock* block)
+    {
+        blockFixups_.emplace_back(here(), block);
+        emit(op, condition);
+    }
+
+    void compileInstruction(const IRInstruction& inst, const IRBasicBlock* next)
+    {
+        const IRInstructionOp op = inst.getOp();
+        if (inst.getNumOperands() == 2) {
+            const bool integers = inst.getOperand(0)->getType() == IRType::Int &&
+                                  inst.getOperand(1)->getType() == IRType::Int;
+            if (const auto opcode = binaryOpcode(op, integers)) {
+                emit(*opcode, reg(&inst), reg(inst.getOperand(0)), reg(inst.getOperand(1)));
+                return;
+            }
+        }
+        switch (op) {
+        case IRInstructionOp::Neg:
+            emit(Opcode::Neg, reg(&inst), reg(inst.getOperand(0)));
+            return;
+        case IRInstructionOp::Not:
+            emit(Opcode::Not, reg(&inst), reg(inst.getOperand(0)));
+            return;
+        case IRInstructionOp::Assign:
+            emit(Opcode::Move, reg(&inst), reg(inst.getOperand(0)));
+            return;
+        case IRInstructionOp::Phi:
+            return; // copied on the incoming edges
+        case IRInstructionOp::Call:
+            compileCall(inst);
+            return;
+        case IRInstructionOp::Return:
+            if (tailCall_ && inst.getPrevNode() == tailCall_) {
+                return; // the callee returns for this function
+            }
+            if (inst.getNumOperands() != 0) {
+                emit(Opcode::Return, reg(inst.getOperand(0)));
+            } else {
+                emit(Opcode::ReturnVoid);
+            }
+            return;
+        case IRInstructionOp::Branch:
+            emitEdge(inst.getParent(), inst.getBlocks()[0], next);
+            return;
+        case IRInstructionOp::BranchIf:
+            compileBranchIf(inst, next);
+            return;
+        default:
+            throw CompileError{std::string("unsupported instruction '") + ir::toString(op) + "' in function '" +
+                               source_.getName() + "'"};
+        }
+    }
+
+    void compileCall(const IRInstruction& inst)
+    {
+        CallSite site;
+        if (const auto it = program_.index.find(inst.getCallee()); it != program_.index.end()) {
+            site.callee = it->second;
+        } else if (const auto intrinsic = findIntrinsic(inst.getCallee())) {
+            site.callee = *intrinsic;
+            site.intrinsic = true;
+        } else {
+            throw CompileError{"Unknown function '" + inst.getCallee() + "' called from '" + source_.getName() + "'"};
+        }
+        site.firstArg = static_cast<std::uint16_t>(window_);
+        site.argCount = static_cast<std::uint16_t>(inst.getNumOperands());
+        for (std::size_t i = 0; i < inst.getNumOperands(); ++i) {
+            emit(Opcode::Move, window_ + i, reg(inst.getOperand(i)));
+        }
+        // Intrinsics return straight away, so only calls of module functions gain
+        // anything from reusing the frame.
+        if (inst.isTailCall() && !site.intrinsic) {
+            Instruction jump{Opcode::TailCall};
+            jump.setBx(static_cast<std::uint32_t>(target_.calls.size()));
+            target_.calls.push_back(site);
+            target_.code.push_back(jump);
+            tailCall_ = &inst;
+            return;
+        }
+        Instruction call{Opcode::Call};
+        call.a = static_cast<std::uint16_t>(registers_[inst.getId()] != kNone ? reg(&inst) : scratch_);
+        call.setBx(static_cast<std::uint32_t>(target_.calls.size()));
+        target_.calls.push_back(site);
+        target_.code.push_back(call);
+    }
+
+    // Phi copies for the edge from -> to, as (destination, source) pairs.
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> edgeCopies(const IRBasicBlock* from,
+                                                                    const IRBasicBlock* to) const
+    {
+        std::vector<std::pair<std::uint32_t, std::uint32_t>> copies;
+        for (const IRInstruction& phi : *to) {
+            if (phi.getOp() != IRInstructionOp::Phi) {
+                break;
+            }
+            const auto& incoming = phi.getBlocks();
+            const auto it = std::find(incoming.begin(), incoming.end(), from);
+            if (it == incoming.end()) {
+                continue;
+            }
+            const std::uint32_t source = reg(phi.getOperand(static_cast<std::size_t>(it - incoming.begin())));
+            if (source != reg(&phi)) {
+                copies.emplace_back(reg(&phi), source);
+            }
+        }
+        return copies;
+    }
+
+    // All Phis of a block read their operands at once, so the copies are ordered so
+    // no destination is written before it has been read, going through the scratch
+    // register to break cycles.
+    void emitParallelCopies(std::vector<std::pair<std::uint32_t, std::uint32_t>> copies)
+    {
+        while (!copies.empty()) {
+            auto ready = std::find_if(copies.begin(), copies.end(), [&copies](const auto& copy) {
+                return std::none_of(copies.begin(), copies.end(),
+                                    [&copy](const auto& other) { return other.second == copy.first; });
+            });
+            if (ready == copies.end()) {
+                const std::uint32_t saved = copies.front().first;
+                emit(Opcode::Move, scratch_, saved);
+                for (auto& copy : copies) {
+                    if (copy.second == saved) {
+                        copy.second = scratch_;
+                    }
+                }
+                continue;
+            }
+            emit(Opcode::Move, ready->first, ready->second);
+            copies.erase(ready);
+        }
+    }
+
+    void emitEdge(const IRBasicBlock* from, const IRBasicBlock* to, const IRBasicBlock* next)
+    {
+        emitParallelCopies(edgeCopies(from, to));
+        if (to != next) {
+            emitJump(Opcode::Jump, 0, to);
+        }
+    }
+
+    void compileBranchIf(const IRInstruction& inst, const IRBasicBlock* next)
+    {
+        const IRBasicBlock* block = inst.getParent();
+        const IRBasicBlock* onTrue = inst.getBlocks()[0];
+        const IRBasicBlock* onFalse = inst.getBlocks()[1];
+        const std::uint16_t condition = reg(inst.getOperand(0));
+        if (edgeCopies(block, onTrue).empty() && onTrue != next) {
+            emitJump(Opcode::JumpIf, condition, onTrue);
+            emitEdge(block, onFalse, next);
+            return;
+        }
+        if (edgeCopies(block, onFalse).empty()) {
+            emitJump(Opcode::JumpIfNot, condition, onFalse);
+            emitEdge(block, onTrue, next);
+            return;
+        }
+        // Otherwise the true edge's copies run first and the false edge gets a stub after them.
+        const std::uint32_t skip = here();
+        emit(Opcode::JumpIfNot, condition);
+        emitEdge(block, onTrue, nullptr);
+        target_.code[skip].setBx(here());
+        emitEdge(block, onFalse, next);
+    }
+
+    const IRFunction& source_;
+    Function& target_;
+    const Program& program_;
+    std::vector<std::uint32_t> registers_;
+    std::uint32_t scratch_{0};
+    std::uint32_t window_{0};
+    const IRInstruction* tailCall_{nullptr}; // its Return is not emitted
+    std::unordered_map<const IRBasicBlock*, std::uint32_t> blockStart_;
+    std::vector<std::pair<std::uint32_t, const IRBasicBlock*>> blockFixups_;
+};
+
+} // namespace
+
+std::expected<Program, std::string> compileModule(const ir::IRModule& module)
+{
+    Program program;
+    // Indexed up front so calls can refer to functions defined later.
+    for (const auto& function : module.getFunctions()) {
+        program.index.emplace(function->getName(), static_cast<std::uint32_t>(program.functions.size()));
+        program.functions.emplace_back().name = function->getName();
+    }
+    try {
+        for (std::size_t i = 0; i < module.getFunctions().size(); ++i) {
+            FunctionCompiler(*module.getFunctions()[i], program.functions[i], program).compile();
+        }
+    } catch (const CompileError& error) {
+        return std::unexpected(error.message);
+    }
+    return program;
+}
+
+} // namespace istudio::vm
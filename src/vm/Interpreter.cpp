@@ -0,0 +1,345 @@
+#include "vm/Interpreter.h"
+
+#include <cmath>
+#include <limits>
+
+#if defined(__GNUC__)
+#define ISTUDIO_VM_THREADED 1
+#else
+#define ISTUDIO_VM_THREADED 0
+#endif
+
+namespace istudio::vm {
+
+namespace {
+
+std::int64_t asInt(const Value& value)
+{
+    if (const auto* integer = std::get_if<std::int64_t>(&value)) {
+        return *integer;
+    }
+    throw RuntimeError(std::string("expected an int, got ") + typeName(value));
+}
+
+// Two's complement wrap-around, as the generated C++ and Java would behave.
+std::int64_t wrap(std::uint64_t value) { return static_cast<std::int64_t>(value); }
+
+[[noreturn]] void badOperands(const char* op, const Value& lhs, const Value& rhs)
+{
+    throw RuntimeError(std::string("cannot apply '") + op + "' to " + typeName(lhs) + " and " + typeName(rhs));
+}
+
+Value arithmetic(Opcode op, const Value& lhs, const Value& rhs)
+{
+    const auto* l = std::get_if<std::int64_t>(&lhs);
+    const auto* r = std::get_if<std::int64_t>(&rhs);
+    if (l && r) {
+        const auto a = static_cast<std::uint64_t>(*l);
+        const auto b = static_cast<std::uint64_t>(*r);
+        switch (op) {
+        case Opcode::Add: return wrap(a + b);
+        case Opcode::Sub: return wrap(a - b);
+        case Opcode::Mul: return wrap(a * b);
+        case Opcode::Div:
+        case Opcode::Rem:
+            if (*r == 0) {
+                throw RuntimeError("integer division by zero");
+            }
+            if (*r == -1) { // INT64_MIN / -1 overflows
+                return op == Opcode::Div ? wrap(0 - a) : std::int64_t{0};
+            }
+            return op == Opcode::Div ? *l / *r : *l % *r;
+        case Opcode::Xor: return *l ^ *r;
+        case Opcode::And: return *l & *r;
+        case Opcode::Or: return *l | *r;
+        case Opcode::Shl: return wrap(a << (b & 63));
+        case Opcode::Shr: return *l >> (b & 63);
+        default: break;
+        }
+    }
+    if (op == Opcode::Add && (std::holds_alternative<std::string>(lhs) || std::holds_alternative<std::string>(rhs))) {
+        return toString(lhs) + toString(rhs);
+    }
+    const auto* lb = std::get_if<bool>(&lhs);
+    const auto* rb = std::get_if<bool>(&rhs);
+    if (lb && rb) {
+        switch (op) {
+        case Opcode::And: return *lb && *rb;
+        case Opcode::Or: return *lb || *rb;
+        case Opcode::Xor: return *lb != *rb;
+        default: break;
+        }
+    }
+    if (isNumber(lhs) && isNumber(rhs)) {
+        const double a = toDouble(lhs);
+        const double b = toDouble(rhs);
+        switch (op) {
+        case Opcode::Add: return a + b;
+        case Opcode::Sub: return a - b;
+        case Opcode::Mul: return a * b;
+        case Opcode::Div: return a / b;
+        case Opcode::Rem: return std::fmod(a, b);
+        default: break;
+        }
+    }
+    badOperands(toString(op), lhs, rhs);
+}
+
+bool equals(const Value& lhs, const Value& rhs)
+{
+    if (isNumber(lhs) && isNumber(rhs)) {
+        return toDouble(lhs) == toDouble(rhs);
+    }
+    return lhs == rhs; // lists and dictionaries compare by identity
+}
+
+// -1, 0 or 1; numbers and strings are ordered.
+int compare(const Value& lhs, const Value& rhs)
+{
+    if (isNumber(lhs) && isNumber(rhs)) {
+        const double a = toDouble(lhs);
+        const double b = toDouble(rhs);
+        return a < b ? -1 : (b < a ? 1 : 0);
+    }
+    const auto* l = std::get_if<std::string>(&lhs);
+    const auto* r = std::get_if<std::string>(&rhs);
+    if (l && r) {
+        const int order = l->compare(*r);
+        return order < 0 ? -1 : (order > 0 ? 1 : 0);
+    }
+    badOperands("<", lhs, rhs);
+}
+
+Value negate(const Value& value)
+{
+    if (const auto* integer = std::get_if<std::int64_t>(&value)) {
+        return wrap(0 - static_cast<std::uint64_t>(*integer));
+    }
+    if (const auto* real = std::get_if<double>(&value)) {
+        return -*real;
+    }
+    throw RuntimeError(std::string("cannot negate ") + typeName(value));
+}
+
+} // namespace
+
+Interpreter::Interpreter(const Program& program, std::ostream& out, std::istream& in)
+    : program_(program), runtime_{out, in}
+{
+}
+
+std::expected<Value, std::string> Interpreter::run(std::string_view entry, std::span<const Value> args)
+{
+    const Function* function = program_.find(std::string(entry));
+    if (!function) {
+        return std::unexpected("no function named '" + std::string(entry) + "'");
+    }
+    stack_.assign(std::max<std::size_t>(function->registers, args.size()), Value{});
+    std::copy(args.begin(), args.end(), stack_.begin());
+    try {
+        frames_.clear();
+        Value result = execute(*function);
+        runtime_.out.flush();
+        return result;
+    } catch (const RuntimeError& error) {
+        runtime_.out.flush();
+        return std::unexpected(std::string(error.what()));
+    }
+}
+
+#if ISTUDIO_VM_THREADED
+// Label addresses and computed goto are GNU extensions.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+#endif
+
+Value Interpreter::execute(const Function& entry)
+{
+    const Function* function = &entry; // the function of the innermost frame
+    std::size_t base = 0;
+    if (stack_.size() < base + function->registers) {
+        stack_.resize(base + function->registers);
+    }
+    Value* R = stack_.data() + base;
+    const Value* K = function->constants.data();
+    const Instruction* code = function->code.data();
+    const Instruction* pc = code;
+
+#if ISTUDIO_VM_THREADED
+#define ISTUDIO_VM_LABEL(name) &&op_##name,
+    static const void* const kLabels[] = {ISTUDIO_VM_OPCODES(ISTUDIO_VM_LABEL)};
+#undef ISTUDIO_VM_LABEL
+#define VM_DISPATCH() goto* kLabels[static_cast<std::uint8_t>(pc->op)]
+#define VM_SWITCH() VM_DISPATCH();
+#define VM_CASE(name) op_##name:
+#define VM_END()
+#else
+#define VM_DISPATCH() continue
+#define VM_SWITCH() \
+    for (;;)        \
+        switch (pc->op) {
+#define VM_CASE(name) case Opcode::name:
+#define VM_END() }
+#endif
+#define VM_NEXT()      \
+    {                  \
+        ++pc;          \
+        VM_DISPATCH(); \
+    }
+#define VM_JUMP(target)        \
+    {                          \
+        pc = code + (target);  \
+        VM_DISPATCH();         \
+    }
+#define VM_INT_BINARY(name, expr)                          \
+    VM_CASE(name)                                          \
+    {                                                      \
+        const auto a = asInt(R[pc->b]);                    \
+        const auto b = asInt(R[pc->c]);                    \
+        R[pc->a] = expr;                                   \
+        VM_NEXT()                                          \
+    }
+#define VM_GENERIC(name, expr)                             \
+    VM_CASE(name)                                          \
+    {                                                      \
+        R[pc->a] = expr;                                   \
+        VM_NEXT()                                          \
+    }
+// Leaves the innermost frame: the run ends with `value`, or the caller resumes
+// after its Call with `value` in the call's result register.
+#define VM_RETURN(value)                                   \
+    {                                                      \
+        Value result = value;                              \
+        if (frames_.empty()) {                             \
+            return result;                                 \
+        }                                                  \
+        const Frame caller = frames_.back();               \
+        frames_.pop_back();                                \
+        function = caller.function;                        \
+        base = caller.base;                                \
+        R = stack_.data() + base;                          \
+        K = function->constants.data();                    \
+        code = function->code.data();                      \
+        pc = caller.call;                                  \
+        R[pc->a] = std::move(result);                      \
+        VM_NEXT()                                          \
+    }
+
+    VM_SWITCH()
+    VM_CASE(Move)
+    {
+        R[pc->a] = R[pc->b];
+        VM_NEXT()
+    }
+    VM_CASE(LoadK)
+    {
+        R[pc->a] = K[pc->bx()];
+        VM_NEXT()
+    }
+    VM_INT_BINARY(AddI, wrap(static_cast<std::uint64_t>(a) + static_cast<std::uint64_t>(b)))
+    VM_INT_BINARY(SubI, wrap(static_cast<std::uint64_t>(a) - static_cast<std::uint64_t>(b)))
+    VM_INT_BINARY(MulI, wrap(static_cast<std::uint64_t>(a) * static_cast<std::uint64_t>(b)))
+    VM_INT_BINARY(EqI, a == b)
+    VM_INT_BINARY(NeI, a != b)
+    VM_INT_BINARY(LtI, a < b)
+    VM_INT_BINARY(LeI, a <= b)
+    VM_INT_BINARY(GtI, a > b)
+    VM_INT_BINARY(GeI, a >= b)
+    VM_GENERIC(Add, arithmetic(Opcode::Add, R[pc->b], R[pc->c]))
+    VM_GENERIC(Sub, arithmetic(Opcode::Sub, R[pc->b], R[pc->c]))
+    VM_GENERIC(Mul, arithmetic(Opcode::Mul, R[pc->b], R[pc->c]))
+    VM_GENERIC(Div, arithmetic(Opcode::Div, R[pc->b], R[pc->c]))
+    VM_GENERIC(Rem, arithmetic(Opcode::Rem, R[pc->b], R[pc->c]))
+    VM_GENERIC(And, arithmetic(Opcode::And, R[pc->b], R[pc->c]))
+    VM_GENERIC(Or, arithmetic(Opcode::Or, R[pc->b], R[pc->c]))
+    VM_GENERIC(Xor, arithmetic(Opcode::Xor, R[pc->b], R[pc->c]))
+    VM_GENERIC(Shl, arithmetic(Opcode::Shl, R[pc->b], R[pc->c]))
+    VM_GENERIC(Shr, arithmetic(Opcode::Shr, R[pc->b], R[pc->c]))
+    VM_GENERIC(Eq, equals(R[pc->b], R[pc->c]))
+    VM_GENERIC(Ne, !equals(R[pc->b], R[pc->c]))
+    VM_GENERIC(Lt, compare(R[pc->b], R[pc->c]) < 0)
+    VM_GENERIC(Le, compare(R[pc->b], R[pc->c]) <= 0)
+    VM_GENERIC(Gt, compare(R[pc->b], R[pc->c]) > 0)
+    VM_GENERIC(Ge, compare(R[pc->b], R[pc->c]) >= 0)
+    VM_GENERIC(Neg, negate(R[pc->b]))
+    VM_GENERIC(Not, !isTruthy(R[pc->b]))
+    VM_CASE(Jump) VM_JUMP(pc->bx())
+    VM_CASE(JumpIf)
+    {
+        if (isTruthy(R[pc->a])) {
+            VM_JUMP(pc->bx())
+        }
+        VM_NEXT()
+    }
+    VM_CASE(JumpIfNot)
+    {
+        if (!isTruthy(R[pc->a])) {
+            VM_JUMP(pc->bx())
+        }
+        VM_NEXT()
+    }
+    VM_CASE(Call)
+    {
+        const CallSite& site = function->calls[pc->bx()];
+        if (site.intrinsic) {
+            R[pc->a] = intrinsics()[site.callee].call(std::span<const Value>(R + site.firstArg, site.argCount), runtime_);
+            VM_NEXT()
+        }
+        const Function& callee = program_.functions[site.callee];
+        if (frames_.size() + 1 >= kMaxCallDepth) {
+            throw RuntimeError("stack overflow in call to '" + callee.name + "'");
+        }
+        frames_.push_back({function, base, pc});
+        base += site.firstArg;
+        if (stack_.size() < base + callee.registers) {
+            stack_.resize(base + callee.registers);
+        }
+        R = stack_.data() + base;
+        for (std::size_t i = site.argCount; i < callee.params; ++i) {
+            R[i] = Value{}; // missing arguments read as null
+        }
+        function = &callee;
+        K = function->constants.data();
+        code = function->code.data();
+        VM_JUMP(0)
+    }
+    VM_CASE(TailCall)
+    {
+        // The callee takes over this frame, so the depth stays where it is.
+        const CallSite& site = function->calls[pc->bx()];
+        const Function& callee = program_.functions[site.callee];
+        for (std::size_t i = 0; i < site.argCount; ++i) {
+            R[i] = std::move(R[site.firstArg + i]);
+        }
+        if (stack_.size() < base + callee.registers) {
+            stack_.resize(base + callee.registers);
+            R = stack_.data() + base;
+        }
+        for (std::size_t i = site.argCount; i < callee.params; ++i) {
+            R[i] = Value{}; // missing arguments read as null
+        }
+        function = &callee;
+        K = function->constants.data();
+        code = function->code.data();
+        VM_JUMP(0)
+    }
+    VM_CASE(Return) VM_RETURN(std::move(R[pc->a]))
+    VM_CASE(ReturnVoid) VM_RETURN(Value{})
+    VM_END()
+
+#undef VM_RETURN
+#undef VM_GENERIC
+#undef VM_INT_BINARY
+#undef VM_JUMP
+#undef VM_NEXT
+#undef VM_END
+#undef VM_CASE
+#undef VM_SWITCH
+#undef VM_DISPATCH
+}
+
+#if ISTUDIO_VM_THREADED
+#pragma GCC diagnostic pop
+#endif
+
+} // namespace istudio::vm
@@ -0,0 +1,332 @@
+#include "vm/Intrinsics.h"
+
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace istudio::vm {
+
+namespace {
+
+const Value& arg(std::span<const Value> args, std::size_t index)
+{
+    static const Value kNull;
+    return index < args.size() ? args[index] : kNull;
+}
+
+double number(std::span<const Value> args, std::size_t index, std::string_view function)
+{
+    const Value& value = arg(args, index);
+    if (!isNumber(value)) {
+        throw RuntimeError(std::string(function) + ": expected a number, got " + typeName(value));
+    }
+    return toDouble(value);
+}
+
+std::shared_ptr<List> list(std::span<const Value> args, std::size_t index, std::string_view function)
+{
+    if (const auto* value = std::get_if<std::shared_ptr<List>>(&arg(args, index))) {
+        return *value;
+    }
+    throw RuntimeError(std::string(function) + ": expected a list, got " + typeName(arg(args, index)));
+}
+
+std::shared_ptr<Dict> dict(std::span<const Value> args, std::size_t index, std::string_view function)
+{
+    if (const auto* value = std::get_if<std::shared_ptr<Dict>>(&arg(args, index))) {
+        return *value;
+    }
+    throw RuntimeError(std::string(function) + ": expected a dict, got " + typeName(arg(args, index)));
+}
+
+bool allInts(std::span<const Value> args)
+{
+    for (const Value& value : args) {
+        if (!std::holds_alternative<std::int64_t>(value)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// The format with each `{}` or printf conversion (%d, %s, ...) replaced by the next
+// element of `values`.
+std::string format(const std::string& pattern, const Value& values)
+{
+    const auto* items = std::get_if<std::shared_ptr<List>>(&values);
+    std::size_t next = 0;
+    auto take = [&]() -> std::string {
+        if (!items || !*items || next >= (*items)->items.size()) {
+            return "";
+        }
+        return toString((*items)->items[next++]);
+    };
+    std::string text;
+    for (std::size_t i = 0; i < pattern.size(); ++i) {
+        if (pattern[i] == '{' && i + 1 < pattern.size() && pattern[i + 1] == '}') {
+            text += take();
+            ++i;
+        } else if (pattern[i] == '%' && i + 1 < pattern.size()) {
+            const char conversion = pattern[i + 1];
+            if (conversion == '%') {
+                text += '%';
+            } else if (std::string_view("dfsigx").find(conversion) != std::string_view::npos) {
+                text += take();
+            } else {
+                text += pattern.substr(i, 2);
+            }
+            ++i;
+        } else {
+            text += pattern[i];
+        }
+    }
+    return text;
+}
+
+std::string readLine(Runtime& runtime)
+{
+    std::string line;
+    std::getline(runtime.in, line);
+    return line;
+}
+
+template <double (*Fn)(double)>
+Value unaryMath(std::span<const Value> args, Runtime&)
+{
+    return Fn(number(args, 0, "math"));
+}
+
+double sin(double value) { return std::sin(value); }
+double cos(double value) { return std::cos(value); }
+double tan(double value) { return std::tan(value); }
+double exp(double value) { return std::exp(value); }
+double floor(double value) { return std::floor(value); }
+double ceil(double value) { return std::ceil(value); }
+double round(double value) { return std::round(value); }
+
+Value sqrtIntrinsic(std::span<const Value> args, Runtime&)
+{
+    const double value = number(args, 0, "sqrt");
+    if (value < 0) {
+        throw RuntimeError("sqrt: negative argument");
+    }
+    return std::sqrt(value);
+}
+
+Value logIntrinsic(std::span<const Value> args, Runtime&)
+{
+    const double value = number(args, 0, "log");
+    return value > 0 ? std::log(value) : 0.0; // as the IPL definition: no domain error
+}
+
+Value powIntrinsic(std::span<const Value> args, Runtime&)
+{
+    if (allInts(args.first(std::min<std::size_t>(args.size(), 2))) && std::get<std::int64_t>(arg(args, 1)) >= 0) {
+        std::int64_t base = std::get<std::int64_t>(arg(args, 0));
+        std::int64_t exponent = std::get<std::int64_t>(arg(args, 1));
+        std::uint64_t result = 1;
+        for (; exponent > 0; --exponent) {
+            result *= static_cast<std::uint64_t>(base);
+        }
+        return static_cast<std::int64_t>(result);
+    }
+    return std::pow(number(args, 0, "pow"), number(args, 1, "pow"));
+}
+
+Value absIntrinsic(std::span<const Value> args, Runtime&)
+{
+    if (const auto* integer = std::get_if<std::int64_t>(&arg(args, 0))) {
+        return *integer < 0 ? -*integer : *integer;
+    }
+    return std::fabs(number(args, 0, "abs"));
+}
+
+Value minIntrinsic(std::span<const Value> args, Runtime&)
+{
+    const bool leftSmaller = number(args, 0, "min") < number(args, 1, "min");
+    return leftSmaller ? arg(args, 0) : arg(args, 1);
+}
+
+Value maxIntrinsic(std::span<const Value> args, Runtime&)
+{
+    const bool leftLarger = number(args, 0, "max") > number(args, 1, "max");
+    return leftLarger ? arg(args, 0) : arg(args, 1);
+}
+
+Value clampIntrinsic(std::span<const Value> args, Runtime&)
+{
+    const double value = number(args, 0, "clamp");
+    if (value < number(args, 1, "clamp")) {
+        return arg(args, 1);
+    }
+    if (value > number(args, 2, "clamp")) {
+        return arg(args, 2);
+    }
+    return arg(args, 0);
+}
+
+Value print(std::span<const Value> args, Runtime& runtime)
+{
+    runtime.out << toString(arg(args, 0));
+    return {};
+}
+
+Value println(std::span<const Value> args, Runtime& runtime)
+{
+    runtime.out << toString(arg(args, 0)) << '\n';
+    return {};
+}
+
+Value printBool(std::span<const Value> args, Runtime& runtime)
+{
+    runtime.out << (isTruthy(arg(args, 0)) ? "true" : "false") << '\n';
+    return {};
+}
+
+Value readLineIntrinsic(std::span<const Value>, Runtime& runtime) { return readLine(runtime); }
+
+Value prompt(std::span<const Value> args, Runtime& runtime)
+{
+    runtime.out << toString(arg(args, 0)) << '\n';
+    return readLine(runtime);
+}
+
+Value printfIntrinsic(std::span<const Value> args, Runtime& runtime)
+{
+    const std::string text = format(toString(arg(args, 0)), arg(args, 1));
+    runtime.out << text;
+    return static_cast<std::int64_t>(text.size());
+}
+
+Value scanf(std::span<const Value> args, Runtime& runtime)
+{
+    // Reads one line and stores its whitespace-separated fields into the list.
+    std::istringstream fields(readLine(runtime));
+    const auto* destinations = std::get_if<std::shared_ptr<List>>(&arg(args, 1));
+    std::int64_t count = 0;
+    for (std::string field; fields >> field; ++count) {
+        if (destinations && *destinations) {
+            (*destinations)->items.emplace_back(std::move(field));
+        }
+    }
+    return count;
+}
+
+Value readFile(std::span<const Value> args, Runtime&)
+{
+    std::ifstream in(toString(arg(args, 0)), std::ios::binary);
+    std::ostringstream contents;
+    contents << in.rdbuf();
+    return contents.str();
+}
+
+Value writeFileMode(std::span<const Value> args, std::ios::openmode mode)
+{
+    std::ofstream out(toString(arg(args, 0)), mode);
+    out << toString(arg(args, 1));
+    return static_cast<bool>(out);
+}
+
+Value writeFile(std::span<const Value> args, Runtime&) { return writeFileMode(args, std::ios::binary | std::ios::trunc); }
+Value appendFile(std::span<const Value> args, Runtime&) { return writeFileMode(args, std::ios::binary | std::ios::app); }
+
+Value listCreate(std::span<const Value>, Runtime&) { return std::make_shared<List>(); }
+
+Value listPush(std::span<const Value> args, Runtime&)
+{
+    auto values = list(args, 0, "listPush");
+    values->items.push_back(arg(args, 1));
+    return values;
+}
+
+Value listPop(std::span<const Value> args, Runtime&)
+{
+    auto values = list(args, 0, "listPop");
+    if (values->items.empty()) {
+        return {};
+    }
+    Value last = std::move(values->items.back());
+    values->items.pop_back();
+    return last;
+}
+
+Value listLength(std::span<const Value> args, Runtime&)
+{
+    return static_cast<std::int64_t>(list(args, 0, "listLength")->items.size());
+}
+
+Value dictCreate(std::span<const Value>, Runtime&) { return std::make_shared<Dict>(); }
+
+Value dictGet(std::span<const Value> args, Runtime&)
+{
+    const auto table = dict(args, 0, "dictGet");
+    const auto it = table->entries.find(toString(arg(args, 1)));
+    return it != table->entries.end() ? it->second : Value{};
+}
+
+Value dictSet(std::span<const Value> args, Runtime&)
+{
+    auto table = dict(args, 0, "dictSet");
+    table->entries[toString(arg(args, 1))] = arg(args, 2);
+    return table;
+}
+
+} // namespace
+
+const std::vector<Intrinsic>& intrinsics()
+{
+    static const std::vector<Intrinsic> table = {
+        // core_io
+        {"print", print},
+        {"println", println},
+        {"printNumber", print},
+        {"printBool", printBool},
+        {"readLine", readLineIntrinsic},
+        {"prompt", prompt},
+        {"printf", printfIntrinsic},
+        {"fprintf", printfIntrinsic},
+        {"scanf", scanf},
+        {"readFile", readFile},
+        {"writeFile", writeFile},
+        {"appendFile", appendFile},
+        // core_math
+        {"abs", absIntrinsic},
+        {"clamp", clampIntrinsic},
+        {"max", maxIntrinsic},
+        {"min", minIntrinsic},
+        {"pow", powIntrinsic},
+        {"operator**", powIntrinsic},
+        {"sqrt", sqrtIntrinsic},
+        {"floor", unaryMath<floor>},
+        {"ceil", unaryMath<ceil>},
+        {"round", unaryMath<round>},
+        {"sin", unaryMath<sin>},
+        {"cos", unaryMath<cos>},
+        {"tan", unaryMath<tan>},
+        {"exp", unaryMath<exp>},
+        {"log", logIntrinsic},
+        // core_collections
+        {"listCreate", listCreate},
+        {"listPush", listPush},
+        {"listPop", listPop},
+        {"listLength", listLength},
+        {"dictCreate", dictCreate},
+        {"dictGet", dictGet},
+        {"dictSet", dictSet},
+    };
+    return table;
+}
+
+std::optional<std::uint32_t> findIntrinsic(std::string_view name)
+{
+    const auto& table = intrinsics();
+    for (std::size_t i = 0; i < table.size(); ++i) {
+        if (table[i].name == name) {
+            return static_cast<std::uint32_t>(i);
+        }
+    }
+    return std::nullopt;
+}
+
+} // namespace istudio::vm
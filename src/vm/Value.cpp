@@ -0,0 +1,87 @@
+#include "vm/Value.h"
+
+#include <sstream>
+
+namespace istudio::vm {
+
+double toDouble(const Value& value)
+{
+    if (const auto* integer = std::get_if<std::int64_t>(&value)) {
+        return static_cast<double>(*integer);
+    }
+    if (const auto* real = std::get_if<double>(&value)) {
+        return *real;
+    }
+    return 0.0;
+}
+
+bool isTruthy(const Value& value)
+{
+    return std::visit(
+        [](const auto& v) -> bool {
+            using T = std::decay_t<decltype(v)>;
+            if constexpr (std::is_same_v<T, std::monostate>) {
+                return false;
+            } else if constexpr (std::is_same_v<T, bool>) {
+                return v;
+            } else if constexpr (std::is_same_v<T, std::int64_t> || std::is_same_v<T, double>) {
+                return v != 0;
+            } else if constexpr (std::is_same_v<T, std::string>) {
+                return !v.empty();
+            } else {
+                return v != nullptr;
+            }
+        },
+        value);
+}
+
+std::string toString(const Value& value)
+{
+    return std::visit(
+        [](const auto& v) -> std::string {
+            using T = std::decay_t<decltype(v)>;
+            if constexpr (std::is_same_v<T, std::monostate>) {
+                return "null";
+            } else if constexpr (std::is_same_v<T, bool>) {
+                return v ? "true" : "false";
+            } else if constexpr (std::is_same_v<T, std::int64_t>) {
+                return std::to_string(v);
+            } else if constexpr (std::is_same_v<T, double>) {
+                std::ostringstream out;
+                out << v;
+                return out.str();
+            } else if constexpr (std::is_same_v<T, std::string>) {
+                return v;
+            } else if constexpr (std::is_same_v<T, std::shared_ptr<List>>) {
+                std::string text = "[";
+                for (std::size_t i = 0; i < v->items.size(); ++i) {
+                    text += (i != 0 ? ", " : "") + toString(v->items[i]);
+                }
+                return text + "]";
+            } else {
+                std::string text = "{";
+                bool first = true;
+                for (const auto& [key, entry] : v->entries) {
+                    text += (first ? "" : ", ") + key + ": " + toString(entry);
+                    first = false;
+                }
+                return text + "}";
+            }
+        },
+        value);
+}
+
+const char* typeName(const Value& value)
+{
+    switch (value.index()) {
+    case 0: return "null";
+    case 1: return "bool";
+    case 2: return "int";
+    case 3: return "float";
+    case 4: return "string";
+    case 5: return "list";
+    default: return "dict";
+    }
+}
+
+} // namespace istudio::vm
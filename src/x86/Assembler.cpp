@@ -0,0 +1,248 @@
+#include "x86/Assembler.h"
+
+#include <stdexcept>
+
+namespace istudio::x86 {
+
+namespace {
+
+unsigned encoding(Reg reg) { return static_cast<unsigned>(reg); }
+
+} // namespace
+
+const char* toString(Reg reg)
+{
+    static const char* const kNames[] = {"rax", "rcx", "rdx", "rbx", "rsp", "rbp", "rsi", "rdi",
+                                         "r8",  "r9",  "r10", "r11", "r12", "r13", "r14", "r15"};
+    return kNames[encoding(reg)];
+}
+
+Assembler::Label Assembler::newLabel()
+{
+    labels_.push_back(-1);
+    return static_cast<Label>(labels_.size() - 1);
+}
+
+void Assembler::bind(Label label) { labels_[label] = static_cast<std::int64_t>(code_.size()); }
+
+void Assembler::imm32(std::int32_t value)
+{
+    const auto bits = static_cast<std::uint32_t>(value);
+    for (int shift = 0; shift < 32; shift += 8) {
+        byte(static_cast<std::uint8_t>(bits >> shift));
+    }
+}
+
+void Assembler::rex(bool wide, unsigned reg, unsigned rm, bool force)
+{
+    const std::uint8_t prefix = 0x40 | (wide ? 8 : 0) | ((reg & 8) ? 4 : 0) | ((rm & 8) ? 1 : 0);
+    if (prefix != 0x40 || force) {
+        byte(prefix);
+    }
+}
+
+void Assembler::modrm(unsigned reg, Operand rm)
+{
+    if (!rm.isMemory) {
+        byte(static_cast<std::uint8_t>(0xC0 | ((reg & 7) << 3) | (encoding(rm.reg) & 7)));
+        return;
+    }
+    // [rbp + disp32]: mod 10, rm 101 needs no SIB byte.
+    byte(static_cast<std::uint8_t>(0x80 | ((reg & 7) << 3) | (encoding(rm.reg) & 7)));
+    imm32(rm.disp);
+}
+
+void Assembler::emitOp(std::uint8_t opcode, unsigned reg, Operand rm)
+{
+    rex(true, reg, encoding(rm.reg));
+    byte(opcode);
+    modrm(reg, rm);
+}
+
+void Assembler::emitOp2(std::uint8_t opcode, unsigned reg, Operand rm)
+{
+    rex(true, reg, encoding(rm.reg));
+    byte(0x0F);
+    byte(opcode);
+    modrm(reg, rm);
+}
+
+void Assembler::mov(Operand dst, Reg src)
+{
+    if (!dst.isMemory && dst.reg == src) {
+        return;
+    }
+    emitOp(0x89, encoding(src), dst);
+}
+
+void Assembler::mov(Reg dst, Operand src)
+{
+    if (!src.isMemory && src.reg == dst) {
+        return;
+    }
+    emitOp(0x8B, encoding(dst), src);
+}
+
+void Assembler::movImm(Reg dst, std::int64_t value)
+{
+    if (value == 0) {
+        rex(false, encoding(dst), encoding(dst));
+        byte(0x31); // xor r32, r32 clears the whole register
+        modrm(encoding(dst), Operand::r(dst));
+    } else if (value > 0 && value <= UINT32_MAX) {
+        rex(false, 0, encoding(dst));
+        byte(static_cast<std::uint8_t>(0xB8 | (encoding(dst) & 7))); // mov r32, imm32 zero-extends
+        imm32(static_cast<std::int32_t>(static_cast<std::uint32_t>(value)));
+    } else if (value >= INT32_MIN && value <= INT32_MAX) {
+        emitOp(0xC7, 0, Operand::r(dst));
+        imm32(static_cast<std::int32_t>(value));
+    } else {
+        movAbs(dst, static_cast<std::uint64_t>(value));
+    }
+}
+
+void Assembler::movAbs(Reg dst, std::uint64_t value)
+{
+    rex(true, 0, encoding(dst));
+    byte(static_cast<std::uint8_t>(0xB8 | (encoding(dst) & 7)));
+    for (int shift = 0; shift < 64; shift += 8) {
+        byte(static_cast<std::uint8_t>(value >> shift));
+    }
+}
+
+void Assembler::alu(Alu op, Reg dst, Operand src)
+{
+    emitOp(static_cast<std::uint8_t>((static_cast<unsigned>(op) << 3) | 0x03), encoding(dst), src);
+}
+
+void Assembler::aluImm(Alu op, Reg dst, std::int32_t value)
+{
+    emitOp(0x81, static_cast<unsigned>(op), Operand::r(dst));
+    imm32(value);
+}
+
+void Assembler::imul(Reg dst, Operand src) { emitOp2(0xAF, encoding(dst), src); }
+
+void Assembler::imulImm(Reg dst, Reg src, std::int32_t value)
+{
+    emitOp(0x69, encoding(dst), Operand::r(src));
+    imm32(value);
+}
+
+void Assembler::cqo()
+{
+    byte(0x48);
+    byte(0x99);
+}
+
+void Assembler::idiv(Reg divisor) { emitOp(0xF7, 7, Operand::r(divisor)); }
+void Assembler::neg(Reg reg) { emitOp(0xF7, 3, Operand::r(reg)); }
+void Assembler::shlCl(Reg reg) { emitOp(0xD3, 4, Operand::r(reg)); }
+void Assembler::sarCl(Reg reg) { emitOp(0xD3, 7, Operand::r(reg)); }
+void Assembler::test(Reg a, Reg b) { emitOp(0x85, encoding(b), Operand::r(a)); }
+
+void Assembler::setcc(Cond cond)
+{
+    byte(0x0F);
+    byte(static_cast<std::uint8_t>(0x90 | static_cast<unsigned>(cond)));
+    byte(0xC0); // al
+    byte(0x0F); // movzx eax, al
+    byte(0xB6);
+    byte(0xC0);
+}
+
+void Assembler::push(Reg reg)
+{
+    rex(false, 0, encoding(reg));
+    byte(static_cast<std::uint8_t>(0x50 | (encoding(reg) & 7)));
+}
+
+void Assembler::pop(Reg reg)
+{
+    rex(false, 0, encoding(reg));
+    byte(static_cast<std::uint8_t>(0x58 | (encoding(reg) & 7)));
+}
+
+void Assembler::subRsp(std::int32_t bytes)
+{
+    if (bytes != 0) {
+        aluImm(Alu::Sub, Reg::Rsp, bytes);
+    }
+}
+
+void Assembler::leaRspFromRbp(std::int32_t disp) { emitOp(0x8D, encoding(Reg::Rsp), Operand::frame(disp)); }
+
+void Assembler::leaData(Reg dst, std::uint32_t dataOffset)
+{
+    rex(true, encoding(dst), 0);
+    byte(0x8D);
+    byte(static_cast<std::uint8_t>(((encoding(dst) & 7) << 3) | 5)); // [rip + disp32]
+    relocations_.push_back({code_.size(), Relocation::Kind::Data, {}, static_cast<std::int64_t>(dataOffset) - 4});
+    imm32(0);
+}
+
+void Assembler::call(const std::string& symbol)
+{
+    byte(0xE8);
+    relocations_.push_back({code_.size(), Relocation::Kind::Call, symbol, -4});
+    imm32(0);
+}
+
+void Assembler::call(Reg target)
+{
+    rex(false, 0, encoding(target));
+    byte(0xFF);
+    modrm(2, Operand::r(target));
+}
+
+void Assembler::jmp(const std::string& symbol)
+{
+    byte(0xE9);
+    relocations_.push_back({code_.size(), Relocation::Kind::Call, symbol, -4});
+    imm32(0);
+}
+
+void Assembler::jmp(Reg target)
+{
+    rex(false, 0, encoding(target));
+    byte(0xFF);
+    modrm(4, Operand::r(target));
+}
+
+void Assembler::labelRef(Label label)
+{
+    fixups_.emplace_back(code_.size(), label);
+    imm32(0);
+}
+
+void Assembler::jmp(Label label)
+{
+    byte(0xE9);
+    labelRef(label);
+}
+
+void Assembler::jcc(Cond cond, Label label)
+{
+    byte(0x0F);
+    byte(static_cast<std::uint8_t>(0x80 | static_cast<unsigned>(cond)));
+    labelRef(label);
+}
+
+void Assembler::ret() { byte(0xC3); }
+
+void Assembler::finish()
+{
+    for (const auto& [offset, label] : fixups_) {
+        if (labels_[label] < 0) {
+            throw std::logic_error("x86 assembler: jump to an unbound label");
+        }
+        const auto rel = static_cast<std::int32_t>(labels_[label] - static_cast<std::int64_t>(offset + 4));
+        const auto bits = static_cast<std::uint32_t>(rel);
+        for (int i = 0; i < 4; ++i) {
+            code_[offset + static_cast<std::size_t>(i)] = static_cast<std::uint8_t>(bits >> (8 * i));
+        }
+    }
+    fixups_.clear();
+}
+
+} // namespace istudio::x86
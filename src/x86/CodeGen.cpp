@@ -0,0 +1,706 @@
+#include "x86/CodeGen.h"
+
+#include "ir/Liveness.h"
+#include "ir/PassManager.h"
+#include "x86/LinearScan.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+
+namespace istudio::x86 {
+
+namespace {
+
+using ir::IRBasicBlock;
+using ir::IRFunction;
+using ir::IRInstruction;
+using ir::IRInstructionOp;
+using ir::IRType;
+using ir::IRValue;
+using ir::IRValueKind;
+
+// rax, rcx and rdx are scratch (division, shifts, results) and r11 carries
+// memory-to-memory moves, so none of them is allocated.
+constexpr std::array kCallerSaved{Reg::Rsi, Reg::Rdi, Reg::R8, Reg::R9, Reg::R10};
+constexpr std::array kCalleeSaved{Reg::Rbx, Reg::R12, Reg::R13, Reg::R14, Reg::R15};
+constexpr std::array kArgumentRegisters{Reg::Rdi, Reg::Rsi, Reg::Rdx, Reg::Rcx, Reg::R8, Reg::R9};
+
+// Standard library functions that map onto a C library call. A `format` becomes
+// the first argument, for printf.
+struct RuntimeFunction {
+    std::string_view name;
+    std::string_view symbol;
+    std::string_view format;
+    IRType parameter;
+};
+
+constexpr std::array kRuntimeFunctions{
+    RuntimeFunction{"print", "printf", "%s", IRType::String},
+    RuntimeFunction{"println", "puts", "", IRType::String},
+    RuntimeFunction{"printNumber", "printf", "%lld", IRType::Int},
+    RuntimeFunction{"abs", "llabs", "", IRType::Int},
+};
+
+const RuntimeFunction* findRuntimeFunction(std::string_view name)
+{
+    for (const RuntimeFunction& function : kRuntimeFunctions) {
+        if (function.name == name) {
+            return &function;
+        }
+    }
+    return nullptr;
+}
+
+struct CodeGenError {
+    std::string message;
+};
+
+bool isScalar(IRType type) { return type == IRType::Int || type == IRType::Bool; }
+
+std::optional<Cond> condition(IRInstructionOp op)
+{
+    switch (op) {
+    case IRInstructionOp::Eq: return Cond::Equal;
+    case IRInstructionOp::Ne: return Cond::NotEqual;
+    case IRInstructionOp::Lt: return Cond::Less;
+    case IRInstructionOp::Le: return Cond::LessEqual;
+    case IRInstructionOp::Gt: return Cond::Greater;
+    case IRInstructionOp::Ge: return Cond::GreaterEqual;
+    default: return std::nullopt;
+    }
+}
+
+Cond inverse(Cond cond) { return static_cast<Cond>(static_cast<std::uint8_t>(cond) ^ 1); }
+
+// A comparison whose only use is the conditional branch right after it sets the
+// flags for that branch instead of materializing a Bool.
+bool feedsBranch(const IRInstruction& compare)
+{
+    const IRInstruction* next = compare.getNextNode();
+    return condition(compare.getOp()) && next && next->getOp() == IRInstructionOp::BranchIf &&
+           next->getOperand(0) == &compare && compare.getNumUses() == 1;
+}
+
+std::optional<Assembler::Alu> aluOp(IRInstructionOp op)
+{
+    switch (op) {
+    case IRInstructionOp::Add: return Assembler::Alu::Add;
+    case IRInstructionOp::Sub: return Assembler::Alu::Sub;
+    case IRInstructionOp::And: return Assembler::Alu::And;
+    case IRInstructionOp::Or: return Assembler::Alu::Or;
+    case IRInstructionOp::Xor: return Assembler::Alu::Xor;
+    default: return std::nullopt;
+    }
+}
+
+class FunctionCodeGen {
+public:
+    FunctionCodeGen(const IRFunction& function, const ir::IRModule& module, ObjectCode& object,
+                    const RuntimeChecks& checks = {})
+        : function_(function), module_(module), object_(object), checks_(checks)
+    {
+    }
+
+    void compile()
+    {
+        validate();
+        generate();
+    }
+
+    void validate() const
+    {
+        if (!isScalar(function_.getType()) && function_.getType() != IRType::Void) {
+            unsupported(std::string("return type ") + ir::toString(function_.getType()));
+        }
+        if (function_.getArguments().size() > kArgumentRegisters.size()) {
+            unsupported("more than 6 parameters");
+        }
+        for (const ir::IRArgument* argument : function_.getArguments()) {
+            if (!isScalar(argument->getType())) {
+                unsupported(std::string("parameter of type ") + ir::toString(argument->getType()));
+            }
+        }
+        for (const IRBasicBlock& block : function_.getBasicBlocks()) {
+            for (const IRInstruction& inst : block) {
+                validate(inst);
+            }
+        }
+    }
+
+private:
+    void generate()
+    {
+        ir::FunctionAnalyses analyses(function_);
+        allocation_ = allocateRegisters(function_, analyses.get<ir::LivenessAnalysis>(),
+                                        {std::span<const Reg>(kCallerSaved), std::span<const Reg>(kCalleeSaved)});
+        for (const IRBasicBlock& block : function_.getBasicBlocks()) {
+            labels_[&block] = assembler_.newLabel();
+        }
+
+        emitPrologue();
+        const auto& blocks = function_.getBasicBlocks();
+        for (auto it = blocks.begin(); it != blocks.end(); ++it) {
+            assembler_.bind(labels_.at(&*it));
+            const IRBasicBlock* next = std::next(it) != blocks.end() ? &*std::next(it) : nullptr;
+            for (const IRInstruction& inst : *it) {
+                lower(inst, next);
+            }
+        }
+        for (const auto& [label, message] : traps_) {
+            assembler_.bind(label);
+            assembler_.leaData(Reg::Rdi, message);
+            assembler_.call(std::string(kTrapSymbol));
+        }
+        assembler_.finish();
+
+        const std::size_t base = object_.text.size();
+        object_.text.insert(object_.text.end(), assembler_.code().begin(), assembler_.code().end());
+        for (Relocation relocation : assembler_.relocations()) {
+            relocation.offset += base;
+            object_.relocations.push_back(std::move(relocation));
+        }
+        object_.functions.push_back({function_.getName(), base, assembler_.size()});
+    }
+
+    struct Move {
+        Location to;
+        Location from;
+        const IRValue* constant{nullptr}; // instead of `from`
+    };
+
+    [[noreturn]] void unsupported(const std::string& what) const
+    {
+        throw CodeGenError{"x86-64 backend: " + what + " in function '" + function_.getName() + "'"};
+    }
+
+    void validate(const IRInstruction& inst) const
+    {
+        switch (inst.getOp()) {
+        case IRInstructionOp::Load:
+        case IRInstructionOp::Store:
+        case IRInstructionOp::Alloca:
+        case IRInstructionOp::GetElementPtr:
+            unsupported(std::string("instruction '") + ir::toString(inst.getOp()) + "'");
+        default:
+            break;
+        }
+        if (inst.getType() != IRType::Void && !isScalar(inst.getType())) {
+            unsupported(std::string(ir::toString(inst.getType())) + " value");
+        }
+        const RuntimeFunction* runtime = nullptr;
+        if (inst.getOp() == IRInstructionOp::Call) {
+            const bool defined = std::any_of(module_.getFunctions().begin(), module_.getFunctions().end(),
+                                             [&](const auto& f) { return f->getName() == inst.getCallee(); });
+            runtime = defined ? nullptr : findRuntimeFunction(inst.getCallee());
+            if (!defined && !runtime) {
+                unsupported("call to '" + inst.getCallee() + "'");
+            }
+            if (inst.getNumOperands() + (runtime && !runtime->format.empty() ? 1 : 0) > kArgumentRegisters.size()) {
+                unsupported("call with more than 6 arguments");
+            }
+        }
+        for (std::size_t i = 0; i < inst.getNumOperands(); ++i) {
+            const IRValue* operand = inst.getOperand(i);
+            const bool stringArgument = runtime && runtime->parameter == IRType::String &&
+                                        operand->getKind() == IRValueKind::Constant &&
+                                        operand->getType() == IRType::String;
+            if (!isScalar(operand->getType()) && !stringArgument) {
+                unsupported(std::string(ir::toString(operand->getType())) + " operand of '" +
+                            ir::toString(inst.getOp()) + "'");
+            }
+        }
+    }
+
+    std::size_t savedRegisters() const { return allocation_.usedCalleeSaved.size(); }
+
+    // A label after the function body that calls the trap with `message`; the
+    // stack is aligned there as it is for any call.
+    Assembler::Label trap(std::string_view message)
+    {
+        const std::uint32_t offset = object_.addString(message);
+        for (const auto& [label, existing] : traps_) {
+            if (existing == offset) {
+                return label;
+            }
+        }
+        const Assembler::Label label = assembler_.newLabel();
+        traps_.emplace_back(label, offset);
+        return label;
+    }
+
+    Operand operand(Location location) const
+    {
+        if (location.kind == Location::Kind::Register) {
+            return Operand::r(location.reg);
+        }
+        const auto below = static_cast<std::int32_t>(8 * (savedRegisters() + location.slot + 1));
+        return Operand::frame(-below);
+    }
+
+    Location location(const IRValue* value) const { return allocation_.locations[value->getId()]; }
+
+    static Location inRegister(Reg reg) { return {Location::Kind::Register, reg, 0}; }
+
+    // Puts the value of `value` in `dst`.
+    void load(Reg dst, const IRValue* value)
+    {
+        if (value->getKind() != IRValueKind::Constant) {
+            assembler_.mov(dst, operand(location(value)));
+            return;
+        }
+        const auto& constant = static_cast<const ir::IRConstant*>(value)->getValue();
+        if (const auto* integer = std::get_if<std::int64_t>(&constant)) {
+            assembler_.movImm(dst, *integer);
+        } else if (const auto* boolean = std::get_if<bool>(&constant)) {
+            assembler_.movImm(dst, *boolean ? 1 : 0);
+        } else if (const auto* text = std::get_if<std::string>(&constant)) {
+            assembler_.leaData(dst, object_.addString(*text));
+        } else {
+            assembler_.movImm(dst, 0); // undef
+        }
+    }
+
+    void store(const IRValue* value, Reg src)
+    {
+        const Location where = location(value);
+        if (where.kind != Location::Kind::None) {
+            assembler_.mov(operand(where), src);
+        }
+    }
+
+    // A constant that fits an instruction's 32-bit immediate.
+    static std::optional<std::int32_t> immediate(const IRValue* value)
+    {
+        if (value->getKind() != IRValueKind::Constant) {
+            return std::nullopt;
+        }
+        const auto& constant = static_cast<const ir::IRConstant*>(value)->getValue();
+        std::int64_t number = 0;
+        if (const auto* integer = std::get_if<std::int64_t>(&constant)) {
+            number = *integer;
+        } else if (const auto* boolean = std::get_if<bool>(&constant)) {
+            number = *boolean ? 1 : 0;
+        } else if (!std::holds_alternative<std::monostate>(constant)) {
+            return std::nullopt;
+        }
+        if (number < INT32_MIN || number > INT32_MAX) {
+            return std::nullopt;
+        }
+        return static_cast<std::int32_t>(number);
+    }
+
+    // The right-hand operand as a register or stack slot, loading constants that
+    // need it into rcx.
+    Operand source(const IRValue* value)
+    {
+        if (value->getKind() == IRValueKind::Constant) {
+            load(Reg::Rcx, value);
+            return Operand::r(Reg::Rcx);
+        }
+        return operand(location(value));
+    }
+
+    void emitPrologue()
+    {
+        assembler_.push(Reg::Rbp);
+        assembler_.mov(Operand::r(Reg::Rbp), Reg::Rsp);
+        for (Reg reg : allocation_.usedCalleeSaved) {
+            assembler_.push(reg);
+        }
+        // Keep rsp 16-byte aligned for calls: rbp is, after the push above.
+        const std::size_t words = savedRegisters() + allocation_.stackSlots;
+        assembler_.subRsp(static_cast<std::int32_t>(8 * allocation_.stackSlots + (words % 2 != 0 ? 8 : 0)));
+        if (checks_.stackLimit != 0) {
+            // Only r11 is clobbered: the arguments are still in their registers.
+            assembler_.movAbs(Reg::R11, checks_.stackLimit);
+            assembler_.alu(Assembler::Alu::Cmp, Reg::Rsp, Operand::r(Reg::R11));
+            assembler_.jcc(Cond::Less, trap("stack overflow in call to '" + function_.getName() + "'"));
+        }
+
+        std::vector<Move> moves;
+        for (const ir::IRArgument* argument : function_.getArguments()) {
+            moves.push_back({location(argument), inRegister(kArgumentRegisters[argument->getIndex()])});
+        }
+        emitParallelMoves(std::move(moves));
+    }
+
+    void emitEpilogue()
+    {
+        leaveFrame();
+        assembler_.ret();
+    }
+
+    // Restores the registers and stack pointer the caller handed over, leaving the
+    // return address on top.
+    void leaveFrame()
+    {
+        if (savedRegisters() != 0) {
+            assembler_.leaRspFromRbp(-static_cast<std::int32_t>(8 * savedRegisters()));
+        } else {
+            assembler_.mov(Operand::r(Reg::Rsp), Reg::Rbp);
+        }
+        for (auto it = allocation_.usedCalleeSaved.rbegin(); it != allocation_.usedCalleeSaved.rend(); ++it) {
+            assembler_.pop(*it);
+        }
+        assembler_.pop(Reg::Rbp);
+    }
+
+    void moveOne(const Move& move)
+    {
+        if (move.constant) {
+            if (move.to.kind == Location::Kind::Register) {
+                load(move.to.reg, move.constant);
+            } else {
+                load(Reg::R11, move.constant);
+                assembler_.mov(operand(move.to), Reg::R11);
+            }
+        } else if (move.to.kind == Location::Kind::Register) {
+            assembler_.mov(move.to.reg, operand(move.from));
+        } else if (move.from.kind == Location::Kind::Register) {
+            assembler_.mov(operand(move.to), move.from.reg);
+        } else {
+            assembler_.mov(Reg::R11, operand(move.from));
+            assembler_.mov(operand(move.to), Reg::R11);
+        }
+    }
+
+    // Performs all moves as if at once: a destination is only written once nothing
+    // still reads it, and cycles are broken by parking one value in rax. Constants,
+    // which read no location, go last.
+    void emitParallelMoves(std::vector<Move> moves)
+    {
+        std::erase_if(moves, [](const Move& move) {
+            return move.to.kind == Location::Kind::None || (!move.constant && move.to == move.from);
+        });
+        std::vector<Move> constants;
+        std::erase_if(moves, [&constants](const Move& move) {
+            if (move.constant) {
+                constants.push_back(move);
+            }
+            return move.constant != nullptr;
+        });
+        while (!moves.empty()) {
+            auto ready = std::find_if(moves.begin(), moves.end(), [&moves](const Move& move) {
+                return std::none_of(moves.begin(), moves.end(),
+                                    [&move](const Move& other) { return other.from == move.to; });
+            });
+            if (ready == moves.end()) {
+                const Location parked = moves.front().to;
+                assembler_.mov(Reg::Rax, operand(parked));
+                for (Move& move : moves) {
+                    if (move.from == parked) {
+                        move.from = inRegister(Reg::Rax);
+                    }
+                }
+                continue;
+            }
+            moveOne(*ready);
+            moves.erase(ready);
+        }
+        for (const Move& move : constants) {
+            moveOne(move);
+        }
+    }
+
+    std::vector<Move> edgeMoves(const IRBasicBlock* from, const IRBasicBlock* to) const
+    {
+        std::vector<Move> moves;
+        for (const IRInstruction& phi : *to) {
+            if (phi.getOp() != IRInstructionOp::Phi) {
+                break;
+            }
+            const auto& incoming = phi.getBlocks();
+            const auto it = std::find(incoming.begin(), incoming.end(), from);
+            if (it == incoming.end()) {
+                continue;
+            }
+            const IRValue* value = phi.getOperand(static_cast<std::size_t>(it - incoming.begin()));
+            if (value->getKind() == IRValueKind::Constant) {
+                moves.push_back({location(&phi), {}, value});
+            } else if (location(value) != location(&phi)) {
+                moves.push_back({location(&phi), location(value)});
+            }
+        }
+        return moves;
+    }
+
+    void emitEdge(const IRBasicBlock* from, const IRBasicBlock* to, const IRBasicBlock* next)
+    {
+        emitParallelMoves(edgeMoves(from, to));
+        if (to != next) {
+            assembler_.jmp(labels_.at(to));
+        }
+    }
+
+    void lower(const IRInstruction& inst, const IRBasicBlock* next)
+    {
+        const IRInstructionOp op = inst.getOp();
+        if (const auto alu = aluOp(op)) {
+            load(Reg::Rax, inst.getOperand(0));
+            if (const auto imm = immediate(inst.getOperand(1))) {
+                assembler_.aluImm(*alu, Reg::Rax, *imm);
+            } else {
+                assembler_.alu(*alu, Reg::Rax, source(inst.getOperand(1)));
+            }
+            store(&inst, Reg::Rax);
+            return;
+        }
+        if (const auto cond = condition(op)) {
+            if (!feedsBranch(inst)) {
+                emitCompare(inst);
+                assembler_.setcc(*cond);
+                store(&inst, Reg::Rax);
+            }
+            return;
+        }
+        switch (op) {
+        case IRInstructionOp::Mul:
+            if (const auto imm = immediate(inst.getOperand(1))) {
+                load(Reg::Rax, inst.getOperand(0));
+                assembler_.imulImm(Reg::Rax, Reg::Rax, *imm);
+            } else {
+                load(Reg::Rax, inst.getOperand(0));
+                assembler_.imul(Reg::Rax, source(inst.getOperand(1)));
+            }
+            store(&inst, Reg::Rax);
+            return;
+        case IRInstructionOp::Div:
+        case IRInstructionOp::Rem:
+            lowerDivision(inst);
+            return;
+        case IRInstructionOp::Shl:
+        case IRInstructionOp::Shr:
+            load(Reg::Rcx, inst.getOperand(1));
+            load(Reg::Rax, inst.getOperand(0));
+            if (op == IRInstructionOp::Shl) {
+                assembler_.shlCl(Reg::Rax);
+            } else {
+                assembler_.sarCl(Reg::Rax);
+            }
+            store(&inst, Reg::Rax);
+            return;
+        case IRInstructionOp::Neg:
+            load(Reg::Rax, inst.getOperand(0));
+            assembler_.neg(Reg::Rax);
+            store(&inst, Reg::Rax);
+            return;
+        case IRInstructionOp::Not:
+            load(Reg::Rax, inst.getOperand(0));
+            assembler_.test(Reg::Rax, Reg::Rax);
+            assembler_.setcc(Cond::Equal);
+            store(&inst, Reg::Rax);
+            return;
+        case IRInstructionOp::Assign:
+            load(Reg::Rax, inst.getOperand(0));
+            store(&inst, Reg::Rax);
+            return;
+        case IRInstructionOp::Phi:
+            return; // moved into place on the incoming edges
+        case IRInstructionOp::Call:
+            lowerCall(inst);
+            return;
+        case IRInstructionOp::Return:
+            if (inst.getPrevNode() && inst.getPrevNode() == tailJump_) {
+                return; // the callee returns to our caller
+            }
+            if (inst.getNumOperands() != 0) {
+                load(Reg::Rax, inst.getOperand(0));
+            } else {
+                assembler_.movImm(Reg::Rax, 0);
+            }
+            emitEpilogue();
+            return;
+        case IRInstructionOp::Branch:
+            emitEdge(inst.getParent(), inst.getBlocks()[0], next);
+            return;
+        case IRInstructionOp::BranchIf:
+            lowerBranchIf(inst, next);
+            return;
+        default:
+            unsupported(std::string("instruction '") + ir::toString(op) + "'");
+        }
+    }
+
+    // idiv faults on a zero divisor and on INT64_MIN / -1. The first is trapped
+    // when checked; the second wraps, as in the VM: x / -1 is -x and x % -1 is 0.
+    void lowerDivision(const IRInstruction& inst)
+    {
+        const bool quotient = inst.getOp() == IRInstructionOp::Div;
+        const auto divisor = immediate(inst.getOperand(1));
+        load(Reg::Rcx, inst.getOperand(1));
+        load(Reg::Rax, inst.getOperand(0));
+        if (divisor && *divisor != 0 && *divisor != -1) {
+            assembler_.cqo();
+            assembler_.idiv(Reg::Rcx);
+            store(&inst, quotient ? Reg::Rax : Reg::Rdx);
+            return;
+        }
+        if (checks_.divisionByZero) {
+            assembler_.test(Reg::Rcx, Reg::Rcx);
+            assembler_.jcc(Cond::Equal, trap("integer division by zero"));
+        }
+        const Assembler::Label divide = assembler_.newLabel();
+        const Assembler::Label done = assembler_.newLabel();
+        assembler_.aluImm(Assembler::Alu::Cmp, Reg::Rcx, -1);
+        assembler_.jcc(Cond::NotEqual, divide);
+        if (quotient) {
+            assembler_.neg(Reg::Rax);
+        } else {
+            assembler_.movImm(Reg::Rdx, 0);
+        }
+        assembler_.jmp(done);
+        assembler_.bind(divide);
+        assembler_.cqo();
+        assembler_.idiv(Reg::Rcx);
+        assembler_.bind(done);
+        store(&inst, quotient ? Reg::Rax : Reg::Rdx);
+    }
+
+    void emitCompare(const IRInstruction& compare)
+    {
+        load(Reg::Rax, compare.getOperand(0));
+        if (const auto imm = immediate(compare.getOperand(1))) {
+            assembler_.aluImm(Assembler::Alu::Cmp, Reg::Rax, *imm);
+        } else {
+            assembler_.alu(Assembler::Alu::Cmp, Reg::Rax, source(compare.getOperand(1)));
+        }
+    }
+
+    void lowerCall(const IRInstruction& inst)
+    {
+        const bool defined = std::any_of(module_.getFunctions().begin(), module_.getFunctions().end(),
+                                         [&](const auto& f) { return f->getName() == inst.getCallee(); });
+        const RuntimeFunction* runtime = defined ? nullptr : findRuntimeFunction(inst.getCallee());
+        const std::size_t first = runtime && !runtime->format.empty() ? 1 : 0;
+
+        std::vector<Move> moves;
+        for (std::size_t i = 0; i < inst.getNumOperands(); ++i) {
+            const IRValue* value = inst.getOperand(i);
+            const Location to = inRegister(kArgumentRegisters[first + i]);
+            if (value->getKind() == IRValueKind::Constant) {
+                moves.push_back({to, {}, value});
+            } else {
+                moves.push_back({to, location(value)});
+            }
+        }
+        emitParallelMoves(std::move(moves));
+        if (first != 0) {
+            assembler_.leaData(Reg::Rdi, object_.addString(runtime->format));
+        }
+        if (runtime && runtime->symbol == "printf") {
+            assembler_.movImm(Reg::Rax, 0); // no vector registers used by the variadic call
+        }
+        // The arguments all travel in registers, so a marked call of a module
+        // function can reuse the return address: tear the frame down and jump. A
+        // void call out of `main` still has to return 0 itself.
+        if (defined && inst.isTailCall() && (inst.getType() != IRType::Void || function_.getName() != "main")) {
+            leaveFrame();
+            assembler_.jmp(inst.getCallee());
+            tailJump_ = &inst;
+            return;
+        }
+        assembler_.call(runtime ? std::string(runtime->symbol) : inst.getCallee());
+        store(&inst, Reg::Rax);
+    }
+
+    void lowerBranchIf(const IRInstruction& inst, const IRBasicBlock* next)
+    {
+        const IRBasicBlock* block = inst.getParent();
+        const IRBasicBlock* onTrue = inst.getBlocks()[0];
+        const IRBasicBlock* onFalse = inst.getBlocks()[1];
+        Cond taken = Cond::NotEqual;
+        const IRValue* value = inst.getOperand(0);
+        if (value->getKind() == IRValueKind::Instruction && feedsBranch(*static_cast<const IRInstruction*>(value))) {
+            const auto& compare = *static_cast<const IRInstruction*>(value);
+            emitCompare(compare);
+            taken = *condition(compare.getOp());
+        } else {
+            load(Reg::Rax, value);
+            assembler_.test(Reg::Rax, Reg::Rax);
+        }
+        if (edgeMoves(block, onTrue).empty() && onTrue != next) {
+            assembler_.jcc(taken, labels_.at(onTrue));
+            emitEdge(block, onFalse, next);
+            return;
+        }
+        if (edgeMoves(block, onFalse).empty()) {
+            assembler_.jcc(inverse(taken), labels_.at(onFalse));
+            emitEdge(block, onTrue, next);
+            return;
+        }
+        const Assembler::Label falseEdge = assembler_.newLabel();
+        assembler_.jcc(inverse(taken), falseEdge);
+        emitEdge(block, onTrue, nullptr);
+        assembler_.bind(falseEdge);
+        emitEdge(block, onFalse, next);
+    }
+
+    const IRFunction& function_;
+    const ir::IRModule& module_;
+    ObjectCode& object_;
+    RuntimeChecks checks_;
+    Assembler assembler_;
+    Allocation allocation_;
+    std::unordered_map<const IRBasicBlock*, Assembler::Label> labels_;
+    const IRInstruction* tailJump_{nullptr}; // its Return is not emitted
+    std::vector<std::pair<Assembler::Label, std::uint32_t>> traps_; // label, message in rodata
+};
+
+} // namespace
+
+std::uint32_t ObjectCode::addString(std::string_view value)
+{
+    // Strings are few; a linear search keeps the section free of duplicates.
+    for (std::size_t offset = 0; offset < rodata.size();) {
+        const auto* start = reinterpret_cast<const char*>(rodata.data() + offset);
+        const std::size_t length = std::strlen(start);
+        if (std::string_view(start, length) == value) {
+            return static_cast<std::uint32_t>(offset);
+        }
+        offset += length + 1;
+    }
+    const auto offset = static_cast<std::uint32_t>(rodata.size());
+    rodata.insert(rodata.end(), value.begin(), value.end());
+    rodata.push_back(0);
+    return offset;
+}
+
+std::expected<void, std::string> compileFunction(const ir::IRFunction& function, const ir::IRModule& module,
+                                                 ObjectCode& object, const RuntimeChecks& checks)
+{
+    try {
+        FunctionCodeGen(function, module, object, checks).compile();
+    } catch (const CodeGenError& error) {
+        return std::unexpected(error.message);
+    }
+    return {};
+}
+
+std::expected<void, std::string> checkFunction(const ir::IRFunction& function, const ir::IRModule& module)
+{
+    ObjectCode unused;
+    try {
+        FunctionCodeGen(function, module, unused).validate();
+    } catch (const CodeGenError& error) {
+        return std::unexpected(error.message);
+    }
+    return {};
+}
+
+std::expected<ObjectCode, std::string> compileModule(const ir::IRModule& module)
+{
+    ObjectCode object;
+    for (const auto& function : module.getFunctions()) {
+        if (auto compiled = compileFunction(*function, module, object); !compiled) {
+            return std::unexpected(compiled.error());
+        }
+    }
+    return object;
+}
+
+} // namespace istudio::x86
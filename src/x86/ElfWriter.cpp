@@ -0,0 +1,197 @@
+#include "x86/ElfWriter.h"
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace istudio::x86 {
+
+namespace {
+
+// ELF64 structures, written field by field in little-endian order.
+class Buffer {
+public:
+    void u8(std::uint8_t value) { bytes_.push_back(value); }
+    void u16(std::uint16_t value) { little(value, 2); }
+    void u32(std::uint32_t value) { little(value, 4); }
+    void u64(std::uint64_t value) { little(value, 8); }
+    void append(const std::vector<std::uint8_t>& data) { bytes_.insert(bytes_.end(), data.begin(), data.end()); }
+    void align(std::size_t alignment)
+    {
+        while (bytes_.size() % alignment != 0) {
+            bytes_.push_back(0);
+        }
+    }
+    [[nodiscard]] std::size_t size() const { return bytes_.size(); }
+    [[nodiscard]] const std::vector<std::uint8_t>& bytes() const { return bytes_; }
+
+private:
+    void little(std::uint64_t value, int width)
+    {
+        for (int i = 0; i < width; ++i) {
+            bytes_.push_back(static_cast<std::uint8_t>(value >> (8 * i)));
+        }
+    }
+
+    std::vector<std::uint8_t> bytes_;
+};
+
+class StringTable {
+public:
+    StringTable() { data_.push_back(0); }
+
+    std::uint32_t add(const std::string& text)
+    {
+        const auto offset = static_cast<std::uint32_t>(data_.size());
+        data_.insert(data_.end(), text.begin(), text.end());
+        data_.push_back(0);
+        return offset;
+    }
+    [[nodiscard]] const std::vector<std::uint8_t>& data() const { return data_; }
+
+private:
+    std::vector<std::uint8_t> data_;
+};
+
+constexpr std::uint32_t kShtProgbits = 1;
+constexpr std::uint32_t kShtSymtab = 2;
+constexpr std::uint32_t kShtStrtab = 3;
+constexpr std::uint32_t kShtRela = 4;
+constexpr std::uint64_t kShfAlloc = 0x2;
+constexpr std::uint64_t kShfExecinstr = 0x4;
+constexpr std::uint64_t kShfInfoLink = 0x40;
+constexpr std::uint8_t kStbLocal = 0;
+constexpr std::uint8_t kStbGlobal = 1;
+constexpr std::uint8_t kSttNotype = 0;
+constexpr std::uint8_t kSttFunc = 2;
+constexpr std::uint8_t kSttSection = 3;
+constexpr std::uint32_t kRX86_64Pc32 = 2;
+constexpr std::uint32_t kRX86_64Plt32 = 4;
+
+// Section indices, in the order the headers are written.
+enum Section : std::uint16_t { Null, Text, Rodata, RelaText, Symtab, Strtab, Shstrtab, NoteStack, SectionCount };
+
+struct SectionHeader {
+    std::uint32_t name{0};
+    std::uint32_t type{0};
+    std::uint64_t flags{0};
+    std::uint64_t offset{0};
+    std::uint64_t size{0};
+    std::uint32_t link{0};
+    std::uint32_t info{0};
+    std::uint64_t align{1};
+    std::uint64_t entsize{0};
+};
+
+void symbol(Buffer& out, std::uint32_t name, std::uint8_t bind, std::uint8_t type, std::uint16_t section,
+            std::uint64_t value, std::uint64_t size)
+{
+    out.u32(name);
+    out.u8(static_cast<std::uint8_t>((bind << 4) | type));
+    out.u8(0); // default visibility
+    out.u16(section);
+    out.u64(value);
+    out.u64(size);
+}
+
+} // namespace
+
+void writeElfObject(const ObjectCode& object, std::ostream& out)
+{
+    // Symbols: null, the .text and .rodata section symbols, then the globals.
+    StringTable strings;
+    Buffer symbols;
+    symbol(symbols, 0, 0, 0, 0, 0, 0);
+    symbol(symbols, 0, kStbLocal, kSttSection, Text, 0, 0);
+    symbol(symbols, 0, kStbLocal, kSttSection, Rodata, 0, 0);
+    constexpr std::uint32_t kRodataSymbol = 2;
+    constexpr std::uint32_t kFirstGlobal = 3;
+
+    std::unordered_map<std::string, std::uint32_t> symbolIndex;
+    std::uint32_t next = kFirstGlobal;
+    for (const ObjectCode::Symbol& function : object.functions) {
+        symbol(symbols, strings.add(function.name), kStbGlobal, kSttFunc, Text, function.offset, function.size);
+        symbolIndex.emplace(function.name, next++);
+    }
+    for (const Relocation& relocation : object.relocations) {
+        if (relocation.kind == Relocation::Kind::Call && !symbolIndex.contains(relocation.symbol)) {
+            symbol(symbols, strings.add(relocation.symbol), kStbGlobal, kSttNotype, Null, 0, 0);
+            symbolIndex.emplace(relocation.symbol, next++);
+        }
+    }
+
+    Buffer relocations;
+    for (const Relocation& relocation : object.relocations) {
+        const bool call = relocation.kind == Relocation::Kind::Call;
+        const std::uint64_t index = call ? symbolIndex.at(relocation.symbol) : kRodataSymbol;
+        relocations.u64(relocation.offset);
+        relocations.u64((index << 32) | (call ? kRX86_64Plt32 : kRX86_64Pc32));
+        relocations.u64(static_cast<std::uint64_t>(relocation.addend));
+    }
+
+    StringTable sectionNames;
+    SectionHeader headers[SectionCount];
+    headers[Null].align = 0;
+    headers[Text] = {sectionNames.add(".text"), kShtProgbits, kShfAlloc | kShfExecinstr, 0, 0, 0, 0, 16, 0};
+    headers[Rodata] = {sectionNames.add(".rodata"), kShtProgbits, kShfAlloc, 0, 0, 0, 0, 1, 0};
+    headers[RelaText] = {sectionNames.add(".rela.text"), kShtRela, kShfInfoLink, 0, 0, Symtab, Text, 8, 24};
+    headers[Symtab] = {sectionNames.add(".symtab"), kShtSymtab, 0, 0, 0, Strtab, kFirstGlobal, 8, 24};
+    headers[Strtab] = {sectionNames.add(".strtab"), kShtStrtab, 0, 0, 0, 0, 0, 1, 0};
+    headers[NoteStack] = {sectionNames.add(".note.GNU-stack"), kShtProgbits, 0, 0, 0, 0, 0, 1, 0};
+    headers[Shstrtab] = {sectionNames.add(".shstrtab"), kShtStrtab, 0, 0, 0, 0, 0, 1, 0};
+
+    // Layout: ELF header, section contents, section header table.
+    constexpr std::size_t kElfHeaderSize = 64;
+    Buffer body;
+    auto place = [&](Section section, const std::vector<std::uint8_t>& data) {
+        body.align(headers[section].align);
+        headers[section].offset = kElfHeaderSize + body.size();
+        headers[section].size = data.size();
+        body.append(data);
+    };
+    place(Text, object.text);
+    place(Rodata, object.rodata);
+    place(RelaText, relocations.bytes());
+    place(Symtab, symbols.bytes());
+    place(Strtab, strings.data());
+    place(Shstrtab, sectionNames.data());
+    headers[NoteStack].offset = kElfHeaderSize + body.size();
+    body.align(8);
+    const std::uint64_t sectionHeaderOffset = kElfHeaderSize + body.size();
+
+    Buffer file;
+    const std::uint8_t ident[16] = {0x7F, 'E', 'L', 'F', 2 /* 64-bit */, 1 /* little-endian */, 1 /* version */};
+    for (std::uint8_t byte : ident) {
+        file.u8(byte);
+    }
+    file.u16(1);    // ET_REL
+    file.u16(62);   // EM_X86_64
+    file.u32(1);    // EV_CURRENT
+    file.u64(0);    // entry
+    file.u64(0);    // program headers
+    file.u64(sectionHeaderOffset);
+    file.u32(0);    // flags
+    file.u16(kElfHeaderSize);
+    file.u16(0);    // program header entry size
+    file.u16(0);    // program header count
+    file.u16(64);   // section header entry size
+    file.u16(SectionCount);
+    file.u16(Shstrtab);
+    file.append(body.bytes());
+    for (const SectionHeader& header : headers) {
+        file.u32(header.name);
+        file.u32(header.type);
+        file.u64(header.flags);
+        file.u64(0); // address
+        file.u64(header.offset);
+        file.u64(header.size);
+        file.u32(header.link);
+        file.u32(header.info);
+        file.u64(header.align);
+        file.u64(header.entsize);
+    }
+    out.write(reinterpret_cast<const char*>(file.bytes().data()), static_cast<std::streamsize>(file.size()));
+}
+
+} // namespace istudio::x86
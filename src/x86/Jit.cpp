@@ -0,0 +1,293 @@
+#include "x86/Jit.h"
+
+#include "x86/Assembler.h"
+#include "x86/CodeGen.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__x86_64__) && (defined(__linux__) || defined(__unix__) || defined(__APPLE__))
+#define ISTUDIO_JIT_SUPPORTED 1
+#include <dlfcn.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#else
+#define ISTUDIO_JIT_SUPPORTED 0
+#endif
+
+namespace istudio::x86 {
+
+namespace {
+
+// Code, stubs and string data share one reservation, so every rel32 call or
+// reference between them is in range.
+constexpr std::size_t kRegionSize = std::size_t{64} << 20;
+
+// Stub layout. Before its function is compiled:
+//   movabs r11, <function index>   49 BB imm64
+//   jmp    <trampoline>            E9 rel32
+// afterwards:
+//   movabs r11, <function address> 49 BB imm64
+//   jmp    r11                     41 FF E3
+constexpr std::size_t kStubSize = 16;
+constexpr std::size_t kStubImmediate = 2;
+
+// Stack left below the limit the compiled code checks for: the trap, resolve()
+// compiling a function and the C library calls all run past it.
+constexpr std::size_t kStackReserve = std::size_t{256} << 10;
+
+// Lowest address of the calling thread's stack, or 0 where it is not known.
+std::uint64_t stackBottom()
+{
+#if ISTUDIO_JIT_SUPPORTED && defined(__linux__)
+    pthread_attr_t attributes;
+    if (pthread_getattr_np(pthread_self(), &attributes) != 0) {
+        return 0;
+    }
+    void* address = nullptr;
+    std::size_t size = 0;
+    const bool known = pthread_attr_getstack(&attributes, &address, &size) == 0;
+    pthread_attr_destroy(&attributes);
+    return known ? reinterpret_cast<std::uint64_t>(address) : 0;
+#elif ISTUDIO_JIT_SUPPORTED && defined(__APPLE__)
+    const auto top = reinterpret_cast<std::uint64_t>(pthread_get_stackaddr_np(pthread_self()));
+    return top - pthread_get_stacksize_np(pthread_self());
+#else
+    return 0;
+#endif
+}
+
+void put64(std::uint8_t* at, std::uint64_t value) { std::memcpy(at, &value, sizeof value); }
+
+void put32(std::uint8_t* at, std::int32_t value) { std::memcpy(at, &value, sizeof value); }
+
+[[noreturn]] void fail(const std::string& message)
+{
+    // Called from inside JIT code, where an exception cannot unwind.
+    std::fflush(stdout);
+    std::fprintf(stderr, "JIT error: %s\n", message.c_str());
+    std::abort();
+}
+
+} // namespace
+
+bool Jit::isSupported() { return ISTUDIO_JIT_SUPPORTED != 0; }
+
+Jit::Jit(const ir::IRModule& module) : module_(module)
+{
+    for (std::size_t i = 0; i < module.getFunctions().size(); ++i) {
+        functions_.emplace(module.getFunctions()[i]->getName(), i);
+    }
+}
+
+Jit::~Jit()
+{
+#if ISTUDIO_JIT_SUPPORTED
+    if (region_) {
+        munmap(region_, capacity_);
+    }
+#endif
+}
+
+std::expected<void, std::string> Jit::prepare()
+{
+    if (!isSupported()) {
+        return std::unexpected("the JIT needs an x86-64 host with mmap");
+    }
+    for (const auto& function : module_.getFunctions()) {
+        if (auto checked = checkFunction(*function, module_); !checked) {
+            return checked;
+        }
+    }
+#if ISTUDIO_JIT_SUPPORTED
+    if (!region_) {
+        void* memory = mmap(nullptr, kRegionSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (memory == MAP_FAILED) {
+            return std::unexpected("could not map memory for JIT code");
+        }
+        region_ = static_cast<std::uint8_t*>(memory);
+        capacity_ = kRegionSize;
+        writeTrampoline();
+        for (std::size_t i = 0; i < module_.getFunctions().size(); ++i) {
+            stubs_.push_back(createStub(i));
+        }
+        endWrite();
+    }
+#endif
+    return {};
+}
+
+std::expected<std::int64_t, std::string> Jit::run(std::string_view entry)
+{
+    if (auto prepared = prepare(); !prepared) {
+        return std::unexpected(prepared.error());
+    }
+    const auto it = functions_.find(std::string(entry));
+    if (it == functions_.end()) {
+        return std::unexpected("no function named '" + std::string(entry) + "'");
+    }
+    if (!module_.getFunctions()[it->second]->getArguments().empty()) {
+        return std::unexpected("entry function '" + std::string(entry) + "' must not take parameters");
+    }
+    if (const std::uint64_t bottom = stackBottom(); bottom != 0) {
+        stackLimit_ = bottom + kStackReserve;
+    }
+    using EntryPoint = std::int64_t (*)();
+    const auto function = reinterpret_cast<EntryPoint>(stubs_[it->second]);
+    if (setjmp(trapJump_) != 0) {
+        std::fflush(stdout);
+        return std::unexpected(trapMessage_);
+    }
+    const std::int64_t result = function();
+    std::fflush(stdout);
+    return result;
+}
+
+std::uint8_t* Jit::allocate(std::size_t size, std::size_t alignment)
+{
+    const std::size_t start = (used_ + alignment - 1) / alignment * alignment;
+    if (start + size > capacity_) {
+        fail("out of code memory");
+    }
+    used_ = start + size;
+    return region_ + start;
+}
+
+void Jit::beginWrite()
+{
+#if ISTUDIO_JIT_SUPPORTED
+    mprotect(region_, capacity_, PROT_READ | PROT_WRITE);
+#endif
+}
+
+void Jit::endWrite()
+{
+#if ISTUDIO_JIT_SUPPORTED
+    const auto page = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    mprotect(region_, (used_ + page - 1) / page * page, PROT_READ | PROT_EXEC);
+#endif
+}
+
+// Entered from a stub with the function index in r11 and the caller's arguments
+// still in registers: saves them, has resolve() compile the function, then jumps
+// to it as if the stub had.
+void Jit::writeTrampoline()
+{
+    constexpr Reg kArguments[] = {Reg::Rdi, Reg::Rsi, Reg::Rdx, Reg::Rcx, Reg::R8, Reg::R9};
+    Assembler assembler;
+    for (Reg reg : kArguments) {
+        assembler.push(reg);
+    }
+    assembler.subRsp(8); // six pushes over the return address leave rsp 8 off alignment
+    assembler.movAbs(Reg::Rdi, reinterpret_cast<std::uint64_t>(this));
+    assembler.mov(Operand::r(Reg::Rsi), Reg::R11);
+    assembler.movAbs(Reg::Rax, reinterpret_cast<std::uint64_t>(&Jit::resolve));
+    assembler.call(Reg::Rax);
+    assembler.aluImm(Assembler::Alu::Add, Reg::Rsp, 8);
+    for (auto it = std::rbegin(kArguments); it != std::rend(kArguments); ++it) {
+        assembler.pop(*it);
+    }
+    assembler.jmp(Reg::Rax);
+    trampoline_ = allocate(assembler.size(), 16);
+    std::memcpy(trampoline_, assembler.code().data(), assembler.size());
+}
+
+std::uint8_t* Jit::createStub(std::uint64_t index)
+{
+    std::uint8_t* stub = allocate(kStubSize, kStubSize);
+    stub[0] = 0x49;
+    stub[1] = 0xBB;
+    put64(stub + kStubImmediate, index);
+    stub[10] = 0xE9;
+    put32(stub + 11, static_cast<std::int32_t>(trampoline_ - (stub + 15)));
+    return stub;
+}
+
+std::uint8_t* Jit::externalStub(const std::string& symbol)
+{
+    if (const auto it = externals_.find(symbol); it != externals_.end()) {
+        return it->second;
+    }
+    void* address = nullptr;
+#if ISTUDIO_JIT_SUPPORTED
+    address = dlsym(RTLD_DEFAULT, symbol.c_str());
+#endif
+    if (!address) {
+        fail("cannot resolve '" + symbol + "'");
+    }
+    // The C library is rarely within rel32 range of the region, so calls go
+    // through an absolute jump.
+    Assembler assembler;
+    assembler.movAbs(Reg::R11, reinterpret_cast<std::uint64_t>(address));
+    assembler.jmp(Reg::R11);
+    std::uint8_t* stub = allocate(kStubSize, kStubSize);
+    std::memcpy(stub, assembler.code().data(), assembler.size());
+    externals_.emplace(symbol, stub);
+    return stub;
+}
+
+// Calls trap() with the message the compiled code passed and this JIT.
+std::uint8_t* Jit::trapStub()
+{
+    if (!trapStub_) {
+        Assembler assembler;
+        assembler.movAbs(Reg::Rsi, reinterpret_cast<std::uint64_t>(this));
+        assembler.movAbs(Reg::R11, reinterpret_cast<std::uint64_t>(&Jit::trap));
+        assembler.jmp(Reg::R11);
+        trapStub_ = allocate(assembler.size(), kStubSize);
+        std::memcpy(trapStub_, assembler.code().data(), assembler.size());
+    }
+    return trapStub_;
+}
+
+std::uint8_t* Jit::compile(std::size_t index)
+{
+    ObjectCode object;
+    const RuntimeChecks checks{.divisionByZero = true, .stackLimit = stackLimit_};
+    if (auto compiled = compileFunction(*module_.getFunctions()[index], module_, object, checks); !compiled) {
+        fail(compiled.error());
+    }
+    std::uint8_t* code = allocate(object.text.size(), 16);
+    std::memcpy(code, object.text.data(), object.text.size());
+    std::uint8_t* data = allocate(object.rodata.size(), 1);
+    std::memcpy(data, object.rodata.data(), object.rodata.size());
+
+    for (const Relocation& relocation : object.relocations) {
+        std::uint8_t* target = data;
+        if (relocation.kind == Relocation::Kind::Call && relocation.symbol == kTrapSymbol) {
+            target = trapStub();
+        } else if (relocation.kind == Relocation::Kind::Call) {
+            const auto callee = functions_.find(relocation.symbol);
+            target = callee != functions_.end() ? stubs_[callee->second] : externalStub(relocation.symbol);
+        }
+        std::uint8_t* place = code + relocation.offset;
+        put32(place, static_cast<std::int32_t>(target + relocation.addend - place));
+    }
+    ++compiled_;
+    return code;
+}
+
+std::uint64_t Jit::resolve(Jit* jit, std::uint64_t index) noexcept
+{
+    jit->beginWrite();
+    std::uint8_t* code = jit->compile(index);
+    std::uint8_t* stub = jit->stubs_[index];
+    put64(stub + kStubImmediate, reinterpret_cast<std::uint64_t>(code));
+    stub[10] = 0x41; // jmp r11
+    stub[11] = 0xFF;
+    stub[12] = 0xE3;
+    jit->endWrite();
+    return reinterpret_cast<std::uint64_t>(code);
+}
+
+// Only JIT frames lie between the failed check and run(), so jumping back skips
+// no destructors.
+void Jit::trap(const char* message, Jit* jit) noexcept
+{
+    jit->trapMessage_ = message;
+    std::longjmp(jit->trapJump_, 1);
+}
+
+} // namespace istudio::x86
@@ -0,0 +1,193 @@
+#include "x86/LinearScan.h"
+
+#include <algorithm>
+#include <limits>
+#include <unordered_map>
+
+namespace istudio::x86 {
+
+namespace {
+
+using ir::IRBasicBlock;
+using ir::IRInstruction;
+using ir::IRInstructionOp;
+using ir::IRValue;
+using ir::IRValueKind;
+
+constexpr std::uint32_t kUnset = std::numeric_limits<std::uint32_t>::max();
+
+struct Interval {
+    unsigned id{0};
+    std::uint32_t start{kUnset};
+    std::uint32_t end{0};
+    bool crossesCall{false};
+
+    void cover(std::uint32_t position)
+    {
+        start = std::min(start, position);
+        end = std::max(end, position);
+    }
+};
+
+bool isAllocated(const IRValue* value)
+{
+    return value->getKind() == IRValueKind::Argument ||
+           (value->getKind() == IRValueKind::Instruction && value->getType() != ir::IRType::Void);
+}
+
+bool isCalleeSaved(Reg reg, const RegisterPool& pool)
+{
+    return std::find(pool.calleeSaved.begin(), pool.calleeSaved.end(), reg) != pool.calleeSaved.end();
+}
+
+} // namespace
+
+Allocation allocateRegisters(const ir::IRFunction& function, const ir::Liveness& liveness,
+                             const RegisterPool& pool)
+{
+    const std::size_t valueCount = function.getValueCount();
+    std::vector<Interval> intervals(valueCount);
+    for (unsigned id = 0; id < valueCount; ++id) {
+        intervals[id].id = id;
+    }
+
+    // Number the code: each block gets a slot for its Phis, then two per instruction,
+    // and ends one past its terminator.
+    struct Range {
+        std::uint32_t start{0};
+        std::uint32_t end{0};
+    };
+    std::unordered_map<const IRBasicBlock*, Range> ranges;
+    std::vector<std::uint32_t> calls;
+    std::uint32_t position = 0;
+    for (const IRBasicBlock& block : function.getBasicBlocks()) {
+        Range& range = ranges[&block];
+        range.start = position;
+        position += 2;
+        for (const IRInstruction& inst : block) {
+            if (inst.getOp() == IRInstructionOp::Phi) {
+                continue;
+            }
+            if (inst.getOp() == IRInstructionOp::Call) {
+                calls.push_back(position);
+            }
+            position += 2;
+        }
+        range.end = position - 1;
+        position += 1;
+    }
+
+    for (const ir::IRArgument* argument : function.getArguments()) {
+        intervals[argument->getId()].cover(0);
+    }
+    for (const IRBasicBlock& block : function.getBasicBlocks()) {
+        const Range range = ranges.at(&block);
+        std::uint32_t at = range.start + 2;
+        for (const IRInstruction& inst : block) {
+            if (inst.getOp() == IRInstructionOp::Phi) {
+                intervals[inst.getId()].cover(range.start);
+                for (std::size_t i = 0; i < inst.getNumOperands(); ++i) {
+                    const IRValue* operand = inst.getOperand(i);
+                    const auto incoming = ranges.find(inst.getBlocks()[i]);
+                    if (isAllocated(operand) && incoming != ranges.end()) {
+                        intervals[operand->getId()].cover(incoming->second.end);
+                    }
+                }
+                continue;
+            }
+            if (isAllocated(&inst)) {
+                intervals[inst.getId()].cover(at);
+            }
+            for (std::size_t i = 0; i < inst.getNumOperands(); ++i) {
+                if (isAllocated(inst.getOperand(i))) {
+                    intervals[inst.getOperand(i)->getId()].cover(at);
+                }
+            }
+            at += 2;
+        }
+        const auto& liveIn = liveness.liveIn(block);
+        const auto& liveOut = liveness.liveOut(block);
+        for (unsigned id = 0; id < valueCount; ++id) {
+            if (id < liveIn.size() && liveIn[id]) {
+                intervals[id].cover(range.start);
+            }
+            if (id < liveOut.size() && liveOut[id]) {
+                intervals[id].cover(range.end);
+            }
+        }
+    }
+
+    std::vector<Interval*> order;
+    for (Interval& interval : intervals) {
+        if (interval.start == kUnset) {
+            continue;
+        }
+        const auto call = std::upper_bound(calls.begin(), calls.end(), interval.start);
+        interval.crossesCall = call != calls.end() && *call < interval.end;
+        order.push_back(&interval);
+    }
+    std::sort(order.begin(), order.end(), [](const Interval* a, const Interval* b) {
+        return a->start != b->start ? a->start < b->start : a->id < b->id;
+    });
+
+    Allocation allocation;
+    allocation.locations.resize(valueCount);
+    std::vector<Reg> freeCallerSaved(pool.callerSaved.rbegin(), pool.callerSaved.rend());
+    std::vector<Reg> freeCalleeSaved(pool.calleeSaved.rbegin(), pool.calleeSaved.rend());
+    std::vector<Interval*> active; // sorted by end
+    auto release = [&](Reg reg) {
+        (isCalleeSaved(reg, pool) ? freeCalleeSaved : freeCallerSaved).push_back(reg);
+    };
+    auto spill = [&](Interval* interval) {
+        allocation.locations[interval->id] = {Location::Kind::Stack, Reg::Rax, allocation.stackSlots++};
+    };
+    auto activate = [&](Interval* interval, Reg reg) {
+        allocation.locations[interval->id] = {Location::Kind::Register, reg, 0};
+        if (isCalleeSaved(reg, pool) &&
+            std::find(allocation.usedCalleeSaved.begin(), allocation.usedCalleeSaved.end(), reg) ==
+                allocation.usedCalleeSaved.end()) {
+            allocation.usedCalleeSaved.push_back(reg);
+        }
+        active.insert(std::upper_bound(active.begin(), active.end(), interval,
+                                       [](const Interval* a, const Interval* b) { return a->end < b->end; }),
+                      interval);
+    };
+
+    for (Interval* current : order) {
+        while (!active.empty() && active.front()->end < current->start) {
+            release(allocation.locations[active.front()->id].reg);
+            active.erase(active.begin());
+        }
+        if (!current->crossesCall && !freeCallerSaved.empty()) {
+            const Reg reg = freeCallerSaved.back();
+            freeCallerSaved.pop_back();
+            activate(current, reg);
+            continue;
+        }
+        if (!freeCalleeSaved.empty()) {
+            const Reg reg = freeCalleeSaved.back();
+            freeCalleeSaved.pop_back();
+            activate(current, reg);
+            continue;
+        }
+        // Spill whichever usable interval ends last, the current one included.
+        Interval* victim = nullptr;
+        for (auto it = active.rbegin(); it != active.rend(); ++it) {
+            if (!current->crossesCall || isCalleeSaved(allocation.locations[(*it)->id].reg, pool)) {
+                victim = *it;
+                break;
+            }
+        }
+        if (!victim || victim->end <= current->end) {
+            spill(current);
+            continue;
+        }
+        const Reg reg = allocation.locations[victim->id].reg;
+        active.erase(std::find(active.begin(), active.end(), victim));
+        spill(victim);
+        activate(current, reg);
+    }
+    return allocation;
+}
+
+} // namespace istudio::x86